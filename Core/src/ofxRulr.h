@@ -17,6 +17,7 @@
 #include "ofxRulr/Utils/ScopedProcess.h"
 #include "ofxRulr/Utils/Serializable.h"
 #include "ofxRulr/Utils/Set.h"
+#include "ofxRulr/Utils/SolverRuntime.h"
 #include "ofxRulr/Utils/SoundEngine.h"
 #include "ofxRulr/Utils/Utils.h"
 #include "ofxRulr/Utils/CaptureSet.h"
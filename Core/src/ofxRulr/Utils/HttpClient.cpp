@@ -0,0 +1,351 @@
+#include "pch_RulrCore.h"
+#include "HttpClient.h"
+
+#include "Poco/URI.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/Net/HTTPClientSession.h"
+#include "Poco/Net/HTTPRequest.h"
+#include "Poco/Net/HTTPResponse.h"
+#include "Poco/Net/NetException.h"
+
+namespace ofxRulr {
+	namespace Utils {
+		typedef map<string, unique_ptr<Poco::Net::HTTPClientSession>> Sessions;
+
+		//----------
+		static HttpClient::Response perform(const HttpClient::Request & request, Sessions & sessions) {
+			HttpClient::Response response;
+
+			Poco::URI uri(request.url);
+			if (uri.getScheme() != "http") {
+				response.error = "Unsupported URI scheme '" + uri.getScheme() + "'";
+				return response;
+			}
+
+			auto pathAndQuery = uri.getPathAndQuery();
+			if (pathAndQuery.empty()) {
+				pathAndQuery = "/";
+			}
+
+			auto sessionName = uri.getHost() + ":" + ofToString(uri.getPort());
+			auto & session = sessions[sessionName];
+
+			// A kept-alive connection may have been closed by the server since we last used it.
+			// In that case we retry once on a fresh connection, but only if the request is a GET (safe to
+			// send twice) and the connection failed before the server started a response.
+			for (int attempt = 0; attempt < 2; attempt++) {
+				auto reusedSession = (bool) session;
+				auto receivedResponse = false;
+				if (!session) {
+					session = make_unique<Poco::Net::HTTPClientSession>(uri.getHost(), uri.getPort());
+					session->setKeepAlive(true);
+				}
+				session->setTimeout(Poco::Timespan((long) request.timeout, (long) (fmod(request.timeout, 1.0f) * 1e6f)));
+
+				try {
+					Poco::Net::HTTPRequest httpRequest(request.method == HttpClient::Method::POST
+						? Poco::Net::HTTPRequest::HTTP_POST
+						: Poco::Net::HTTPRequest::HTTP_GET
+						, pathAndQuery
+						, Poco::Net::HTTPMessage::HTTP_1_1);
+					httpRequest.setKeepAlive(true);
+					if (!request.body.empty()) {
+						httpRequest.setContentType(request.contentType);
+						httpRequest.setContentLength((std::streamsize) request.body.size());
+					}
+
+					auto & requestStream = session->sendRequest(httpRequest);
+					requestStream << request.body;
+
+					Poco::Net::HTTPResponse httpResponse;
+					auto & responseStream = session->receiveResponse(httpResponse);
+					receivedResponse = true;
+					Poco::StreamCopier::copyToString(responseStream, response.data);
+
+					// Clear any error left by a failed first attempt
+					response.status = (int) httpResponse.getStatus();
+					response.error = response.isSuccess()
+						? string()
+						: httpResponse.getReason();
+					if (!httpResponse.getKeepAlive()) {
+						session.reset();
+					}
+					return response;
+				}
+				catch (const Poco::Exception & e) {
+					session.reset();
+					response.error = e.displayText();
+
+					// Reset whilst sending, or closed without any reply (NoMessageException).
+					// Timeouts are not retried.
+					auto staleSession = dynamic_cast<const Poco::Net::ConnectionResetException *>(&e)
+						|| dynamic_cast<const Poco::Net::ConnectionAbortedException *>(&e)
+						|| dynamic_cast<const Poco::Net::NoMessageException *>(&e);
+					auto canRetry = reusedSession
+						&& staleSession
+						&& !receivedResponse
+						&& request.method == HttpClient::Method::GET;
+					if (!canRetry) {
+						break;
+					}
+				}
+				catch (const std::exception & e) {
+					session.reset();
+					response.error = e.what();
+					break;
+				}
+			}
+
+			return response;
+		}
+
+		//----------
+		bool HttpClient::Response::isSuccess() const {
+			return this->status >= 200 && this->status < 300;
+		}
+
+		//----------
+		HttpClient::HttpClient(size_t maxInFlight)
+			: maxInFlight(0) {
+			this->setMaxInFlight(maxInFlight);
+		}
+
+		//----------
+		HttpClient::~HttpClient() {
+			{
+				auto lock = unique_lock<mutex>(this->queueMutex);
+				this->closing = true;
+			}
+			this->queueCondition.notify_all();
+
+			auto lock = unique_lock<mutex>(this->workersMutex);
+			for (auto & worker : this->workers) {
+				if (worker.joinable()) {
+					worker.join();
+				}
+			}
+
+			// Anything left in the queue never started
+			for (auto & job : this->queue) {
+				Response response;
+				response.error = "HttpClient closed before the request was sent";
+				if (job->callback) {
+					try {
+						job->callback(response);
+					}
+					RULR_CATCH_ALL_TO_ERROR;
+				}
+				else {
+					job->promise.set_value(response);
+				}
+			}
+		}
+
+		//----------
+		void HttpClient::setMaxInFlight(size_t maxInFlight) {
+			maxInFlight = max<size_t>(maxInFlight, 1);
+			{
+				auto lock = unique_lock<mutex>(this->queueMutex);
+				this->maxInFlight = maxInFlight;
+			}
+			this->queueCondition.notify_all();
+
+			auto lock = unique_lock<mutex>(this->workersMutex);
+			while (this->workers.size() < maxInFlight) {
+				auto workerIndex = this->workers.size();
+				this->workers.emplace_back([this, workerIndex]() {
+					this->workerFunction(workerIndex);
+				});
+			}
+		}
+
+		//----------
+		size_t HttpClient::getMaxInFlight() const {
+			auto lock = unique_lock<mutex>(this->queueMutex);
+			return this->maxInFlight;
+		}
+
+		//----------
+		future<HttpClient::Response> HttpClient::request(const Request & request) {
+			auto job = make_shared<Job>();
+			job->request = request;
+			auto future = job->promise.get_future();
+			{
+				auto lock = unique_lock<mutex>(this->queueMutex);
+				this->queue.push_back(job);
+			}
+
+			// Not notify_one : the woken worker may be one parked above maxInFlight, which would go back to sleep
+			this->queueCondition.notify_all();
+			return future;
+		}
+
+		//----------
+		void HttpClient::request(const Request & request, const Callback & callback) {
+			auto job = make_shared<Job>();
+			job->request = request;
+			job->callback = callback;
+			{
+				auto lock = unique_lock<mutex>(this->queueMutex);
+				this->queue.push_back(job);
+			}
+			this->queueCondition.notify_all();
+		}
+
+		//----------
+		HttpClient::Response HttpClient::requestSync(const Request & request) {
+			return this->request(request).get();
+		}
+
+		//----------
+		vector<HttpClient::Response> HttpClient::requestAll(const vector<Request> & requests) {
+			vector<future<Response>> futures;
+			futures.reserve(requests.size());
+			for (const auto & request : requests) {
+				futures.push_back(this->request(request));
+			}
+
+			vector<Response> responses;
+			responses.reserve(requests.size());
+			for (auto & future : futures) {
+				responses.push_back(future.get());
+			}
+			return responses;
+		}
+
+		//----------
+		size_t HttpClient::getInFlightCount() const {
+			auto lock = unique_lock<mutex>(this->queueMutex);
+			return this->inFlightCount;
+		}
+
+		//----------
+		size_t HttpClient::getQueueSize() const {
+			auto lock = unique_lock<mutex>(this->queueMutex);
+			return this->queue.size();
+		}
+
+		//----------
+		map<string, HttpClient::EndpointStatistics> HttpClient::getStatistics() const {
+			auto lock = unique_lock<mutex>(this->statisticsMutex);
+			return this->statistics;
+		}
+
+		//----------
+		void HttpClient::resetStatistics() {
+			auto lock = unique_lock<mutex>(this->statisticsMutex);
+			this->statistics.clear();
+		}
+
+		//----------
+		void HttpClient::addToInspector(shared_ptr<ofxCvGui::Panels::Widgets> inspector) {
+			inspector->addTitle("HTTP", ofxCvGui::Widgets::Title::Level::H3);
+
+			inspector->addLiveValue<string>("In flight", [this]() {
+				return ofToString(this->getInFlightCount()) + " / " + ofToString(this->getMaxInFlight())
+					+ " (" + ofToString(this->getQueueSize()) + " queued)";
+			});
+
+			inspector->addLiveValue<string>("Endpoints", [this]() {
+				stringstream message;
+				for (const auto & it : this->getStatistics()) {
+					const auto & endpoint = it.second;
+					message << it.first << " : "
+						<< endpoint.requestCount << " requests, "
+						<< endpoint.errorCount << " errors, "
+						<< ofToString(endpoint.meanLatency, 1) << "ms mean, "
+						<< ofToString(endpoint.maxLatency, 1) << "ms max" << endl;
+				}
+				return message.str();
+			});
+
+			inspector->addButton("Reset HTTP statistics", [this]() {
+				this->resetStatistics();
+			});
+		}
+
+		//----------
+		string HttpClient::getEndpointName(const Request & request) {
+			string name = request.method == Method::POST ? "POST " : "GET ";
+
+			try {
+				Poco::URI uri(request.url);
+				name += uri.getHost() + ":" + ofToString(uri.getPort());
+
+				vector<string> segments;
+				uri.getPathSegments(segments);
+				for (const auto & segment : segments) {
+					auto isNumeric = !segment.empty()
+						&& std::all_of(segment.begin(), segment.end(), [](char c) {
+							return isdigit((unsigned char) c) || c == '.' || c == ',' || c == '-';
+						});
+					name += "/" + (isNumeric ? string("*") : segment);
+				}
+			}
+			catch (...) {
+				name += request.url;
+			}
+
+			return name;
+		}
+
+		//----------
+		void HttpClient::workerFunction(size_t workerIndex) {
+			Sessions sessions;
+
+			while (true) {
+				shared_ptr<Job> job;
+				{
+					auto lock = unique_lock<mutex>(this->queueMutex);
+					this->queueCondition.wait(lock, [this, workerIndex]() {
+						return this->closing
+							|| (!this->queue.empty() && workerIndex < this->maxInFlight);
+					});
+					if (this->closing) {
+						break;
+					}
+
+					job = this->queue.front();
+					this->queue.pop_front();
+					this->inFlightCount++;
+				}
+
+				auto startTime = chrono::steady_clock::now();
+				auto response = perform(job->request, sessions);
+				response.latency = chrono::duration<float, milli>(chrono::steady_clock::now() - startTime).count();
+
+				this->recordStatistics(job->request, response);
+
+				{
+					auto lock = unique_lock<mutex>(this->queueMutex);
+					this->inFlightCount--;
+				}
+
+				if (job->callback) {
+					try {
+						job->callback(response);
+					}
+					RULR_CATCH_ALL_TO_ERROR;
+				}
+				else {
+					job->promise.set_value(response);
+				}
+			}
+		}
+
+		//----------
+		void HttpClient::recordStatistics(const Request & request, const Response & response) {
+			auto name = HttpClient::getEndpointName(request);
+
+			auto lock = unique_lock<mutex>(this->statisticsMutex);
+			auto & endpoint = this->statistics[name];
+			endpoint.requestCount++;
+			if (!response.isSuccess()) {
+				endpoint.errorCount++;
+			}
+			endpoint.lastLatency = response.latency;
+			endpoint.meanLatency += (response.latency - endpoint.meanLatency) / (float) endpoint.requestCount;
+			endpoint.maxLatency = max(endpoint.maxLatency, response.latency);
+		}
+	}
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "ofxRulr/Utils/Constants.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+
+namespace ofxCvGui {
+	namespace Panels {
+		class Widgets;
+	}
+}
+
+namespace ofxRulr {
+	namespace Utils {
+		//HTTP requests performed on a pool of worker threads, so that many requests (e.g. one per module) are
+		//in flight at once rather than each waiting for the previous one to complete.
+		//
+		//Each worker keeps its connections open between requests (HTTP/1.1 keep-alive, one connection per
+		//worker per host), so a batch of N requests costs roughly N / maxInFlight round trips and no
+		//connection setup after the first batch. A GET which fails because its kept-alive connection was
+		//closed by the server (before any response arrived) is retried once on a fresh connection. POSTs and
+		//timeouts are never retried.
+		//
+		//Latency and error counts are kept per endpoint. Numeric path segments are collapsed into the
+		//endpoint name, e.g. "GET localhost:8080/*/*/getPosition".
+		//
+		//Only plain http:// URLs are supported.
+		class OFXRULR_API_ENTRY HttpClient {
+		public:
+			enum class Method {
+				GET,
+				POST
+			};
+
+			struct Request {
+				Method method = Method::GET;
+				string url;
+				string body;
+				string contentType = "application/json";
+				float timeout = 5.0f; // [s]
+			};
+
+			struct Response {
+				int status = 0; // 0 if the request didn't complete
+				string data;
+				string error;
+				float latency = 0.0f; // [ms]
+
+				bool isSuccess() const;
+			};
+
+			struct EndpointStatistics {
+				size_t requestCount = 0;
+				size_t errorCount = 0;
+				float lastLatency = 0.0f; // [ms]
+				float meanLatency = 0.0f; // [ms]
+				float maxLatency = 0.0f; // [ms]
+			};
+
+			typedef function<void(const Response &)> Callback;
+
+			HttpClient(size_t maxInFlight = 16);
+			~HttpClient();
+
+			//Extra workers are started when this is raised. Lowering it leaves the extra workers idle
+			void setMaxInFlight(size_t);
+			size_t getMaxInFlight() const;
+
+			//Never throws for network or HTTP errors, check the Response instead
+			future<Response> request(const Request &);
+
+			//The callback is called on a worker thread
+			void request(const Request &, const Callback &);
+
+			//Blocks until complete
+			Response requestSync(const Request &);
+
+			//Performs all the requests concurrently and blocks until they have all completed.
+			//Responses are in the same order as the requests
+			vector<Response> requestAll(const vector<Request> &);
+
+			size_t getInFlightCount() const;
+			size_t getQueueSize() const;
+
+			map<string, EndpointStatistics> getStatistics() const;
+			void resetStatistics();
+
+			void addToInspector(shared_ptr<ofxCvGui::Panels::Widgets>);
+
+			static string getEndpointName(const Request &);
+		protected:
+			struct Job {
+				Request request;
+				promise<Response> promise;
+				Callback callback;
+			};
+
+			void workerFunction(size_t workerIndex);
+			void recordStatistics(const Request &, const Response &);
+
+			deque<shared_ptr<Job>> queue;
+			size_t maxInFlight;
+			size_t inFlightCount = 0;
+			bool closing = false;
+			mutable mutex queueMutex;
+			condition_variable queueCondition;
+
+			vector<std::thread> workers;
+			mutex workersMutex;
+
+			map<string, EndpointStatistics> statistics;
+			mutable mutex statisticsMutex;
+		};
+	}
+}
\ No newline at end of file
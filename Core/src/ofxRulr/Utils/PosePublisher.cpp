@@ -0,0 +1,339 @@
+#include "pch_RulrCore.h"
+#include "PosePublisher.h"
+
+#include "ofxOscSender.h"
+#include "ofxOscBundle.h"
+#include "UdpSocket.h"
+
+namespace ofxRulr {
+	namespace Utils {
+		const uint16_t binaryVersion = 1;
+		const size_t binaryHeaderSize = 4 + 2 + 2 + 4 + 2 + 2 + 8;
+		const size_t binaryPoseSize = 4 + 16 * 4;
+		const size_t maxDatagramSize = 1472; // Ethernet MTU - IP and UDP headers
+
+		//----------
+		template<typename T>
+		void writeValue(uint8_t *& cursor, const T & value) {
+			memcpy(cursor, &value, sizeof(T));
+			cursor += sizeof(T);
+		}
+
+		//----------
+		static string getSharedKey(const PosePublisher::Settings & settings) {
+			stringstream key;
+			key << (int) settings.format.get();
+			for (const auto & destination : settings.destinations) {
+				key << "," << destination.address << ":" << destination.port;
+			}
+			return key.str();
+		}
+
+		//----------
+		static mutex sharedPublishersMutex;
+		static map<string, weak_ptr<PosePublisher>> sharedPublishers;
+
+		//----------
+		PosePublisher::PosePublisher() {
+			this->thread = std::thread([this]() {
+				this->threadedFunction();
+			});
+		}
+
+		//----------
+		PosePublisher::~PosePublisher() {
+			{
+				auto lock = unique_lock<mutex>(this->pendingMutex);
+				this->closing = true;
+			}
+			this->pendingCondition.notify_all();
+			if (this->thread.joinable()) {
+				this->thread.join();
+			}
+		}
+
+		//----------
+		void PosePublisher::setSettings(const Settings & settings) {
+			auto lock = unique_lock<mutex>(this->pendingMutex);
+			this->settings = settings;
+			this->settingsChanged = true;
+		}
+
+		//----------
+		PosePublisher::Settings PosePublisher::getSettings() const {
+			auto lock = unique_lock<mutex>(this->pendingMutex);
+			return this->settings;
+		}
+
+		//----------
+		shared_ptr<PosePublisher> PosePublisher::acquireShared(const Settings & settings) {
+			shared_ptr<PosePublisher> publisher;
+			{
+				auto lock = unique_lock<mutex>(sharedPublishersMutex);
+				auto & sharedPublisher = sharedPublishers[getSharedKey(settings)];
+				publisher = sharedPublisher.lock();
+				if (!publisher) {
+					publisher = make_shared<PosePublisher>();
+					publisher->setSettings(settings);
+					sharedPublisher = publisher;
+				}
+
+				//remove entries whose publishers have been released
+				for (auto it = sharedPublishers.begin(); it != sharedPublishers.end(); ) {
+					if (it->second.expired()) {
+						it = sharedPublishers.erase(it);
+					}
+					else {
+						it++;
+					}
+				}
+			}
+
+			{
+				auto lock = unique_lock<mutex>(publisher->pendingMutex);
+				publisher->sourceCount++;
+			}
+			return publisher;
+		}
+
+		//----------
+		void PosePublisher::releaseShared(shared_ptr<PosePublisher> & publisher) {
+			if (!publisher) {
+				return;
+			}
+			{
+				auto lock = unique_lock<mutex>(publisher->pendingMutex);
+				if (publisher->sourceCount > 0) {
+					publisher->sourceCount--;
+				}
+			}
+			publisher->pendingCondition.notify_all();
+			publisher.reset();
+		}
+
+		//----------
+		void PosePublisher::publish(const vector<Pose> & poses, chrono::nanoseconds timestamp) {
+			{
+				auto lock = unique_lock<mutex>(this->pendingMutex);
+				for (const auto & pose : poses) {
+					auto findPose = this->pendingPoses.find(pose.ID);
+					if (findPose != this->pendingPoses.end()) {
+						findPose->second = pose;
+						this->posesCoalesced++;
+					}
+					else {
+						this->pendingPoses.emplace(pose.ID, pose);
+					}
+				}
+				this->pendingTimestamp = timestamp;
+			}
+			this->pendingCondition.notify_all();
+		}
+
+		//----------
+		uint32_t PosePublisher::getSequence() const {
+			return this->sequence.load();
+		}
+
+		//----------
+		size_t PosePublisher::getPosesCoalesced() const {
+			return this->posesCoalesced.load();
+		}
+
+		//----------
+		size_t PosePublisher::getSourceCount() const {
+			auto lock = unique_lock<mutex>(this->pendingMutex);
+			return this->sourceCount;
+		}
+
+		//----------
+		vector<PosePublisher::Destination> PosePublisher::parseDestinations(const string & text, int defaultPort) {
+			vector<Destination> destinations;
+			for (auto entry : ofSplitString(text, ",", true, true)) {
+				Destination destination{ entry, defaultPort };
+				auto colon = entry.rfind(':');
+				if (colon != string::npos) {
+					destination.address = entry.substr(0, colon);
+					destination.port = ofToInt(entry.substr(colon + 1));
+				}
+				if (!destination.address.empty() && destination.port > 0) {
+					destinations.push_back(destination);
+				}
+			}
+			return destinations;
+		}
+
+		//----------
+		void PosePublisher::threadedFunction() {
+			Settings settings;
+			vector<Pose> poses;
+
+			while (true) {
+				chrono::nanoseconds timestamp;
+				bool settingsChanged = false;
+
+				//wait for poses and take them all
+				{
+					auto lock = unique_lock<mutex>(this->pendingMutex);
+					this->pendingCondition.wait(lock, [this]() {
+						return this->closing || !this->pendingPoses.empty();
+					});
+
+					//gather the poses of the other sources for this frame
+					auto gatherDeadline = chrono::steady_clock::now() + this->gatherTimeout;
+					this->pendingCondition.wait_until(lock, gatherDeadline, [this]() {
+						return this->closing || this->pendingPoses.size() >= this->sourceCount;
+					});
+
+					if (this->closing) {
+						break;
+					}
+
+					poses.clear();
+					for (auto & pendingPose : this->pendingPoses) {
+						poses.push_back(move(pendingPose.second));
+					}
+					this->pendingPoses.clear();
+					timestamp = this->pendingTimestamp;
+
+					if (this->settingsChanged) {
+						settings = this->settings;
+						settingsChanged = true;
+						this->settingsChanged = false;
+					}
+				}
+
+				try {
+					if (settingsChanged) {
+						this->rebuildSockets(settings);
+					}
+
+					auto sequence = this->sequence++;
+					switch (settings.format.get()) {
+					case PoseFormat::OSC:
+						this->sendOSC(poses, sequence, timestamp);
+						break;
+					case PoseFormat::Binary:
+						this->sendBinary(poses, sequence, timestamp);
+						break;
+					default:
+						break;
+					}
+				}
+				catch (const std::exception & e) {
+					RULR_ERROR << "PosePublisher : " << e.what();
+				}
+				catch (...) {
+					RULR_ERROR << "PosePublisher : Unknown error";
+				}
+			}
+		}
+
+		//----------
+		void PosePublisher::rebuildSockets(const Settings & settings) {
+			this->oscSenders.clear();
+			this->sockets.clear();
+
+			for (const auto & destination : settings.destinations) {
+				try {
+					switch (settings.format.get()) {
+					case PoseFormat::OSC:
+					{
+						auto sender = make_unique<ofxOscSender>();
+						sender->setup(destination.address, destination.port);
+						this->oscSenders.push_back(move(sender));
+						break;
+					}
+					case PoseFormat::Binary:
+					{
+						auto socket = make_unique<UdpTransmitSocket>(IpEndpointName(destination.address.c_str(), destination.port));
+						this->sockets.push_back(move(socket));
+						break;
+					}
+					default:
+						break;
+					}
+				}
+				catch (const std::exception & e) {
+					RULR_ERROR << "PosePublisher : Couldn't open " << destination.address << ":" << destination.port << " (" << e.what() << ")";
+				}
+			}
+		}
+
+		//----------
+		void PosePublisher::sendOSC(const vector<Pose> & poses, uint32_t sequence, chrono::nanoseconds timestamp) {
+			if (this->oscSenders.empty()) {
+				return;
+			}
+
+			ofxOscBundle bundle;
+			{
+				ofxOscMessage message;
+				message.setAddress("/frame");
+				message.addInt32Arg((int32_t)sequence);
+				message.addInt64Arg(timestamp.count());
+				bundle.addMessage(message);
+			}
+
+			for (const auto & pose : poses) {
+				if (!pose.oscAddress.empty()) {
+					ofxOscMessage message;
+					message.setAddress(pose.oscAddress);
+					auto values = glm::value_ptr(pose.transform);
+					for (int i = 0; i < 16; i++) {
+						message.addFloatArg(values[i]);
+					}
+					bundle.addMessage(message);
+				}
+				for (const auto & message : pose.oscMessages) {
+					bundle.addMessage(message);
+				}
+			}
+
+			for (auto & sender : this->oscSenders) {
+				sender->sendBundle(bundle);
+			}
+		}
+
+		//----------
+		void PosePublisher::sendBinary(const vector<Pose> & poses, uint32_t sequence, chrono::nanoseconds timestamp) {
+			if (this->sockets.empty()) {
+				return;
+			}
+
+			const size_t posesPerPacket = (maxDatagramSize - binaryHeaderSize) / binaryPoseSize;
+			const auto packetCount = (uint16_t)max<size_t>((poses.size() + posesPerPacket - 1) / posesPerPacket, 1);
+
+			this->packetBuffer.resize(maxDatagramSize);
+
+			for (uint16_t packetIndex = 0; packetIndex < packetCount; packetIndex++) {
+				auto poseBegin = packetIndex * posesPerPacket;
+				auto poseEnd = min(poseBegin + posesPerPacket, poses.size());
+
+				auto cursor = this->packetBuffer.data();
+				{
+					const char magic[4] = { 'R', 'L', 'P', 'S' };
+					memcpy(cursor, magic, 4);
+					cursor += 4;
+					writeValue(cursor, binaryVersion);
+					writeValue(cursor, (uint16_t)(poseEnd - poseBegin));
+					writeValue(cursor, sequence);
+					writeValue(cursor, packetIndex);
+					writeValue(cursor, packetCount);
+					writeValue(cursor, (int64_t)timestamp.count());
+				}
+
+				for (auto i = poseBegin; i < poseEnd; i++) {
+					writeValue(cursor, poses[i].ID);
+					memcpy(cursor, glm::value_ptr(poses[i].transform), 16 * sizeof(float));
+					cursor += 16 * sizeof(float);
+				}
+
+				auto size = (size_t)(cursor - this->packetBuffer.data());
+				for (auto & socket : this->sockets) {
+					socket->Send((const char *)this->packetBuffer.data(), size);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "ofxRulr/Utils/Constants.h"
+#include "ofxOscMessage.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+class ofxOscSender;
+class UdpTransmitSocket;
+
+namespace ofxRulr {
+	namespace Utils {
+		MAKE_ENUM(PoseFormat
+			, (OSC, Binary)
+			, ("OSC", "Binary"));
+
+		//Publishes rigid body poses over UDP from a dedicated thread, so that the
+		//tracking thread which calls publish() never waits on the network.
+		//
+		//Poses published whilst the previous packet is being sent are coalesced (latest pose per ID)
+		//and leave together in the next packet, so a slow consumer causes dropped poses rather than latency.
+		//
+		//Publishers are shared process-wide by settings (destinations and format). Each body which publishes to the
+		//same destinations holds the same publisher (see acquireShared), and the publisher waits (up to gatherTimeout)
+		//for a pose from each of its sources before sending, so the bodies of one frame leave in one packet.
+		//
+		//Destinations may be unicast or multicast group addresses (multicast is sent with the default TTL of 1).
+		//
+		//Binary format (little endian), split into as many datagrams as needed to stay under the MTU:
+		//	Header	: char[4] "RLPS", uint16 version, uint16 poseCount, uint32 sequence, uint16 packetIndex, uint16 packetCount, int64 timestamp [ns]
+		//	Pose	: uint32 ID, float[16] transform (column major)
+		class OFXRULR_API_ENTRY PosePublisher {
+		public:
+			struct Pose {
+				uint32_t ID = 0;
+				glm::mat4 transform;
+
+				//OSC format only
+				string oscAddress; // address of the transform message (16 floats)
+				vector<ofxOscMessage> oscMessages; // extra messages sent alongside the transform
+			};
+
+			struct Destination {
+				string address;
+				int port;
+			};
+
+			struct Settings {
+				vector<Destination> destinations;
+				PoseFormat format = PoseFormat::OSC;
+			};
+
+			PosePublisher();
+			~PosePublisher();
+
+			//Get the publisher for these settings (creating it if needed) and register the caller as one of its sources.
+			//Call releaseShared when the caller stops publishing (or before acquiring with different settings).
+			static shared_ptr<PosePublisher> acquireShared(const Settings &);
+			static void releaseShared(shared_ptr<PosePublisher> &);
+
+			void setSettings(const Settings &);
+			Settings getSettings() const;
+
+			//Thread safe, doesn't block on sending
+			void publish(const vector<Pose> &, chrono::nanoseconds timestamp);
+
+			uint32_t getSequence() const;
+			size_t getPosesCoalesced() const;
+			size_t getSourceCount() const;
+
+			//Parse "host:port, host:port, ..." (entries without a port use defaultPort)
+			static vector<Destination> parseDestinations(const string &, int defaultPort);
+		protected:
+			void threadedFunction();
+			void rebuildSockets(const Settings &);
+			void sendOSC(const vector<Pose> &, uint32_t sequence, chrono::nanoseconds timestamp);
+			void sendBinary(const vector<Pose> &, uint32_t sequence, chrono::nanoseconds timestamp);
+
+			Settings settings;
+			bool settingsChanged = true;
+
+			map<uint32_t, Pose> pendingPoses;
+			chrono::nanoseconds pendingTimestamp;
+			size_t sourceCount = 0;
+			chrono::microseconds gatherTimeout{ 2000 };
+			bool closing = false;
+			mutable mutex pendingMutex;
+			condition_variable pendingCondition;
+
+			//owned by the publishing thread
+			vector<unique_ptr<ofxOscSender>> oscSenders;
+			vector<unique_ptr<UdpTransmitSocket>> sockets;
+			vector<uint8_t> packetBuffer;
+
+			atomic<uint32_t> sequence{ 0 };
+			atomic<size_t> posesCoalesced{ 0 };
+
+			std::thread thread;
+		};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+
+// Header only : include from plugins which use ofxCeres (Core itself doesn't link ceres)
+#include "ofxCeres.h"
+#include "ofxRulr/Utils/SolverRuntime.h"
+
+#include <unordered_map>
+
+namespace ofxRulr {
+	namespace Utils {
+		//----------
+		// Forwards each iteration to the SolverRuntime, and stops the solve when it is cancelled
+		class SolverRuntimeCallback : public ceres::IterationCallback {
+		public:
+			SolverRuntimeCallback(SolverRuntime::Solve & solve)
+				: solve(solve) {
+
+			}
+
+			ceres::CallbackReturnType operator()(const ceres::IterationSummary & iterationSummary) override {
+				SolverRuntime::Iteration iteration{
+					iterationSummary.iteration
+					, iterationSummary.cost
+					, iterationSummary.cumulative_time_in_seconds
+				};
+				return SolverRuntime::X().reportIteration(this->solve, iteration)
+					? ceres::SOLVER_CONTINUE
+					: ceres::SOLVER_ABORT;
+			}
+		protected:
+			SolverRuntime::Solve & solve;
+		};
+
+		//----------
+		// Choose a Schur complement solver if the problem has point-like blocks which can be eliminated, i.e. a
+		// large set of parameter blocks which share no residual with each other (e.g. the points of a bundle
+		// adjustment). The eliminated blocks become the first group of the linear solver ordering.
+		// Leaves the options alone if they already have an ordering, or if eliminating wouldn't pay off.
+		inline void selectLinearSolver(ceres::Solver::Options & options, const ceres::Problem & problem) {
+			if (options.minimizer_type != ceres::TRUST_REGION
+				|| options.linear_solver_ordering) {
+				return;
+			}
+
+			vector<double*> parameterBlocks;
+			problem.GetParameterBlocks(&parameterBlocks);
+
+			unordered_map<const double*, size_t> parameterBlockIndices;
+			for (size_t i = 0; i < parameterBlocks.size(); i++) {
+				parameterBlockIndices[parameterBlocks[i]] = i;
+			}
+
+			// Which free blocks share each residual
+			vector<ceres::ResidualBlockId> residualBlocks;
+			problem.GetResidualBlocks(&residualBlocks);
+			vector<vector<size_t>> blocksOfResidual(residualBlocks.size());
+			vector<vector<size_t>> residualsOfBlock(parameterBlocks.size());
+			{
+				vector<double*> residualParameterBlocks;
+				for (size_t r = 0; r < residualBlocks.size(); r++) {
+					problem.GetParameterBlocksForResidualBlock(residualBlocks[r], &residualParameterBlocks);
+					for (auto parameterBlock : residualParameterBlocks) {
+						if (problem.IsParameterBlockConstant(parameterBlock)) {
+							continue;
+						}
+						auto b = parameterBlockIndices[parameterBlock];
+						blocksOfResidual[r].push_back(b);
+						residualsOfBlock[b].push_back(r);
+					}
+				}
+			}
+
+			// Greedy independent set, smallest blocks first (points are smaller than cameras / poses)
+			vector<size_t> order;
+			size_t freeParameterCount = 0;
+			for (size_t b = 0; b < parameterBlocks.size(); b++) {
+				if (!problem.IsParameterBlockConstant(parameterBlocks[b])) {
+					order.push_back(b);
+					freeParameterCount += problem.ParameterBlockSize(parameterBlocks[b]);
+				}
+			}
+			stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+				return problem.ParameterBlockSize(parameterBlocks[a]) < problem.ParameterBlockSize(parameterBlocks[b]);
+			});
+
+			vector<bool> eliminate(parameterBlocks.size(), false);
+			vector<bool> blocked(parameterBlocks.size(), false);
+			size_t eliminatedBlockCount = 0;
+			size_t eliminatedParameterCount = 0;
+			for (auto b : order) {
+				if (blocked[b]) {
+					continue;
+				}
+				eliminate[b] = true;
+				eliminatedBlockCount++;
+				eliminatedParameterCount += problem.ParameterBlockSize(parameterBlocks[b]);
+				for (auto r : residualsOfBlock[b]) {
+					for (auto neighbour : blocksOfResidual[r]) {
+						blocked[neighbour] = true;
+					}
+				}
+			}
+
+			// Only worth it if most of the problem is eliminated, leaving a small reduced system
+			const auto reducedParameterCount = freeParameterCount - eliminatedParameterCount;
+			if (eliminatedBlockCount < 2
+				|| reducedParameterCount == 0
+				|| eliminatedParameterCount < 2 * reducedParameterCount) {
+				return;
+			}
+
+			auto ordering = make_shared<ceres::ParameterBlockOrdering>();
+			for (size_t b = 0; b < parameterBlocks.size(); b++) {
+				ordering->AddElementToGroup(parameterBlocks[b], eliminate[b] ? 0 : 1);
+			}
+			options.linear_solver_ordering = ordering;
+
+			if (reducedParameterCount > 1000
+				&& ceres::IsSparseLinearAlgebraLibraryTypeAvailable(options.sparse_linear_algebra_library_type)) {
+				options.linear_solver_type = ceres::SPARSE_SCHUR;
+			}
+			else {
+				options.linear_solver_type = ceres::DENSE_SCHUR;
+			}
+		}
+
+		//----------
+		// ofxCeres::Result which also keeps the number of iterations the solve took (e.g. for benchmarks)
+		template<typename SolutionType>
+		struct SolveResult : ofxCeres::Result<SolutionType> {
+			SolveResult() {
+
+			}
+
+			SolveResult(const ceres::Solver::Summary & summary)
+				: ofxCeres::Result<SolutionType>(summary)
+				, iterations(summary.num_successful_steps + summary.num_unsuccessful_steps) {
+
+			}
+
+			int iterations = -1; // -1 if not made by a solve
+		};
+
+		//----------
+		// Use in place of ceres::Solve. Applies the machine-wide thread budget (options.num_threads is the
+		// request, 0 = as many as available) and streams telemetry to the SolverRuntime.
+		// Solvers with point-like blocks (e.g. bundle adjustment) can opt in to selectLinearSolver, otherwise
+		// the linear solver in the options is used as given.
+		inline void solveCeres(const string & name
+			, ceres::Solver::Options options
+			, ceres::Problem * problem
+			, ceres::Solver::Summary * summary
+			, bool selectLinearSolverFromStructure = false) {
+			auto & runtime = SolverRuntime::X();
+
+			auto threadLease = runtime.acquireThreads((size_t) max(options.num_threads, 0));
+			options.num_threads = (int) threadLease->getThreadCount();
+
+			if (selectLinearSolverFromStructure) {
+				selectLinearSolver(options, *problem);
+			}
+
+			auto solve = runtime.beginSolve(name
+				, threadLease->getThreadCount()
+				, ceres::LinearSolverTypeToString(options.linear_solver_type));
+
+			SolverRuntimeCallback callback(*solve);
+			options.callbacks.push_back(&callback);
+
+			try {
+				ceres::Solve(options, problem, summary);
+			}
+			catch (...) {
+				runtime.endSolve(solve);
+				throw;
+			}
+			runtime.endSolve(solve);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,272 @@
+#include "pch_RulrCore.h"
+#include "SolverBenchmark.h"
+#include "SolverRuntime.h"
+
+namespace ofxRulr {
+	namespace Utils {
+		//----------
+		static int getLatestSolveIterations() {
+			auto solve = SolverRuntime::X().getLatestSolve();
+			SolverRuntime::Iteration iteration;
+			if (!solve || !solve->getLastIteration(iteration)) {
+				return -1;
+			}
+			return iteration.iteration;
+		}
+
+#pragma mark Record
+		//----------
+		void SolverBenchmark::Record::addIterations(int iterations) {
+			if (iterations < 0) {
+				return;
+			}
+			this->iterations = max(this->iterations, 0) + iterations;
+		}
+
+#pragma mark SolverBenchmark
+		//----------
+		SolverBenchmark::Record SolverBenchmark::measure(const string & solver
+			, const string & problem
+			, size_t size
+			, size_t trial
+			, const function<void(Record &)> & action) {
+			Record record;
+			record.solver = solver;
+			record.problem = problem;
+			record.size = size;
+			record.trial = trial;
+
+			auto & runtime = SolverRuntime::X();
+			auto priorSolve = runtime.getLatestSolve();
+
+			auto startTime = chrono::high_resolution_clock::now();
+			{
+				action(record);
+			}
+			auto endTime = chrono::high_resolution_clock::now();
+			record.wallTime = chrono::duration<float, milli>(endTime - startTime).count();
+
+			if (record.iterations < 0) {
+				auto latestSolve = runtime.getLatestSolve();
+				if (latestSolve && latestSolve != priorSolve) {
+					record.iterations = getLatestSolveIterations();
+				}
+			}
+
+			{
+				auto lock = unique_lock<mutex>(this->recordsMutex);
+				this->records.push_back(record);
+			}
+
+			return record;
+		}
+
+		//----------
+		void SolverBenchmark::clear() {
+			auto lock = unique_lock<mutex>(this->recordsMutex);
+			this->records.clear();
+		}
+
+		//----------
+		vector<SolverBenchmark::Record> SolverBenchmark::getRecords() const {
+			auto lock = unique_lock<mutex>(this->recordsMutex);
+			return this->records;
+		}
+
+		//----------
+		vector<SolverBenchmark::Summary> SolverBenchmark::getSummaries() const {
+			auto records = this->getRecords();
+
+			//group by solver, problem and size (in order of first appearance)
+			vector<Summary> summaries;
+			for (const auto & record : records) {
+				auto findSummary = find_if(summaries.begin(), summaries.end(), [&record](const Summary & summary) {
+					return summary.solver == record.solver
+						&& summary.problem == record.problem
+						&& summary.size == record.size;
+				});
+
+				if (findSummary == summaries.end()) {
+					Summary summary;
+					summary.solver = record.solver;
+					summary.problem = record.problem;
+					summary.size = record.size;
+					summary.wallTimeMin = record.wallTime;
+					summary.wallTimeMax = record.wallTime;
+					summaries.push_back(summary);
+					findSummary = summaries.end() - 1;
+				}
+
+				auto & summary = *findSummary;
+				summary.trials++;
+				if (record.converged) {
+					summary.convergedCount++;
+				}
+				summary.wallTimeMean += record.wallTime;
+				summary.wallTimeMin = min(summary.wallTimeMin, record.wallTime);
+				summary.wallTimeMax = max(summary.wallTimeMax, record.wallTime);
+				if (record.iterations >= 0) {
+					summary.iterationsMean = max(summary.iterationsMean, 0.0f) + (float) record.iterations;
+					summary.iterationsReportedCount++;
+				}
+				summary.residualMean += record.residual;
+				summary.parameterErrorMean += record.parameterError;
+				summary.parameterErrorMax = max(summary.parameterErrorMax, record.parameterError);
+			}
+
+			for (auto & summary : summaries) {
+				auto trials = (float) summary.trials;
+				summary.wallTimeMean /= trials;
+				if (summary.iterationsReportedCount > 0) {
+					summary.iterationsMean /= (float) summary.iterationsReportedCount;
+				}
+				summary.residualMean /= trials;
+				summary.parameterErrorMean /= trials;
+			}
+
+			return summaries;
+		}
+
+		//----------
+		string SolverBenchmark::getSummaryText() const {
+			stringstream ss;
+			for (const auto & summary : this->getSummaries()) {
+				ss << summary.solver << " [" << summary.problem << " x" << summary.size << "] : "
+					<< summary.convergedCount << "/" << summary.trials << " converged" << endl;
+				ss << "\ttime mean/min/max : "
+					<< summary.wallTimeMean << " / "
+					<< summary.wallTimeMin << " / "
+					<< summary.wallTimeMax << " ms";
+				if (summary.iterationsReportedCount > 0) {
+					ss << ", " << summary.iterationsMean << " iterations";
+				}
+				ss << endl;
+				ss << "\tresidual " << summary.residualMean
+					<< ", error mean/max : " << summary.parameterErrorMean << " / " << summary.parameterErrorMax << endl;
+			}
+			return ss.str();
+		}
+
+		//----------
+		void SolverBenchmark::save(string filename, const string & label) const {
+			if (filename.empty()) {
+				auto result = ofSystemSaveDialog("solverBenchmark", "Save solver benchmark results (.json and .csv)");
+				if (!result.bSuccess) {
+					return;
+				}
+				filename = result.filePath;
+			}
+
+			//strip any extension, we write both formats
+			auto basePath = filesystem::path(filename);
+			if (basePath.extension() == ".json" || basePath.extension() == ".csv") {
+				basePath.replace_extension();
+			}
+
+			this->saveJson(basePath.string() + ".json", label);
+			this->saveCsv(basePath.string() + ".csv");
+		}
+
+		//----------
+		void SolverBenchmark::saveJson(const string & filename, const string & label) const {
+			nlohmann::json json;
+			json["label"] = label;
+			json["timestamp"] = ofGetTimestampString("%Y-%m-%dT%H:%M:%S");
+			json["threadBudget"] = SolverRuntime::X().getThreadBudget();
+
+			json["records"] = nlohmann::json::array();
+			for (const auto & record : this->getRecords()) {
+				nlohmann::json jsonRecord;
+				jsonRecord["solver"] = record.solver;
+				jsonRecord["problem"] = record.problem;
+				jsonRecord["size"] = record.size;
+				jsonRecord["trial"] = record.trial;
+				jsonRecord["wallTime"] = record.wallTime;
+				jsonRecord["iterations"] = record.iterations;
+				jsonRecord["residual"] = record.residual;
+				jsonRecord["parameterError"] = record.parameterError;
+				jsonRecord["converged"] = record.converged;
+				json["records"].push_back(jsonRecord);
+			}
+
+			json["summaries"] = nlohmann::json::array();
+			for (const auto & summary : this->getSummaries()) {
+				nlohmann::json jsonSummary;
+				jsonSummary["solver"] = summary.solver;
+				jsonSummary["problem"] = summary.problem;
+				jsonSummary["size"] = summary.size;
+				jsonSummary["trials"] = summary.trials;
+				jsonSummary["convergedCount"] = summary.convergedCount;
+				jsonSummary["wallTimeMean"] = summary.wallTimeMean;
+				jsonSummary["wallTimeMin"] = summary.wallTimeMin;
+				jsonSummary["wallTimeMax"] = summary.wallTimeMax;
+				jsonSummary["iterationsReportedCount"] = summary.iterationsReportedCount;
+				jsonSummary["iterationsMean"] = summary.iterationsMean;
+				jsonSummary["residualMean"] = summary.residualMean;
+				jsonSummary["parameterErrorMean"] = summary.parameterErrorMean;
+				jsonSummary["parameterErrorMax"] = summary.parameterErrorMax;
+				json["summaries"].push_back(jsonSummary);
+			}
+
+			ofstream file(ofToDataPath(filename, true), ios::out);
+			if (!file.is_open()) {
+				throw(ofxRulr::Exception("Cannot open " + filename + " for writing"));
+			}
+			file << json.dump(4);
+		}
+
+		//----------
+		void SolverBenchmark::saveCsv(const string & filename) const {
+			ofstream file(ofToDataPath(filename, true), ios::out);
+			if (!file.is_open()) {
+				throw(ofxRulr::Exception("Cannot open " + filename + " for writing"));
+			}
+
+			file << "solver,problem,size,trial,wallTime,iterations,residual,parameterError,converged" << endl;
+			for (const auto & record : this->getRecords()) {
+				file << record.solver << ","
+					<< record.problem << ","
+					<< record.size << ","
+					<< record.trial << ","
+					<< record.wallTime << ","
+					<< record.iterations << ","
+					<< record.residual << ","
+					<< record.parameterError << ","
+					<< (record.converged ? 1 : 0) << endl;
+			}
+		}
+
+		//----------
+		void SolverBenchmark::finishUnattended(const string & resultsPath
+			, bool exitApp
+			, const function<void(const string & resultsPath)> & save) {
+			if (!resultsPath.empty()) {
+				try {
+					save(resultsPath);
+				}
+				RULR_CATCH_ALL_TO_ERROR;
+			}
+
+			if (exitApp) {
+				ofExit();
+			}
+		}
+
+		//----------
+		void SolverBenchmark::addToInspector(shared_ptr<ofxCvGui::Panels::Widgets> inspector) {
+			inspector->addTitle("Results", ofxCvGui::Widgets::Title::Level::H3);
+			inspector->addLiveValue<string>("Summary", [this]() {
+				return this->getSummaryText();
+			});
+			inspector->addButton("Clear results", [this]() {
+				this->clear();
+			});
+			inspector->addButton("Save results...", [this]() {
+				try {
+					this->save();
+				}
+				RULR_CATCH_ALL_TO_ALERT;
+			});
+		}
+	}
+}
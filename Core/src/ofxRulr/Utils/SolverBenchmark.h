@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ofxRulr/Utils/Constants.h"
+
+#include <mutex>
+
+namespace ofxCvGui {
+	namespace Panels {
+		class Widgets;
+	}
+}
+
+namespace ofxRulr {
+	namespace Utils {
+		//Records solves of synthetic problems (where the ground truth is known) so that solver changes
+		//can be compared for speed and accuracy. Results are saved as JSON (with a label and timestamp) and as CSV.
+		//Actions report iterations from their solve results (see Utils::SolveResult). If they don't, the iterations of
+		//the solve made during the measurement are taken from the SolverRuntime telemetry.
+		class OFXRULR_API_ENTRY SolverBenchmark {
+		public:
+			struct Record {
+				string solver;
+				string problem;
+				size_t size = 0; // e.g. number of unknowns / modules / grid width
+				size_t trial = 0;
+				float wallTime = 0.0f; // [ms]
+				int iterations = -1; // -1 if not reported
+				float residual = 0.0f; // as reported by the solver
+				float parameterError = 0.0f; // against the ground truth (units depend on the problem)
+				bool converged = false;
+
+				//Sum the iterations of one of several solves made in the action (negative = not reported, ignored)
+				void addIterations(int);
+			};
+
+			struct Summary {
+				string solver;
+				string problem;
+				size_t size = 0;
+				size_t trials = 0;
+				size_t convergedCount = 0;
+				float wallTimeMean = 0.0f; // [ms]
+				float wallTimeMin = 0.0f;
+				float wallTimeMax = 0.0f;
+				size_t iterationsReportedCount = 0; // trials which reported iterations
+				float iterationsMean = -1.0f; // over the trials which reported iterations, -1 if none did
+				float residualMean = 0.0f;
+				float parameterErrorMean = 0.0f;
+				float parameterErrorMax = 0.0f;
+			};
+
+			//The action fills in the residual, parameter error and convergence of the record.
+			//If the action doesn't set the iterations, they are taken from the latest solve in the SolverRuntime.
+			Record measure(const string & solver
+				, const string & problem
+				, size_t size
+				, size_t trial
+				, const function<void(Record &)> & action);
+
+			void clear();
+			vector<Record> getRecords() const;
+			vector<Summary> getSummaries() const;
+			string getSummaryText() const;
+
+			//Saves [filename].json and [filename].csv. Opens a dialog if filename is empty
+			void save(string filename = "", const string & label = "") const;
+			void saveJson(const string & filename, const string & label) const;
+			void saveCsv(const string & filename) const;
+
+			//For unattended runs (e.g. a patch opened by a script) : saves to resultsPath (if not empty) and then
+			//exits the app (if exitApp). Errors whilst saving are logged so that the app still exits.
+			static void finishUnattended(const string & resultsPath
+				, bool exitApp
+				, const function<void(const string & resultsPath)> & save);
+
+			void addToInspector(shared_ptr<ofxCvGui::Panels::Widgets>);
+		protected:
+			vector<Record> records;
+			mutable mutex recordsMutex;
+		};
+	}
+}
\ No newline at end of file
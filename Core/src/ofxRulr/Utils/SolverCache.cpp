@@ -0,0 +1,333 @@
+#include "pch_RulrCore.h"
+#include "SolverCache.h"
+
+namespace ofxRulr {
+	namespace Utils {
+		//----------
+		// FNV-1a
+		static uint64_t hashBytes(uint64_t hash, const void * data, size_t size) {
+			auto bytes = (const uint8_t *) data;
+			for (size_t i = 0; i < size; i++) {
+				hash ^= bytes[i];
+				hash *= 1099511628211ULL;
+			}
+			return hash;
+		}
+
+#pragma mark Key
+		//----------
+		SolverCache::Key & SolverCache::Key::addStructure(int64_t value) {
+			this->structureHash = hashBytes(this->structureHash, &value, sizeof(value));
+			return *this;
+		}
+
+		//----------
+		SolverCache::Key & SolverCache::Key::addStructure(const string & value) {
+			this->addStructure((int64_t) value.size());
+			this->structureHash = hashBytes(this->structureHash, value.data(), value.size());
+			return *this;
+		}
+
+		//----------
+		SolverCache::Key & SolverCache::Key::add(float value) {
+			this->values.push_back(value);
+			return *this;
+		}
+
+		//----------
+		SolverCache::Key & SolverCache::Key::add(double value) {
+			this->values.push_back((float) value);
+			return *this;
+		}
+
+		//----------
+		SolverCache::Key & SolverCache::Key::add(const glm::vec2 & value) {
+			this->values.push_back(value.x);
+			this->values.push_back(value.y);
+			return *this;
+		}
+
+		//----------
+		SolverCache::Key & SolverCache::Key::add(const glm::vec3 & value) {
+			this->values.push_back(value.x);
+			this->values.push_back(value.y);
+			this->values.push_back(value.z);
+			return *this;
+		}
+
+		//----------
+		uint64_t SolverCache::Key::getHash() const {
+			auto hash = this->getStructureHash();
+			auto count = (int64_t) this->values.size();
+			hash = hashBytes(hash, &count, sizeof(count));
+			return hashBytes(hash, this->values.data(), this->values.size() * sizeof(float));
+		}
+
+		//----------
+		uint64_t SolverCache::Key::getStructureHash() const {
+			return this->structureHash;
+		}
+
+		//----------
+		const vector<float> & SolverCache::Key::getValues() const {
+			return this->values;
+		}
+
+		//----------
+		vector<float> SolverCache::Key::getSignature() const {
+			const size_t maxSignatureSize = 64;
+			if (this->values.size() <= maxSignatureSize) {
+				return this->values;
+			}
+
+			vector<float> signature(maxSignatureSize, 0.0f);
+			const auto count = this->values.size();
+			for (size_t i = 0; i < maxSignatureSize; i++) {
+				auto begin = i * count / maxSignatureSize;
+				auto end = (i + 1) * count / maxSignatureSize;
+				double sum = 0.0;
+				for (auto j = begin; j < end; j++) {
+					sum += this->values[j];
+				}
+				signature[i] = (float) (sum / (double) (end - begin));
+			}
+			return signature;
+		}
+
+#pragma mark SolverCache
+		//----------
+		SolverCache::SolverCache(size_t capacity)
+			: capacity(capacity) {
+
+		}
+
+		//----------
+		SolverCache::Lookup SolverCache::find(const Key & key, float maxRelativeDistance) {
+			Lookup lookup;
+			if (!this->enabled.get()) {
+				return lookup;
+			}
+
+			auto hash = key.getHash();
+			auto structureHash = key.getStructureHash();
+			auto signature = key.getSignature();
+
+			auto lock = unique_lock<mutex>(this->entriesMutex);
+
+			Entry * nearestEntry = nullptr;
+			float nearestDistance = maxRelativeDistance;
+
+			for (auto & entry : this->entries) {
+				if (entry.structureHash != structureHash) {
+					continue;
+				}
+
+				//the hash alone could collide, so an exact match also needs every input to be equal
+				if (entry.hash == hash && entry.values == key.getValues()) {
+					nearestEntry = &entry;
+					nearestDistance = 0.0f;
+					lookup.match = Match::Exact;
+					break;
+				}
+
+				if (entry.signature.size() != signature.size()) {
+					continue;
+				}
+
+				double differenceSquared = 0.0;
+				double magnitudeSquared = 0.0;
+				for (size_t i = 0; i < signature.size(); i++) {
+					auto difference = (double) signature[i] - (double) entry.signature[i];
+					differenceSquared += difference * difference;
+					magnitudeSquared += (double) signature[i] * (double) signature[i];
+				}
+				auto distance = (float) (sqrt(differenceSquared) / max(sqrt(magnitudeSquared), 1e-9));
+				if (distance <= nearestDistance) {
+					nearestEntry = &entry;
+					nearestDistance = distance;
+					lookup.match = Match::Nearest;
+				}
+			}
+
+			switch (lookup.match) {
+			case Match::Exact:
+				this->hits.exact++;
+				break;
+			case Match::Nearest:
+				this->hits.nearest++;
+				break;
+			default:
+				this->hits.missed++;
+				break;
+			}
+
+			if (nearestEntry) {
+				nearestEntry->lastUsed = ++this->useCounter;
+				lookup.solution = nearestEntry->solution;
+				lookup.residual = nearestEntry->residual;
+				lookup.distance = nearestDistance;
+			}
+
+			return lookup;
+		}
+
+		//----------
+		void SolverCache::store(const Key & key, const vector<double> & solution, float residual) {
+			if (!this->enabled.get()) {
+				return;
+			}
+
+			Entry newEntry;
+			newEntry.hash = key.getHash();
+			newEntry.structureHash = key.getStructureHash();
+			newEntry.signature = key.getSignature();
+			newEntry.values = key.getValues();
+			newEntry.solution = solution;
+			newEntry.residual = residual;
+
+			auto lock = unique_lock<mutex>(this->entriesMutex);
+			newEntry.lastUsed = ++this->useCounter;
+
+			auto findEntry = find_if(this->entries.begin(), this->entries.end(), [&newEntry](const Entry & entry) {
+				return entry.hash == newEntry.hash
+					&& entry.structureHash == newEntry.structureHash
+					&& (entry.values == newEntry.values || entry.values.empty());
+			});
+			if (findEntry != this->entries.end()) {
+				*findEntry = move(newEntry);
+			}
+			else {
+				this->entries.push_back(move(newEntry));
+				this->evict();
+			}
+		}
+
+		//----------
+		void SolverCache::clear() {
+			auto lock = unique_lock<mutex>(this->entriesMutex);
+			this->entries.clear();
+			this->hits.exact = 0;
+			this->hits.nearest = 0;
+			this->hits.missed = 0;
+		}
+
+		//----------
+		size_t SolverCache::size() const {
+			auto lock = unique_lock<mutex>(this->entriesMutex);
+			return this->entries.size();
+		}
+
+		//----------
+		size_t SolverCache::getCapacity() const {
+			return this->capacity;
+		}
+
+		//----------
+		void SolverCache::setCapacity(size_t capacity) {
+			auto lock = unique_lock<mutex>(this->entriesMutex);
+			this->capacity = capacity;
+			this->evict();
+		}
+
+		//----------
+		void SolverCache::setMaxSerializedSize(size_t maxSerializedSize) {
+			auto lock = unique_lock<mutex>(this->entriesMutex);
+			this->maxSerializedSize = maxSerializedSize;
+		}
+
+		//----------
+		size_t SolverCache::getMaxSerializedSize() const {
+			auto lock = unique_lock<mutex>(this->entriesMutex);
+			return this->maxSerializedSize;
+		}
+
+		//----------
+		void SolverCache::serialize(nlohmann::json & json) const {
+			json["enabled"] = this->enabled.get();
+
+			auto lock = unique_lock<mutex>(this->entriesMutex);
+			auto & jsonEntries = json["entries"];
+			jsonEntries = nlohmann::json::array();
+			for (const auto & entry : this->entries) {
+				if (entry.solution.size() > this->maxSerializedSize) {
+					continue;
+				}
+
+				nlohmann::json jsonEntry;
+				jsonEntry["hash"] = entry.hash;
+				jsonEntry["structureHash"] = entry.structureHash;
+				jsonEntry["signature"] = entry.signature;
+				if (entry.values.size() <= this->maxSerializedSize) {
+					jsonEntry["values"] = entry.values;
+				}
+				jsonEntry["solution"] = entry.solution;
+				jsonEntry["residual"] = entry.residual;
+				jsonEntry["lastUsed"] = entry.lastUsed;
+				jsonEntries.push_back(jsonEntry);
+			}
+		}
+
+		//----------
+		void SolverCache::deserialize(const nlohmann::json & json) {
+			if (json.contains("enabled")) {
+				this->enabled.set(json["enabled"].get<bool>());
+			}
+
+			auto lock = unique_lock<mutex>(this->entriesMutex);
+			this->entries.clear();
+			this->useCounter = 0;
+
+			if (!json.contains("entries")) {
+				return;
+			}
+
+			for (const auto & jsonEntry : json["entries"]) {
+				try {
+					Entry entry;
+					entry.hash = jsonEntry["hash"].get<uint64_t>();
+					entry.structureHash = jsonEntry["structureHash"].get<uint64_t>();
+					entry.signature = jsonEntry["signature"].get<vector<float>>();
+					if (jsonEntry.contains("values")) {
+						entry.values = jsonEntry["values"].get<vector<float>>();
+					}
+					entry.solution = jsonEntry["solution"].get<vector<double>>();
+					entry.residual = jsonEntry["residual"].get<float>();
+					entry.lastUsed = jsonEntry["lastUsed"].get<uint64_t>();
+					this->useCounter = max(this->useCounter, entry.lastUsed);
+					this->entries.push_back(entry);
+				}
+				catch (const nlohmann::json::exception & e) {
+					ofLogWarning("SolverCache") << "Skipping cache entry : " << e.what();
+				}
+			}
+			this->evict();
+		}
+
+		//----------
+		void SolverCache::addToInspector(shared_ptr<ofxCvGui::Panels::Widgets> inspector) {
+			inspector->addTitle("Solver cache", ofxCvGui::Widgets::Title::Level::H3);
+			inspector->addToggle(this->enabled);
+			inspector->addLiveValue<string>("Entries", [this]() {
+				return ofToString(this->size()) + " / " + ofToString(this->getCapacity());
+			});
+			inspector->addLiveValue<string>("Exact / nearest / missed", [this]() {
+				auto lock = unique_lock<mutex>(this->entriesMutex);
+				return ofToString(this->hits.exact) + " / " + ofToString(this->hits.nearest) + " / " + ofToString(this->hits.missed);
+			});
+			inspector->addButton("Clear solver cache", [this]() {
+				this->clear();
+			});
+		}
+
+		//----------
+		void SolverCache::evict() {
+			// Remove the least recently used (call with the lock held)
+			while (this->entries.size() > this->capacity) {
+				auto oldest = min_element(this->entries.begin(), this->entries.end(), [](const Entry & a, const Entry & b) {
+					return a.lastUsed < b.lastUsed;
+				});
+				this->entries.erase(oldest);
+			}
+		}
+	}
+}
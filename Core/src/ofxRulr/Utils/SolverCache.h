@@ -0,0 +1,111 @@
+#pragma once
+
+#include "ofxRulr/Utils/Constants.h"
+
+#include <nlohmann/json.hpp>
+#include <mutex>
+
+namespace ofxCvGui {
+	namespace Panels {
+		class Widgets;
+	}
+}
+
+namespace ofxRulr {
+	namespace Utils {
+		//Remembers the solutions of a solver against the inputs of the solve, so that re-running with identical
+		//inputs returns the stored solution, and re-running with near-identical inputs (e.g. a filter was tweaked)
+		//can start from the closest stored solution rather than from scratch.
+		//The owner packs its solution into a vector<double>, and serializes the cache with its own state.
+		//An exact match needs both the hash and all of the continuous inputs to match.
+		class OFXRULR_API_ENTRY SolverCache {
+		public:
+			//Build one per solve from the inputs which the solution depends on
+			class OFXRULR_API_ENTRY Key {
+			public:
+				//Discrete inputs (counts, indices, fixed-parameter flags, solver settings).
+				//Entries are only compared if all of these match.
+				Key & addStructure(int64_t);
+				Key & addStructure(const string &);
+
+				//Continuous inputs (observations, values of fixed parameters)
+				Key & add(float);
+				Key & add(double);
+				Key & add(const glm::vec2 &);
+				Key & add(const glm::vec3 &);
+
+				uint64_t getHash() const;
+				uint64_t getStructureHash() const;
+				const vector<float> & getValues() const;
+
+				//Continuous inputs averaged down to at most 64 values, used to find the nearest entry
+				vector<float> getSignature() const;
+			protected:
+				uint64_t structureHash = 14695981039346656037ULL;
+				vector<float> values;
+			};
+
+			struct Entry {
+				uint64_t hash = 0;
+				uint64_t structureHash = 0;
+				vector<float> signature;
+				vector<float> values; // all continuous inputs (empty if too large to have been saved)
+				vector<double> solution;
+				float residual = 0.0f;
+				uint64_t lastUsed = 0;
+			};
+
+			enum class Match {
+				None,
+				Nearest,
+				Exact
+			};
+
+			struct Lookup {
+				Match match = Match::None;
+				vector<double> solution;
+				float residual = 0.0f;
+				float distance = 0.0f; // relative distance between the signatures (0 for Exact)
+			};
+
+			SolverCache(size_t capacity = 8);
+
+			//Exact if all inputs match, otherwise the entry with matching structure whose signature is closest
+			//(within maxRelativeDistance, i.e. |a - b| / |a|)
+			Lookup find(const Key &, float maxRelativeDistance = 0.1f);
+			void store(const Key &, const vector<double> & solution, float residual);
+
+			void clear();
+			size_t size() const;
+			size_t getCapacity() const;
+			void setCapacity(size_t);
+
+			//Entries (or their inputs) larger than this many values are kept in memory but not saved.
+			//Entries loaded without their inputs can only match as Nearest.
+			void setMaxSerializedSize(size_t);
+			size_t getMaxSerializedSize() const;
+
+			void serialize(nlohmann::json &) const;
+			void deserialize(const nlohmann::json &);
+
+			void addToInspector(shared_ptr<ofxCvGui::Panels::Widgets>);
+
+			ofParameter<bool> enabled{ "Solver cache", true };
+		protected:
+			void evict();
+
+			vector<Entry> entries;
+			size_t capacity;
+			size_t maxSerializedSize = 4096;
+			uint64_t useCounter = 0;
+
+			struct {
+				size_t exact = 0;
+				size_t nearest = 0;
+				size_t missed = 0;
+			} hits;
+
+			mutable mutex entriesMutex;
+		};
+	}
+}
\ No newline at end of file
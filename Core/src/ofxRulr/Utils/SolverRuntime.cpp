@@ -0,0 +1,254 @@
+#include "pch_RulrCore.h"
+#include "SolverRuntime.h"
+
+OFXSINGLETON_DEFINE(ofxRulr::Utils::SolverRuntime);
+
+namespace ofxRulr {
+	namespace Utils {
+#pragma mark ThreadLease
+		//----------
+		SolverRuntime::ThreadLease::ThreadLease(size_t threadCount)
+			: threadCount(threadCount) {
+
+		}
+
+		//----------
+		SolverRuntime::ThreadLease::~ThreadLease() {
+			SolverRuntime::X().releaseThreads(this->threadCount);
+		}
+
+		//----------
+		size_t SolverRuntime::ThreadLease::getThreadCount() const {
+			return this->threadCount;
+		}
+
+#pragma mark Solve
+		//----------
+		SolverRuntime::Solve::Solve(const string & name)
+			: name(name) {
+
+		}
+
+		//----------
+		const string & SolverRuntime::Solve::getName() const {
+			return this->name;
+		}
+
+		//----------
+		vector<SolverRuntime::Iteration> SolverRuntime::Solve::getIterations() const {
+			auto lock = unique_lock<mutex>(this->iterationsMutex);
+			return this->iterations;
+		}
+
+		//----------
+		bool SolverRuntime::Solve::getLastIteration(Iteration & iteration) const {
+			auto lock = unique_lock<mutex>(this->iterationsMutex);
+			if (this->iterations.empty()) {
+				return false;
+			}
+			iteration = this->iterations.back();
+			return true;
+		}
+
+		//----------
+		bool SolverRuntime::Solve::isRunning() const {
+			return this->running.load();
+		}
+
+		//----------
+		bool SolverRuntime::Solve::isCancelRequested() const {
+			return this->cancelRequested.load();
+		}
+
+		//----------
+		void SolverRuntime::Solve::requestCancel() {
+			this->cancelRequested.store(true);
+		}
+
+		//----------
+		size_t SolverRuntime::Solve::getThreadCount() const {
+			return this->threadCount;
+		}
+
+		//----------
+		const string & SolverRuntime::Solve::getLinearSolver() const {
+			return this->linearSolver;
+		}
+
+#pragma mark SolverRuntime
+		//----------
+		SolverRuntime::SolverRuntime() {
+			this->threadBudget = max(std::thread::hardware_concurrency(), 1u);
+		}
+
+		//----------
+		unique_ptr<SolverRuntime::ThreadLease> SolverRuntime::acquireThreads(size_t requested) {
+			auto lock = unique_lock<mutex>(this->threadsMutex);
+
+			auto available = this->threadBudget > this->threadsInUse
+				? this->threadBudget - this->threadsInUse
+				: 0;
+
+			if (requested == 0) {
+				requested = this->threadBudget;
+			}
+
+			auto granted = max<size_t>(min(requested, available), 1);
+			this->threadsInUse += granted;
+			return make_unique<ThreadLease>(granted);
+		}
+
+		//----------
+		void SolverRuntime::setThreadBudget(size_t threadBudget) {
+			auto lock = unique_lock<mutex>(this->threadsMutex);
+			this->threadBudget = max<size_t>(threadBudget, 1);
+		}
+
+		//----------
+		size_t SolverRuntime::getThreadBudget() const {
+			auto lock = unique_lock<mutex>(this->threadsMutex);
+			return this->threadBudget;
+		}
+
+		//----------
+		size_t SolverRuntime::getThreadsInUse() const {
+			auto lock = unique_lock<mutex>(this->threadsMutex);
+			return this->threadsInUse;
+		}
+
+		//----------
+		void SolverRuntime::releaseThreads(size_t threadCount) {
+			auto lock = unique_lock<mutex>(this->threadsMutex);
+			this->threadsInUse -= min(threadCount, this->threadsInUse);
+		}
+
+		//----------
+		shared_ptr<SolverRuntime::Solve> SolverRuntime::beginSolve(const string & name, size_t threadCount, const string & linearSolver) {
+			auto solve = make_shared<Solve>(name);
+			solve->threadCount = threadCount;
+			solve->linearSolver = linearSolver;
+			solve->lastNotice = chrono::steady_clock::now();
+
+			auto lock = unique_lock<mutex>(this->solvesMutex);
+			this->activeSolves.push_back(solve);
+			this->latestSolve = solve;
+			return solve;
+		}
+
+		//----------
+		void SolverRuntime::endSolve(shared_ptr<Solve> solve) {
+			solve->running.store(false);
+
+			auto lock = unique_lock<mutex>(this->solvesMutex);
+			auto findSolve = find(this->activeSolves.begin(), this->activeSolves.end(), solve);
+			if (findSolve != this->activeSolves.end()) {
+				this->activeSolves.erase(findSolve);
+			}
+		}
+
+		//----------
+		bool SolverRuntime::reportIteration(Solve & solve, const Iteration & iteration) {
+			{
+				auto lock = unique_lock<mutex>(solve.iterationsMutex);
+				solve.iterations.push_back(iteration);
+			}
+
+			//When the solve is blocking the main thread, the GUI can't redraw or take input,
+			//so draw the progress directly and poll ESC for cancelling
+			if (ofThread::isMainThread()) {
+				auto now = chrono::steady_clock::now();
+				if (iteration.time > 1.0 && now - solve.lastNotice > chrono::milliseconds(200)) {
+					solve.lastNotice = now;
+
+					stringstream message;
+					message << "Solving " << solve.name << endl;
+					message << "Iteration " << iteration.iteration << ", cost " << iteration.cost;
+#ifdef TARGET_WIN32
+					message << endl << "Hold [ESC] to cancel";
+#endif
+					ofxCvGui::Utils::drawProcessingNotice(message.str());
+				}
+
+				//Only on Windows : elsewhere there's no way to read the keyboard without pumping the event loop
+				//(which would re-enter the app from inside the solve). Blocking solves on other platforms can only
+				//be cancelled with cancelActiveSolves() from another thread.
+#ifdef TARGET_WIN32
+				if (GetAsyncKeyState(VK_ESCAPE) & 0x8000) {
+					solve.requestCancel();
+				}
+#endif
+			}
+
+			return !solve.isCancelRequested();
+		}
+
+		//----------
+		shared_ptr<SolverRuntime::Solve> SolverRuntime::getLatestSolve() const {
+			auto lock = unique_lock<mutex>(this->solvesMutex);
+			return this->latestSolve;
+		}
+
+		//----------
+		vector<shared_ptr<SolverRuntime::Solve>> SolverRuntime::getActiveSolves() const {
+			auto lock = unique_lock<mutex>(this->solvesMutex);
+			return this->activeSolves;
+		}
+
+		//----------
+		void SolverRuntime::cancelActiveSolves() {
+			auto lock = unique_lock<mutex>(this->solvesMutex);
+			for (auto solve : this->activeSolves) {
+				solve->requestCancel();
+			}
+		}
+
+		//----------
+		void SolverRuntime::addToInspector(shared_ptr<ofxCvGui::Panels::Widgets> inspector) {
+			inspector->addTitle("Solver", ofxCvGui::Widgets::Title::Level::H3);
+
+			inspector->addLiveValue<string>("Threads", []() {
+				auto & runtime = SolverRuntime::X();
+				return ofToString(runtime.getThreadsInUse()) + " / " + ofToString(runtime.getThreadBudget());
+			});
+
+			inspector->addLiveValue<string>("Latest solve", []() -> string {
+				auto solve = SolverRuntime::X().getLatestSolve();
+				if (!solve) {
+					return "";
+				}
+
+				stringstream message;
+				message << solve->getName() << " (" << solve->getLinearSolver() << ", " << solve->getThreadCount() << " threads)";
+				if (solve->isCancelRequested()) {
+					message << " [cancelled]";
+				}
+				else if (solve->isRunning()) {
+					message << " [running]";
+				}
+				return message.str();
+			});
+
+			inspector->addLiveValue<string>("Iteration", []() -> string {
+				auto solve = SolverRuntime::X().getLatestSolve();
+				Iteration iteration;
+				if (!solve || !solve->getLastIteration(iteration)) {
+					return "";
+				}
+				return ofToString(iteration.iteration) + " (" + ofToString(iteration.time, 2) + "s)";
+			});
+
+			inspector->addLiveValueHistory("log10(cost)", []() {
+				auto solve = SolverRuntime::X().getLatestSolve();
+				Iteration iteration;
+				if (!solve || !solve->getLastIteration(iteration) || iteration.cost <= 0.0) {
+					return 0.0f;
+				}
+				return (float) log10(iteration.cost);
+			});
+
+			inspector->addButton("Cancel solves", []() {
+				SolverRuntime::X().cancelActiveSolves();
+			});
+		}
+	}
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "ofxRulr/Utils/Constants.h"
+#include "ofxSingleton.h"
+
+#include <mutex>
+#include <atomic>
+
+namespace ofxCvGui {
+	namespace Panels {
+		class Widgets;
+	}
+}
+
+namespace ofxRulr {
+	namespace Utils {
+		//Shared state for all non-linear solves in the process (see SolveCeres.h for the ceres side) :
+		//	* A machine-wide thread budget, so that solves running concurrently (e.g. from several nodes
+		//		or worker threads) share the cores rather than each asking for all of them.
+		//	* Per-iteration telemetry of each solve, for display in node inspectors.
+		//	* Cancellation, from the inspector or by holding ESC whilst a solve blocks the main thread
+		//		(ESC on Windows only, see reportIteration).
+		class OFXRULR_API_ENTRY SolverRuntime : public ofxSingleton::Singleton<SolverRuntime> {
+		public:
+			class OFXRULR_API_ENTRY ThreadLease {
+			public:
+				ThreadLease(size_t threadCount);
+				ThreadLease(const ThreadLease &) = delete;
+				~ThreadLease();
+				size_t getThreadCount() const;
+			protected:
+				size_t threadCount;
+			};
+
+			struct Iteration {
+				int iteration;
+				double cost;
+				double time; // [s] since start of solve
+			};
+
+			class OFXRULR_API_ENTRY Solve {
+			public:
+				Solve(const string & name);
+
+				const string & getName() const;
+				vector<Iteration> getIterations() const;
+				bool getLastIteration(Iteration &) const;
+				bool isRunning() const;
+				bool isCancelRequested() const;
+				void requestCancel();
+				size_t getThreadCount() const;
+				const string & getLinearSolver() const;
+
+			protected:
+				friend SolverRuntime;
+
+				string name;
+				string linearSolver;
+				size_t threadCount = 1;
+
+				vector<Iteration> iterations;
+				mutable mutex iterationsMutex;
+
+				atomic<bool> running{ true };
+				atomic<bool> cancelRequested{ false };
+				chrono::steady_clock::time_point lastNotice;
+			};
+
+			SolverRuntime();
+
+			//Threads are granted immediately (never blocks). If the budget is exhausted the lease has 1 thread.
+			//Pass 0 to request as many threads as the budget allows
+			unique_ptr<ThreadLease> acquireThreads(size_t requested);
+
+			void setThreadBudget(size_t);
+			size_t getThreadBudget() const;
+			size_t getThreadsInUse() const;
+
+			shared_ptr<Solve> beginSolve(const string & name, size_t threadCount, const string & linearSolver);
+			void endSolve(shared_ptr<Solve>);
+
+			//Called by the solver each iteration. Returns false if the solve should stop
+			bool reportIteration(Solve &, const Iteration &);
+
+			shared_ptr<Solve> getLatestSolve() const;
+			vector<shared_ptr<Solve>> getActiveSolves() const;
+			void cancelActiveSolves();
+
+			static void addToInspector(shared_ptr<ofxCvGui::Panels::Widgets>);
+		protected:
+			friend ThreadLease;
+			void releaseThreads(size_t);
+
+			size_t threadBudget;
+			size_t threadsInUse = 0;
+			mutable mutex threadsMutex;
+
+			vector<shared_ptr<Solve>> activeSolves;
+			shared_ptr<Solve> latestSolve;
+			mutable mutex solvesMutex;
+		};
+	}
+}
\ No newline at end of file
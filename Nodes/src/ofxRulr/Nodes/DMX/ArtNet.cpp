@@ -0,0 +1,101 @@
+#include "pch_RulrNodes.h"
+#include "ArtNet.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace DMX {
+			const size_t artDmxHeaderSize = 18;
+
+			//----------
+			ArtNet::ArtNet() {
+				RULR_NODE_INIT_LISTENER;
+			}
+
+			//----------
+			ArtNet::~ArtNet() {
+				this->stopOutput();
+			}
+
+			//----------
+			string ArtNet::getTypeName() const {
+				return "DMX::ArtNet";
+			}
+
+			//----------
+			void ArtNet::init() {
+				RULR_NODE_UPDATE_LISTENER;
+
+				this->manageParameters(this->parameters);
+
+				// ArtDmx header
+				{
+					this->packet.assign(artDmxHeaderSize + 512, 0);
+					auto data = this->packet.data();
+
+					memcpy(data, "Art-Net", 8); // includes null terminator
+					data[8] = 0x00; // OpDmx (0x5000) little endian
+					data[9] = 0x50;
+					data[10] = 0; // protocol version 14, big endian
+					data[11] = 14;
+					data[12] = 0; // sequence
+					data[13] = 0; // physical
+					data[14] = 0; // port-address low byte (SubUni)
+					data[15] = 0; // port-address high 7 bits (Net)
+					data[16] = (512 >> 8) & 0xff; // length, big endian
+					data[17] = 512 & 0xff;
+				}
+			}
+
+			//----------
+			void ArtNet::update() {
+				if (this->parameters.universeCount.get() != this->getUniverseCount()) {
+					this->setUniverseCount((UniverseIndex) this->parameters.universeCount.get());
+				}
+
+				if (this->parameters.address.get() != this->cachedSettings.address
+					|| this->parameters.port.get() != this->cachedSettings.port
+					|| this->parameters.firstUniverse.get() != this->cachedSettings.firstUniverse) {
+					this->rebuild();
+				}
+			}
+
+			//----------
+			void ArtNet::rebuild() {
+				lock_guard<mutex> lock(this->outputMutex);
+				this->socket.reset();
+
+				this->cachedSettings.address = this->parameters.address.get();
+				this->cachedSettings.port = this->parameters.port.get();
+				this->cachedSettings.firstUniverse = this->parameters.firstUniverse.get();
+
+				try {
+					this->destination = Poco::Net::SocketAddress(this->cachedSettings.address, (Poco::UInt16) this->cachedSettings.port);
+
+					this->socket = make_unique<Poco::Net::DatagramSocket>();
+					this->socket->setBroadcast(true);
+				}
+				catch (const Poco::Exception & e) {
+					RULR_ERROR << "DMX::ArtNet : Couldn't open socket to " << this->cachedSettings.address << " : " << e.displayText();
+					this->socket.reset();
+				}
+			}
+
+			//----------
+			void ArtNet::sendUniverse(UniverseIndex index, const Value * channels, uint8_t sequence) {
+				if (!this->socket) {
+					return;
+				}
+
+				auto portAddress = this->cachedSettings.firstUniverse + index;
+
+				auto data = this->packet.data();
+				data[12] = sequence;
+				data[14] = portAddress & 0xff;
+				data[15] = (portAddress >> 8) & 0x7f;
+				memcpy(data + artDmxHeaderSize, channels + 1, 512);
+
+				this->socket->sendTo(data, (int) this->packet.size(), this->destination);
+			}
+		}
+	}
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Transmit.h"
+
+#include "Poco/Net/DatagramSocket.h"
+#include "Poco/Net/SocketAddress.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace DMX {
+			//Sends universes as Art-Net ArtDmx packets over UDP (unicast or broadcast).
+			//Universe i is sent to Art-Net port-address (firstUniverse + i).
+			class ArtNet : public DMX::Transmit {
+			public:
+				ArtNet();
+				~ArtNet();
+				string getTypeName() const override;
+				void init();
+				void update();
+			protected:
+				void rebuild();
+				void sendUniverse(UniverseIndex, const Value * channels, uint8_t sequence) override;
+
+				struct : ofParameterGroup {
+					ofParameter<string> address{ "Address", "2.255.255.255" };
+					ofParameter<int> port{ "Port", 6454 };
+					ofParameter<int> universeCount{ "Universe count", 1, 1, 256 };
+					ofParameter<int> firstUniverse{ "First universe", 0, 0, 32767 };
+					PARAM_DECLARE("Art-Net", address, port, universeCount, firstUniverse);
+				} parameters;
+
+				struct {
+					string address;
+					int port = 0;
+					int firstUniverse = 0;
+				} cachedSettings; // read by the output thread (with outputMutex locked)
+
+				unique_ptr<Poco::Net::DatagramSocket> socket;
+				Poco::Net::SocketAddress destination;
+				vector<uint8_t> packet; // preallocated, header is written once
+			};
+		}
+	}
+}
\ No newline at end of file
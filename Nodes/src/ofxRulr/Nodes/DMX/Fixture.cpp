@@ -119,6 +119,16 @@ namespace ofxRulr {
 				this->channelIndex = channelIndex;
 			}
 
+			//----------
+			DMX::ChannelIndex Fixture::getChannelIndex() const {
+				return this->channelIndex;
+			}
+
+			//----------
+			DMX::UniverseIndex Fixture::getUniverseIndex() const {
+				return this->universeIndex;
+			}
+
 			//----------
 			const vector<shared_ptr<Fixture::Channel>> & Fixture::getChannels() const {
 				return this->channels;
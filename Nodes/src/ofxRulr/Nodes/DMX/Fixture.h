@@ -26,6 +26,8 @@ namespace ofxRulr {
 				void deserialize(const nlohmann::json &);
 
 				void setChannelIndex(DMX::ChannelIndex);
+				DMX::ChannelIndex getChannelIndex() const;
+				DMX::UniverseIndex getUniverseIndex() const;
 				const vector<shared_ptr<Channel>> & getChannels() const;
 				shared_ptr<Channel> getChannel(DMX::ChannelIndex index);
 				shared_ptr<Channel> getChannel(string name);
@@ -101,36 +101,11 @@ namespace ofxRulr {
 				auto panTilt = MovingHead::getPanTiltForTargetInObjectSpace(objectSpacePoint, this->parameters.tiltOffset);
 
 				if (navigationEnabled) {
-					//we want to find the fastest route to it, for every 180 degrees of pan there is a valid solution, let's choose the one with the smallest pan always
-					auto halfRotationsMin = ceil(this->parameters.pan.getMin() / 180.0f);
-					auto halfRotationsMax = ceil(this->parameters.pan.getMax() / 180.0f) + 1;
-					map<float, glm::vec2> solutions; // panDistance, (pan,tilt)
-					for (int halfRotation = halfRotationsMin; halfRotation < halfRotationsMax; halfRotation++) {
-						//for each hemisphere, find the solution, check if it's in valid range
-						float searchPan = (halfRotation * 180) + panTilt.x;
-						float searchTilt;
-						if (halfRotation % 2 == 0) {
-							//even, keep tilt
-							searchTilt = panTilt.y;
-						}
-						else {
-							//odd, flip tilt
-							searchTilt = -panTilt.y;
-						}
-						if (searchPan >= this->parameters.pan.getMin() && searchPan <= this->parameters.pan.getMax() && searchTilt >= this->parameters.tilt.getMin() && searchTilt <= this->parameters.tilt.getMax()) {
-							//it's a valid solution
-							auto panDistance = abs(searchPan - this->parameters.pan);
-							pair<float, glm::vec2> solution(panDistance, glm::vec2(searchPan, searchTilt));
-							solutions.insert(solution);
-						}
-					}
-
-					if (solutions.empty()) {
+					glm::vec2 solution;
+					if (!MovingHead::getClosestSolution(panTilt, this->parameters.pan, this->getPanRange(), this->getTiltRange(), solution)) {
 						throw(ofxRulr::Exception("No valid solutions found to aim MovingHead '" + this->getName() + "' at target (" + ofToString(worldSpacePoint) + ")"));
 					}
-
-					auto solution = solutions.begin();
-					return solution->second;
+					return solution;
 				}
 				else {
 					return panTilt;
@@ -148,6 +123,36 @@ namespace ofxRulr {
 				return glm::vec2(pan, tilt + tiltOffset);
 			}
 
+			//----------
+			bool MovingHead::getClosestSolution(const glm::vec2 & panTilt, float currentPan, const glm::vec2 & panRange, const glm::vec2 & tiltRange, glm::vec2 & solution) {
+				//we want to find the fastest route to it, for every 180 degrees of pan there is a valid solution, let's choose the one with the smallest pan always
+				auto halfRotationsMin = (int) ceil(panRange.x / 180.0f);
+				auto halfRotationsMax = (int) ceil(panRange.y / 180.0f) + 1;
+				auto bestPanDistance = numeric_limits<float>::max();
+				for (int halfRotation = halfRotationsMin; halfRotation < halfRotationsMax; halfRotation++) {
+					//for each hemisphere, find the solution, check if it's in valid range
+					float searchPan = (halfRotation * 180) + panTilt.x;
+					float searchTilt;
+					if (halfRotation % 2 == 0) {
+						//even, keep tilt
+						searchTilt = panTilt.y;
+					}
+					else {
+						//odd, flip tilt
+						searchTilt = -panTilt.y;
+					}
+					if (searchPan >= panRange.x && searchPan <= panRange.y && searchTilt >= tiltRange.x && searchTilt <= tiltRange.y) {
+						//it's a valid solution
+						auto panDistance = abs(searchPan - currentPan);
+						if (panDistance < bestPanDistance) {
+							bestPanDistance = panDistance;
+							solution = glm::vec2(searchPan, searchTilt);
+						}
+					}
+				}
+				return bestPanDistance != numeric_limits<float>::max();
+			}
+
 			//----------
 			void MovingHead::lookAt(const glm::vec3& worldSpacePoint) {
 				const auto panTilt = this->getPanTiltForTarget(worldSpacePoint, false);
@@ -186,6 +191,21 @@ namespace ofxRulr {
 				this->parameters.tiltOffset = tiltOffset;
 			}
 
+			//----------
+			float MovingHead::getTiltOffset() const {
+				return this->parameters.tiltOffset;
+			}
+
+			//----------
+			glm::vec2 MovingHead::getPanRange() const {
+				return glm::vec2(this->parameters.pan.getMin(), this->parameters.pan.getMax());
+			}
+
+			//----------
+			glm::vec2 MovingHead::getTiltRange() const {
+				return glm::vec2(this->parameters.tilt.getMin(), this->parameters.tilt.getMax());
+			}
+
 			//----------
 			void MovingHead::copyFrom(shared_ptr<MovingHead> other) {
 				this->parameters.pan = other->parameters.pan;
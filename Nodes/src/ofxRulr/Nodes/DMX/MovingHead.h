@@ -20,6 +20,7 @@ namespace ofxRulr {
 				glm::vec2 getPanTilt() const;
 				glm::vec2 getPanTiltForTarget(const glm::vec3 & worldSpacePoint, bool navigationEnabled) const; ///navigationEnabled uses closest path, also throws on impossible target
 				static glm::vec2 getPanTiltForTargetInObjectSpace(const glm::vec3 & objectSpacePoint, float tiltOffset = 0.0f);
+				static bool getClosestSolution(const glm::vec2 & panTilt, float currentPan, const glm::vec2 & panRange, const glm::vec2 & tiltRange, glm::vec2 & solution); ///of the equivalent pan/tilt's within range, the one with least pan movement
 				void lookAt(const glm::vec3 & worldSpacePoint); /// warning : throws exception if impossible
 				void setPanTilt(const glm::vec2 & panTilt);
 
@@ -29,6 +30,9 @@ namespace ofxRulr {
 				void setHome();
 
 				void setTiltOffset(float);
+				float getTiltOffset() const;
+				glm::vec2 getPanRange() const;
+				glm::vec2 getTiltRange() const;
 				void copyFrom(shared_ptr<MovingHead>);
 			protected:
 				void populateInspector(ofxCvGui::InspectArguments &);
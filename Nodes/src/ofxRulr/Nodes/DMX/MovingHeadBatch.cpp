@@ -0,0 +1,275 @@
+#include "pch_RulrNodes.h"
+#include "MovingHeadBatch.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace DMX {
+#pragma mark Fixtures
+			//----------
+			size_t MovingHeadBatch::Fixtures::size() const {
+				return this->pan.size();
+			}
+
+			//----------
+			void MovingHeadBatch::Fixtures::resize(size_t size) {
+				for (auto & row : this->worldToObject) {
+					row.resize(size);
+				}
+				this->tiltOffset.resize(size);
+				this->panMin.resize(size);
+				this->panMax.resize(size);
+				this->tiltMin.resize(size);
+				this->tiltMax.resize(size);
+				this->pan.resize(size);
+				this->tilt.resize(size);
+				this->universeIndex.resize(size);
+				this->panChannel.resize(size);
+				this->panFineChannel.resize(size);
+				this->tiltChannel.resize(size);
+				this->tiltFineChannel.resize(size);
+			}
+
+#pragma mark Targets
+			//----------
+			size_t MovingHeadBatch::Targets::size() const {
+				return this->x.size();
+			}
+
+			//----------
+			void MovingHeadBatch::Targets::resize(size_t size) {
+				this->x.resize(size);
+				this->y.resize(size);
+				this->z.resize(size);
+			}
+
+#pragma mark MovingHeadBatch
+			//----------
+			void MovingHeadBatch::setMovingHeads(const vector<shared_ptr<MovingHead>> & movingHeads) {
+				this->movingHeads.assign(movingHeads.begin(), movingHeads.end());
+
+				auto & fixtures = this->fixtures;
+				fixtures.resize(movingHeads.size());
+
+				for (size_t i = 0; i < movingHeads.size(); i++) {
+					const auto & movingHead = movingHeads[i];
+
+					auto worldToObject = glm::inverse(movingHead->getTransform());
+					for (int row = 0; row < 3; row++) {
+						for (int column = 0; column < 4; column++) {
+							fixtures.worldToObject[row * 4 + column][i] = worldToObject[column][row];
+						}
+					}
+
+					fixtures.tiltOffset[i] = movingHead->getTiltOffset();
+
+					auto panRange = movingHead->getPanRange();
+					fixtures.panMin[i] = panRange.x;
+					fixtures.panMax[i] = panRange.y;
+
+					auto tiltRange = movingHead->getTiltRange();
+					fixtures.tiltMin[i] = tiltRange.x;
+					fixtures.tiltMax[i] = tiltRange.y;
+
+					auto panTilt = movingHead->getPanTilt();
+					fixtures.pan[i] = panTilt.x;
+					fixtures.tilt[i] = panTilt.y;
+
+					//find the pan/tilt channels (e.g. as named by Sharpy)
+					fixtures.universeIndex[i] = movingHead->getUniverseIndex();
+					fixtures.panChannel[i] = -1;
+					fixtures.panFineChannel[i] = -1;
+					fixtures.tiltChannel[i] = -1;
+					fixtures.tiltFineChannel[i] = -1;
+					const auto & channels = movingHead->getChannels();
+					for (size_t channelOffset = 0; channelOffset < channels.size(); channelOffset++) {
+						if (!channels[channelOffset]->enabled.get()) {
+							//the fixture stops outputting at the first disabled channel
+							break;
+						}
+
+						auto channelIndex = (int)movingHead->getChannelIndex() + (int)channelOffset;
+						const auto & name = channels[channelOffset]->value.getName();
+						if (name == "Pan") {
+							fixtures.panChannel[i] = channelIndex;
+						}
+						else if (name == "Pan fine") {
+							fixtures.panFineChannel[i] = channelIndex;
+						}
+						else if (name == "Tilt") {
+							fixtures.tiltChannel[i] = channelIndex;
+						}
+						else if (name == "Tilt fine") {
+							fixtures.tiltFineChannel[i] = channelIndex;
+						}
+					}
+				}
+			}
+
+			//----------
+			size_t MovingHeadBatch::size() const {
+				return this->fixtures.size();
+			}
+
+			//----------
+			MovingHeadBatch::Fixtures & MovingHeadBatch::getFixtures() {
+				return this->fixtures;
+			}
+
+			//----------
+			const MovingHeadBatch::Fixtures & MovingHeadBatch::getFixtures() const {
+				return this->fixtures;
+			}
+
+			//----------
+			size_t MovingHeadBatch::solve(const Targets & targets, const Settings & settings) {
+				auto & fixtures = this->fixtures;
+				const auto count = fixtures.size();
+				if (targets.size() != count) {
+					throw(ofxRulr::Exception("MovingHeadBatch has " + ofToString(count) + " moving heads but " + ofToString(targets.size()) + " targets"));
+				}
+
+				this->directPan.resize(count);
+				this->directTilt.resize(count);
+				this->valid.resize(count);
+
+				//--
+				//Direct solution (same as MovingHead::getPanTiltForTargetInObjectSpace)
+				//--
+				//
+				{
+					const auto & m = fixtures.worldToObject;
+					const float * m00 = m[0].data(), * m01 = m[1].data(), * m02 = m[2].data(), * m03 = m[3].data();
+					const float * m10 = m[4].data(), * m11 = m[5].data(), * m12 = m[6].data(), * m13 = m[7].data();
+					const float * m20 = m[8].data(), * m21 = m[9].data(), * m22 = m[10].data(), * m23 = m[11].data();
+					const float * targetX = targets.x.data(), * targetY = targets.y.data(), * targetZ = targets.z.data();
+					const float * tiltOffset = fixtures.tiltOffset.data();
+					float * directPan = this->directPan.data();
+					float * directTilt = this->directTilt.data();
+
+					//no branches or function calls other than math, so that this loop vectorises
+					for (size_t i = 0; i < count; i++) {
+						auto x = m00[i] * targetX[i] + m01[i] * targetY[i] + m02[i] * targetZ[i] + m03[i];
+						auto y = m10[i] * targetX[i] + m11[i] * targetY[i] + m12[i] * targetZ[i] + m13[i];
+						auto z = m20[i] * targetX[i] + m21[i] * targetY[i] + m22[i] * targetZ[i] + m23[i];
+
+						auto pan = atan2f(z, x) * (float)RAD_TO_DEG - 90.0f;
+						pan += pan < -180.0f ? 360.0f : 0.0f;
+
+						auto length = sqrtf(x * x + y * y + z * z);
+						auto tilt = acosf(-y / length) * (float)RAD_TO_DEG;
+
+						directPan[i] = pan;
+						directTilt[i] = tilt + tiltOffset[i];
+					}
+				}
+				//
+				//--
+
+
+
+				//--
+				//Select solutions
+				//--
+				//
+				size_t invalidCount = 0;
+				for (size_t i = 0; i < count; i++) {
+					glm::vec2 panTilt(this->directPan[i], this->directTilt[i]);
+
+					auto & valid = this->valid[i];
+					valid = !isnan(panTilt.x) && !isnan(panTilt.y);
+
+					if (valid && settings.continuity) {
+						valid = MovingHead::getClosestSolution(panTilt
+							, fixtures.pan[i]
+							, { fixtures.panMin[i], fixtures.panMax[i] }
+							, { fixtures.tiltMin[i], fixtures.tiltMax[i] }
+							, panTilt);
+					}
+
+					if (valid) {
+						fixtures.pan[i] = panTilt.x;
+						fixtures.tilt[i] = panTilt.y;
+					}
+					else {
+						invalidCount++;
+					}
+				}
+				//
+				//--
+
+				return invalidCount;
+			}
+
+			//----------
+			const vector<uint8_t> & MovingHeadBatch::getValid() const {
+				return this->valid;
+			}
+
+			//----------
+			void MovingHeadBatch::applyToMovingHeads() const {
+				for (size_t i = 0; i < this->movingHeads.size(); i++) {
+					auto movingHead = this->movingHeads[i].lock();
+					if (movingHead) {
+						movingHead->setPanTilt({ this->fixtures.pan[i], this->fixtures.tilt[i] });
+					}
+				}
+			}
+
+			//----------
+			void MovingHeadBatch::writeToUniverses(const Transmit & transmit) const {
+				//keep the nodes in step, otherwise Fixture::update writes their old pan/tilt back next frame
+				this->applyToMovingHeads();
+
+				const auto & fixtures = this->fixtures;
+
+				//16 bit values, mapped across the range as Sharpy does
+				auto toDMX = [](float value, float minimum, float maximum) {
+					auto normalised = ofClamp((value - minimum) / (maximum - minimum), 0.0f, 1.0f);
+					return (uint16_t)(normalised * (float)std::numeric_limits<uint16_t>::max());
+				};
+
+				shared_ptr<Transmit::Universe> universe;
+				UniverseIndex universeIndex = 0;
+
+				for (size_t i = 0; i < fixtures.size(); i++) {
+					if (!universe || universeIndex != fixtures.universeIndex[i]) {
+						universeIndex = fixtures.universeIndex[i];
+						universe = transmit.getUniverse(universeIndex);
+					}
+					if (!universe) {
+						continue;
+					}
+
+					auto pan = toDMX(fixtures.pan[i], fixtures.panMin[i], fixtures.panMax[i]);
+					auto tilt = toDMX(fixtures.tilt[i], fixtures.tiltMin[i], fixtures.tiltMax[i]);
+
+					//pan, pan fine, tilt, tilt fine are usually adjacent, so write them in one go
+					const auto & panChannel = fixtures.panChannel[i];
+					if (panChannel > 0
+						&& fixtures.panFineChannel[i] == panChannel + 1
+						&& fixtures.tiltChannel[i] == panChannel + 2
+						&& fixtures.tiltFineChannel[i] == panChannel + 3) {
+						Value values[4] = {
+							(Value)(pan >> 8)
+							, (Value)(pan % 256)
+							, (Value)(tilt >> 8)
+							, (Value)(tilt % 256)
+						};
+						universe->setChannels((ChannelIndex)panChannel, values, 4);
+					}
+					else {
+						auto setChannel = [&universe](int channel, Value value) {
+							if (channel > 0) {
+								universe->setChannel((ChannelIndex)channel, value);
+							}
+						};
+						setChannel(fixtures.panChannel[i], (Value)(pan >> 8));
+						setChannel(fixtures.panFineChannel[i], (Value)(pan % 256));
+						setChannel(fixtures.tiltChannel[i], (Value)(tilt >> 8));
+						setChannel(fixtures.tiltFineChannel[i], (Value)(tilt % 256));
+					}
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
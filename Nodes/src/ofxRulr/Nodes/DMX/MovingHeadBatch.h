@@ -0,0 +1,76 @@
+#pragma once
+
+#include "MovingHead.h"
+#include "Transmit.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace DMX {
+			//Aims many moving heads at many targets at once.
+			//The calibration of each moving head (its rigid body transform and tilt offset, e.g. as fitted by
+			//MovingHeadToWorld) is gathered once in setMovingHeads(). Each frame, fill the targets (one per moving head)
+			//and call solve(), then applyToMovingHeads() or writeToUniverses().
+			//Fixtures and targets are held as structures of arrays, so that the pan/tilt solve runs as plain loops over
+			//contiguous floats which the compiler can vectorise.
+			class MovingHeadBatch {
+			public:
+				struct Fixtures {
+					array<vector<float>, 12> worldToObject; // rows of the 3x4 world to object transform
+					vector<float> tiltOffset;
+					vector<float> panMin, panMax;
+					vector<float> tiltMin, tiltMax;
+
+					//current pan/tilt (used for continuity and updated by solve)
+					vector<float> pan, tilt;
+
+					//where pan/tilt are written in the DMX output (-1 if the fixture doesn't have that channel)
+					vector<UniverseIndex> universeIndex;
+					vector<int> panChannel, panFineChannel;
+					vector<int> tiltChannel, tiltFineChannel;
+
+					size_t size() const;
+					void resize(size_t);
+				};
+
+				struct Targets {
+					vector<float> x, y, z; // world space
+
+					size_t size() const;
+					void resize(size_t);
+				};
+
+				struct Settings {
+					//Choose the equivalent pan/tilt (within the fixture's range) with the least pan movement, as
+					//MovingHead::getPanTiltForTarget(.., true). Otherwise use the direct solution, as MovingHead::lookAt.
+					bool continuity = true;
+				};
+
+				void setMovingHeads(const vector<shared_ptr<MovingHead>> &);
+				size_t size() const;
+
+				Fixtures & getFixtures();
+				const Fixtures & getFixtures() const;
+
+				//Targets must have one entry per moving head. Returns the number of moving heads with no valid
+				//solution (these keep their current pan/tilt).
+				size_t solve(const Targets &, const Settings &);
+				const vector<uint8_t> & getValid() const;
+
+				//Set the pan/tilt parameters of the MovingHead nodes (which they then output in their own update)
+				void applyToMovingHeads() const;
+
+				//Write pan/tilt straight into the universes (sent by the output thread without waiting for the
+				//fixtures' update). Also sets the MovingHead nodes' parameters as applyToMovingHeads(), since each
+				//fixture writes its parameters into the universe in its own update (which would otherwise undo this)
+				void writeToUniverses(const Transmit &) const;
+			protected:
+				vector<weak_ptr<MovingHead>> movingHeads;
+				Fixtures fixtures;
+
+				//reused between solves
+				vector<float> directPan, directTilt;
+				vector<uint8_t> valid;
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "pch_RulrNodes.h"
+#include "SACN.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace DMX {
+			// E1.31 data packet layout
+			const size_t sacnFramingLayerOffset = 38;
+			const size_t sacnSequenceOffset = 111;
+			const size_t sacnUniverseOffset = 113;
+			const size_t sacnDMPLayerOffset = 115;
+			const size_t sacnHeaderSize = 126;
+			const size_t sacnPacketSize = sacnHeaderSize + 512;
+
+			//----------
+			static void writeBigEndian16(uint8_t * data, uint16_t value) {
+				data[0] = (value >> 8) & 0xff;
+				data[1] = value & 0xff;
+			}
+
+			//----------
+			static void writeBigEndian32(uint8_t * data, uint32_t value) {
+				data[0] = (value >> 24) & 0xff;
+				data[1] = (value >> 16) & 0xff;
+				data[2] = (value >> 8) & 0xff;
+				data[3] = value & 0xff;
+			}
+
+			//----------
+			SACN::SACN() {
+				RULR_NODE_INIT_LISTENER;
+			}
+
+			//----------
+			SACN::~SACN() {
+				this->stopOutput();
+			}
+
+			//----------
+			string SACN::getTypeName() const {
+				return "DMX::SACN";
+			}
+
+			//----------
+			void SACN::init() {
+				RULR_NODE_UPDATE_LISTENER;
+
+				this->manageParameters(this->parameters);
+
+				// Component identifier for this session
+				for (auto & byte : this->cid) {
+					byte = (uint8_t) ofRandom(256);
+				}
+
+				this->packet.assign(sacnPacketSize, 0);
+			}
+
+			//----------
+			void SACN::update() {
+				if (this->parameters.universeCount.get() != this->getUniverseCount()) {
+					this->setUniverseCount((UniverseIndex) this->parameters.universeCount.get());
+				}
+
+				if (this->parameters.unicastAddress.get() != this->cachedSettings.unicastAddress
+					|| this->parameters.port.get() != this->cachedSettings.port
+					|| this->parameters.firstUniverse.get() != this->cachedSettings.firstUniverse
+					|| this->parameters.priority.get() != this->cachedSettings.priority
+					|| this->parameters.sourceName.get() != this->cachedSettings.sourceName
+					|| this->destinations.size() != this->getUniverseCount()) {
+					this->rebuild();
+				}
+			}
+
+			//----------
+			void SACN::rebuild() {
+				lock_guard<mutex> lock(this->outputMutex);
+				this->socket.reset();
+				this->destinations.clear();
+
+				this->cachedSettings.unicastAddress = this->parameters.unicastAddress.get();
+				this->cachedSettings.port = this->parameters.port.get();
+				this->cachedSettings.firstUniverse = this->parameters.firstUniverse.get();
+				this->cachedSettings.priority = this->parameters.priority.get();
+				this->cachedSettings.sourceName = this->parameters.sourceName.get();
+
+				// Header (everything except sequence, universe and data)
+				{
+					auto data = this->packet.data();
+					memset(data, 0, sacnHeaderSize);
+
+					// Root layer
+					writeBigEndian16(data + 0, 0x0010); // preamble size
+					writeBigEndian16(data + 2, 0x0000); // postamble size
+					memcpy(data + 4, "ASC-E1.17\0\0\0", 12); // ACN packet identifier
+					writeBigEndian16(data + 16, 0x7000 | (uint16_t) (sacnPacketSize - 16)); // flags and length
+					writeBigEndian32(data + 18, 0x00000004); // VECTOR_ROOT_E131_DATA
+					memcpy(data + 22, this->cid, 16);
+
+					// Framing layer
+					writeBigEndian16(data + sacnFramingLayerOffset, 0x7000 | (uint16_t) (sacnPacketSize - sacnFramingLayerOffset));
+					writeBigEndian32(data + sacnFramingLayerOffset + 2, 0x00000002); // VECTOR_E131_DATA_PACKET
+					strncpy((char *) data + sacnFramingLayerOffset + 6, this->cachedSettings.sourceName.c_str(), 63); // 64 bytes, null terminated
+					data[108] = (uint8_t) this->cachedSettings.priority;
+					writeBigEndian16(data + 109, 0); // synchronization address
+					data[112] = 0; // options
+
+					// DMP layer
+					writeBigEndian16(data + sacnDMPLayerOffset, 0x7000 | (uint16_t) (sacnPacketSize - sacnDMPLayerOffset));
+					data[117] = 0x02; // VECTOR_DMP_SET_PROPERTY
+					data[118] = 0xa1; // address type and data type
+					writeBigEndian16(data + 119, 0x0000); // first property address
+					writeBigEndian16(data + 121, 0x0001); // address increment
+					writeBigEndian16(data + 123, 513); // property value count (start code + 512 channels)
+					data[125] = 0; // start code
+				}
+
+				try {
+					for (UniverseIndex i = 0; i < this->getUniverseCount(); i++) {
+						auto universe = this->cachedSettings.firstUniverse + i;
+						auto address = this->cachedSettings.unicastAddress.empty()
+							? "239.255." + ofToString((universe >> 8) & 0xff) + "." + ofToString(universe & 0xff)
+							: this->cachedSettings.unicastAddress;
+						this->destinations.emplace_back(address, (Poco::UInt16) this->cachedSettings.port);
+					}
+
+					this->socket = make_unique<Poco::Net::DatagramSocket>();
+				}
+				catch (const Poco::Exception & e) {
+					RULR_ERROR << "DMX::SACN : Couldn't open socket : " << e.displayText();
+					this->socket.reset();
+					this->destinations.clear();
+				}
+			}
+
+			//----------
+			void SACN::sendUniverse(UniverseIndex index, const Value * channels, uint8_t sequence) {
+				if (!this->socket || index >= this->destinations.size()) {
+					return;
+				}
+
+				auto data = this->packet.data();
+				data[sacnSequenceOffset] = sequence;
+				writeBigEndian16(data + sacnUniverseOffset, (uint16_t) (this->cachedSettings.firstUniverse + index));
+				memcpy(data + sacnHeaderSize, channels + 1, 512);
+
+				this->socket->sendTo(data, (int) this->packet.size(), this->destinations[index]);
+			}
+		}
+	}
+}
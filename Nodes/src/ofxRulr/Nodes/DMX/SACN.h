@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Transmit.h"
+
+#include "Poco/Net/DatagramSocket.h"
+#include "Poco/Net/SocketAddress.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace DMX {
+			//Sends universes as sACN (ANSI E1.31) data packets over UDP.
+			//Universe i is sent as sACN universe (firstUniverse + i), to its multicast group (239.255.x.y)
+			//or to a unicast address if one is set.
+			class SACN : public DMX::Transmit {
+			public:
+				SACN();
+				~SACN();
+				string getTypeName() const override;
+				void init();
+				void update();
+			protected:
+				void rebuild();
+				void sendUniverse(UniverseIndex, const Value * channels, uint8_t sequence) override;
+
+				struct : ofParameterGroup {
+					ofParameter<string> unicastAddress{ "Unicast address", "" }; // empty = multicast
+					ofParameter<int> port{ "Port", 5568 };
+					ofParameter<int> universeCount{ "Universe count", 1, 1, 256 };
+					ofParameter<int> firstUniverse{ "First universe", 1, 1, 63999 };
+					ofParameter<int> priority{ "Priority", 100, 0, 200 };
+					ofParameter<string> sourceName{ "Source name", "Rulr" };
+					PARAM_DECLARE("sACN", unicastAddress, port, universeCount, firstUniverse, priority, sourceName);
+				} parameters;
+
+				struct {
+					string unicastAddress;
+					int port = 0;
+					int firstUniverse = 0;
+					int priority = 0;
+					string sourceName;
+				} cachedSettings;
+
+				//read by the output thread (with outputMutex locked)
+				unique_ptr<Poco::Net::DatagramSocket> socket;
+				vector<Poco::Net::SocketAddress> destinations; // per universe
+				vector<uint8_t> packet; // preallocated, header is written in rebuild
+				uint8_t cid[16];
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -14,7 +14,8 @@ namespace ofxRulr {
 #pragma mark Transmit::Universe
 			//----------
 			Transmit::Universe::Universe() {
-				this->clearChannels();
+				memset(this->values, 0, 513);
+				this->outputDirty = true;
 				this->previewDirty = true;
 				this->preview.allocate(32, 16, GL_LUMINANCE);
 				this->preview.setTextureMinMagFilter(GL_NEAREST, GL_NEAREST);
@@ -26,8 +27,10 @@ namespace ofxRulr {
 				if (channel > 512) {
 					RULR_ERROR << "ofxRulr::Nodes::DMX::Transmit : Channel index " << (int)(channel) << " is invalid";
 				}
-				else {
+				else if (this->values[channel] != value) {
+					lock_guard<mutex> lock(this->valuesMutex);
 					this->values[channel] = value;
+					this->outputDirty = true;
 					this->previewDirty = true;
 				}
 			}
@@ -37,8 +40,10 @@ namespace ofxRulr {
 				if (channelOffset + count > 512) {
 					RULR_ERROR << "ofxRulr::Nodes::DMX::Transmit : Channel range " << (int)(channelOffset) << "->" << (int) (channelOffset + count) << " is invalid";
 				}
-				else {
+				else if (memcmp(this->values + channelOffset, values, count) != 0) {
+					lock_guard<mutex> lock(this->valuesMutex);
 					memcpy(this->values + channelOffset, values, count);
+					this->outputDirty = true;
 					this->previewDirty = true;
 				}
 			}
@@ -59,8 +64,26 @@ namespace ofxRulr {
 
 			//----------
 			void Transmit::Universe::clearChannels() {
-				memset(this->values, 0, 513);
-				this->previewDirty = true;
+				for (int i = 0; i < 513; i++) {
+					if (this->values[i] != 0) {
+						lock_guard<mutex> lock(this->valuesMutex);
+						memset(this->values, 0, 513);
+						this->outputDirty = true;
+						this->previewDirty = true;
+						return;
+					}
+				}
+			}
+
+			//----------
+			bool Transmit::Universe::takeChannels(Value * channels, bool force) {
+				lock_guard<mutex> lock(this->valuesMutex);
+				if (!this->outputDirty && !force) {
+					return false;
+				}
+				memcpy(channels, this->values, 513);
+				this->outputDirty = false;
+				return true;
 			}
 
 #pragma mark Transmit
@@ -72,15 +95,27 @@ namespace ofxRulr {
 				RULR_NODE_SERIALIZATION_LISTENERS;
 			}
 
+			//----------
+			Transmit::~Transmit() {
+				this->stopOutput();
+			}
+
 			//----------
 			void Transmit::init() {
 				this->view = make_shared<Panels::Scroll>();
 				this->setUniverseCount(1);
 				this->firstFrame = true;
+
+				this->outputThread = std::thread([this]() {
+					this->outputThreadFunction();
+				});
 			}
 
 			//----------
 			void Transmit::update() {
+				this->outputRate = this->outputParameters.rate.get();
+				this->outputKeepAlivePeriod = this->outputParameters.keepAlivePeriod.get();
+
 				if (this->firstFrame) {
 					//don't send on first frame
 					this->firstFrame = false;
@@ -90,8 +125,8 @@ namespace ofxRulr {
 						if (this->universes[i]->blackoutEnabled) {
 							this->universes[i]->clearChannels();
 						}
-						this->sendUniverse(i, this->universes[i]);
 					}
+					this->outputReady = true;
 				}
 			}
 
@@ -112,6 +147,7 @@ namespace ofxRulr {
 					auto & jsonUniverse = jsonUniverses[ofToString(i)];
 					Utils::serialize(jsonUniverse, this->universes[i]->blackoutEnabled);
 				}
+				Utils::serialize(json, this->outputParameters);
 			}
 
 			//----------
@@ -121,11 +157,30 @@ namespace ofxRulr {
 					const auto & jsonUniverse = jsonUniverses[ofToString(i)];
 					Utils::deserialize(jsonUniverse, this->universes[i]->blackoutEnabled);
 				}
+				Utils::deserialize(json, this->outputParameters);
 			}
 
 			//----------
 			void Transmit::populateInspector(ofxCvGui::InspectArguments & inspectArguments) {
 				auto inspector = inspectArguments.inspector;
+
+				inspector->addParameterGroup(this->outputParameters);
+				inspector->addLiveValue<float>("Frame rate [Hz]", [this]() {
+					return this->getOutputStatistics().frameRate;
+				});
+				inspector->addLiveValue<float>("Max frame lateness [ms]", [this]() {
+					return this->getOutputStatistics().maxFrameLateness;
+				});
+				inspector->addLiveValue<size_t>("Universes sent", [this]() {
+					return this->getOutputStatistics().universesSent;
+				});
+				inspector->addLiveValue<size_t>("Universes unchanged", [this]() {
+					return this->getOutputStatistics().universesUnchanged;
+				});
+				inspector->addButton("Reset statistics", [this]() {
+					this->resetOutputStatistics();
+				});
+
 				for (int i = 0; i < this->universes.size(); i++) {
 					inspector->add(new Widgets::Title("Universe " + ofToString(i)));
 					inspector->add(new Widgets::Toggle(this->universes[i]->blackoutEnabled));
@@ -153,14 +208,29 @@ namespace ofxRulr {
 				}
 			}
 
+			//----------
+			Transmit::OutputStatistics Transmit::getOutputStatistics() const {
+				lock_guard<mutex> lock(this->outputStatisticsMutex);
+				return this->outputStatistics;
+			}
+
+			//----------
+			void Transmit::resetOutputStatistics() {
+				lock_guard<mutex> lock(this->outputStatisticsMutex);
+				this->outputStatistics = OutputStatistics();
+			}
+
 			//----------
 			void Transmit::setUniverseCount(UniverseIndex universeCount) {
-				if (this->universes.size() > universeCount) {
-					this->universes.resize(universeCount);
-				}
-				else {
-					while (universeCount > this->universes.size()) {
-						this->universes.push_back(make_shared<Universe>());
+				{
+					lock_guard<mutex> lock(this->outputMutex);
+					if (this->universes.size() > universeCount) {
+						this->universes.resize(universeCount);
+					}
+					else {
+						while (universeCount > this->universes.size()) {
+							this->universes.push_back(make_shared<Universe>());
+						}
 					}
 				}
 
@@ -183,6 +253,102 @@ namespace ofxRulr {
 					this->view->add(preview);
 				}
 			}
+
+			//----------
+			void Transmit::stopOutput() {
+				{
+					lock_guard<mutex> lock(this->outputClosingMutex);
+					this->outputClosing = true;
+				}
+				this->outputClosingCondition.notify_all();
+
+				if (this->outputThread.joinable()) {
+					this->outputThread.join();
+				}
+			}
+
+			//----------
+			void Transmit::outputThreadFunction() {
+				auto nextFrameTime = chrono::steady_clock::now();
+				auto lastFrameTime = nextFrameTime;
+
+				while (true) {
+					// Wait until the next frame (or until we're closed)
+					{
+						auto period = chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(1.0 / (double) max(this->outputRate.load(), 1.0f)));
+						nextFrameTime += period;
+
+						// If we've fallen behind (e.g. a slow send) then skip frames rather than sending a burst
+						auto now = chrono::steady_clock::now();
+						if (nextFrameTime < now) {
+							nextFrameTime = now;
+						}
+
+						unique_lock<mutex> lock(this->outputClosingMutex);
+						this->outputClosingCondition.wait_until(lock, nextFrameTime, [this]() {
+							return this->outputClosing;
+						});
+						if (this->outputClosing) {
+							break;
+						}
+					}
+
+					if (!this->outputReady) {
+						continue;
+					}
+
+					auto frameTime = chrono::steady_clock::now();
+					auto frameLateness = chrono::duration<float, milli>(frameTime - nextFrameTime).count();
+					auto frameInterval = chrono::duration<float>(frameTime - lastFrameTime).count();
+					lastFrameTime = frameTime;
+
+					auto keepAlivePeriod = chrono::duration<float>(this->outputKeepAlivePeriod.load());
+					size_t universesSent = 0;
+					size_t universesUnchanged = 0;
+
+					{
+						lock_guard<mutex> lock(this->outputMutex);
+
+						if (this->universeOutputs.size() != this->universes.size()) {
+							this->universeOutputs.resize(this->universes.size());
+						}
+
+						for (size_t i = 0; i < this->universes.size(); i++) {
+							auto & universeOutput = this->universeOutputs[i];
+							auto keepAlive = keepAlivePeriod.count() > 0.0f
+								&& frameTime - universeOutput.lastSendTime > keepAlivePeriod;
+
+							if (!this->universes[i]->takeChannels(universeOutput.channels, keepAlive)) {
+								universesUnchanged++;
+								continue;
+							}
+
+							universeOutput.sequence = universeOutput.sequence == 255
+								? 1
+								: universeOutput.sequence + 1;
+							universeOutput.lastSendTime = frameTime;
+
+							try {
+								this->sendUniverse((UniverseIndex) i, universeOutput.channels, universeOutput.sequence);
+							}
+							RULR_CATCH_ALL_TO_ERROR;
+							universesSent++;
+						}
+					}
+
+					{
+						lock_guard<mutex> lock(this->outputStatisticsMutex);
+						auto & statistics = this->outputStatistics;
+						statistics.framesSent++;
+						statistics.universesSent += universesSent;
+						statistics.universesUnchanged += universesUnchanged;
+						if (frameInterval > 0.0f) {
+							statistics.frameRate = ofLerp(statistics.frameRate, 1.0f / frameInterval, 0.1f);
+						}
+						statistics.maxFrameLateness = max(statistics.maxFrameLateness, frameLateness);
+					}
+				}
+			}
 		}
 	}
 }
\ No newline at end of file
@@ -5,9 +5,19 @@
 
 #include "Base.h"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
 namespace ofxRulr {
 	namespace Nodes {
 		namespace DMX {
+			//Universes are sent from a dedicated output thread at a fixed rate (independent of the GUI frame rate).
+			//A universe is only sent when its channels have changed, or when keepAlivePeriod has passed since it
+			//was last sent (receivers such as Art-Net nodes drop their output if they hear nothing for a few seconds).
+			//Subclasses implement sendUniverse (called on the output thread, with outputMutex locked) and must call
+			//stopOutput() in their destructor.
 			class Transmit : public DMX::Base {
 			public:
 				class Universe {
@@ -18,14 +28,30 @@ namespace ofxRulr {
 					const Value * getChannels() const;
 					const ofTexture & getTextureReference();
 					void clearChannels();
+
+					//Copy the channels if they have changed since the last take (or always if forced). Thread safe.
+					bool takeChannels(Value * channels, bool force);
+
 					ofParameter<bool> blackoutEnabled;
 				protected:
 					Value values[513]; // 0th channel is unused
+					bool outputDirty;
+					mutable mutex valuesMutex;
+
 					ofTexture preview;
 					bool previewDirty;
 				};
 
+				struct OutputStatistics {
+					size_t framesSent = 0;
+					size_t universesSent = 0;
+					size_t universesUnchanged = 0;
+					float frameRate = 0.0f; // [Hz]
+					float maxFrameLateness = 0.0f; // [ms] since last reset
+				};
+
 				Transmit();
+				virtual ~Transmit();
 				void init();
 				void update();
 				virtual string getTypeName() const override;
@@ -38,14 +64,52 @@ namespace ofxRulr {
 				UniverseIndex getUniverseCount() const;
 				const vector<shared_ptr<Universe>> & getUniverses() const;
 				shared_ptr<Universe> getUniverse(UniverseIndex universeIndex) const;
+
+				OutputStatistics getOutputStatistics() const;
+				void resetOutputStatistics();
 			protected:
 				void setUniverseCount(UniverseIndex);
-				virtual void sendUniverse(UniverseIndex, shared_ptr<Universe>) { }
+
+				//Called on the output thread. channels has 513 values (0th is unused).
+				//sequence counts 1...255 per universe (0 is never used)
+				virtual void sendUniverse(UniverseIndex, const Value * channels, uint8_t sequence) { }
+
+				void stopOutput();
+
+				struct : ofParameterGroup {
+					ofParameter<float> rate{ "Rate [Hz]", 44, 1, 100 };
+					ofParameter<float> keepAlivePeriod{ "Keep alive period [s]", 1.0f, 0.0f, 10.0f };
+					PARAM_DECLARE("Output", rate, keepAlivePeriod);
+				} outputParameters;
+
 				shared_ptr<ofxCvGui::Panels::Scroll> view;
 
 				vector<shared_ptr<Universe>> universes;
 
+				//Held whilst sending. Lock it when changing what sendUniverse uses (e.g. reconnecting)
+				mutex outputMutex;
+
 				bool firstFrame;
+			private:
+				void outputThreadFunction();
+
+				struct UniverseOutput {
+					Value channels[513];
+					uint8_t sequence = 0;
+					chrono::steady_clock::time_point lastSendTime;
+				};
+				vector<UniverseOutput> universeOutputs; // output thread only
+
+				std::thread outputThread;
+				atomic<bool> outputReady{ false };
+				atomic<float> outputRate{ 44.0f };
+				atomic<float> outputKeepAlivePeriod{ 1.0f };
+				bool outputClosing = false;
+				mutex outputClosingMutex;
+				condition_variable outputClosingCondition;
+
+				OutputStatistics outputStatistics;
+				mutable mutex outputStatisticsMutex;
 			};
 		}
 	}
@@ -14,6 +14,8 @@
 #include "ofxRulr/Nodes/Data/Recorder.h"
 
 #include "ofxRulr/Nodes/DMX/Sharpy.h"
+#include "ofxRulr/Nodes/DMX/ArtNet.h"
+#include "ofxRulr/Nodes/DMX/SACN.h"
 #include "ofxRulr/Nodes/DMX/AimMovingHeadAt.h"
 
 #include "ofxRulr/Nodes/Item/Board.h"
@@ -38,6 +40,7 @@
 
 #include "ofxRulr/Nodes/Test/ARCube.h"
 #include "ofxRulr/Nodes/Test/Focus.h"
+#include "ofxRulr/Nodes/Test/HttpClient.h"
 
 #include "ofxRulr/Nodes/Watchdog/Camera.h"
 #include "ofxRulr/Nodes/Watchdog/Startup.h"
@@ -63,6 +66,8 @@ namespace ofxRulr {
 
 			RULR_DECLARE_NODE(DMX::Sharpy);
 			RULR_DECLARE_NODE(DMX::AimMovingHeadAt);
+			RULR_DECLARE_NODE(DMX::ArtNet);
+			RULR_DECLARE_NODE(DMX::SACN);
 
 			RULR_DECLARE_NODE(Item::Board);
 			RULR_DECLARE_NODE(Item::Camera);
@@ -87,6 +92,7 @@ namespace ofxRulr {
 			
 			RULR_DECLARE_NODE(Test::ARCube);
 			RULR_DECLARE_NODE(Test::Focus);
+			RULR_DECLARE_NODE(Test::HttpClient);
 
 			RULR_DECLARE_NODE(Watchdog::Camera);
 			RULR_DECLARE_NODE(Watchdog::Startup);
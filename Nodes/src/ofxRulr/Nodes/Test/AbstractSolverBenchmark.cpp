@@ -0,0 +1,85 @@
+#include "pch_RulrNodes.h"
+#include "AbstractSolverBenchmark.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Test {
+			//----------
+			AbstractSolverBenchmark::AbstractSolverBenchmark() {
+				// Subclasses have their own init
+				this->onInit += [this]() {
+					this->init();
+				};
+			}
+
+			//----------
+			void AbstractSolverBenchmark::init() {
+				RULR_NODE_UPDATE_LISTENER;
+				RULR_NODE_INSPECTOR_LISTENER;
+				RULR_NODE_SERIALIZATION_LISTENERS;
+
+				this->manageParameters(this->benchmarkParameters);
+			}
+
+			//----------
+			void AbstractSolverBenchmark::update() {
+				// Deferred to the first update so that the rest of the patch (and our parameters) have loaded
+				if (this->loadPending) {
+					this->loadPending = false;
+
+					const auto& unattended = this->benchmarkParameters.unattended;
+					if (unattended.runOnLoad) {
+						try {
+							this->run();
+						}
+						RULR_CATCH_ALL_TO_ERROR;
+
+						Utils::SolverBenchmark::finishUnattended(unattended.resultsPath.get()
+							, unattended.exitApp.get()
+							, [this, &unattended](const string& resultsPath) {
+								this->benchmark.save(resultsPath, unattended.label.get());
+							});
+					}
+				}
+			}
+
+			//----------
+			void AbstractSolverBenchmark::populateInspector(ofxCvGui::InspectArguments& args) {
+				auto inspector = args.inspector;
+
+				inspector->addButton("Run", [this]() {
+					try {
+						this->run();
+					}
+					RULR_CATCH_ALL_TO_ALERT;
+				}, ' ');
+
+				this->benchmark.addToInspector(inspector);
+			}
+
+			//----------
+			void AbstractSolverBenchmark::serialize(nlohmann::json&) {
+
+			}
+
+			//----------
+			void AbstractSolverBenchmark::deserialize(const nlohmann::json&) {
+				this->loadPending = true;
+			}
+
+			//----------
+			void AbstractSolverBenchmark::run() {
+				ofSeedRandom(this->benchmarkParameters.seed.get());
+
+				for (int trial = 0; trial < this->benchmarkParameters.trials.get(); trial++) {
+					this->runTrial((size_t)trial);
+				}
+			}
+
+			//----------
+			const Utils::SolverBenchmark& AbstractSolverBenchmark::getBenchmark() const {
+				return this->benchmark;
+			}
+		}
+	}
+}
\ No newline at end of file
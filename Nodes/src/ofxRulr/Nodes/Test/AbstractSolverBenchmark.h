@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ofxRulr/Nodes/Base.h"
+#include "ofxRulr/Utils/SolverBenchmark.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Test {
+			// Base for nodes which benchmark solvers on synthetic problems.
+			// Subclasses generate and measure the problems of each trial, this class runs the seeded trials,
+			// shows the results and can run once the patch has loaded (saving the results and exiting the app).
+			// This all happens inside the Rulr app : there is no separate (windowless) executable.
+			class AbstractSolverBenchmark : public Nodes::Base {
+			public:
+				AbstractSolverBenchmark();
+				void init();
+				void update();
+				void populateInspector(ofxCvGui::InspectArguments&);
+				void serialize(nlohmann::json&);
+				void deserialize(const nlohmann::json&);
+
+				void run();
+				const Utils::SolverBenchmark& getBenchmark() const;
+			protected:
+				// Measure the solves of one trial into this->benchmark
+				virtual void runTrial(size_t trial) = 0;
+
+				struct : ofParameterGroup {
+					ofParameter<int> trials{ "Trials", 3 };
+					ofParameter<int> seed{ "Seed", 0 };
+
+					struct : ofParameterGroup {
+						ofParameter<bool> runOnLoad{ "Run on load", false };
+						ofParameter<string> resultsPath{ "Results path", "" };
+						ofParameter<string> label{ "Label", "" };
+						ofParameter<bool> exitApp{ "Exit app", false };
+						PARAM_DECLARE("Unattended", runOnLoad, resultsPath, label, exitApp);
+					} unattended;
+
+					PARAM_DECLARE("Benchmark", trials, seed, unattended);
+				} benchmarkParameters;
+
+				Utils::SolverBenchmark benchmark;
+			private:
+				bool loadPending = false;
+			};
+		}
+	}
+}
\ No newline at end of file
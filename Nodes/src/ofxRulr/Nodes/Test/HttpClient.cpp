@@ -0,0 +1,233 @@
+#include "pch_RulrNodes.h"
+#include "HttpClient.h"
+
+#include "ofxRulr/Utils/HttpClient.h"
+
+#include "Poco/NullStream.h"
+#include "Poco/StreamCopier.h"
+#include "Poco/Net/HTTPServer.h"
+#include "Poco/Net/HTTPServerParams.h"
+#include "Poco/Net/HTTPServerRequest.h"
+#include "Poco/Net/HTTPServerResponse.h"
+#include "Poco/Net/HTTPRequestHandler.h"
+#include "Poco/Net/HTTPRequestHandlerFactory.h"
+#include "Poco/Net/ServerSocket.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Test {
+			namespace {
+				// Paths :
+				//	/ok		200
+				//	/slow	200 after slowResponseDelay
+				//	/error	500
+				class MockRequestHandler : public Poco::Net::HTTPRequestHandler {
+				public:
+					MockRequestHandler(float slowResponseDelay)
+						: slowResponseDelay(slowResponseDelay) {
+
+					}
+
+					void handleRequest(Poco::Net::HTTPServerRequest & request, Poco::Net::HTTPServerResponse & response) override {
+						Poco::NullOutputStream nullStream;
+						Poco::StreamCopier::copyStream(request.stream(), nullStream);
+
+						const auto & path = request.getURI();
+						if (path == "/slow") {
+							std::this_thread::sleep_for(chrono::duration<float>(this->slowResponseDelay));
+						}
+
+						response.setStatus(path == "/error"
+							? Poco::Net::HTTPResponse::HTTP_INTERNAL_SERVER_ERROR
+							: Poco::Net::HTTPResponse::HTTP_OK);
+						response.setContentType("text/plain");
+						response.send() << path;
+					}
+				protected:
+					const float slowResponseDelay;
+				};
+
+				class MockRequestHandlerFactory : public Poco::Net::HTTPRequestHandlerFactory {
+				public:
+					MockRequestHandlerFactory(float slowResponseDelay)
+						: slowResponseDelay(slowResponseDelay) {
+
+					}
+
+					Poco::Net::HTTPRequestHandler * createRequestHandler(const Poco::Net::HTTPServerRequest &) override {
+						return new MockRequestHandler(this->slowResponseDelay);
+					}
+				protected:
+					const float slowResponseDelay;
+				};
+
+				class MockServer {
+				public:
+					MockServer(float keepAliveTimeout, float slowResponseDelay)
+						: socket(Poco::Net::SocketAddress("127.0.0.1", 0)) {
+						auto params = new Poco::Net::HTTPServerParams();
+						params->setKeepAlive(true);
+						params->setKeepAliveTimeout(Poco::Timespan(0, (long) (keepAliveTimeout * 1e6f)));
+
+						this->server = make_unique<Poco::Net::HTTPServer>(new MockRequestHandlerFactory(slowResponseDelay)
+							, this->socket
+							, params);
+						this->server->start();
+					}
+
+					~MockServer() {
+						this->server->stop();
+					}
+
+					string getURL(const string & path) const {
+						return "http://127.0.0.1:" + ofToString(this->socket.address().port()) + path;
+					}
+
+					int getConnectionCount() const {
+						return this->server->totalConnections();
+					}
+				protected:
+					Poco::Net::ServerSocket socket;
+					unique_ptr<Poco::Net::HTTPServer> server;
+				};
+			}
+
+			//----------
+			HttpClient::HttpClient() {
+				RULR_NODE_INIT_LISTENER;
+			}
+
+			//----------
+			string HttpClient::getTypeName() const {
+				return "Test::HttpClient";
+			}
+
+			//----------
+			void HttpClient::init() {
+				RULR_NODE_INSPECTOR_LISTENER;
+				this->manageParameters(this->parameters);
+			}
+
+			//----------
+			void HttpClient::populateInspector(ofxCvGui::InspectArguments & inspectArgs) {
+				auto inspector = inspectArgs.inspector;
+
+				inspector->addButton("Run", [this]() {
+					try {
+						Utils::ScopedProcess scopedProcess("Testing HttpClient");
+						this->run();
+						scopedProcess.end();
+					}
+					RULR_CATCH_ALL_TO_ALERT;
+				}, ' ');
+
+				inspector->addLiveValue<string>("Checks", [this]() {
+					stringstream message;
+					for (const auto & check : this->checks) {
+						message << (check.passed ? "PASS " : "FAIL ") << check.name << " : " << check.detail << endl;
+					}
+					return message.str();
+				});
+			}
+
+			//----------
+			void HttpClient::run() {
+				this->checks.clear();
+				auto addCheck = [this](const string & name, bool passed, const string & detail) {
+					this->checks.push_back(Check{ name, passed, detail });
+				};
+
+				const auto requestCount = (size_t) max(this->parameters.requestCount.get(), 1);
+				const auto maxInFlight = (size_t) max(this->parameters.maxInFlight.get(), 1);
+				const auto keepAliveTimeout = this->parameters.keepAliveTimeout.get();
+				const auto slowResponseDelay = this->parameters.slowResponseDelay.get();
+
+				MockServer server(keepAliveTimeout, slowResponseDelay);
+
+				auto makeRequest = [&server](const string & path) {
+					Utils::HttpClient::Request request;
+					request.url = server.getURL(path);
+					return request;
+				};
+
+				//sequential requests from one worker share one kept-alive connection
+				{
+					Utils::HttpClient client(1);
+					auto connectionsBefore = server.getConnectionCount();
+					size_t successCount = 0;
+					for (size_t i = 0; i < requestCount; i++) {
+						if (client.requestSync(makeRequest("/ok")).isSuccess()) {
+							successCount++;
+						}
+					}
+					auto connections = server.getConnectionCount() - connectionsBefore;
+					addCheck("Pooled"
+						, successCount == requestCount && connections == 1
+						, ofToString(successCount) + "/" + ofToString(requestCount) + " succeeded over " + ofToString(connections) + " connections");
+				}
+
+				//concurrent requests use at most one connection per worker
+				{
+					Utils::HttpClient client(maxInFlight);
+					auto connectionsBefore = server.getConnectionCount();
+					auto responses = client.requestAll(vector<Utils::HttpClient::Request>(requestCount, makeRequest("/ok")));
+					auto successCount = (size_t) count_if(responses.begin(), responses.end(), [](const Utils::HttpClient::Response & response) {
+						return response.isSuccess();
+					});
+					auto connections = server.getConnectionCount() - connectionsBefore;
+					addCheck("Concurrent"
+						, successCount == requestCount && connections <= (int) maxInFlight
+						, ofToString(successCount) + "/" + ofToString(requestCount) + " succeeded over " + ofToString(connections) + " connections");
+				}
+
+				//a GET on a connection which the server has closed since is retried on a fresh connection
+				{
+					Utils::HttpClient client(1);
+					auto connectionsBefore = server.getConnectionCount();
+					auto firstResponse = client.requestSync(makeRequest("/ok"));
+					std::this_thread::sleep_for(chrono::duration<float>(keepAliveTimeout * 2.0f + 0.1f));
+					auto response = client.requestSync(makeRequest("/ok"));
+					auto connections = server.getConnectionCount() - connectionsBefore;
+					addCheck("Retry stale connection"
+						, firstResponse.isSuccess() && response.isSuccess() && response.error.empty() && connections == 2
+						, "status " + ofToString(response.status) + ", error '" + response.error + "', " + ofToString(connections) + " connections");
+				}
+
+				//timeouts are reported (and not retried), and the worker recovers on a fresh connection
+				{
+					Utils::HttpClient client(1);
+					auto request = makeRequest("/slow");
+					request.timeout = slowResponseDelay / 4.0f;
+					auto response = client.requestSync(request);
+					auto nextResponse = client.requestSync(makeRequest("/ok"));
+					addCheck("Timeout"
+						, response.status == 0 && !response.error.empty() && response.latency < slowResponseDelay * 1000.0f && nextResponse.isSuccess()
+						, "error '" + response.error + "' after " + ofToString(response.latency, 1) + "ms, next status " + ofToString(nextResponse.status));
+				}
+
+				//HTTP errors are responses, not retries
+				{
+					Utils::HttpClient client(1);
+					auto response = client.requestSync(makeRequest("/error"));
+					auto statistics = client.getStatistics();
+					auto errorCount = statistics.empty() ? 0 : statistics.begin()->second.errorCount;
+					addCheck("HTTP error"
+						, response.status == 500 && !response.error.empty() && errorCount == 1
+						, "status " + ofToString(response.status) + ", error '" + response.error + "'");
+				}
+
+				auto failedCount = count_if(this->checks.begin(), this->checks.end(), [](const Check & check) {
+					return !check.passed;
+				});
+				if (failedCount > 0) {
+					throw(ofxRulr::Exception(ofToString(failedCount) + " of " + ofToString(this->checks.size()) + " HttpClient checks failed"));
+				}
+			}
+
+			//----------
+			const vector<HttpClient::Check> & HttpClient::getChecks() const {
+				return this->checks;
+			}
+		}
+	}
+}
\ No newline at end of file
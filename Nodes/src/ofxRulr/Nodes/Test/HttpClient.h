@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ofxRulr/Nodes/Base.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Test {
+			// Runs Utils::HttpClient against a mock HTTP server (started in this process on localhost) to check
+			// connection pooling, the retry of GETs on connections closed by the server, timeouts and HTTP errors.
+			class HttpClient : public Nodes::Base {
+			public:
+				struct Check {
+					string name;
+					bool passed = false;
+					string detail;
+				};
+
+				HttpClient();
+				string getTypeName() const override;
+				void init();
+				void populateInspector(ofxCvGui::InspectArguments &);
+
+				// Throws if any check fails
+				void run();
+				const vector<Check> & getChecks() const;
+			protected:
+				struct : ofParameterGroup {
+					ofParameter<int> requestCount{ "Request count", 32 };
+					ofParameter<int> maxInFlight{ "Max in flight", 4 };
+					ofParameter<float> keepAliveTimeout{ "Server keep alive timeout [s]", 0.2f };
+					ofParameter<float> slowResponseDelay{ "Slow response delay [s]", 1.0f };
+					PARAM_DECLARE("HttpClient", requestCount, maxInFlight, keepAliveTimeout, slowResponseDelay);
+				} parameters;
+
+				vector<Check> checks;
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -27,37 +27,41 @@ namespace ofxRulr {
 
 			//----------
 			void OSCRelay::update() {
-				//clear sender if parameters changed
-				if (this->parameters.remotePort.get() != this->cachedParameters.remotePort.get()
-					|| this->parameters.remoteAddress.get() != this->cachedParameters.remoteAddress.get()) {
-					this->sender.reset();
-				}
+				//update publisher if parameters changed
+				if (this->parameters.remoteAddress.get() != this->cachedParameters.remoteAddress
+					|| this->parameters.remotePort.get() != this->cachedParameters.remotePort
+					|| this->parameters.additionalDestinations.get() != this->cachedParameters.additionalDestinations
+					|| this->parameters.format.get() != this->cachedParameters.format) {
+					this->cachedParameters.remoteAddress = this->parameters.remoteAddress.get();
+					this->cachedParameters.remotePort = this->parameters.remotePort.get();
+					this->cachedParameters.additionalDestinations = this->parameters.additionalDestinations.get();
+					this->cachedParameters.format = this->parameters.format.get();
 
-				//make sender if we don't have one
-				if (!this->sender) {
-					auto sender = make_unique<ofxOscSender>();
-					sender->setup(this->parameters.remoteAddress, this->parameters.remotePort);
-					this->sender = move(sender);
-					this->cachedParameters = this->parameters;
+					Utils::PosePublisher::Settings settings;
+					settings.destinations.push_back({ this->cachedParameters.remoteAddress, this->cachedParameters.remotePort });
+					auto additionalDestinations = Utils::PosePublisher::parseDestinations(this->cachedParameters.additionalDestinations, this->cachedParameters.remotePort);
+					settings.destinations.insert(settings.destinations.end(), additionalDestinations.begin(), additionalDestinations.end());
+					settings.format = this->cachedParameters.format;
+					this->publisher.setSettings(settings);
 				}
 
-				//if we have a sender then do the thing
-				if (this->sender) {
-					auto findMarkersNode = this->getInput<FindMarkers>();
-					if (findMarkersNode) {
-						ofxOscBundle bundle;
-
-						const auto & markers = findMarkersNode->getTrackedMarkers();
-						for (const auto & marker : markers) {
-							ofxOscMessage message;
-							message.setAddress("/aruco/" + ofToString(marker.second->ID));
-							for (int i = 0; i < 16; i++) {
-								message.addFloatArg(marker.second->transform.getPtr()[i]);
-							}
-							bundle.addMessage(message);
-						}
+				//publish all markers together
+				auto findMarkersNode = this->getInput<FindMarkers>();
+				if (findMarkersNode) {
+					const auto & markers = findMarkersNode->getTrackedMarkers();
+					vector<Utils::PosePublisher::Pose> poses;
+					poses.reserve(markers.size());
+					for (const auto & marker : markers) {
+						Utils::PosePublisher::Pose pose;
+						pose.ID = (uint32_t) marker.second->ID;
+						pose.transform = marker.second->transform;
+						pose.oscAddress = "/aruco/" + ofToString(marker.second->ID);
+						poses.push_back(move(pose));
+					}
 
-						this->sender->sendBundle(bundle);
+					if (!poses.empty()) {
+						auto timestamp = chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch());
+						this->publisher.publish(poses, timestamp);
 					}
 				}
 			}
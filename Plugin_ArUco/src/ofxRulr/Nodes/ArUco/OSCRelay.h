@@ -2,7 +2,7 @@
 
 #include "Constants_Plugin_ArUco.h"
 #include "ofxRulr/Nodes/Base.h"
-#include "ofxOsc.h"
+#include "ofxRulr/Utils/PosePublisher.h"
 
 namespace ofxRulr {
 	namespace Nodes {
@@ -20,19 +20,20 @@ namespace ofxRulr {
 				struct Parameters : ofParameterGroup {
 					ofParameter<string> remoteAddress{ "Remote address", "localhost" };
 					ofParameter<int> remotePort{ "Remote port", 5000 };
-					PARAM_DECLARE("OSCRelay", remoteAddress, remotePort);
+					ofParameter<string> additionalDestinations{ "Additional destinations", "" }; // host:port, host:port (may be multicast groups)
+					ofParameter<Utils::PoseFormat> format{ "Format", Utils::PoseFormat::OSC };
+					PARAM_DECLARE("OSCRelay", remoteAddress, remotePort, additionalDestinations, format);
 				} parameters;
 
-				Parameters cachedParameters;
+				struct {
+					string remoteAddress;
+					int remotePort = 0;
+					string additionalDestinations;
+					Utils::PoseFormat format;
+				} cachedParameters;
 
-				shared_ptr<ofxOscSender> getSender() const;
-				shared_ptr<ofxOscSender> tryMakeSender() const;
-
-				void setSender(shared_ptr<ofxOscSender>);
-				void invalidateSender();
-
-				unique_ptr<ofxOscSender> sender;
-				mutable mutex senderMutex;
+				//all markers of a frame leave in one packet, sent from the publisher's thread
+				Utils::PosePublisher publisher;
 			};
 		}
 	}
@@ -530,11 +530,15 @@ namespace ofxRulr {
 					}
 					RULR_CATCH_ALL_TO_ALERT;
 					});
+
+				this->solverCache.addToInspector(inspector);
+				Utils::SolverRuntime::addToInspector(inspector);
 			}
 
 			//----------
 			void Calibrate::serialize(nlohmann::json& json) {
 				this->captures.serialize(json["captures"]);
+				this->solverCache.serialize(json["solverCache"]);
 			}
 
 			//----------
@@ -551,6 +555,10 @@ namespace ofxRulr {
 					}
 				}
 
+				if (json.contains("solverCache")) {
+					this->solverCache.deserialize(json["solverCache"]);
+				}
+
 				this->dirty.capturePreviews = true;
 			}
 
@@ -1145,30 +1153,128 @@ namespace ofxRulr {
 					solverSettings.options.num_threads = this->parameters.calibration.bundleAdjustment.numThreads.get();
 
 					auto cameraView = camera->getViewInObjectSpace();
+					const auto projectionMatrix = cameraView.getClippedProjectionMatrix();
+
+					// Look for a prior solve of the same data
+					Utils::SolverCache::Key cacheKey;
+					{
+						cacheKey.addStructure("MarkerProjections")
+							.addStructure(solverSettings.options.max_num_iterations)
+							.add(solverSettings.options.function_tolerance)
+							.addStructure(camera->getWidth())
+							.addStructure(camera->getHeight());
+						for (int i = 0; i < 16; i++) {
+							cacheKey.add(glm::value_ptr(projectionMatrix)[i]);
+						}
+
+						cacheKey.addStructure(objectPoints.size());
+						for (const auto& objectVertices : objectPoints) {
+							cacheKey.addStructure(objectVertices.size());
+							for (const auto& objectVertex : objectVertices) {
+								cacheKey.add(objectVertex);
+							}
+						}
+
+						cacheKey.addStructure(images.size());
+						for (const auto& image : images) {
+							cacheKey.addStructure(image.viewIndex)
+								.addStructure(image.objectIndex)
+								.addStructure(image.imagePointsUndistorted.size());
+							for (const auto& imagePoint : image.imagePointsUndistorted) {
+								cacheKey.add(imagePoint);
+							}
+						}
+
+						// Fixed markers are part of the input
+						cacheKey.addStructure(fixedObjectIndices.size());
+						for (auto fixedObjectIndex : fixedObjectIndices) {
+							cacheKey.addStructure(fixedObjectIndex)
+								.add(initialSolution.objects[fixedObjectIndex].translation)
+								.add(initialSolution.objects[fixedObjectIndex].rotation);
+						}
+					}
 
-					auto result = Solvers::MarkerProjections::solve(camera->getWidth()
-						, camera->getHeight()
-						, cameraView.getClippedProjectionMatrix()
-						, objectPoints
-						, images
-						, fixedObjectIndices
-						, initialSolution
-						, solverSettings);
-
-					if (!result.isConverged()) {
-						if (this->parameters.calibration.bundleAdjustment.useIncompleteSolution.get()) {
-							unpackSolution(captures
-								, result.solution
-								, markers
-								, images);
+					// Solution is packed as translation and rotation per object, then per view, then the reprojection error per image
+					auto packSolution = [](const Solvers::MarkerProjections::Solution& solution) {
+						vector<double> packed;
+						for (auto transforms : { &solution.objects, &solution.views }) {
+							for (const auto& transform : *transforms) {
+								packed.insert(packed.end(), {
+									transform.translation.x, transform.translation.y, transform.translation.z
+									, transform.rotation.x, transform.rotation.y, transform.rotation.z
+									});
+							}
+						}
+						packed.insert(packed.end(), solution.reprojectionErrorPerImage.begin(), solution.reprojectionErrorPerImage.end());
+						return packed;
+					};
+					auto unpackCachedSolution = [&images](const vector<double>& packed, Solvers::MarkerProjections::Solution& solution) {
+						if (packed.size() != (solution.objects.size() + solution.views.size()) * 6 + images.size()) {
+							return false;
+						}
+						auto value = packed.begin();
+						for (auto transforms : { &solution.objects, &solution.views }) {
+							for (auto& transform : *transforms) {
+								transform.translation.x = (float)*value++;
+								transform.translation.y = (float)*value++;
+								transform.translation.z = (float)*value++;
+								transform.rotation.x = (float)*value++;
+								transform.rotation.y = (float)*value++;
+								transform.rotation.z = (float)*value++;
+							}
 						}
-						throw(ofxRulr::Exception("Failed to converge"));
+						solution.reprojectionErrorPerImage.assign(value, packed.end());
+						return true;
+					};
+
+					auto cachedSolution = initialSolution;
+					auto cacheLookup = this->solverCache.find(cacheKey);
+					if (cacheLookup.match == Utils::SolverCache::Match::Exact
+						&& unpackCachedSolution(cacheLookup.solution, cachedSolution)) {
+						// Identical data : use the stored solution
+						ofLogNotice("MarkerMap::Calibrate") << "Using cached solution (residual " << cacheLookup.residual << ")";
+						unpackSolution(captures
+							, cachedSolution
+							, markers
+							, images);
 					}
+					else {
+						// Near-identical data : start from the closest stored solution (keeping the fixed markers)
+						if (cacheLookup.match == Utils::SolverCache::Match::Nearest) {
+							const auto priorObjects = initialSolution.objects;
+							if (unpackCachedSolution(cacheLookup.solution, initialSolution)) {
+								for (auto fixedObjectIndex : fixedObjectIndices) {
+									initialSolution.objects[fixedObjectIndex] = priorObjects[fixedObjectIndex];
+								}
+							}
+						}
+
+						auto result = Solvers::MarkerProjections::solve(camera->getWidth()
+							, camera->getHeight()
+							, projectionMatrix
+							, objectPoints
+							, images
+							, fixedObjectIndices
+							, initialSolution
+							, solverSettings);
 
-					unpackSolution(captures
-						, result.solution
-						, markers
-						, images);
+						if (!result.isConverged()) {
+							if (this->parameters.calibration.bundleAdjustment.useIncompleteSolution.get()) {
+								unpackSolution(captures
+									, result.solution
+									, markers
+									, images);
+							}
+							throw(ofxRulr::Exception("Failed to converge"));
+						}
+
+						this->solverCache.store(cacheKey, packSolution(result.solution), (float)result.residual);
+
+						unpackSolution(captures
+							, result.solution
+							, markers
+							, images);
+					}
 				}
 
 				this->dirty.capturePreviews = true;
@@ -5,6 +5,7 @@
 #include "ofxRulr/Nodes/Item/Camera.h"
 #include <aruco/aruco.h>
 #include "ofxRulr/Utils/CaptureSet.h"
+#include "ofxRulr/Utils/SolverCache.h"
 #include "ofxRulr/Solvers/MarkerProjections.h"
 
 namespace ofxRulr {
@@ -94,6 +95,9 @@ namespace ofxRulr {
 				Utils::CaptureSet<Capture> captures;
 				shared_ptr<ofxCvGui::Panels::Widgets> panel;
 
+				// Solutions of calibrateSelected() against the image points, markers and fixed markers
+				Utils::SolverCache solverCache;
+
 				// If previews need updating
 				struct {
 					bool capturePreviews = true;
@@ -0,0 +1,156 @@
+#include "pch_Plugin_ArUco.h"
+#include "SolverBenchmark.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace MarkerMap {
+			//----------
+			SolverBenchmark::SolverBenchmark()
+			{
+				RULR_NODE_INIT_LISTENER;
+			}
+
+			//----------
+			string
+				SolverBenchmark::getTypeName() const
+			{
+				return "MarkerMap::SolverBenchmark";
+			}
+
+			//----------
+			void
+				SolverBenchmark::init()
+			{
+				this->manageParameters(this->parameters);
+			}
+
+			//----------
+			void
+				SolverBenchmark::runTrial(size_t trial)
+			{
+				const int cameraWidth = 1920;
+				const int cameraHeight = 1080;
+				const auto cameraProjectionMatrix = glm::perspective(60.0f * DEG_TO_RAD
+					, (float)cameraWidth / (float)cameraHeight
+					, 0.05f
+					, 100.0f);
+
+				const auto markerCount = (size_t)max(this->parameters.markers.count.get(), 2);
+				const auto viewCount = (size_t)max(this->parameters.views.count.get(), 1);
+				const auto markerSize = this->parameters.markers.size.get();
+				const auto spread = this->parameters.markers.spread.get();
+				const auto distance = this->parameters.views.distance.get();
+
+				auto randomVector = [](float amplitude) {
+					return glm::vec3(ofRandomf(), ofRandomf(), ofRandomf()) * amplitude;
+				};
+
+				// Ground truth
+				Solvers::MarkerProjections::Solution groundTruth;
+				vector<vector<glm::vec3>> objectPoints;
+				{
+					const auto r = markerSize / 2.0f;
+					for (size_t i = 0; i < markerCount; i++) {
+						objectPoints.push_back({
+							{ -r, r, 0 }
+							, { r, r, 0 }
+							, { r, -r, 0 }
+							, { -r, -r, 0 }
+							});
+
+						Solvers::MarkerProjections::Solution::Transform transform;
+						transform.rotation = randomVector(0.3f);
+						transform.translation = glm::vec3(ofRandomf() * spread, ofRandomf() * spread, 0.0f);
+						groundTruth.objects.push_back(transform);
+					}
+
+					for (size_t i = 0; i < viewCount; i++) {
+						// Views are inverse transforms (world to camera), camera looks down -z
+						Solvers::MarkerProjections::Solution::Transform transform;
+						transform.rotation = randomVector(0.2f);
+						transform.translation = glm::vec3(ofRandomf() * 0.2f, ofRandomf() * 0.2f, -distance * ofRandom(1.0f, 1.3f));
+						groundTruth.views.push_back(transform);
+					}
+				}
+
+				// Project into the views
+				vector<Solvers::MarkerProjections::Image> images;
+				{
+					const auto noise = this->parameters.noise.imageNoise.get();
+					for (size_t viewIndex = 0; viewIndex < viewCount; viewIndex++) {
+						const auto view = Solvers::MarkerProjections::getTransform(groundTruth.views[viewIndex]);
+						for (size_t objectIndex = 0; objectIndex < markerCount; objectIndex++) {
+							const auto object = Solvers::MarkerProjections::getTransform(groundTruth.objects[objectIndex]);
+
+							Solvers::MarkerProjections::Image image;
+							image.viewIndex = (int)viewIndex;
+							image.objectIndex = (int)objectIndex;
+
+							bool inView = true;
+							for (const auto& objectPoint : objectPoints[objectIndex]) {
+								auto viewPoint = ofxCeres::VectorMath::applyTransform(view * object, objectPoint);
+								auto projectedPoint = ofxCeres::VectorMath::applyTransform(cameraProjectionMatrix, viewPoint);
+								if (viewPoint.z >= 0.0f || abs(projectedPoint.x) > 1.0f || abs(projectedPoint.y) > 1.0f) {
+									inView = false;
+									break;
+								}
+								image.imagePointsUndistorted.emplace_back((float)cameraWidth * (projectedPoint.x + 1.0f) / 2.0f + ofRandomf() * noise
+									, (float)cameraHeight * (1.0f - projectedPoint.y) / 2.0f + ofRandomf() * noise);
+							}
+
+							if (inView) {
+								images.push_back(image);
+							}
+						}
+					}
+				}
+
+				// Perturb the ground truth as the initial solution (object 0 is fixed to hold the gauge)
+				auto initialSolution = groundTruth;
+				{
+					const auto rotationError = this->parameters.noise.initialRotation.get();
+					const auto translationError = this->parameters.noise.initialTranslation.get();
+					for (size_t i = 1; i < initialSolution.objects.size(); i++) {
+						initialSolution.objects[i].rotation += randomVector(rotationError);
+						initialSolution.objects[i].translation += randomVector(translationError);
+					}
+					for (auto& view : initialSolution.views) {
+						view.rotation += randomVector(rotationError);
+						view.translation += randomVector(translationError);
+					}
+				}
+
+				auto solverSettings = Solvers::MarkerProjections::defaultSolverSettings();
+				solverSettings.printReport = false;
+
+				this->benchmark.measure("MarkerProjections", "MarkerMap", markerCount, trial, [&](Utils::SolverBenchmark::Record& record) {
+					auto result = Solvers::MarkerProjections::solve(cameraWidth
+						, cameraHeight
+						, cameraProjectionMatrix
+						, objectPoints
+						, images
+						, { 0 }
+						, initialSolution
+						, solverSettings);
+
+					record.converged = result.isConverged();
+
+					// Mean reprojection error [px]
+					for (auto reprojectionError : result.solution.reprojectionErrorPerImage) {
+						record.residual += reprojectionError;
+					}
+					if (!images.empty()) {
+						record.residual /= (float)images.size();
+					}
+
+					// Mean marker position error [m]
+					for (size_t i = 1; i < markerCount; i++) {
+						record.parameterError += glm::distance(result.solution.objects[i].translation
+							, groundTruth.objects[i].translation);
+					}
+					record.parameterError /= (float)(markerCount - 1);
+					});
+			}
+		}
+	}
+}
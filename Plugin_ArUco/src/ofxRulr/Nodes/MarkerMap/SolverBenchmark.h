@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Constants_Plugin_ArUco.h"
+#include "ofxRulr/Nodes/Base.h"
+#include "ofxRulr/Nodes/Test/AbstractSolverBenchmark.h"
+#include "ofxRulr/Solvers/MarkerProjections.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace MarkerMap {
+			// Runs MarkerProjections on a synthetic marker map (markers and camera views with known poses)
+			// and records time and error against the known marker positions
+			class PLUGIN_ARUCO_EXPORTS SolverBenchmark : public Test::AbstractSolverBenchmark {
+			public:
+				SolverBenchmark();
+				string getTypeName() const override;
+				void init();
+			protected:
+				void runTrial(size_t trial) override;
+
+				struct : ofParameterGroup {
+					struct : ofParameterGroup {
+						ofParameter<int> count{ "Count", 20 };
+						ofParameter<float> size{ "Size", 0.1, 0.01, 1 };
+						ofParameter<float> spread{ "Spread", 0.5, 0, 5 };
+						PARAM_DECLARE("Markers", count, size, spread);
+					} markers;
+
+					struct : ofParameterGroup {
+						ofParameter<int> count{ "Count", 10 };
+						ofParameter<float> distance{ "Distance", 1.5, 0.1, 10 };
+						PARAM_DECLARE("Views", count, distance);
+					} views;
+
+					struct : ofParameterGroup {
+						ofParameter<float> imageNoise{ "Image noise [px]", 0.2, 0, 10 };
+						ofParameter<float> initialRotation{ "Initial rotation error", 0.05, 0, 1 };
+						ofParameter<float> initialTranslation{ "Initial translation error", 0.05, 0, 1 };
+						PARAM_DECLARE("Noise", imageNoise, initialRotation, initialTranslation);
+					} noise;
+
+					PARAM_DECLARE("SolverBenchmark", markers, views, noise);
+				} parameters;
+			};
+		}
+	}
+}
\ No newline at end of file
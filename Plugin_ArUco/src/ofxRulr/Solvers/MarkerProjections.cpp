@@ -1,6 +1,7 @@
 #include "pch_Plugin_ArUco.h"
 #include "MarkerProjections.h"
 #include <glm/gtx/matrix_decompose.hpp>
+#include "ofxRulr/Utils/SolveCeres.h"
 
 using namespace ofxCeres::VectorMath;
 
@@ -252,9 +253,11 @@ namespace ofxRulr {
 
 			// Solve the fit
 			ceres::Solver::Summary summary;
-			ceres::Solve(solverSettings.options
+			Utils::solveCeres("MarkerProjections"
+				, solverSettings.options
 				, &problem
-				, &summary);
+				, &summary
+				, true); // views or objects can be eliminated (Schur)
 
 			if (solverSettings.printReport) {
 				std::cout << summary.FullReport() << "\n";
@@ -21,4 +21,5 @@
 #include "ofxRulr/Nodes/MarkerMap/Calibrate.h"
 #include "ofxRulr/Nodes/MarkerMap/NavigateCamera.h"
 #include "ofxRulr/Nodes/MarkerMap/Transform.h"
+#include "ofxRulr/Nodes/MarkerMap/SolverBenchmark.h"
 
@@ -17,6 +17,7 @@ OFXPLUGIN_PLUGIN_MODULES_BEGIN(ofxRulr::Nodes::Base)
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::MarkerMap::Calibrate);
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::MarkerMap::NavigateCamera);
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::MarkerMap::Transform);
+	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::MarkerMap::SolverBenchmark);
 
 }
 OFXPLUGIN_PLUGIN_MODULES_END
\ No newline at end of file
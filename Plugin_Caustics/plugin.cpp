@@ -3,11 +3,13 @@
 #include "ofxRulr/Nodes/Caustics/Target.h"
 #include "ofxRulr/Nodes/Caustics/SimpleSurface.h"
 #include "ofxRulr/Nodes/Caustics/BlockSolver.h"
+#include "ofxRulr/Nodes/Caustics/SolverBenchmark.h"
 
 OFXPLUGIN_PLUGIN_MODULES_BEGIN(ofxRulr::Nodes::Base)
 {
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::Caustics::Target);
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::Caustics::SimpleSurface);
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::Caustics::BlockSolver);
+	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::Caustics::SolverBenchmark);
 }
 OFXPLUGIN_PLUGIN_MODULES_END
\ No newline at end of file
@@ -26,27 +26,65 @@ namespace ofxRulr {
 			}
 		};
 
+		// Positions are stored flat in row-major order (index = i + j * cols) so that
+		// solvers can walk the grid (and map it onto Ceres parameter arrays) without
+		// chasing a pointer per row
 		template<typename T, typename PositionType>
 		struct DistortedGrid_ {
-			std::vector<std::vector<PositionType>> positions;
+			std::vector<PositionType> positions;
+			size_t width = 0;
+			size_t height = 0;
 
 			template<typename T2, typename PositionType2>
 			DistortedGrid_<T2, typename PositionType2> castTo() const
 			{
 				DistortedGrid_<T2, typename PositionType2> newDistortedGrid;
+				this->castInto(newDistortedGrid);
+				return newDistortedGrid;
+			}
 
-				for (const auto& row : this->positions) {
-					// Add a new row
-					newDistortedGrid.positions.resize(newDistortedGrid.positions.size() + 1);
-					auto& newRow = newDistortedGrid.positions.back();
+			// Cast into an existing grid (re-uses its allocation when the size matches)
+			template<typename T2, typename PositionType2>
+			void castInto(DistortedGrid_<T2, typename PositionType2>& newDistortedGrid) const
+			{
+				newDistortedGrid.resize(this->width, this->height);
 
-					for (const auto& position : row) {
-						const auto newPosition = position.castTo<T2>();
-						newRow.push_back(newPosition);
-					}
+				auto newPosition = newDistortedGrid.positions.begin();
+				for (const auto& position : this->positions) {
+					*newPosition++ = position.castTo<T2>();
 				}
+			}
 
-				return newDistortedGrid;
+			void
+				resize(size_t width, size_t height)
+			{
+				this->width = width;
+				this->height = height;
+				this->positions.resize(width * height);
+			}
+
+			void
+				clear()
+			{
+				this->resize(0, 0);
+			}
+
+			bool
+				empty() const
+			{
+				return this->positions.empty();
+			}
+
+			size_t
+				size() const
+			{
+				return this->positions.size();
+			}
+
+			size_t
+				indexOf(size_t i, size_t j) const
+			{
+				return i + j * this->width;
 			}
 
 			void
@@ -56,21 +94,19 @@ namespace ofxRulr {
 					throw(ofxCeres::Exception("Minimum DistortedGrid size is 2x2"));
 				}
 
-				this->positions.clear();
+				this->resize(size, size);
 
+				auto position = this->positions.begin();
 				for (size_t j = 0; j < size; j++) {
-					std::vector<PositionType> rowOfPositions;
 					for (size_t i = 0; i < size; i++) {
-						PositionType position;
-						position.initialPosition = glm::tvec3<T>(
+						position->initialPosition = glm::tvec3<T>(
 							scale * ((T)i / (T)(size - 1) - (T) 0.5)
 							, scale * ((T)j / (T)(size - 1) - (T) 0.5)
 							, (T)0
 							);
-						position.currentPosition = position.initialPosition;
-						rowOfPositions.push_back(position);
+						position->currentPosition = position->initialPosition;
+						position++;
 					}
-					this->positions.push_back(rowOfPositions);
 				}
 
 				this->calculateDirectionVectors();
@@ -79,19 +115,12 @@ namespace ofxRulr {
 			void
 				initFromPreviousGrid(const DistortedGrid_<T, PositionType>& previousGrid)
 			{
-				this->positions.clear();
-
-				for (size_t j = 0; j < previousGrid.positions.size(); j++) {
-					const auto& previousRow = previousGrid.positions[j];
-					this->positions.push_back(std::vector<SurfacePosition>());
-					auto& newRow = this->positions.back();
-
-					for (size_t i = 0; i < previousRow.size() i++) {
-						auto position = make_shared<PositionType>();
-						position->initialPosition = previousRow[i].currentPosition;
-						position->currentPosition = position.initialPosition;
-						newRow.push_back(position);
-					}
+				this->resize(previousGrid.width, previousGrid.height);
+
+				for (size_t index = 0; index < this->positions.size(); index++) {
+					auto& position = this->positions[index];
+					position.initialPosition = previousGrid.positions[index].currentPosition;
+					position.currentPosition = position.initialPosition;
 				}
 
 				this->calculateDirectionVectors();
@@ -100,29 +129,29 @@ namespace ofxRulr {
 			void
 				calculateDirectionVectors()
 			{
-				for (size_t j = 0; j < this->positions.size(); j++) {
-					auto& row = this->positions[j];
-					for (size_t i = 0; i < row.size(); i++) {
-						auto& position = row[i];
+				const auto rows = this->rows();
+				const auto cols = this->cols();
 
-						const auto& thisPos = row[i].initialPosition;
+				for (size_t j = 0; j < rows; j++) {
+					for (size_t i = 0; i < cols; i++) {
+						auto& position = this->at(i, j);
 
 						// right vector
-						if (i == 0 || i == row.size() - 1) {
+						if (i == 0 || i == cols - 1) {
 							position.rightVector = glm::tvec3<T>(0.0);
 						}
 						else {
-							const auto& leftPos = row[i - 1].initialPosition;
-							const auto& rightPos = row[i + 1].initialPosition;
+							const auto& leftPos = this->at(i - 1, j).initialPosition;
+							const auto& rightPos = this->at(i + 1, j).initialPosition;
 							position.rightVector = (rightPos - leftPos) / (T)2;
 						}
 
 						// down vector
-						if (j == 0 || j == this->positions.size() - 1) {
-							position.downVector = glm::tvec3<T>(0.0); ;
+						if (j == 0 || j == rows - 1) {
+							position.downVector = glm::tvec3<T>(0.0);
 						}
 						else {
-							position.downVector = (this->positions[j + 1][i].initialPosition - this->positions[j - 1][i].initialPosition) / (T)2;
+							position.downVector = (this->at(i, j + 1).initialPosition - this->at(i, j - 1).initialPosition) / (T)2;
 						}
 					}
 				}
@@ -132,56 +161,40 @@ namespace ofxRulr {
 				fromParameters(const T* parameters)
 			{
 				auto movingParameters = parameters;
-
-				for (size_t j = 0; j < this->positions.size(); j++) {
-					auto& row = this->positions[j];
-					for (size_t i = 0; i < row.size(); i++) {
-						auto& position = row[i];
-						position.setParameters(movingParameters);
-						movingParameters += 2;
-					}
+				for (auto& position : this->positions) {
+					position.setParameters(movingParameters);
+					movingParameters += 2;
 				}
 			}
 
 			size_t
 				getParameterCount() const
 			{
-				size_t count = 0;
-				for (const auto& row : this->positions) {
-					for (const auto& point : row) {
-						count += 2;
-					}
-				}
-				return count;
+				return this->positions.size() * 2;
 			}
 
 			const PositionType &
 				at(size_t i, size_t j) const
 			{
-				return this->positions[j][i];
+				return this->positions[i + j * this->width];
 			}
 
 			PositionType&
 				at(size_t i, size_t j)
 			{
-				return this->positions[j][i];
+				return this->positions[i + j * this->width];
 			}
 
 			size_t
 				cols() const
 			{
-				if (this->rows() == 0) {
-					return 0;
-				}
-				else {
-					return this->positions.front().size();
-				}
+				return this->width;
 			}
 
 			size_t
 				rows() const
 			{
-				return this->positions.size();
+				return this->height;
 			}
 
 			bool
@@ -239,17 +252,11 @@ namespace ofxRulr {
 
 				auto& jsonPositions = json["positions"];
 
-				this->positions.clear();
+				this->resize(cols, rows);
 				for (size_t j = 0; j < rows; j++) {
-					this->positions.push_back(vector<PositionType>());
-					auto& row = this->positions.back();
-
 					const auto& jsonRow = jsonPositions[j];
 					for (size_t i = 0; i < cols; i++) {
-						const auto& jsonPosition = jsonRow[i];
-						PositionType position;
-						position.deserialize(jsonPosition);
-						row.push_back(position);
+						this->at(i, j).deserialize(jsonRow[i]);
 					}
 				}
 			}
@@ -314,14 +321,11 @@ namespace ofxRulr {
 				getSubSection(size_t i_start, size_t j_start, size_t width, size_t height) const
 			{
 				DistortedGrid_<T, PositionType> newGrid;
+				newGrid.resize(width, height);
 
 				for (size_t _j = 0; _j < height; _j++) {
-					newGrid.positions.push_back(vector<PositionType>());
-					auto& newRow = newGrid.positions.back();
-
-					for (size_t _i = 0; _i < width; _i++) {
-						newRow.push_back(this->at(_i + i_start, _j + j_start));
-					}
+					const auto rowStart = this->positions.begin() + this->indexOf(i_start, _j + j_start);
+					std::copy(rowStart, rowStart + width, newGrid.positions.begin() + newGrid.indexOf(0, _j));
 				}
 				return newGrid;
 			}
@@ -330,9 +334,8 @@ namespace ofxRulr {
 				setSubSection(size_t i_start, size_t j_start, const DistortedGrid_<T, PositionType>& subGrid)
 			{
 				for (size_t _j = 0; _j < subGrid.rows(); _j++) {
-					for (size_t _i = 0; _i < subGrid.cols(); _i++) {
-						this->at(_i + i_start, _j + j_start) = subGrid.at(_i, _j);
-					}
+					const auto rowStart = subGrid.positions.begin() + subGrid.indexOf(0, _j);
+					std::copy(rowStart, rowStart + subGrid.cols(), this->positions.begin() + this->indexOf(i_start, _j + j_start));
 				}
 			}
 		};
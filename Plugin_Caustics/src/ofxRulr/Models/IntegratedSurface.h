@@ -33,19 +33,15 @@ namespace ofxRulr {
 
 			size_t getResidualCount() const
 			{
-				size_t count = 0;
-				for (size_t j = 1; j < this->distortedGrid.positions.size(); j++) {
-					const auto& row = this->distortedGrid.positions[j];
-					for (size_t i = 1; i < row.size(); i++) {
-						count++;
-					}
+				if (this->distortedGrid.empty()) {
+					return 0;
 				}
-				return count;
+				return (this->distortedGrid.rows() - 1) * (this->distortedGrid.cols() - 1);
 			}
 
 			void integrateHeights(T* residuals = nullptr, glm::tvec3<T>* residualPositions = nullptr)
 			{
-				if (this->distortedGrid.positions.empty()) {
+				if (this->distortedGrid.empty()) {
 					throw(ofxCeres::Exception("Grid is empty"));
 				}
 
@@ -53,10 +49,9 @@ namespace ofxRulr {
 
 				// First go along bottom row
 				//{
-				//	auto& row = this->distortedGrid.positions.front();
-				//	for (size_t i = 1; i < row.size(); i++) {
-				//		auto& position = row[i];
-				//		const auto& leftPosition = row[i - 1];
+				//	for (size_t i = 1; i < this->distortedGrid.cols(); i++) {
+				//		auto& position = this->distortedGrid.at(i, 0);
+				//		const auto& leftPosition = this->distortedGrid.at(i - 1, 0);
 
 				//		const auto heightFromX = getHeightAt2(leftPosition.currentPosition.x
 				//			, position.currentPosition.x
@@ -70,7 +65,7 @@ namespace ofxRulr {
 
 				// Then go along left edge
 				{
-					for (size_t j = 1; j < this->distortedGrid.positions.size(); j++) {
+					for (size_t j = 1; j < this->distortedGrid.rows(); j++) {
 						const auto& downPosition = this->distortedGrid.at(0, j - 1);
 						auto& position = this->distortedGrid.at(0, j);
 
@@ -85,9 +80,8 @@ namespace ofxRulr {
 				}
 
 				// Then do other rows
-				for (size_t j = 1; j < this->distortedGrid.positions.size(); j++) {
-					auto& row = this->distortedGrid.positions[j];
-					for (size_t i = 1; i < row.size(); i++) {
+				for (size_t j = 1; j < this->distortedGrid.rows(); j++) {
+					for (size_t i = 1; i < this->distortedGrid.cols(); i++) {
 						auto& position = this->distortedGrid.at(i, j);
 						const auto& leftPosition = this->distortedGrid.at(i - 1, j);
 						const auto& downPosition = this->distortedGrid.at(i, j - 1);
@@ -35,6 +35,28 @@ namespace ofxRulr {
 				return parameters;
 			}
 
+			void applyHeights(DistortedGrid_<double, SurfacePosition_<double>>& grid
+				, const vector<double>& heights) const
+			{
+				auto heightMover = heights.begin();
+				for (size_t j = this->j_start; j < this->j_end(); j++) {
+					for (size_t i = this->i_start; i < this->i_end(); i++) {
+						grid.at(i, j).currentPosition.z = *heightMover++;
+					}
+				}
+			}
+
+			void applyHeights(DistortedGrid_<float, SurfacePosition_<float>>& grid
+				, const vector<double>& heights) const
+			{
+				auto heightMover = heights.begin();
+				for (size_t j = this->j_start; j < this->j_end(); j++) {
+					for (size_t i = this->i_start; i < this->i_end(); i++) {
+						grid.at(i, j).currentPosition.z = (float) *heightMover++;
+					}
+				}
+			}
+
 			void applyParameters(DistortedGrid_<double, SurfacePosition_<double>>& grid
 				, vector<double*> heightParameters) const
 			{
@@ -94,63 +116,44 @@ namespace ofxRulr {
 
 			size_t getParameterCount() const
 			{
-				bool firstVertex = true;
-				size_t count = 0;
-				for (auto& row : this->distortedGrid.positions) {
-					for (auto& position : row) {
-						if (firstVertex) {
-							firstVertex = false;
-						}
-						else {
-							count++;
-						}
-					}
-				}
-				return count;
+				// First vertex is fixed
+				return this->distortedGrid.empty()
+					? 0
+					: this->distortedGrid.size() - 1;
 			}
 
 			void fromParameters(const T* const heightMap)
 			{
-				bool firstVertex = true;
+				if (this->distortedGrid.empty()) {
+					return;
+				}
+
+				// To clamp the surface we need to fix at least one vertex
+				auto position = this->distortedGrid.positions.begin();
+				position->currentPosition.z = (T)0;
+
 				auto heightMapMover = heightMap;
-				for (auto& row : this->distortedGrid.positions) {
-					for (auto& position : row) {
-						if (firstVertex) {
-							// To clamp the surface we need to fix at least one vertex
-							position.currentPosition.z = (T)0;
-							firstVertex = false;
-						}
-						else {
-							position.currentPosition.z = *heightMapMover++;
-						}
-					}
+				for (position++; position != this->distortedGrid.positions.end(); position++) {
+					position->currentPosition.z = *heightMapMover++;
 				}
 			}
 
 			void toParameters(T* heightMap) const
 			{
-				const auto rows = this->distortedGrid.rows();
-				const auto cols = this->distortedGrid.cols();
-				for (size_t j = 0; j < rows; j++) {
-					for (size_t i = 0; i < cols; i++) {
-						if (i == 0 && j == 0) {
-							// first vertex is always zero
-							continue;
-						}
-						*heightMap++ = this->distortedGrid.at(i, j).currentPosition.z;
-					}
+				if (this->distortedGrid.empty()) {
+					return;
+				}
+
+				// first vertex is always zero
+				auto position = this->distortedGrid.positions.begin();
+				for (position++; position != this->distortedGrid.positions.end(); position++) {
+					*heightMap++ = position->currentPosition.z;
 				}
 			}
 
 			size_t getResidualCount() const
 			{
-				size_t count = 0;
-				for (auto& row : this->distortedGrid.positions) {
-					for (auto& position : row) {
-						count += 3;
-					}
-				}
-				return count;
+				return this->distortedGrid.size() * 3;
 			}
 
 			void getResiduals(T* residuals) const
@@ -167,72 +170,41 @@ namespace ofxRulr {
 				}
 			}
 
-			glm::tvec3<T>
-				estimateNormal(size_t i, size_t j) const
+			//----------
+			// As getResiduals but reading heights directly from the parameter array (see toParameters)
+			// so that cost functions don't need to cast a copy of the grid for each evaluation
+			template<typename T2>
+			void getResidualsFromParameters(const T2* const heights, T2* residuals) const
 			{
-				T totalWeight = (T)0;
-				glm::tvec3<T> accumulateNormal{ 0, 0, 0 };
-
-				const auto& center = this->distortedGrid.at(i, j);
-
-				if (j > 0) {
-					const auto& down = this->distortedGrid.at(i, j - 1);
-					const auto to_down = down.currentPosition - center.currentPosition;
-
-					if (i > 0) {
-						const auto& left = this->distortedGrid.at(i - 1, j);
-
-						const auto to_left = left.currentPosition - center.currentPosition;
-
-						const auto normal = VM::normalize(VM::cross(to_left, to_down));
-
-						const auto weight = acos(VM::dot(to_left, to_down));
-
-						accumulateNormal += weight * normal;
-						totalWeight += weight;
-					}
-
-					if (i < this->distortedGrid.cols() - 1) {
-						const auto& right = this->distortedGrid.at(i + 1, j);
-						const auto to_right = right.currentPosition - center.currentPosition;
-
-						const auto normal = VM::normalize(VM::cross(to_down, to_right));
-						const auto weight = acos(VM::dot(to_right, to_down));
-
-						accumulateNormal += weight * normal;
-						totalWeight += weight;
-					}
-				}
-				if (j < this->distortedGrid.rows() - 1) {
-					const auto& up = this->distortedGrid.at(i, j + 1);
-					const auto to_up = up.currentPosition - center.currentPosition;
-
-					if (i > 0) {
-						const auto& left = this->distortedGrid.at(i - 1, j);
-
-						const auto to_left = left.currentPosition - center.currentPosition;
-
-						const auto normal = VM::normalize(VM::cross(to_up, to_left));
-
-						const auto weight = acos(VM::dot(to_left, to_up));
-
-						accumulateNormal += weight * normal;
-						totalWeight += weight;
-					}
-
-					if (i < this->distortedGrid.cols() - 1) {
-						const auto& right = this->distortedGrid.at(i + 1, j);
-						const auto to_right = right.currentPosition - center.currentPosition;
+				const auto cols = this->distortedGrid.cols();
 
-						const auto normal = VM::normalize(VM::cross(to_right, to_up));
-						const auto weight = acos(VM::dot(to_right, to_up));
+				auto getVertex = [&](size_t i, size_t j) {
+					auto vertex = (glm::tvec3<T2>) this->distortedGrid.at(i, j).currentPosition;
+					vertex.z = (i == 0 && j == 0)
+						? (T2)0
+						: heights[(i + j * cols) - 1];
+					return vertex;
+				};
 
-						accumulateNormal += weight * normal;
-						totalWeight += weight;
+				for (size_t j = 0; j < this->distortedGrid.rows(); j++) {
+					for (size_t i = 0; i < cols; i++) {
+						auto estimatedNormal = this->estimateNormalFromVertices<T2>(getVertex, i, j);
+						auto normal = (glm::tvec3<T2>) this->distortedGrid.at(i, j).normal;
+						auto delta = estimatedNormal - normal;
+						*residuals++ = delta[0];
+						*residuals++ = delta[1];
+						*residuals++ = delta[2];
 					}
 				}
+			}
 
-				return accumulateNormal / totalWeight;
+			glm::tvec3<T>
+				estimateNormal(size_t i, size_t j) const
+			{
+				auto getVertex = [&](size_t i, size_t j) {
+					return this->distortedGrid.at(i, j).currentPosition;
+				};
+				return this->estimateNormalFromVertices<T>(getVertex, i, j);
 			}
 
 			template<typename T2>
@@ -242,9 +214,6 @@ namespace ofxRulr {
 					, size_t j
 					, size_t cols) const
 			{
-				auto totalWeight = (T2)0;
-				glm::tvec3<T2> accumulateNormal{ 0, 0, 0 };
-
 				auto getVertex = [&](size_t i, size_t j) {
 					auto vertex = (glm::tvec3<T2>) this->distortedGrid.at(i, j).initialPosition;
 					if (i != 0 || j != 0) {
@@ -252,67 +221,7 @@ namespace ofxRulr {
 					}
 					return vertex;
 				};
-
-				const auto center = getVertex(i, j);
-
-				if (j > 0) {
-					const auto down = getVertex(i, j - 1);
-					const auto to_down = down - center;
-
-					if (i > 0) {
-						const auto left = getVertex(i - 1, j);
-
-						const auto to_left = left - center;
-
-						const auto normal = VM::normalize(VM::cross(to_left, to_down));
-
-						const auto weight = acos(VM::dot(to_left, to_down));
-
-						accumulateNormal += weight * normal;
-						totalWeight += weight;
-					}
-
-					if (i < this->distortedGrid.cols() - 1) {
-						const auto right = getVertex(i + 1, j);
-						const auto to_right = right - center;
-
-						const auto normal = VM::normalize(VM::cross(to_down, to_right));
-						const auto weight = acos(VM::dot(to_right, to_down));
-
-						accumulateNormal += weight * normal;
-						totalWeight += weight;
-					}
-				}
-				if (j < this->distortedGrid.rows() - 1) {
-					const auto up = getVertex(i, j + 1);
-					const auto to_up = up - center;
-
-					if (i > 0) {
-						const auto left = getVertex(i - 1, j);
-
-						const auto to_left = left - center;
-
-						const auto normal = VM::normalize(VM::cross(to_up, to_left));
-
-						const auto weight = acos(VM::dot(to_left, to_up));
-
-						accumulateNormal += weight * normal;
-						totalWeight += weight;
-					}
-
-					if (i < this->distortedGrid.cols() - 1) {
-						const auto& right = getVertex(i + 1, j);
-						const auto to_right = right - center;
-
-						const auto normal = VM::normalize(VM::cross(to_right, to_up));
-						const auto weight = acos(VM::dot(to_right, to_up));
-
-						accumulateNormal += weight * normal;
-						totalWeight += weight;
-					}
-				}
-
-				return accumulateNormal / totalWeight;
+				return this->estimateNormalFromVertices<T2>(getVertex, i, j);
 			}
 
 			//----------
@@ -323,23 +232,34 @@ namespace ofxRulr {
 					, size_t i
 					, size_t j) const
 			{
-				auto totalWeight = (T2)0;
-				glm::tvec3<T2> accumulateNormal{ 0, 0, 0 };
-
 				auto getVertex = [&](size_t i, size_t j) {
 					auto vertex = (glm::tvec3<T2>) this->distortedGrid.at(i, j).initialPosition;
 					vertex.z = heightSectionParameters.getHeight(i, j);
 					return vertex;
 				};
+				return this->estimateNormalFromVertices<T2>(getVertex, i, j);
+			}
+
+			//----------
+			// Angle-weighted mean of the normals of the faces around vertex (i, j)
+			// getVertex(i, j) returns the position of a vertex as glm::tvec3<T2>
+			template<typename T2, typename GetVertex>
+			glm::tvec3<T2>
+				estimateNormalFromVertices(const GetVertex& getVertex
+					, size_t i
+					, size_t j) const
+			{
+				auto totalWeight = (T2)0;
+				glm::tvec3<T2> accumulateNormal{ 0, 0, 0 };
 
-				const auto center = getVertex(i, j);
+				const glm::tvec3<T2> center = getVertex(i, j);
 
 				if (j > 0) {
-					const auto down = getVertex(i, j - 1);
+					const glm::tvec3<T2> down = getVertex(i, j - 1);
 					const auto to_down = down - center;
 
 					if (i > 0) {
-						const auto left = getVertex(i - 1, j);
+						const glm::tvec3<T2> left = getVertex(i - 1, j);
 
 						const auto to_left = left - center;
 
@@ -352,7 +272,7 @@ namespace ofxRulr {
 					}
 
 					if (i < this->distortedGrid.cols() - 1) {
-						const auto right = getVertex(i + 1, j);
+						const glm::tvec3<T2> right = getVertex(i + 1, j);
 						const auto to_right = right - center;
 
 						const auto normal = VM::normalize(VM::cross(to_down, to_right));
@@ -363,11 +283,11 @@ namespace ofxRulr {
 					}
 				}
 				if (j < this->distortedGrid.rows() - 1) {
-					const auto up = getVertex(i, j + 1);
+					const glm::tvec3<T2> up = getVertex(i, j + 1);
 					const auto to_up = up - center;
 
 					if (i > 0) {
-						const auto left = getVertex(i - 1, j);
+						const glm::tvec3<T2> left = getVertex(i - 1, j);
 
 						const auto to_left = left - center;
 
@@ -380,7 +300,7 @@ namespace ofxRulr {
 					}
 
 					if (i < this->distortedGrid.cols() - 1) {
-						const auto& right = getVertex(i + 1, j);
+						const glm::tvec3<T2> right = getVertex(i + 1, j);
 						const auto to_right = right - center;
 
 						const auto normal = VM::normalize(VM::cross(to_right, to_up));
@@ -412,7 +332,7 @@ namespace ofxRulr {
 				const auto rows = (int) this->distortedGrid.rows();
 				const auto cols = (int) this->distortedGrid.cols();
 
-				auto getPosition = [&](int i, int j) {
+				auto getPosition = [&](int i, int j) -> const SurfacePosition_<T>& {
 					// With Neumann Boundary we use negative indices also
 					if (i < 0) {
 						i = -i;
@@ -431,7 +351,7 @@ namespace ofxRulr {
 					return this->distortedGrid.at(i, j);
 				};
 
-				auto getPositionSimple = [&](int i, int j) {
+				auto getPositionSimple = [&](int i, int j) -> const SurfacePosition_<T>& {
 					return this->distortedGrid.at(i, j);
 				};
 
@@ -51,6 +51,16 @@ namespace ofxRulr {
 			{
 				auto inspector = args.inspector;
 
+				inspector->addLiveValueHistory("Residual RMS", [this]() {
+					return this->residualRMS;
+					});
+				inspector->addLiveValueHistory("Solve time [ms]", [this]() {
+					return this->solveDuration;
+					});
+				inspector->addLiveValue<size_t>("Tiles solved", [this]() {
+					return this->tilesSolved;
+					});
+
 				inspector->addButton("Solve", [this]() {
 					try {
 						this->solve();
@@ -64,6 +74,8 @@ namespace ofxRulr {
 					}
 					RULR_CATCH_ALL_TO_ALERT;
 					});
+
+				Utils::SolverRuntime::addToInspector(inspector);
 			}
 
 			//----------
@@ -83,6 +95,35 @@ namespace ofxRulr {
 				BlockSolver::solve()
 			{
 				this->throwIfMissingAnyConnection();
+
+				auto startTime = chrono::high_resolution_clock::now();
+				switch (this->parameters.mode.get()) {
+				case BlockSolveMode::Section:
+					this->solveSection();
+					break;
+				case BlockSolveMode::Tiles:
+					this->solveTiles();
+					break;
+				default:
+					break;
+				}
+				this->solveDuration = (float) chrono::duration_cast<chrono::microseconds>(chrono::high_resolution_clock::now() - startTime).count() / 1000.0f;
+
+				this->updateResidual();
+			}
+
+			//----------
+			void
+				BlockSolver::reset()
+			{
+				this->parameters.sectionSolve.i.set(0);
+				this->parameters.sectionSolve.j.set(0);
+			}
+
+			//----------
+			void
+				BlockSolver::solveSection()
+			{
 				auto simpleSurface = this->getInput<SimpleSurface>();
 
 				auto i_start = this->parameters.sectionSolve.i.get();
@@ -137,10 +178,149 @@ namespace ofxRulr {
 
 			//----------
 			void
-				BlockSolver::reset()
+				BlockSolver::solveTiles()
 			{
-				this->parameters.sectionSolve.i.set(0);
-				this->parameters.sectionSolve.j.set(0);
+				auto simpleSurface = this->getInput<SimpleSurface>();
+				auto& surface = simpleSurface->getSurface();
+				if (surface.distortedGrid.empty()) {
+					throw(Exception("Surface is empty"));
+				}
+
+				const auto cols = surface.distortedGrid.cols();
+				const auto rows = surface.distortedGrid.rows();
+				const auto tileSize = this->parameters.tiledSolve.tileSize.get();
+				const auto halo = this->parameters.tiledSolve.halo.get();
+				if (tileSize < 2) {
+					throw(Exception("Tile size must be at least 2"));
+				}
+
+				// Build the tiles. Each tile has a core (which it owns) and a window (core + halo) which it solves
+				struct Tile {
+					Models::SurfaceSectionSettings core;
+					Models::SurfaceSectionSettings window;
+				};
+
+				// The windows of tiles with the same colour must not overlap, so that no tile solves heights which
+				// another tile of its colour owns or is solving at the same time.
+				// Red-black : diagonal neighbours share a colour, so their windows only stay apart without a halo.
+				// Four colour : tiles of a colour are `stride` tiles apart. Their windows stay apart whilst
+				// 2 * halo <= (stride - 1) * tileSize, so the stride grows beyond 2 (stride^2 colours) for large halos.
+				const auto redBlack = this->parameters.tiledSolve.colouring.get() == TileColouring::RedBlack;
+				if (redBlack && halo > 0) {
+					throw(Exception("Red-black tiles need a halo of 0 (the windows of diagonal tiles overlap). Use four colour"));
+				}
+				const size_t stride = max((size_t) 2, 1 + (2 * halo + tileSize - 1) / tileSize);
+				const auto colourCount = redBlack ? 2 : stride * stride;
+				vector<vector<Tile>> tilesByColour(colourCount);
+				{
+					const auto tileCols = (cols + tileSize - 1) / tileSize;
+					const auto tileRows = (rows + tileSize - 1) / tileSize;
+					for (size_t tj = 0; tj < tileRows; tj++) {
+						for (size_t ti = 0; ti < tileCols; ti++) {
+							Tile tile;
+							tile.core.i_start = ti * tileSize;
+							tile.core.j_start = tj * tileSize;
+							tile.core.width = min(tileSize, cols - tile.core.i_start);
+							tile.core.height = min(tileSize, rows - tile.core.j_start);
+
+							tile.window.i_start = tile.core.i_start > halo ? tile.core.i_start - halo : 0;
+							tile.window.j_start = tile.core.j_start > halo ? tile.core.j_start - halo : 0;
+							tile.window.width = min(tile.core.i_end() + halo, cols) - tile.window.i_start;
+							tile.window.height = min(tile.core.j_end() + halo, rows) - tile.window.j_start;
+
+							auto colour = redBlack
+								? (ti + tj) % 2
+								: (ti % stride) + stride * (tj % stride);
+							tilesByColour[colour].push_back(tile);
+						}
+					}
+				}
+
+				// Threads come from the shared solver budget (0 = as many as the budget allows)
+				auto threadLease = Utils::SolverRuntime::X().acquireThreads((size_t) max(this->parameters.tiledSolve.threads.get(), 0));
+				auto threadCount = threadLease->getThreadCount();
+
+				auto solverSettings = this->parameters.tiledSolve.solverSettings.getSolverSettings();
+				solverSettings.printReport = false;
+				solverSettings.options.minimizer_progress_to_stdout = false;
+				solverSettings.options.num_threads = 1;
+
+				this->tilesSolved = 0;
+
+				for (const auto& tiles : tilesByColour) {
+					if (tiles.empty()) {
+						continue;
+					}
+
+					// All tiles of this colour read from the same snapshot
+					const auto surfaceSnapshot = surface.castTo<double>();
+					vector<vector<double>> tileHeights(tiles.size());
+
+					atomic<size_t> tileIndex{ 0 };
+					vector<future<void>> workers;
+					for (size_t t = 0; t < min(threadCount, tiles.size()); t++) {
+						workers.push_back(std::async(std::launch::async, [&]() {
+							while (true) {
+								auto index = tileIndex++;
+								if (index >= tiles.size()) {
+									break;
+								}
+								auto result = Solvers::NormalsSurface::solveSectionHeights(surfaceSnapshot
+									, solverSettings
+									, tiles[index].window);
+								if (!result.isError) {
+									tileHeights[index] = move(result.solution.heights);
+								}
+							}
+						}));
+					}
+					for (auto& worker : workers) {
+						worker.get();
+					}
+
+					// Write back the cores (halo heights are discarded - the neighbouring tile owns them)
+					for (size_t t = 0; t < tiles.size(); t++) {
+						const auto& heights = tileHeights[t];
+						if (heights.empty()) {
+							continue;
+						}
+
+						const auto& core = tiles[t].core;
+						const auto& window = tiles[t].window;
+						for (size_t j = core.j_start; j < core.j_end(); j++) {
+							for (size_t i = core.i_start; i < core.i_end(); i++) {
+								auto windowIndex = (i - window.i_start) + (j - window.j_start) * window.width;
+								surface.distortedGrid.at(i, j).currentPosition.z = (float) heights[windowIndex];
+							}
+						}
+						this->tilesSolved++;
+					}
+				}
+
+				simpleSurface->updatePreview();
+			}
+
+			//----------
+			void
+				BlockSolver::updateResidual()
+			{
+				auto simpleSurface = this->getInput<SimpleSurface>();
+				if (!simpleSurface) {
+					return;
+				}
+				const auto& surface = simpleSurface->getSurface();
+				if (surface.distortedGrid.empty()) {
+					return;
+				}
+
+				vector<float> residuals(surface.getResidualCount());
+				surface.getResiduals(residuals.data());
+
+				double sumSquared = 0.0;
+				for (const auto& residual : residuals) {
+					sumSquared += residual * residual;
+				}
+				this->residualRMS = (float) sqrt(sumSquared / (double) residuals.size());
 			}
 		}
 	}
@@ -11,6 +11,14 @@
 namespace ofxRulr {
 	namespace Nodes {
 		namespace Caustics {
+			MAKE_ENUM(BlockSolveMode
+				, (Section, Tiles)
+				, ("Section", "Tiles"));
+
+			MAKE_ENUM(TileColouring
+				, (RedBlack, FourColour)
+				, ("Red-black", "Four colour"));
+
 			class BlockSolver : public ofxRulr::Nodes::Base {
 			public:
 				BlockSolver();
@@ -25,6 +33,10 @@ namespace ofxRulr {
 				void solve();
 				void reset();
 			protected:
+				void solveSection();
+				void solveTiles();
+				void updateResidual();
+
 				struct : ofParameterGroup {
 					struct : ofParameterGroup {
 						ofxCeres::ParameterisedSolverSettings solverSettings{ Solvers::NormalsSurface::getDefaultSolverSettings() };
@@ -39,8 +51,26 @@ namespace ofxRulr {
 						ofParameter<int> iterations{ "Iterations", 1 };
 						PARAM_DECLARE("Section solve", solverSettings, i, j, width, height, continuously, once, move, healHeightAmplitude, iterations);
 					} sectionSolve;
-					PARAM_DECLARE("BlockSolver", sectionSolve);
+
+					// Tiles of the same colour are solved concurrently, then their heights are written back
+					// before the next colour is solved (so each tile sees the latest heights of its neighbours).
+					// Windows of the same colour never overlap (see solveTiles)
+					struct : ofParameterGroup {
+						ofxCeres::ParameterisedSolverSettings solverSettings{ Solvers::NormalsSurface::getDefaultSolverSettings() };
+						ofParameter<size_t> tileSize{ "Tile size", 16 };
+						ofParameter<size_t> halo{ "Halo", 2 };
+						ofParameter<TileColouring> colouring{ "Colouring", TileColouring::FourColour };
+						ofParameter<int> threads{ "Threads", 0 }; // 0 = thread budget
+						PARAM_DECLARE("Tiled solve", solverSettings, tileSize, halo, colouring, threads);
+					} tiledSolve;
+
+					ofParameter<BlockSolveMode> mode{ "Mode", BlockSolveMode::Section };
+					PARAM_DECLARE("BlockSolver", mode, sectionSolve, tiledSolve);
 				} parameters;
+
+				float residualRMS = 0.0f;
+				float solveDuration = 0.0f; // [ms]
+				size_t tilesSolved = 0;
 			};
 		}
 	}
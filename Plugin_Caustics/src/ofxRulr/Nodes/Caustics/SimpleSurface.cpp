@@ -33,6 +33,9 @@ namespace ofxRulr {
 
 				this->manageParameters(this->parameters);
 
+				// Height maps are the size of the surface, so they're only kept in memory (not saved with the node)
+				this->heightMapCache.setMaxSerializedSize(0);
+
 				this->addInput<Target>();
 
 				this->preview.lighting.left.setDirectional();
@@ -212,6 +215,13 @@ namespace ofxRulr {
 					RULR_CATCH_ALL_TO_ALERT;
 					}, '2');
 
+				inspector->addLiveValue<float>("Normal solve time [ms]", [this]() {
+					return this->normalSolveStatus.duration;
+					});
+				inspector->addLiveValue<float>("Normal validation max deviation [deg]", [this]() {
+					return this->normalSolveStatus.maxDeviation;
+					});
+
 				inspector->addButton("Solve height map", [this]() {
 					try {
 						this->solveHeightMap();
@@ -226,6 +236,15 @@ namespace ofxRulr {
 					RULR_CATCH_ALL_TO_ALERT;
 					}, '4');
 
+				inspector->addLiveValue<string>("Multigrid", [this]() {
+					return ofToString(this->multigridStatus.levels) + " levels, "
+						+ ofToString(this->multigridStatus.cycles) + " cycles, "
+						+ ofToString(this->multigridStatus.duration, 1) + "ms";
+					});
+				inspector->addLiveValue<float>("Multigrid residual", [this]() {
+					return this->multigridStatus.residual;
+					});
+
 				inspector->addButton("Combined solve step", [this]() {
 					try {
 						this->combinedSolveStepHeightMap();
@@ -283,6 +302,9 @@ namespace ofxRulr {
 					}
 					RULR_CATCH_ALL_TO_ALERT;
 					}, 'e');
+
+				this->heightMapCache.addToInspector(inspector);
+				Utils::SolverRuntime::addToInspector(inspector);
 			}
 
 			//----------
@@ -290,6 +312,7 @@ namespace ofxRulr {
 				SimpleSurface::serialize(nlohmann::json& json)
 			{
 				this->surface.serialize(json["surface"]);
+				this->heightMapCache.serialize(json["heightMapCache"]);
 			}
 
 			//----------
@@ -299,6 +322,9 @@ namespace ofxRulr {
 				if (json.contains("surface")) {
 					this->surface.deserialize(json["surface"]);
 				}
+				if (json.contains("heightMapCache")) {
+					this->heightMapCache.deserialize(json["heightMapCache"]);
+				}
 			}
 
 			//----------
@@ -331,10 +357,11 @@ namespace ofxRulr {
 				auto targetPoints = target->getTargetPointsForCurves(curves);
 
 				// All rows have same targets
-				for (auto& row : this->surface.distortedGrid.positions) {
+				for (size_t j = 0; j < this->surface.distortedGrid.rows(); j++) {
 					for (size_t i = 0; i < resolution; i++) {
-						row[i].target = targetPoints[i]; // HACK!
-						row[i].incoming = glm::vec3(0, 0, 1);
+						auto& position = this->surface.distortedGrid.at(i, j);
+						position.target = targetPoints[i]; // HACK!
+						position.incoming = glm::vec3(0, 0, 1);
 					}
 				}
 
@@ -345,11 +372,16 @@ namespace ofxRulr {
 			void
 				SimpleSurface::solveNormals()
 			{
-				for (auto& row : this->surface.distortedGrid.positions) {
-					for (auto& position : row) {
+				auto& positions = this->surface.distortedGrid.positions;
+				const auto exitIORvsIncidentIOR = 1.0f / this->parameters.optics.materialIOR.get();
+				const auto method = this->parameters.normalSolver.method.get();
+
+				auto startTime = chrono::high_resolution_clock::now();
+
+				if (method == NormalSolveMethod::Ceres) {
+					for (auto& position : positions) {
 						auto refracted = glm::normalize(position.target - position.currentPosition);
 						auto incident = position.incoming;
-						auto exitIORvsIncidentIOR = 1.0f / this->parameters.optics.materialIOR.get();
 						auto result = Solvers::Normal::solve(incident
 							, refracted
 							, exitIORvsIncidentIOR
@@ -357,6 +389,48 @@ namespace ofxRulr {
 						position.normal = result.solution;
 					}
 				}
+				else {
+					// Gather into the batch
+					Solvers::Normal::Batch batch;
+					batch.resize(positions.size());
+					for (size_t i = 0; i < positions.size(); i++) {
+						const auto& position = positions[i];
+						const auto refracted = position.target - position.currentPosition;
+						batch.incidentX[i] = position.incoming.x;
+						batch.incidentY[i] = position.incoming.y;
+						batch.incidentZ[i] = position.incoming.z;
+						batch.refractedX[i] = refracted.x;
+						batch.refractedY[i] = refracted.y;
+						batch.refractedZ[i] = refracted.z;
+					}
+
+					Solvers::Normal::solveBatch(batch, exitIORvsIncidentIOR);
+
+					// Compare against Ceres
+					if (method == NormalSolveMethod::Validate) {
+						float maxDeviation = 0.0f;
+						for (size_t i = 0; i < positions.size(); i++) {
+							const auto& position = positions[i];
+							auto result = Solvers::Normal::solve(position.incoming
+								, glm::normalize(position.target - position.currentPosition)
+								, exitIORvsIncidentIOR
+								, this->parameters.normalSolver.solverSettings.getSolverSettings());
+							const auto closedForm = glm::vec3(batch.normalX[i], batch.normalY[i], batch.normalZ[i]);
+							const auto deviation = (float) (acos(ofClamp(glm::dot(closedForm, result.solution), -1.0f, 1.0f)) * RAD_TO_DEG);
+							if (deviation > maxDeviation) {
+								maxDeviation = deviation;
+							}
+						}
+						this->normalSolveStatus.maxDeviation = maxDeviation;
+					}
+
+					// Scatter back
+					for (size_t i = 0; i < positions.size(); i++) {
+						positions[i].normal = glm::vec3(batch.normalX[i], batch.normalY[i], batch.normalZ[i]);
+					}
+				}
+
+				this->normalSolveStatus.duration = (float) chrono::duration_cast<chrono::microseconds>(chrono::high_resolution_clock::now() - startTime).count() / 1000.0f;
 
 				this->preview.dirty = true;
 			}
@@ -370,10 +444,8 @@ namespace ofxRulr {
 				surface.distortedGrid.calculateDirectionVectors();
 
 				// Bake existing transform
-				for (auto& row : surface.distortedGrid.positions) {
-					for (auto& position : row) {
-						position.initialPosition = position.currentPosition;
-					}
+				for (auto& position : surface.distortedGrid.positions) {
+					position.initialPosition = position.currentPosition;
 				}
 
 				auto result = Solvers::IntegratedSurface::solve(surface
@@ -387,24 +459,67 @@ namespace ofxRulr {
 			void
 				SimpleSurface::solveHeightMap()
 			{
+				auto& positions = this->surface.distortedGrid.positions;
+				auto solverSettings = this->parameters.surfaceSolver.solverSettings.getSolverSettings();
+
+				// The height map depends on the grid and the normals
+				Utils::SolverCache::Key cacheKey;
+				{
+					cacheKey.addStructure("NormalsSurface")
+						.addStructure(this->parameters.surfaceSolver.universalSolve.get())
+						.addStructure(solverSettings.options.max_num_iterations)
+						.add(solverSettings.options.function_tolerance)
+						.addStructure(this->surface.distortedGrid.cols())
+						.addStructure(this->surface.distortedGrid.rows());
+					for (const auto& position : positions) {
+						cacheKey.add((glm::vec2)position.currentPosition)
+							.add(position.normal);
+					}
+				}
+
+				auto cacheLookup = this->heightMapCache.find(cacheKey);
+				if (cacheLookup.solution.size() == positions.size()) {
+					for (size_t i = 0; i < positions.size(); i++) {
+						positions[i].currentPosition.z = (float)cacheLookup.solution[i];
+					}
+
+					// Identical normals : use the stored heights
+					if (cacheLookup.match == Utils::SolverCache::Match::Exact) {
+						this->preview.dirty = true;
+						return;
+					}
+
+					// Near-identical normals : start from the stored heights
+				}
+
 				auto surface = this->surface;
 
 				// Bake existing transform
-				for (auto& row : surface.distortedGrid.positions) {
-					for (auto& position : row) {
-						position.initialPosition = position.currentPosition;
-					}
+				for (auto& position : surface.distortedGrid.positions) {
+					position.initialPosition = position.currentPosition;
 				}
 
+				float residual = 0.0f;
 				if (this->parameters.surfaceSolver.universalSolve) {
 					auto result = Solvers::NormalsSurface::solveUniversal(surface
-						, this->parameters.surfaceSolver.solverSettings.getSolverSettings());
+						, solverSettings);
 					this->surface = result.solution.surface;
+					residual = (float)result.residual;
 				}
 				else {
 					auto result = Solvers::NormalsSurface::solveByIndividual(surface
-						, this->parameters.surfaceSolver.solverSettings.getSolverSettings());
+						, solverSettings);
 					this->surface = result.solution.surface;
+					residual = (float)result.residual;
+				}
+
+				{
+					vector<double> heights;
+					heights.reserve(this->surface.distortedGrid.positions.size());
+					for (const auto& position : this->surface.distortedGrid.positions) {
+						heights.push_back(position.currentPosition.z);
+					}
+					this->heightMapCache.store(cacheKey, heights, residual);
 				}
 				
 				this->preview.dirty = true;
@@ -414,8 +529,37 @@ namespace ofxRulr {
 			void
 				SimpleSurface::poissonStepHeightMap()
 			{
-				for (int i = 0; i < this->parameters.surfaceSolver.poissonSolver.iterations; i++) {
-					this->surface.poissonStep(this->parameters.surfaceSolver.poissonSolver.factor, false);
+				switch (this->parameters.surfaceSolver.poissonSolver.method.get()) {
+				case PoissonMethod::Iterative:
+				{
+					for (int i = 0; i < this->parameters.surfaceSolver.poissonSolver.iterations; i++) {
+						this->surface.poissonStep(this->parameters.surfaceSolver.poissonSolver.factor, false);
+					}
+					break;
+				}
+				case PoissonMethod::Multigrid:
+				{
+					const auto& multigridParameters = this->parameters.surfaceSolver.poissonSolver.multigrid;
+
+					Solvers::MultigridSurface::Settings settings;
+					settings.maxCycles = multigridParameters.maxCycles.get();
+					settings.tolerance = multigridParameters.tolerance.get();
+					settings.preSmoothingSteps = multigridParameters.smoothingSteps.get();
+					settings.postSmoothingSteps = multigridParameters.smoothingSteps.get();
+					settings.fullMultigrid = multigridParameters.fullMultigrid.get();
+
+					auto startTime = chrono::high_resolution_clock::now();
+					auto result = Solvers::MultigridSurface::solve(this->surface, settings);
+					this->multigridStatus.duration = (float) chrono::duration_cast<chrono::microseconds>(chrono::high_resolution_clock::now() - startTime).count() / 1000.0f;
+
+					this->surface = result.surface;
+					this->multigridStatus.levels = result.levelCount;
+					this->multigridStatus.cycles = result.cycles;
+					this->multigridStatus.residual = (float) result.finalResidual;
+					break;
+				}
+				default:
+					break;
 				}
 				this->preview.dirty = true;
 			}
@@ -656,50 +800,48 @@ namespace ofxRulr {
 
 				this->preview.targets.clear();
 
-				if (this->surface.distortedGrid.positions.empty()) {
+				if (this->surface.distortedGrid.empty()) {
 					return;
 				}
 
 				auto scale = this->parameters.draw.vectorLength.get();
 
-				for (const auto& row : this->surface.distortedGrid.positions) {
-					for (const auto& position : row) {
-						const auto direction = glm::normalize(position.target - position.currentPosition);
+				for (const auto& position : this->surface.distortedGrid.positions) {
+					const auto direction = glm::normalize(position.target - position.currentPosition);
 
-						// Add normal
+					// Add normal
+					{
 						{
-							{
-								this->preview.normals.addVertex(position.currentPosition);
-								this->preview.normals.addVertex(position.currentPosition + position.normal * scale);
-							}
-
-							{
-								ofFloatColor color(
-									ofMap(position.normal.x * 10, -1, 1, 0, 1)
-									, ofMap(position.normal.y * 10, -1, 1, 0, 1)
-									, ofMap(position.normal.z, -1, 1, 0, 1)
-								);
-								this->preview.normals.addColor(color);
-								this->preview.normals.addColor(color);
-							}
+							this->preview.normals.addVertex(position.currentPosition);
+							this->preview.normals.addVertex(position.currentPosition + position.normal * scale);
 						}
 
-						// Add rays incoming
 						{
-							this->preview.rays.addVertex(position.currentPosition);
-							this->preview.rays.addVertex(position.currentPosition - position.incoming * scale);
+							ofFloatColor color(
+								ofMap(position.normal.x * 10, -1, 1, 0, 1)
+								, ofMap(position.normal.y * 10, -1, 1, 0, 1)
+								, ofMap(position.normal.z, -1, 1, 0, 1)
+							);
+							this->preview.normals.addColor(color);
+							this->preview.normals.addColor(color);
 						}
+					}
 
-						// Add rays outgoing
-						{
-							this->preview.rays.addVertex(position.currentPosition);
-							this->preview.rays.addVertex(position.currentPosition + direction * scale);
-						}
+					// Add rays incoming
+					{
+						this->preview.rays.addVertex(position.currentPosition);
+						this->preview.rays.addVertex(position.currentPosition - position.incoming * scale);
+					}
 
-						// Add target
-						{
-							this->preview.targets.push_back(position.target);
-						}
+					// Add rays outgoing
+					{
+						this->preview.rays.addVertex(position.currentPosition);
+						this->preview.rays.addVertex(position.currentPosition + direction * scale);
+					}
+
+					// Add target
+					{
+						this->preview.targets.push_back(position.target);
 					}
 				}
 
@@ -709,14 +851,13 @@ namespace ofxRulr {
 						return this->surface.distortedGrid.at(i, j).currentPosition;
 					};
 
-					auto rows = this->surface.distortedGrid.positions.size();
-					auto cols = this->surface.distortedGrid.positions.front().size();
+					auto rows = this->surface.distortedGrid.rows();
+					auto cols = this->surface.distortedGrid.cols();
 
 					for (size_t j = 0; j < rows; j++) {
-						auto& row = this->surface.distortedGrid.positions[j];
 						this->preview.surface.addVertex(getPos(0, j));
 
-						for (size_t i = 1; i < row.size() - 1; i++){
+						for (size_t i = 1; i < cols - 1; i++){
 							this->preview.surface.addVertex(getPos(i, j));
 							this->preview.surface.addVertex(getPos(i, j));
 						}
@@ -759,12 +900,12 @@ namespace ofxRulr {
 				SimpleSurface::exportHeightMap(const std::filesystem::path& path) const
 			{
 				ofFile file(path, ofFile::Mode::WriteOnly, false);
-				for (const auto& row : this->surface.distortedGrid.positions) {
-					for (auto it = row.begin(); it != row.end(); it++) {
-						if (it != row.begin()) {
+				for (size_t j = 0; j < this->surface.distortedGrid.rows(); j++) {
+					for (size_t i = 0; i < this->surface.distortedGrid.cols(); i++) {
+						if (i != 0) {
 							file << ", ";
 						}
-						file << it->currentPosition.z;
+						file << this->surface.distortedGrid.at(i, j).currentPosition.z;
 					}
 					file << std::endl;
 				}
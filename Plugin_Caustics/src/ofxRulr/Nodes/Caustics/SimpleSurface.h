@@ -6,10 +6,20 @@
 #include "ofxRulr/Solvers/Normal.h"
 #include "ofxRulr/Solvers/IntegratedSurface.h"
 #include "ofxRulr/Solvers/NormalsSurface.h"
+#include "ofxRulr/Solvers/MultigridSurface.h"
+#include "ofxRulr/Utils/SolverCache.h"
 
 namespace ofxRulr {
 	namespace Nodes {
 		namespace Caustics {
+			MAKE_ENUM(NormalSolveMethod
+				, (ClosedForm, Ceres, Validate)
+				, ("Closed form", "Ceres", "Validate"));
+
+			MAKE_ENUM(PoissonMethod
+				, (Iterative, Multigrid)
+				, ("Iterative", "Multigrid"));
+
 			class SimpleSurface : public ofxRulr::Nodes::Item::RigidBody {
 			public:
 				SimpleSurface();
@@ -61,9 +71,19 @@ namespace ofxRulr {
 
 						struct : ofParameterGroup {
 							ofParameter<bool> enabled{ "Enabled", false };
+							ofParameter<PoissonMethod> method{ "Method", PoissonMethod::Multigrid };
 							ofParameter<float> factor{ "Factor", 1.5 };
 							ofParameter<int> iterations{ "Iterations", 1 };
-							PARAM_DECLARE("Poisson", enabled, factor, iterations);
+
+							struct : ofParameterGroup {
+								ofParameter<int> maxCycles{ "Max cycles", 20 };
+								ofParameter<float> tolerance{ "Tolerance", 1e-6, 0, 1 };
+								ofParameter<int> smoothingSteps{ "Smoothing steps", 2 };
+								ofParameter<bool> fullMultigrid{ "Coarse to fine", true };
+								PARAM_DECLARE("Multigrid", maxCycles, tolerance, smoothingSteps, fullMultigrid);
+							} multigrid;
+
+							PARAM_DECLARE("Poisson", enabled, method, factor, iterations, multigrid);
 						} poissonSolver;
 
 						struct : ofParameterGroup {
@@ -83,8 +103,10 @@ namespace ofxRulr {
 					} surfaceSolver;
 
 					struct : ofParameterGroup {
+						// Validate : solve with both and report the largest difference (closed form result is kept)
+						ofParameter<NormalSolveMethod> method{ "Method", NormalSolveMethod::ClosedForm };
 						ofxCeres::ParameterisedSolverSettings solverSettings{ Solvers::Normal::getDefaultSolverSettings() };
-						PARAM_DECLARE("Normal solver", solverSettings);
+						PARAM_DECLARE("Normal solver", method, solverSettings);
 					} normalSolver;
 
 					struct : ofParameterGroup {
@@ -122,6 +144,21 @@ namespace ofxRulr {
 
 				Models::Surface surface;
 
+				// Height maps from solveHeightMap() against the normals
+				Utils::SolverCache heightMapCache{ 4 };
+
+				struct {
+					float duration = 0.0f; // [ms]
+					float maxDeviation = 0.0f; // [degrees] between closed form and Ceres (Validate only)
+				} normalSolveStatus;
+
+				struct {
+					size_t levels = 0;
+					int cycles = 0;
+					float residual = 0.0f;
+					float duration = 0.0f; // [ms]
+				} multigridStatus;
+
 				struct {
 					bool dirty = true;
 					ofMesh rays;
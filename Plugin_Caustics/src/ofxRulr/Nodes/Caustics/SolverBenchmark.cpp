@@ -0,0 +1,215 @@
+#include "pch_Plugin_Caustics.h"
+#include "SolverBenchmark.h"
+
+#include "ofxRulr/Solvers/Normal.h"
+#include "ofxRulr/Solvers/NormalsSurface.h"
+#include "ofxRulr/Solvers/MultigridSurface.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Caustics {
+			//----------
+			SolverBenchmark::SolverBenchmark()
+			{
+				RULR_NODE_INIT_LISTENER;
+			}
+
+			//----------
+			string
+				SolverBenchmark::getTypeName() const
+			{
+				return "Caustics::SolverBenchmark";
+			}
+
+			//----------
+			void
+				SolverBenchmark::init()
+			{
+				this->manageParameters(this->parameters);
+			}
+
+			//----------
+			void
+				SolverBenchmark::runTrial(size_t trial)
+			{
+				this->runNormals(trial);
+				this->runSurfaces(trial);
+			}
+
+			//----------
+			void
+				SolverBenchmark::runNormals(size_t trial)
+			{
+				const auto count = (size_t)max(this->parameters.normals.count.get(), 1);
+				const auto ceresCount = min((size_t)max(this->parameters.normals.ceresCount.get(), 0), count);
+				const auto exitIORvsIncidentIOR = this->parameters.normals.exitIORvsIncidentIOR.get();
+				const auto maxAngle = this->parameters.normals.maxAngle.get() * DEG_TO_RAD;
+
+				// Create the ground truth
+				vector<glm::vec3> incidents(count), refracteds(count), normals(count);
+				for (size_t i = 0; i < count; i++) {
+					glm::vec3 refracted;
+					do {
+						auto tilt = ofRandom(0, maxAngle);
+						auto direction = ofRandom(0, TWO_PI);
+						normals[i] = {
+							sin(tilt) * cos(direction)
+							, sin(tilt) * sin(direction)
+							, cos(tilt)
+						};
+						incidents[i] = glm::normalize(glm::vec3(ofRandomf() * 0.2f, ofRandomf() * 0.2f, -1.0f));
+						refracted = glm::refract(incidents[i], normals[i], 1.0f / exitIORvsIncidentIOR);
+					} while (glm::length(refracted) < 0.5f); // total internal reflection
+					refracteds[i] = refracted;
+				}
+
+				auto measureNormal = [&](size_t i, const glm::vec3& solvedNormal, float& residual, float& error) {
+					auto refracted = glm::refract(incidents[i], solvedNormal, 1.0f / exitIORvsIncidentIOR);
+					residual += glm::length(refracted - refracteds[i]);
+					error += acos(ofClamp(glm::dot(solvedNormal, normals[i]), -1.0f, 1.0f)) * RAD_TO_DEG;
+				};
+
+				// Closed form (batched)
+				{
+					Solvers::Normal::Batch batch;
+					batch.resize(count);
+					for (size_t i = 0; i < count; i++) {
+						batch.incidentX[i] = incidents[i].x;
+						batch.incidentY[i] = incidents[i].y;
+						batch.incidentZ[i] = incidents[i].z;
+						batch.refractedX[i] = refracteds[i].x;
+						batch.refractedY[i] = refracteds[i].y;
+						batch.refractedZ[i] = refracteds[i].z;
+					}
+
+					this->benchmark.measure("Normal::solveBatch", "Normals", count, trial, [&](Utils::SolverBenchmark::Record& record) {
+						Solvers::Normal::solveBatch(batch, exitIORvsIncidentIOR);
+
+						record.converged = true;
+						for (size_t i = 0; i < count; i++) {
+							glm::vec3 normal(batch.normalX[i], batch.normalY[i], batch.normalZ[i]);
+							measureNormal(i, normal, record.residual, record.parameterError);
+						}
+						record.residual /= (float)count;
+						record.parameterError /= (float)count;
+						});
+				}
+
+				// Ceres (one solve per normal)
+				if (ceresCount > 0) {
+					auto solverSettings = Solvers::Normal::getDefaultSolverSettings();
+					solverSettings.printReport = false;
+
+					this->benchmark.measure("Normal::solve", "Normals", ceresCount, trial, [&](Utils::SolverBenchmark::Record& record) {
+						record.converged = true;
+						for (size_t i = 0; i < ceresCount; i++) {
+							auto result = Solvers::Normal::solve(incidents[i]
+								, refracteds[i]
+								, exitIORvsIncidentIOR
+								, solverSettings);
+							record.addIterations(result.iterations);
+							record.converged &= result.isConverged();
+							measureNormal(i, result.solution, record.residual, record.parameterError);
+						}
+						record.residual /= (float)ceresCount;
+						record.parameterError /= (float)ceresCount;
+						});
+				}
+			}
+
+			//----------
+			void
+				SolverBenchmark::runSurfaces(size_t trial)
+			{
+				vector<float> heights;
+				auto surface = this->makeSurface(heights);
+				const auto resolution = surface.distortedGrid.width;
+
+				// Multigrid
+				{
+					Solvers::MultigridSurface::Settings settings;
+					this->benchmark.measure("MultigridSurface", "Surface", resolution, trial, [&](Utils::SolverBenchmark::Record& record) {
+						auto result = Solvers::MultigridSurface::solve(surface, settings);
+						record.iterations = result.cycles;
+						record.residual = (float)result.finalResidual;
+						record.converged = result.converged;
+						record.parameterError = SolverBenchmark::getHeightError(result.surface, heights);
+						});
+				}
+
+				// Ceres (all heights in one problem)
+				if (resolution <= (size_t)this->parameters.surface.ceresMaxResolution.get()) {
+					auto solverSettings = Solvers::NormalsSurface::getDefaultSolverSettings();
+					solverSettings.printReport = false;
+
+					this->benchmark.measure("NormalsSurface::solveUniversal", "Surface", resolution, trial, [&](Utils::SolverBenchmark::Record& record) {
+						auto result = Solvers::NormalsSurface::solveUniversal(surface, solverSettings);
+						record.residual = result.residual;
+						record.converged = result.isConverged();
+						record.parameterError = SolverBenchmark::getHeightError(result.solution.surface, heights);
+						});
+				}
+			}
+
+			//----------
+			Models::Surface
+				SolverBenchmark::makeSurface(vector<float>& heights) const
+			{
+				const auto resolution = (size_t)max(this->parameters.surface.resolution.get(), 2);
+				const auto amplitude = this->parameters.surface.amplitude.get();
+				const auto frequency = this->parameters.surface.frequency.get();
+				const auto phaseX = ofRandom(0, TWO_PI);
+				const auto phaseY = ofRandom(0, TWO_PI);
+
+				Models::Surface surface;
+				auto& grid = surface.distortedGrid;
+				grid.initGrid(resolution, 1.0f);
+
+				heights.resize(grid.size());
+				for (size_t index = 0; index < grid.size(); index++) {
+					auto& position = grid.positions[index].currentPosition;
+					heights[index] = amplitude
+						* sin(position.x * frequency * TWO_PI + phaseX)
+						* cos(position.y * frequency * TWO_PI + phaseY);
+					position.z = heights[index];
+				}
+
+				for (size_t j = 0; j < grid.rows(); j++) {
+					for (size_t i = 0; i < grid.cols(); i++) {
+						grid.at(i, j).normal = glm::normalize(surface.estimateNormal(i, j));
+					}
+				}
+
+				for (auto& position : grid.positions) {
+					position.currentPosition.z = 0.0f;
+				}
+
+				return surface;
+			}
+
+			//----------
+			float
+				SolverBenchmark::getHeightError(const Models::Surface& solved, const vector<float>& heights)
+			{
+				// Heights are only defined up to a constant, so remove the mean offset first
+				const auto& positions = solved.distortedGrid.positions;
+				if (positions.size() != heights.size() || heights.empty()) {
+					throw(ofxRulr::Exception("Solved surface doesn't match the ground truth"));
+				}
+
+				double meanOffset = 0.0;
+				for (size_t i = 0; i < heights.size(); i++) {
+					meanOffset += positions[i].currentPosition.z - heights[i];
+				}
+				meanOffset /= (double)heights.size();
+
+				double sumSquared = 0.0;
+				for (size_t i = 0; i < heights.size(); i++) {
+					auto error = positions[i].currentPosition.z - heights[i] - meanOffset;
+					sumSquared += error * error;
+				}
+				return (float)sqrt(sumSquared / (double)heights.size());
+			}
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ofxRulr.h"
+#include "ofxRulr/Nodes/Test/AbstractSolverBenchmark.h"
+#include "ofxRulr/Models/Surface.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Caustics {
+			// Runs the caustic solvers on a synthetic surface (a known height map and its normals)
+			// and records time and error against the known solution
+			class SolverBenchmark : public Test::AbstractSolverBenchmark {
+			public:
+				SolverBenchmark();
+				string getTypeName() const override;
+				void init();
+			protected:
+				void runTrial(size_t trial) override;
+				void runNormals(size_t trial);
+				void runSurfaces(size_t trial);
+
+				// Height map of sines with random phase. The normals of the surface are set from the heights,
+				// and the heights are then zeroed as the starting point of the solve.
+				Models::Surface makeSurface(vector<float>& heights) const;
+				static float getHeightError(const Models::Surface& solved, const vector<float>& heights);
+
+				struct : ofParameterGroup {
+					struct : ofParameterGroup {
+						ofParameter<int> count{ "Count", 100000 };
+						ofParameter<int> ceresCount{ "Ceres count", 1000 };
+						ofParameter<float> exitIORvsIncidentIOR{ "Exit IOR vs incident IOR", 1.5304, 0.1, 3 };
+						ofParameter<float> maxAngle{ "Max angle", 30, 0, 80 };
+						PARAM_DECLARE("Normals", count, ceresCount, exitIORvsIncidentIOR, maxAngle);
+					} normals;
+
+					struct : ofParameterGroup {
+						ofParameter<int> resolution{ "Resolution", 64 };
+						ofParameter<int> ceresMaxResolution{ "Ceres max resolution", 16 };
+						ofParameter<float> amplitude{ "Amplitude", 0.01, 0, 0.1 };
+						ofParameter<float> frequency{ "Frequency", 2, 0, 10 };
+						PARAM_DECLARE("Surface", resolution, ceresMaxResolution, amplitude, frequency);
+					} surface;
+
+					PARAM_DECLARE("SolverBenchmark", normals, surface);
+				} parameters;
+			};
+		}
+	}
+}
\ No newline at end of file
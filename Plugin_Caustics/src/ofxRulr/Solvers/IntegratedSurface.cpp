@@ -1,5 +1,6 @@
 #include "pch_Plugin_Caustics.h"
 #include "IntegratedSurface.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 struct IntegratedSurfaceCost
 {
@@ -52,7 +53,7 @@ namespace ofxRulr {
 			IntegratedSurface::solve(const Models::IntegratedSurface& initialCondition
 				, const ofxCeres::SolverSettings& solverSettings)
 		{
-			if (initialCondition.distortedGrid.positions.empty()) {
+			if (initialCondition.distortedGrid.empty()) {
 				throw(ofxCeres::Exception("Grid is empty"));
 			}
 
@@ -86,7 +87,8 @@ namespace ofxRulr {
 				if (solverSettings.printReport) {
 					cout << "Solve OpticalSystemSolver" << endl;
 				}
-				ceres::Solve(solverSettings.options
+				Utils::solveCeres("IntegratedSurface"
+					, solverSettings.options
 					, &problem
 					, &summary);
 
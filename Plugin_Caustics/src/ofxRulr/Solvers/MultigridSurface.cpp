@@ -0,0 +1,397 @@
+#include "pch_Plugin_Caustics.h"
+#include "MultigridSurface.h"
+
+namespace ofxRulr {
+	namespace Solvers {
+		namespace {
+			// One level of the grid hierarchy. The operator on every level is the graph Laplacian of the
+			// 4-connected grid (degree * center - sum of neighbours), with fewer neighbours at the edges.
+			struct MultigridLevel {
+				size_t cols = 0;
+				size_t rows = 0;
+
+				vector<double> heights;
+				vector<double> rhs; // from the normals of this level
+
+				// Scratch used when this level receives a correction from the finer level
+				vector<double> correction;
+				vector<double> correctionRhs;
+				vector<double> residual;
+
+				size_t indexOf(size_t i, size_t j) const {
+					return i + j * this->cols;
+				}
+
+				void resize(size_t cols, size_t rows) {
+					this->cols = cols;
+					this->rows = rows;
+					const auto size = cols * rows;
+					this->heights.assign(size, 0.0);
+					this->rhs.assign(size, 0.0);
+					this->correction.assign(size, 0.0);
+					this->correctionRhs.assign(size, 0.0);
+					this->residual.assign(size, 0.0);
+				}
+			};
+
+			//----------
+			// Fine index which coarse index I sits on
+			size_t coarseToFine(size_t I, size_t fineSize)
+			{
+				return min(I * 2, fineSize - 1);
+			}
+
+			//----------
+			// Linear interpolation weights from the coarse grid onto fine index i (along one axis)
+			void prolongationWeights(size_t i, size_t fineSize, size_t coarseSize, size_t& I0, size_t& I1, double& t)
+			{
+				I0 = min(i / 2, coarseSize - 1);
+				I1 = min(I0 + 1, coarseSize - 1);
+
+				const auto f0 = coarseToFine(I0, fineSize);
+				const auto f1 = coarseToFine(I1, fineSize);
+				t = f1 > f0
+					? (double)(i - f0) / (double)(f1 - f0)
+					: 0.0;
+			}
+
+			//----------
+			// Build the right hand side from the normals : the sum over the edges from each vertex of the height
+			// difference implied by the average slope along that edge
+			void calculateRHS(const Models::Surface& surface, MultigridLevel& level)
+			{
+				const auto cols = surface.distortedGrid.cols();
+				const auto rows = surface.distortedGrid.rows();
+
+				vector<glm::dvec2> slopes(cols * rows);
+				for (size_t index = 0; index < slopes.size(); index++) {
+					const auto& normal = surface.distortedGrid.positions[index].normal;
+					slopes[index] = abs(normal.z) > 1e-6f
+						? -glm::dvec2(normal.x, normal.y) / (double)normal.z
+						: glm::dvec2(0.0);
+				}
+
+				auto heightDifference = [&](size_t iA, size_t jA, size_t iB, size_t jB) {
+					const auto indexA = surface.distortedGrid.indexOf(iA, jA);
+					const auto indexB = surface.distortedGrid.indexOf(iB, jB);
+					const auto& positionA = surface.distortedGrid.positions[indexA].currentPosition;
+					const auto& positionB = surface.distortedGrid.positions[indexB].currentPosition;
+					const auto delta = glm::dvec2(positionB.x - positionA.x, positionB.y - positionA.y);
+					return glm::dot(delta, (slopes[indexA] + slopes[indexB]) / 2.0);
+				};
+
+				for (size_t j = 0; j < rows; j++) {
+					for (size_t i = 0; i < cols; i++) {
+						double sum = 0.0;
+						if (i > 0) {
+							sum += heightDifference(i, j, i - 1, j);
+						}
+						if (i < cols - 1) {
+							sum += heightDifference(i, j, i + 1, j);
+						}
+						if (j > 0) {
+							sum += heightDifference(i, j, i, j - 1);
+						}
+						if (j < rows - 1) {
+							sum += heightDifference(i, j, i, j + 1);
+						}
+						level.rhs[level.indexOf(i, j)] = -sum;
+					}
+				}
+			}
+
+			//----------
+			void smooth(const MultigridLevel& level, vector<double>& heights, const vector<double>& rhs, int sweeps)
+			{
+				const auto cols = level.cols;
+				const auto rows = level.rows;
+
+				for (int sweep = 0; sweep < sweeps; sweep++) {
+					for (size_t colour = 0; colour < 2; colour++) {
+						for (size_t j = 0; j < rows; j++) {
+							for (size_t i = (j + colour) % 2; i < cols; i += 2) {
+								const auto index = level.indexOf(i, j);
+								double sum = rhs[index];
+								int degree = 0;
+								if (i > 0) {
+									sum += heights[index - 1];
+									degree++;
+								}
+								if (i < cols - 1) {
+									sum += heights[index + 1];
+									degree++;
+								}
+								if (j > 0) {
+									sum += heights[index - cols];
+									degree++;
+								}
+								if (j < rows - 1) {
+									sum += heights[index + cols];
+									degree++;
+								}
+								if (degree > 0) {
+									heights[index] = sum / (double)degree;
+								}
+							}
+						}
+					}
+				}
+			}
+
+			//----------
+			// residual = rhs - A * heights. Returns the RMS of the residual
+			double calculateResidual(const MultigridLevel& level, const vector<double>& heights, const vector<double>& rhs, vector<double>& residual)
+			{
+				const auto cols = level.cols;
+				const auto rows = level.rows;
+
+				double sumSquared = 0.0;
+				for (size_t j = 0; j < rows; j++) {
+					for (size_t i = 0; i < cols; i++) {
+						const auto index = level.indexOf(i, j);
+						double value = 0.0;
+						int degree = 0;
+						if (i > 0) {
+							value -= heights[index - 1];
+							degree++;
+						}
+						if (i < cols - 1) {
+							value -= heights[index + 1];
+							degree++;
+						}
+						if (j > 0) {
+							value -= heights[index - cols];
+							degree++;
+						}
+						if (j < rows - 1) {
+							value -= heights[index + cols];
+							degree++;
+						}
+						value += degree * heights[index];
+
+						residual[index] = rhs[index] - value;
+						sumSquared += residual[index] * residual[index];
+					}
+				}
+				return sqrt(sumSquared / (double)(cols * rows));
+			}
+
+			//----------
+			// coarse += P^T * fine (transpose of the bilinear prolongation, i.e. full weighting scaled for the coarser spacing)
+			void restrictResidual(const MultigridLevel& fine, const vector<double>& fineValues, const MultigridLevel& coarse, vector<double>& coarseValues)
+			{
+				std::fill(coarseValues.begin(), coarseValues.end(), 0.0);
+
+				for (size_t j = 0; j < fine.rows; j++) {
+					size_t J0, J1;
+					double tj;
+					prolongationWeights(j, fine.rows, coarse.rows, J0, J1, tj);
+
+					for (size_t i = 0; i < fine.cols; i++) {
+						size_t I0, I1;
+						double ti;
+						prolongationWeights(i, fine.cols, coarse.cols, I0, I1, ti);
+
+						const auto value = fineValues[fine.indexOf(i, j)];
+						coarseValues[coarse.indexOf(I0, J0)] += value * (1.0 - ti) * (1.0 - tj);
+						coarseValues[coarse.indexOf(I1, J0)] += value * ti * (1.0 - tj);
+						coarseValues[coarse.indexOf(I0, J1)] += value * (1.0 - ti) * tj;
+						coarseValues[coarse.indexOf(I1, J1)] += value * ti * tj;
+					}
+				}
+			}
+
+			//----------
+			// fine (+)= P * coarse
+			void prolongate(const MultigridLevel& coarse, const vector<double>& coarseValues, const MultigridLevel& fine, vector<double>& fineValues, bool add)
+			{
+				for (size_t j = 0; j < fine.rows; j++) {
+					size_t J0, J1;
+					double tj;
+					prolongationWeights(j, fine.rows, coarse.rows, J0, J1, tj);
+
+					for (size_t i = 0; i < fine.cols; i++) {
+						size_t I0, I1;
+						double ti;
+						prolongationWeights(i, fine.cols, coarse.cols, I0, I1, ti);
+
+						const auto value = coarseValues[coarse.indexOf(I0, J0)] * (1.0 - ti) * (1.0 - tj)
+							+ coarseValues[coarse.indexOf(I1, J0)] * ti * (1.0 - tj)
+							+ coarseValues[coarse.indexOf(I0, J1)] * (1.0 - ti) * tj
+							+ coarseValues[coarse.indexOf(I1, J1)] * ti * tj;
+
+						auto& fineValue = fineValues[fine.indexOf(i, j)];
+						fineValue = add ? fineValue + value : value;
+					}
+				}
+			}
+
+			//----------
+			void vCycle(vector<MultigridLevel>& levels
+				, size_t levelIndex
+				, vector<double>& heights
+				, const vector<double>& rhs
+				, const MultigridSurface::Settings& settings)
+			{
+				auto& level = levels[levelIndex];
+
+				if (levelIndex == levels.size() - 1) {
+					// Coarsest level is small enough to smooth to convergence
+					smooth(level, heights, rhs, (int)(level.cols * level.rows) * 4 + 8);
+					return;
+				}
+
+				auto& coarse = levels[levelIndex + 1];
+
+				smooth(level, heights, rhs, settings.preSmoothingSteps);
+
+				calculateResidual(level, heights, rhs, level.residual);
+				restrictResidual(level, level.residual, coarse, coarse.correctionRhs);
+				std::fill(coarse.correction.begin(), coarse.correction.end(), 0.0);
+
+				vCycle(levels, levelIndex + 1, coarse.correction, coarse.correctionRhs, settings);
+
+				prolongate(coarse, coarse.correction, level, heights, true);
+
+				smooth(level, heights, rhs, settings.postSmoothingSteps);
+			}
+		}
+
+		//----------
+		MultigridSurface::Result
+			MultigridSurface::solve(const Models::Surface& surface
+				, const Settings& settings)
+		{
+			if (surface.distortedGrid.empty()) {
+				throw(Exception("Grid is empty"));
+			}
+
+			// Build the hierarchy of surfaces (finest first)
+			vector<Models::Surface> surfaces;
+			{
+				surfaces.push_back(surface);
+				const auto coarsestSize = max<size_t>(settings.coarsestSize, 2);
+				while (true) {
+					const auto& finest = surfaces.back();
+					if (finest.distortedGrid.cols() / 2 + 1 < coarsestSize
+						|| finest.distortedGrid.rows() / 2 + 1 < coarsestSize
+						|| finest.distortedGrid.cols() <= 2
+						|| finest.distortedGrid.rows() <= 2) {
+						break;
+					}
+					surfaces.push_back(MultigridSurface::restrictSurface(finest));
+				}
+			}
+
+			vector<MultigridLevel> levels(surfaces.size());
+			for (size_t i = 0; i < levels.size(); i++) {
+				auto& level = levels[i];
+				level.resize(surfaces[i].distortedGrid.cols(), surfaces[i].distortedGrid.rows());
+				calculateRHS(surfaces[i], level);
+				for (size_t index = 0; index < level.heights.size(); index++) {
+					level.heights[index] = surfaces[i].distortedGrid.positions[index].currentPosition.z;
+				}
+			}
+
+			Result result;
+			result.levelCount = levels.size();
+
+			// Solve each level in turn, coarsest first, using the coarser result as the starting point
+			const auto firstLevel = settings.fullMultigrid
+				? levels.size() - 1
+				: 0;
+
+			for (auto levelIndex = (int) firstLevel; levelIndex >= 0; levelIndex--) {
+				auto& level = levels[levelIndex];
+
+				if (levelIndex != (int) firstLevel) {
+					prolongate(levels[levelIndex + 1], levels[levelIndex + 1].heights, level, level.heights, false);
+				}
+
+				auto initialResidual = calculateResidual(level, level.heights, level.rhs, level.residual);
+				auto residual = initialResidual;
+				int cycles = 0;
+				while (cycles < settings.maxCycles
+					&& residual > settings.tolerance * initialResidual
+					&& residual > 0.0) {
+					vCycle(levels, levelIndex, level.heights, level.rhs, settings);
+					residual = calculateResidual(level, level.heights, level.rhs, level.residual);
+					cycles++;
+				}
+
+				if (levelIndex == 0) {
+					result.cycles = cycles;
+					result.initialResidual = initialResidual;
+					result.finalResidual = residual;
+					result.converged = residual <= settings.tolerance * initialResidual;
+				}
+			}
+
+			// Write the heights back (with the minimum height at 0 as in Surface::poissonStep)
+			{
+				result.surface = surface;
+
+				const auto& heights = levels.front().heights;
+				const auto minHeight = *std::min_element(heights.begin(), heights.end());
+				for (size_t index = 0; index < heights.size(); index++) {
+					result.surface.distortedGrid.positions[index].currentPosition.z = (float)(heights[index] - minHeight);
+				}
+			}
+
+			return result;
+		}
+
+		//----------
+		Models::Surface
+			MultigridSurface::restrictSurface(const Models::Surface& surface)
+		{
+			const auto& fineGrid = surface.distortedGrid;
+			const auto fineCols = fineGrid.cols();
+			const auto fineRows = fineGrid.rows();
+			const auto coarseCols = fineCols / 2 + 1;
+			const auto coarseRows = fineRows / 2 + 1;
+
+			Models::Surface coarseSurface;
+			auto& coarseGrid = coarseSurface.distortedGrid;
+			coarseGrid.resize(coarseCols, coarseRows);
+
+			// Take the positions from the fine vertices which the coarse vertices sit on
+			for (size_t J = 0; J < coarseRows; J++) {
+				for (size_t I = 0; I < coarseCols; I++) {
+					coarseGrid.at(I, J) = fineGrid.at(coarseToFine(I, fineCols), coarseToFine(J, fineRows));
+				}
+			}
+
+			// Normals are the weighted average of the fine normals around each coarse vertex
+			vector<glm::dvec3> normals(coarseGrid.size(), glm::dvec3(0.0));
+			for (size_t j = 0; j < fineRows; j++) {
+				size_t J0, J1;
+				double tj;
+				prolongationWeights(j, fineRows, coarseRows, J0, J1, tj);
+
+				for (size_t i = 0; i < fineCols; i++) {
+					size_t I0, I1;
+					double ti;
+					prolongationWeights(i, fineCols, coarseCols, I0, I1, ti);
+
+					const auto normal = (glm::dvec3)fineGrid.at(i, j).normal;
+					normals[coarseGrid.indexOf(I0, J0)] += normal * (1.0 - ti) * (1.0 - tj);
+					normals[coarseGrid.indexOf(I1, J0)] += normal * ti * (1.0 - tj);
+					normals[coarseGrid.indexOf(I0, J1)] += normal * (1.0 - ti) * tj;
+					normals[coarseGrid.indexOf(I1, J1)] += normal * ti * tj;
+				}
+			}
+
+			for (size_t index = 0; index < normals.size(); index++) {
+				const auto length = glm::length(normals[index]);
+				if (length > 0.0) {
+					coarseGrid.positions[index].normal = (glm::vec3)(normals[index] / length);
+				}
+			}
+
+			coarseGrid.calculateDirectionVectors();
+
+			return coarseSurface;
+		}
+	}
+}
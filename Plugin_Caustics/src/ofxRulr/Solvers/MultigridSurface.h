@@ -0,0 +1,41 @@
+#pragma once
+
+#include "ofxRulr/Models/Surface.h"
+
+namespace ofxRulr {
+	namespace Solvers {
+		// Integrate the normal field of a surface into a height map using multigrid.
+		//
+		// Heights are the least squares fit to the height differences implied by the normals along each
+		// grid edge (i.e. a Poisson equation with natural Neumann boundaries). The normal field is restricted
+		// onto coarser grids which are solved first, and each level's heights are prolongated as the
+		// starting point of the next finer level (full multigrid). Each level is then refined with V-cycles
+		// until the residual has dropped by the tolerance, rather than running a fixed number of iterations.
+		class MultigridSurface {
+		public:
+			struct Settings {
+				int preSmoothingSteps = 2; // red-black Gauss-Seidel sweeps before restricting
+				int postSmoothingSteps = 2; // sweeps after applying the coarse correction
+				int maxCycles = 20; // V-cycles per level
+				double tolerance = 1e-6; // residual relative to the residual at the start of the level
+				size_t coarsestSize = 3; // stop coarsening below this many vertices on either axis
+				bool fullMultigrid = true; // solve coarse levels first (otherwise start from the current heights)
+			};
+
+			struct Result {
+				Models::Surface surface;
+				size_t levelCount = 0;
+				int cycles = 0; // V-cycles on the finest level
+				double initialResidual = 0.0; // RMS [m] on the finest level
+				double finalResidual = 0.0;
+				bool converged = false;
+			};
+
+			static Result solve(const Models::Surface& surface
+				, const Settings& settings);
+
+			// Build a coarser surface (half resolution) whose normals are the full-weighted average of the finer normals
+			static Models::Surface restrictSurface(const Models::Surface& surface);
+		};
+	}
+}
\ No newline at end of file
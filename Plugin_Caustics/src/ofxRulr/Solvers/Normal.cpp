@@ -1,5 +1,7 @@
 #include "pch_Plugin_Caustics.h"
 #include "Normal.h"
+#include "ofxRulr/Utils/SolveCeres.h"
+#include "ofxRulr/Utils/SolverRuntime.h"
 
 template<typename T>
 glm::tvec3<T> makeNormalFromParameters(const T* parameters)
@@ -63,6 +65,24 @@ struct NormalCost {
 
 namespace ofxRulr {
 	namespace Solvers {
+		//----------
+		void
+			Normal::Batch::resize(size_t size)
+		{
+			for (auto values : { &incidentX, &incidentY, &incidentZ
+				, &refractedX, &refractedY, &refractedZ
+				, &normalX, &normalY, &normalZ }) {
+				values->resize(size);
+			}
+		}
+
+		//----------
+		size_t
+			Normal::Batch::size() const
+		{
+			return this->incidentX.size();
+		}
+
 		//----------
 		ofxCeres::SolverSettings
 			Normal::getDefaultSolverSettings()
@@ -100,7 +120,8 @@ namespace ofxRulr {
 				if (solverSettings.printReport) {
 					cout << "Solve OpticalSystemSolver" << endl;
 				}
-				ceres::Solve(solverSettings.options
+				Utils::solveCeres("Normal"
+					, solverSettings.options
 					, &problem
 					, &summary);
 
@@ -116,5 +137,76 @@ namespace ofxRulr {
 				return result;
 			}
 		}
+
+		//----------
+		glm::vec3
+			Normal::solveClosedForm(const glm::vec3& incident
+				, const glm::vec3& refracted
+				, float exitIORvsIncidentIOR)
+		{
+			auto normal = glm::normalize(incident) - exitIORvsIncidentIOR * glm::normalize(refracted);
+			if (normal.z < 0.0f) {
+				normal = -normal;
+			}
+			return glm::normalize(normal);
+		}
+
+		//----------
+		void
+			Normal::solveBatch(Batch& batch
+				, float exitIORvsIncidentIOR
+				, size_t threadCount)
+		{
+			const auto size = batch.size();
+
+			// Keep chunks large enough that thread startup doesn't dominate
+			const size_t minimumChunkSize = 4096;
+			auto threadLease = Utils::SolverRuntime::X().acquireThreads(threadCount);
+			threadCount = max<size_t>(min(threadLease->getThreadCount(), size / minimumChunkSize), 1);
+			const auto chunkSize = (size + threadCount - 1) / threadCount;
+
+			// Plain loops over contiguous arrays so that the compiler can vectorise them
+			auto solveRange = [&batch, exitIORvsIncidentIOR](size_t begin, size_t end) {
+				const auto ratio = exitIORvsIncidentIOR;
+				const auto* ix = batch.incidentX.data();
+				const auto* iy = batch.incidentY.data();
+				const auto* iz = batch.incidentZ.data();
+				const auto* rx = batch.refractedX.data();
+				const auto* ry = batch.refractedY.data();
+				const auto* rz = batch.refractedZ.data();
+				auto* nx = batch.normalX.data();
+				auto* ny = batch.normalY.data();
+				auto* nz = batch.normalZ.data();
+
+				for (size_t i = begin; i < end; i++) {
+					const auto incidentScale = 1.0f / sqrt(ix[i] * ix[i] + iy[i] * iy[i] + iz[i] * iz[i]);
+					const auto refractedScale = ratio / sqrt(rx[i] * rx[i] + ry[i] * ry[i] + rz[i] * rz[i]);
+
+					auto x = ix[i] * incidentScale - rx[i] * refractedScale;
+					auto y = iy[i] * incidentScale - ry[i] * refractedScale;
+					auto z = iz[i] * incidentScale - rz[i] * refractedScale;
+
+					// Face +z
+					const auto scale = (z < 0.0f ? -1.0f : 1.0f) / sqrt(x * x + y * y + z * z);
+					nx[i] = x * scale;
+					ny[i] = y * scale;
+					nz[i] = z * scale;
+				}
+			};
+
+			if (threadCount == 1) {
+				solveRange(0, size);
+				return;
+			}
+
+			vector<future<void>> workers;
+			for (size_t begin = 0; begin < size; begin += chunkSize) {
+				auto end = min(begin + chunkSize, size);
+				workers.push_back(std::async(std::launch::async, solveRange, begin, end));
+			}
+			for (auto& worker : workers) {
+				worker.get();
+			}
+		}
 	}
 }
\ No newline at end of file
@@ -1,11 +1,22 @@
 #pragma once
 #include "ofxCeres.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 namespace ofxRulr {
 	namespace Solvers {
 		class Normal {
 		public:
-			typedef ofxCeres::Result<glm::vec3> Result;
+			typedef Utils::SolveResult<glm::vec3> Result;
+
+			// Structure of arrays for solving many normals at once
+			struct Batch {
+				vector<float> incidentX, incidentY, incidentZ;
+				vector<float> refractedX, refractedY, refractedZ;
+				vector<float> normalX, normalY, normalZ;
+
+				void resize(size_t size);
+				size_t size() const;
+			};
 
 			static ofxCeres::SolverSettings getDefaultSolverSettings();
 
@@ -13,6 +24,17 @@ namespace ofxRulr {
 				, const glm::vec3 & refracted
 				, float exitIORvsIncidentIOR
 				, const ofxCeres::SolverSettings& solverSettings);
+
+			// Snell's law in vector form (n1 * incident - n2 * refracted is parallel to the normal).
+			// Returns the normal facing +z to match the Ceres solve.
+			static glm::vec3 solveClosedForm(const glm::vec3& incident
+				, const glm::vec3& refracted
+				, float exitIORvsIncidentIOR);
+
+			// Closed form solve of every entry in the batch, split across threadCount threads (0 = as many as the SolverRuntime budget allows)
+			static void solveBatch(Batch&
+				, float exitIORvsIncidentIOR
+				, size_t threadCount = 0);
 		};
 	}
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "pch_Plugin_Caustics.h"
 #include "NormalsSurface.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 struct NormalsSurfaceCost
 {
@@ -16,9 +17,7 @@ struct NormalsSurfaceCost
 		operator()(const T* const* heightParameters
 			, T* residuals) const
 	{
-		auto surface = this->priorSurface.castTo<T>();
-		surface.fromParameters(heightParameters[0]);
-		surface.getResiduals(residuals);
+		this->priorSurface.getResidualsFromParameters(heightParameters[0], residuals);
 		return true;
 	}
 
@@ -185,7 +184,7 @@ namespace ofxRulr {
 			NormalsSurface::solveUniversal(const Models::Surface& initialCondition
 				, const ofxCeres::SolverSettings& solverSettings)
 		{
-			if (initialCondition.distortedGrid.positions.empty()) {
+			if (initialCondition.distortedGrid.empty()) {
 				throw(ofxCeres::Exception("Grid is empty"));
 			}
 
@@ -208,7 +207,8 @@ namespace ofxRulr {
 				if (solverSettings.printReport) {
 					cout << "Solve OpticalSystemSolver" << endl;
 				}
-				ceres::Solve(solverSettings.options
+				Utils::solveCeres("NormalsSurface"
+					, solverSettings.options
 					, &problem
 					, &summary);
 
@@ -243,7 +243,7 @@ namespace ofxRulr {
 				, const ofxCeres::SolverSettings& solverSettings
 				, bool edgesOnly)
 		{
-			if (initialCondition.distortedGrid.positions.empty()) {
+			if (initialCondition.distortedGrid.empty()) {
 				throw(ofxCeres::Exception("Grid is empty"));
 			}
 
@@ -283,7 +283,8 @@ namespace ofxRulr {
 				if (solverSettings.printReport) {
 					cout << "Solve OpticalSystemSolver" << endl;
 				}
-				ceres::Solve(solverSettings.options
+				Utils::solveCeres("NormalsSurface"
+					, solverSettings.options
 					, &problem
 					, &summary);
 
@@ -313,20 +314,18 @@ namespace ofxRulr {
 		}
 
 		//----------
-		NormalsSurface::Result
-			NormalsSurface::solveSection(const Models::Surface& initialCondition
+		ceres::Solver::Summary
+			solveSectionInto(const Models::Surface_<double>& surface
 				, const ofxCeres::SolverSettings& solverSettings
-				, const Models::SurfaceSectionSettings & surfaceSectionSettings)
+				, const Models::SurfaceSectionSettings & surfaceSectionSettings
+				, vector<double>& heights)
 		{
-			if (initialCondition.distortedGrid.positions.empty()) {
+			if (surface.distortedGrid.empty()) {
 				throw(ofxCeres::Exception("Grid is empty"));
 			}
 
 			ceres::Problem problem;
 
-			// Create the surface
-			auto surface = initialCondition.castTo<double>();
-
 			// Check surface section settings
 			if (surfaceSectionSettings.i_end() > surface.distortedGrid.cols()
 				|| surfaceSectionSettings.j_end() > surface.distortedGrid.rows()) {
@@ -371,15 +370,15 @@ namespace ofxRulr {
 					}
 				}
 			}
-			
 
 			// Perform the solve
 			ceres::Solver::Summary summary;
-			{
+			if (problem.NumResidualBlocks() > 0) {
 				if (solverSettings.printReport) {
 					cout << "Solve OpticalSystemSolver" << endl;
 				}
-				ceres::Solve(solverSettings.options
+				Utils::solveCeres("NormalsSurface"
+					, solverSettings.options
 					, &problem
 					, &summary);
 
@@ -388,19 +387,43 @@ namespace ofxRulr {
 				}
 			}
 
-			// Bring parameters back
-			{
-				surfaceSectionSettings.applyParameters(surface.distortedGrid
-					, allParameters);
-			}
-
-			// Destroy parameter blocks
+			// Bring parameters back and destroy parameter blocks
 			{
+				heights.clear();
+				heights.reserve(surfaceSectionSettings.width * surfaceSectionSettings.height);
 				for (const auto& parameterBlock : allParameters) {
+					heights.insert(heights.end(), parameterBlock, parameterBlock + surfaceSectionSettings.width);
 					delete[] parameterBlock;
 				}
 			}
 
+			return summary;
+		}
+
+		//----------
+		NormalsSurface::Result
+			NormalsSurface::solveSection(const Models::Surface& initialCondition
+				, const ofxCeres::SolverSettings& solverSettings
+				, const Models::SurfaceSectionSettings & surfaceSectionSettings)
+		{
+			if (initialCondition.distortedGrid.empty()) {
+				throw(ofxCeres::Exception("Grid is empty"));
+			}
+
+			// Create the surface
+			auto surface = initialCondition.castTo<double>();
+
+			// Perform the solve
+			vector<double> heights;
+			auto summary = solveSectionInto(surface
+				, solverSettings
+				, surfaceSectionSettings
+				, heights);
+
+			// Bring heights back
+			surfaceSectionSettings.applyHeights(surface.distortedGrid
+				, heights);
+
 			// Create the result
 			{
 				Result result(summary);
@@ -408,5 +431,22 @@ namespace ofxRulr {
 				return result;
 			}
 		}
+
+		//----------
+		NormalsSurface::SectionResult
+			NormalsSurface::solveSectionHeights(const Models::Surface_<double>& surface
+				, const ofxCeres::SolverSettings& solverSettings
+				, const Models::SurfaceSectionSettings & surfaceSectionSettings)
+		{
+			vector<double> heights;
+			auto summary = solveSectionInto(surface
+				, solverSettings
+				, surfaceSectionSettings
+				, heights);
+
+			SectionResult result(summary);
+			result.solution.heights = move(heights);
+			return result;
+		}
 	}
 }
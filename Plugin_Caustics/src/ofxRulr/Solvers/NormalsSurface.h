@@ -11,6 +11,11 @@ namespace ofxRulr {
 			};
 			typedef ofxCeres::Result<Solution> Result;
 
+			struct SectionSolution {
+				vector<double> heights; // row major within the section
+			};
+			typedef ofxCeres::Result<SectionSolution> SectionResult;
+
 			static ofxCeres::SolverSettings getDefaultSolverSettings();
 
 			static vector<double*> initParameters(const Models::Surface_<double>& surface);
@@ -25,6 +30,12 @@ namespace ofxRulr {
 			static Result solveSection(const Models::Surface& surface
 				, const ofxCeres::SolverSettings& solverSettings
 				, const Models::SurfaceSectionSettings& surfaceSectionSettings);
+
+			// Solve the heights of a section without copying the surface.
+			// The surface is only read, so this can be called concurrently for sections that don't overlap.
+			static SectionResult solveSectionHeights(const Models::Surface_<double>& surface
+				, const ofxCeres::SolverSettings& solverSettings
+				, const Models::SurfaceSectionSettings& surfaceSectionSettings);
 		};
 	}
 }
\ No newline at end of file
@@ -21,6 +21,12 @@ namespace ofxRulr {
 				RULR_NODE_INIT_LISTENER;
 			}
 
+			//----------
+			EnttecUsbPro::~EnttecUsbPro() {
+				this->stopOutput();
+				this->disconnect();
+			}
+
 			//----------
 			void EnttecUsbPro::init() {
 				RULR_NODE_SERIALIZATION_LISTENERS;
@@ -28,6 +34,25 @@ namespace ofxRulr {
 
 				this->portName.set("Port name", "COM1");
 
+				// build the packet (code taken from ofxDmx)
+				{
+					ChannelIndex dataSize = 512 + DMX_START_CODE_SIZE;
+					unsigned int packetSize = DMX_PRO_HEADER_SIZE + dataSize + DMX_PRO_END_SIZE;
+					this->packet.assign(packetSize, 0);
+
+					// header
+					this->packet[0] = DMX_PRO_START_MSG;
+					this->packet[1] = DMX_PRO_SEND_PACKET;
+					this->packet[2] = dataSize & 0xff; // data length lsb
+					this->packet[3] = (dataSize >> 8) & 0xff; // data length msb
+
+					// data
+					this->packet[4] = DMX_START_CODE; // first data byte
+
+					// end
+					this->packet[packetSize - 1] = DMX_PRO_END_MSG;
+				}
+
 				//we connect in deserialise
 			}
 
@@ -51,6 +76,8 @@ namespace ofxRulr {
 			void EnttecUsbPro::connect() {
 				this->disconnect();
 
+				lock_guard<mutex> lock(this->outputMutex);
+
 				try {
 					this->sender = make_shared<ofSerial>();
 					this->sender->setup(this->portName.get(), 57600);
@@ -66,6 +93,7 @@ namespace ofxRulr {
 
 			//----------
 			void EnttecUsbPro::disconnect() {
+				lock_guard<mutex> lock(this->outputMutex);
 				if (this->sender) {
 					this->sender->close();
 					this->sender.reset();
@@ -73,32 +101,11 @@ namespace ofxRulr {
 			}
 
 			//----------
-			void EnttecUsbPro::sendUniverse(UniverseIndex index, shared_ptr<Universe> universe) {
-				if (this->sender && universe) {
-					//code taken from ofxDmx
-
+			void EnttecUsbPro::sendUniverse(UniverseIndex index, const Value * channels, uint8_t sequence) {
+				if (this->sender) {
 					//we only have one universe, so send it
-
-					ChannelIndex dataSize = 512 + DMX_START_CODE_SIZE;
-					unsigned int packetSize = DMX_PRO_HEADER_SIZE + dataSize + DMX_PRO_END_SIZE;
-					DMX::Value * packet = new DMX::Value[packetSize];
-
-					// header
-					packet[0] = DMX_PRO_START_MSG;
-					packet[1] = DMX_PRO_SEND_PACKET;
-					packet[2] = dataSize & 0xff; // data length lsb
-					packet[3] = (dataSize >> 8) & 0xff; // data length msb
-
-														// data
-					packet[4] = DMX_START_CODE; // first data byte
-					memcpy(packet + 5, universe->getChannels() + 1, 512);
-
-					// end
-					packet[packetSize - 1] = DMX_PRO_END_MSG;
-
-					this->sender->writeBytes(&packet[0], packetSize);
-
-					delete[] packet;
+					memcpy(this->packet.data() + 5, channels + 1, 512);
+					this->sender->writeBytes(this->packet.data(), this->packet.size());
 				}
 			}
 
@@ -9,6 +9,7 @@ namespace ofxRulr {
 			class EnttecUsbPro : public DMX::Transmit {
 			public:
 				EnttecUsbPro();
+				~EnttecUsbPro();
 				void init();
 				string getTypeName() const;
 
@@ -18,11 +19,12 @@ namespace ofxRulr {
 				void connect();
 				void disconnect();
 
-				void sendUniverse(UniverseIndex, shared_ptr<Universe>) override;
+				void sendUniverse(UniverseIndex, const Value * channels, uint8_t sequence) override;
 
 				void populateInspector(ofxCvGui::InspectArguments &);
 
 				shared_ptr<ofSerial> sender;
+				vector<DMX::Value> packet; // preallocated, header and footer are written once
 
 				ofParameter<string> portName;
 			};
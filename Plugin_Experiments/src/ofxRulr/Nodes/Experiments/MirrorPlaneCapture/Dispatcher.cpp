@@ -18,9 +18,17 @@ namespace ofxRulr {
 				void Dispatcher::init() {
 					this->manageParameters(this->parameters);
 
+					RULR_NODE_UPDATE_LISTENER;
 					RULR_NODE_INSPECTOR_LISTENER;
 				}
 
+				//----------
+				void Dispatcher::update() {
+					if (this->httpClient.getMaxInFlight() != (size_t) this->parameters.maxInFlight.get()) {
+						this->httpClient.setMaxInFlight((size_t) this->parameters.maxInFlight.get());
+					}
+				}
+
 				//----------
 				void Dispatcher::populateInspector(ofxCvGui::InspectArguments& args) {
 					auto inspector = args.inspector;
@@ -57,24 +65,74 @@ namespace ofxRulr {
 						}
 						RULR_CATCH_ALL_TO_ALERT;
 						});
+
+					this->httpClient.addToInspector(inspector);
 				}
 
 				//----------
 				nlohmann::json Dispatcher::request(const ofHttpRequest & request) {
+					return this->requestAsync(request).get();
+				}
+
+				//----------
+				future<nlohmann::json> Dispatcher::requestAsync(const ofHttpRequest& request) {
+					if (!this->parameters.enabled.get()) {
+						return std::async(std::launch::deferred, []() {
+							return nlohmann::json();
+							});
+					}
+
+					auto responseFuture = this->httpClient.request(Dispatcher::toHttpRequest(request)).share();
+					return std::async(std::launch::deferred, [responseFuture]() {
+						return Dispatcher::parseResponse(responseFuture.get());
+						});
+				}
+
+				//----------
+				void Dispatcher::requestAsync(const ofHttpRequest& request, const Callback& callback) {
 					if (!this->parameters.enabled.get()) {
-						return nlohmann::json();
+						callback(nullptr);
+						return;
 					}
 
-					ofURLFileLoader urlLoader;
-					auto response = urlLoader.handleRequest(request);
+					this->httpClient.request(Dispatcher::toHttpRequest(request), [callback](const Utils::HttpClient::Response& response) {
+						try {
+							Dispatcher::parseResponse(response);
+						}
+						catch (...) {
+							callback(current_exception());
+							return;
+						}
+						callback(nullptr);
+						});
+				}
+
+				//----------
+				Utils::HttpClient::Request Dispatcher::toHttpRequest(const ofHttpRequest& request) {
+					Utils::HttpClient::Request httpRequest;
+					{
+						httpRequest.method = request.method == ofHttpRequest::Method::POST
+							? Utils::HttpClient::Method::POST
+							: Utils::HttpClient::Method::GET;
+						httpRequest.url = request.url;
+						httpRequest.body = request.body;
+						httpRequest.contentType = request.contentType;
+						if (request.timeoutSeconds > 0) {
+							httpRequest.timeout = (float)request.timeoutSeconds;
+						}
+					}
+					return httpRequest;
+				}
 
+				//----------
+				nlohmann::json Dispatcher::parseResponse(const Utils::HttpClient::Response& response) {
 					if (response.status != 200) {
 						throw(ofxRulr::Exception("Dispatcher : " + response.error));
 					}
 
-					auto responseJson = nlohmann::json::parse((string)response.data);
+					auto responseJson = nlohmann::json::parse(response.data);
 					if (!responseJson.contains("success")) {
-						throw(ofxRulr::Exception("Dispatcher : Malformed response from server : " + (string)response.data));
+						throw(ofxRulr::Exception("Dispatcher : Malformed response from server : " + response.data));
 					}
 
 					auto success = responseJson["success"];
@@ -98,21 +156,41 @@ namespace ofxRulr {
 
 				//----------
 				nlohmann::json Dispatcher::requestGET(const string& path) {
+					return this->requestGETAsync(path).get();
+				}
+
+				//----------
+				nlohmann::json Dispatcher::requestPOST(const string& path, const nlohmann::json& requestJson) {
+					return this->requestPOSTAsync(path, requestJson).get();
+				}
+
+				//----------
+				future<nlohmann::json> Dispatcher::requestGETAsync(const string& path) {
 					ofHttpRequest request(this->parameters.address.get() + path, "");
 					request.method = ofHttpRequest::Method::GET;
 					request.contentType = "application/json";
 
-					return this->request(request);
+					return this->requestAsync(request);
 				}
 
 				//----------
-				nlohmann::json Dispatcher::requestPOST(const string& path, const nlohmann::json& requestJson) {
+				future<nlohmann::json> Dispatcher::requestPOSTAsync(const string& path, const nlohmann::json& requestJson) {
 					ofHttpRequest request(this->parameters.address.get() + path, "");
 					request.method = ofHttpRequest::Method::POST;
 					request.body = requestJson.dump(4);
 					request.contentType = "application/json";
 
-					return this->request(request);
+					return this->requestAsync(request);
+				}
+
+				//----------
+				void Dispatcher::requestPOSTAsync(const string& path, const nlohmann::json& requestJson, const Callback& callback) {
+					ofHttpRequest request(this->parameters.address.get() + path, "");
+					request.method = ofHttpRequest::Method::POST;
+					request.body = requestJson.dump(4);
+					request.contentType = "application/json";
+
+					this->requestAsync(request, callback);
 				}
 
 				//----------
@@ -149,6 +227,16 @@ namespace ofxRulr {
 
 				//----------
 				void Dispatcher::multiMoveRequest(const MultiMoveRequest& multiMoveRequest) {
+					this->requestPOST("/Servo/MultiMove", Dispatcher::toJson(multiMoveRequest));
+				}
+
+				//----------
+				void Dispatcher::multiMoveRequestAsync(const MultiMoveRequest& multiMoveRequest, const Callback& callback) {
+					this->requestPOSTAsync("/Servo/MultiMove", Dispatcher::toJson(multiMoveRequest), callback);
+				}
+
+				//----------
+				nlohmann::json Dispatcher::toJson(const MultiMoveRequest& multiMoveRequest) {
 					nlohmann::json requestJson;
 					
 					requestJson["movements"] = nlohmann::json::array();
@@ -163,23 +251,31 @@ namespace ofxRulr {
 					requestJson["epsilon"] = multiMoveRequest.epsilon;
 					requestJson["timeout"] = multiMoveRequest.timeout;
 
-					this->requestPOST("/Servo/MultiMove", requestJson);
+					return requestJson;
 				}
 
 				//----------
 				vector<Dispatcher::RegisterValue>
 					Dispatcher::multiGetRequest(const MultiGetRequest& multiGetRequest) {
+					return this->multiGetRequestAsync(multiGetRequest).get();
+				}
+
+				//----------
+				future<vector<Dispatcher::RegisterValue>>
+					Dispatcher::multiGetRequestAsync(const MultiGetRequest& multiGetRequest) {
 					nlohmann::json requestJson;
 
 					requestJson["servoIDs"] = multiGetRequest.servoIDs;
 					requestJson["registerType"] = multiGetRequest.registerName;
 
-					auto result = this->requestPOST("/Servo/MultiGet", requestJson);
-					if (result.empty()) {
-						throw(ofxRulr::Exception("Empty response to multiGetRequest"));
-					}
-					auto values = result.get<vector<Dispatcher::RegisterValue>>();
-					return values;
+					auto resultFuture = this->requestPOSTAsync("/Servo/MultiGet", requestJson).share();
+					return std::async(std::launch::deferred, [resultFuture]() {
+						auto result = resultFuture.get();
+						if (result.empty()) {
+							throw(ofxRulr::Exception("Empty response to multiGetRequest"));
+						}
+						return result.get<vector<Dispatcher::RegisterValue>>();
+						});
 				}
 
 				//----------
@@ -2,6 +2,7 @@
 
 #include "pch_Plugin_Experiments.h"
 #include "ofxRulr/Solvers/HeliostatActionModel.h"
+#include "ofxRulr/Utils/HttpClient.h"
 
 namespace ofxRulr {
 	namespace Nodes {
@@ -34,16 +35,27 @@ namespace ofxRulr {
 						std::string registerName;
 					};
 
+					// Called on a worker thread when the request completes, with the exception if it failed
+					typedef function<void(exception_ptr)> Callback;
+
 					Dispatcher();
 					string getTypeName() const override;
 
 					void init();
+					void update();
 					void populateInspector(ofxCvGui::InspectArguments&);
 
 					nlohmann::json request(const ofHttpRequest&);
 					nlohmann::json requestGET(const string& path);
 					nlohmann::json requestPOST(const string& path, const nlohmann::json& requestJson);
 
+					// The request is sent immediately, the response is parsed (and any error thrown) on get()
+					future<nlohmann::json> requestAsync(const ofHttpRequest&);
+					future<nlohmann::json> requestGETAsync(const string& path);
+					future<nlohmann::json> requestPOSTAsync(const string& path, const nlohmann::json& requestJson);
+					void requestAsync(const ofHttpRequest&, const Callback&);
+					void requestPOSTAsync(const string& path, const nlohmann::json& requestJson, const Callback&);
+
 					void nudge();
 					void zero();
 					void setTorqueEnabled(bool);
@@ -51,14 +63,23 @@ namespace ofxRulr {
 					vector<ServoID> getServoIDs();
 
 					void multiMoveRequest(const MultiMoveRequest&);
+					void multiMoveRequestAsync(const MultiMoveRequest&, const Callback&);
 					vector<RegisterValue> multiGetRequest(const MultiGetRequest&);
+					future<vector<RegisterValue>> multiGetRequestAsync(const MultiGetRequest&);
 					void multiSetRequest(const MultiSetRequest&);
 				protected:
+					static nlohmann::json parseResponse(const Utils::HttpClient::Response&);
+					static Utils::HttpClient::Request toHttpRequest(const ofHttpRequest&);
+					static nlohmann::json toJson(const MultiMoveRequest&);
+
 					struct : ofParameterGroup {
 						ofParameter<string> address{ "Address", "http://localhost:8000" };
 						ofParameter<bool> enabled{ "Enabled", true };
-						PARAM_DECLARE("Dispatcher", address, enabled);
+						ofParameter<int> maxInFlight{ "Max in flight", 4, 1, 64 };
+						PARAM_DECLARE("Dispatcher", address, enabled, maxInFlight);
 					} parameters;
+
+					Utils::HttpClient httpClient;
 				};
 			}
 		}
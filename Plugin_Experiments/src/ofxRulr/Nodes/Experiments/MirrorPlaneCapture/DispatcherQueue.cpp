@@ -0,0 +1,398 @@
+#include "pch_Plugin_Experiments.h"
+#include "DispatcherQueue.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Experiments {
+			namespace MirrorPlaneCapture {
+#pragma mark Histogram
+				//----------
+				void
+					DispatcherQueue::Histogram::add(float value)
+				{
+					size_t bucketIndex = 0;
+					if (value >= 1.0f) {
+						bucketIndex = min((size_t)floor(log2(value)) + 1, bucketCount - 1);
+					}
+					this->counts[bucketIndex]++;
+				}
+
+				//----------
+				size_t
+					DispatcherQueue::Histogram::getTotal() const
+				{
+					size_t total = 0;
+					for (const auto& count : this->counts) {
+						total += count;
+					}
+					return total;
+				}
+
+				//----------
+				string
+					DispatcherQueue::Histogram::getBucketName(size_t bucketIndex)
+				{
+					if (bucketIndex == 0) {
+						return "<1";
+					}
+					auto minimum = (size_t)1 << (bucketIndex - 1);
+					if (bucketIndex >= bucketCount - 1) {
+						return ">=" + ofToString(minimum);
+					}
+					return ofToString(minimum) + "-" + ofToString(minimum * 2);
+				}
+
+#pragma mark DispatcherQueue
+				//----------
+				DispatcherQueue::DispatcherQueue()
+				{
+					this->thread = std::thread([this]() {
+						this->threadFunction();
+						});
+				}
+
+				//----------
+				DispatcherQueue::~DispatcherQueue()
+				{
+					{
+						unique_lock<std::mutex> lock(this->mutex);
+						this->closing = true;
+						this->condition.notify_all();
+					}
+					this->thread.join();
+				}
+
+				//----------
+				shared_future<void>
+					DispatcherQueue::enqueueMoves(shared_ptr<Dispatcher> dispatcher, const Dispatcher::MultiMoveRequest& request)
+				{
+					unique_lock<std::mutex> lock(this->mutex);
+
+					this->statistics.movesEnqueued += request.movements.size();
+
+					// Merge into the last waiting command if it's a compatible move
+					if (!this->commands.empty()) {
+						auto& last = this->commands.back();
+						if (!last->action
+							&& last->dispatcher == dispatcher
+							&& last->waitUntilComplete == request.waitUntilComplete
+							&& last->epsilon == request.epsilon
+							&& last->timeout == request.timeout) {
+							for (const auto& movement : request.movements) {
+								if (last->movements.find(movement.servoID) != last->movements.end()) {
+									this->statistics.movesMerged++;
+								}
+								last->movements[movement.servoID] = movement.position;
+							}
+							return last->future;
+						}
+					}
+
+					auto command = make_shared<Command>();
+					{
+						command->dispatcher = dispatcher;
+						for (const auto& movement : request.movements) {
+							if (command->movements.find(movement.servoID) != command->movements.end()) {
+								this->statistics.movesMerged++;
+							}
+							command->movements[movement.servoID] = movement.position;
+						}
+						command->waitUntilComplete = request.waitUntilComplete;
+						command->epsilon = request.epsilon;
+						command->timeout = request.timeout;
+						command->future = command->promise.get_future().share();
+					}
+					this->commands.push_back(command);
+					this->condition.notify_all();
+
+					return command->future;
+				}
+
+				//----------
+				shared_future<void>
+					DispatcherQueue::enqueueAction(const function<void()>& action)
+				{
+					auto command = make_shared<Command>();
+					{
+						command->action = action;
+						command->future = command->promise.get_future().share();
+					}
+
+					unique_lock<std::mutex> lock(this->mutex);
+					this->commands.push_back(command);
+					this->condition.notify_all();
+
+					return command->future;
+				}
+
+				//----------
+				void
+					DispatcherQueue::setPipelineDepth(size_t pipelineDepth)
+				{
+					unique_lock<std::mutex> lock(this->mutex);
+					this->pipelineDepth = max<size_t>(pipelineDepth, 1);
+					this->condition.notify_all();
+				}
+
+				//----------
+				size_t
+					DispatcherQueue::getPipelineDepth() const
+				{
+					unique_lock<std::mutex> lock(this->mutex);
+					return this->pipelineDepth;
+				}
+
+				//----------
+				size_t
+					DispatcherQueue::getQueueDepth() const
+				{
+					unique_lock<std::mutex> lock(this->mutex);
+					return this->commands.size();
+				}
+
+				//----------
+				size_t
+					DispatcherQueue::getInFlightCount() const
+				{
+					unique_lock<std::mutex> lock(this->mutex);
+					return this->inFlight.size();
+				}
+
+				//----------
+				DispatcherQueue::Statistics
+					DispatcherQueue::getStatistics() const
+				{
+					unique_lock<std::mutex> lock(this->mutex);
+					return this->statistics;
+				}
+
+				//----------
+				void
+					DispatcherQueue::resetStatistics()
+				{
+					unique_lock<std::mutex> lock(this->mutex);
+					this->statistics = Statistics();
+				}
+
+				//----------
+				vector<Dispatcher::ServoID>
+					DispatcherQueue::takeFailedServos()
+				{
+					unique_lock<std::mutex> lock(this->mutex);
+					vector<Dispatcher::ServoID> failedServos;
+					swap(failedServos, this->failedServos);
+					return failedServos;
+				}
+
+				//----------
+				void
+					DispatcherQueue::addToInspector(shared_ptr<ofxCvGui::Panels::Widgets> inspector)
+				{
+					inspector->addTitle("Dispatcher queue", ofxCvGui::Widgets::Title::Level::H3);
+					inspector->addLiveValue<size_t>("Queue depth", [this]() {
+						return this->getQueueDepth();
+						});
+					inspector->addLiveValue<size_t>("In flight", [this]() {
+						return this->getInFlightCount();
+						});
+					inspector->addLiveValue<string>("Moves enqueued / merged", [this]() {
+						auto statistics = this->getStatistics();
+						return ofToString(statistics.movesEnqueued) + " / " + ofToString(statistics.movesMerged);
+						});
+					inspector->addLiveValue<string>("Requests sent / failed", [this]() {
+						auto statistics = this->getStatistics();
+						return ofToString(statistics.requestsSent) + " / " + ofToString(statistics.requestsFailed);
+						});
+
+					auto addHistogram = [this, inspector](const string& title, const function<Histogram(const Statistics&)>& getHistogram) {
+						auto element = ofxCvGui::makeElement();
+						element->setHeight(80.0f);
+						element->onDraw += [this, title, getHistogram](ofxCvGui::DrawArguments& args) {
+							auto histogram = getHistogram(this->getStatistics());
+
+							size_t maxCount = 1;
+							for (const auto& count : histogram.counts) {
+								maxCount = max(maxCount, count);
+							}
+
+							const auto graphHeight = args.localBounds.height - 20.0f;
+							const auto barWidth = args.localBounds.width / (float)Histogram::bucketCount;
+
+							ofPushStyle();
+							{
+								ofFill();
+								ofSetColor(150);
+								for (size_t i = 0; i < Histogram::bucketCount; i++) {
+									auto barHeight = graphHeight * (float)histogram.counts[i] / (float)maxCount;
+									ofDrawRectangle(i * barWidth + 1.0f
+										, 20.0f + graphHeight - barHeight
+										, barWidth - 2.0f
+										, barHeight);
+								}
+								ofSetColor(255);
+								ofDrawBitmapString(title
+									+ " (" + Histogram::getBucketName(0)
+									+ " .. " + Histogram::getBucketName(Histogram::bucketCount - 1) + ")"
+									, 5, 14);
+							}
+							ofPopStyle();
+						};
+						inspector->add(element);
+					};
+					addHistogram("Queue depth", [](const Statistics& statistics) {
+						return statistics.queueDepth;
+						});
+					addHistogram("Latency (ms)", [](const Statistics& statistics) {
+						return statistics.latency;
+						});
+
+					inspector->addButton("Reset queue statistics", [this]() {
+						this->resetStatistics();
+						});
+				}
+
+				//----------
+				void
+					DispatcherQueue::threadFunction()
+				{
+					unique_lock<std::mutex> lock(this->mutex);
+					while (!this->closing) {
+						if (this->commands.empty() || this->isBlocked(*this->commands.front())) {
+							this->condition.wait(lock);
+							continue;
+						}
+
+						auto command = this->commands.front();
+						this->commands.pop_front();
+						this->statistics.queueDepth.add((float)this->commands.size());
+
+						if (command->action) {
+							lock.unlock();
+							try {
+								command->action();
+								command->promise.set_value();
+							}
+							catch (...) {
+								auto exception = current_exception();
+								command->promise.set_exception(exception);
+								try {
+									rethrow_exception(exception);
+								}
+								RULR_CATCH_ALL_TO_ERROR;
+							}
+							lock.lock();
+						}
+						else {
+							InFlight inFlight;
+							{
+								inFlight.command = command;
+								inFlight.startTime = chrono::steady_clock::now();
+							}
+							this->inFlight.push_back(inFlight);
+							this->statistics.requestsSent++;
+
+							lock.unlock();
+							this->send(command);
+							lock.lock();
+						}
+					}
+
+					// Responses to requests which have already been sent still arrive here
+					this->condition.wait(lock, [this]() {
+						return this->inFlight.empty();
+						});
+				}
+
+				//----------
+				bool
+					DispatcherQueue::isBlocked(const Command& command) const
+				{
+					if (command.action) {
+						return !this->inFlight.empty();
+					}
+
+					if (this->inFlight.size() >= this->pipelineDepth) {
+						return true;
+					}
+
+					for (const auto& inFlight : this->inFlight) {
+						for (const auto& movement : command.movements) {
+							if (inFlight.command->movements.find(movement.first) != inFlight.command->movements.end()) {
+								return true;
+							}
+						}
+					}
+
+					return false;
+				}
+
+				//----------
+				void
+					DispatcherQueue::send(shared_ptr<Command> command)
+				{
+					auto startTime = chrono::steady_clock::now();
+
+					Dispatcher::MultiMoveRequest request;
+					{
+						for (const auto& movement : command->movements) {
+							request.movements.push_back({ movement.first, movement.second });
+						}
+						request.waitUntilComplete = command->waitUntilComplete;
+						request.epsilon = command->epsilon;
+						request.timeout = command->timeout;
+					}
+
+					try {
+						command->dispatcher->multiMoveRequestAsync(request, [this, command, startTime](exception_ptr exception) {
+							this->onResponse(command, startTime, exception);
+							});
+					}
+					catch (...) {
+						this->onResponse(command, startTime, current_exception());
+					}
+				}
+
+				//----------
+				void
+					DispatcherQueue::onResponse(shared_ptr<Command> command
+						, const chrono::steady_clock::time_point& startTime
+						, exception_ptr exception)
+				{
+					{
+						unique_lock<std::mutex> lock(this->mutex);
+
+						for (auto it = this->inFlight.begin(); it != this->inFlight.end(); it++) {
+							if (it->command == command) {
+								this->inFlight.erase(it);
+								break;
+							}
+						}
+
+						this->statistics.latency.add(chrono::duration<float, milli>(chrono::steady_clock::now() - startTime).count());
+
+						if (exception) {
+							this->statistics.requestsFailed++;
+							for (const auto& movement : command->movements) {
+								this->failedServos.push_back(movement.first);
+							}
+						}
+
+						// Notify whilst locked (the destructor may be waiting for this response)
+						this->condition.notify_all();
+					}
+
+					if (exception) {
+						command->promise.set_exception(exception);
+						try {
+							rethrow_exception(exception);
+						}
+						RULR_CATCH_ALL_TO_ERROR;
+					}
+					else {
+						command->promise.set_value();
+					}
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Dispatcher.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Experiments {
+			namespace MirrorPlaneCapture {
+				// Commands for a Dispatcher, performed in order on a worker thread.
+				//
+				// Servo moves enqueued whilst earlier moves are still waiting are merged into a single MultiMove,
+				// where the latest position for each servo wins. Up to pipelineDepth MultiMoves are in flight at
+				// once. A MultiMove which moves a servo that is still moving in an earlier request waits for that
+				// request, so the moves for any one servo always arrive in order.
+				//
+				// Other actions wait for all the commands before them to complete.
+				class DispatcherQueue {
+				public:
+					// Bucket 0 counts values < 1, bucket i counts values in [2^(i-1), 2^i), the last bucket counts everything above
+					struct Histogram {
+						static const size_t bucketCount = 14;
+						array<size_t, bucketCount> counts{};
+
+						void add(float value);
+						size_t getTotal() const;
+						static string getBucketName(size_t bucketIndex);
+					};
+
+					struct Statistics {
+						size_t movesEnqueued = 0;
+						size_t movesMerged = 0; // replaced by a later position for the same servo before being sent
+						size_t requestsSent = 0;
+						size_t requestsFailed = 0;
+						Histogram queueDepth; // commands waiting when each request is sent
+						Histogram latency; // [ms] round trip of each request
+					};
+
+					DispatcherQueue();
+					~DispatcherQueue();
+
+					// The future completes when a request containing these moves has completed (or throws if it failed)
+					shared_future<void> enqueueMoves(shared_ptr<Dispatcher>, const Dispatcher::MultiMoveRequest&);
+
+					// Performed on the worker thread once everything before it has completed
+					shared_future<void> enqueueAction(const function<void()>&);
+
+					void setPipelineDepth(size_t);
+					size_t getPipelineDepth() const;
+
+					size_t getQueueDepth() const;
+					size_t getInFlightCount() const;
+
+					Statistics getStatistics() const;
+					void resetStatistics();
+
+					// Servos whose moves failed since the last call
+					vector<Dispatcher::ServoID> takeFailedServos();
+
+					void addToInspector(shared_ptr<ofxCvGui::Panels::Widgets>);
+				protected:
+					struct Command {
+						// Moves
+						shared_ptr<Dispatcher> dispatcher;
+						map<Dispatcher::ServoID, Dispatcher::RegisterValue> movements;
+						bool waitUntilComplete = false;
+						int epsilon = 1;
+						float timeout = 5.0f;
+
+						// Action (if set then this isn't a move)
+						function<void()> action;
+
+						promise<void> promise;
+						shared_future<void> future;
+					};
+
+					struct InFlight {
+						shared_ptr<Command> command;
+						chrono::steady_clock::time_point startTime;
+					};
+
+					void threadFunction();
+					bool isBlocked(const Command&) const;
+					void send(shared_ptr<Command>);
+					void onResponse(shared_ptr<Command>, const chrono::steady_clock::time_point& startTime, exception_ptr);
+
+					// All below guarded by mutex
+					deque<shared_ptr<Command>> commands;
+					vector<InFlight> inFlight;
+					size_t pipelineDepth = 4;
+					Statistics statistics;
+					vector<Dispatcher::ServoID> failedServos;
+					bool closing = false;
+
+					mutable std::mutex mutex;
+					condition_variable condition;
+					std::thread thread;
+				};
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -10,15 +10,6 @@ namespace ofxRulr {
 					RULR_NODE_INIT_LISTENER;
 				}
 
-				//----------
-				Heliostats2::~Heliostats2() {
-					if (this->dispatcherThread.isRunning) {
-						this->dispatcherThread.isClosing = true;
-						this->dispatcherThread.actionsCV.notify_one();
-						this->dispatcherThread.thread.join();
-					}
-				}
-
 				//----------
 				string Heliostats2::getTypeName() const {
 					return "Halo::Heliostats2";
@@ -46,46 +37,16 @@ namespace ofxRulr {
 					}
 
 					this->addInput<Dispatcher>();
-
-					this->dispatcherThread.thread = std::thread([this]() {
-						while (!this->dispatcherThread.isClosing) {
-							std::unique_lock<std::mutex> lock(this->dispatcherThread.actionsLock);
-							this->dispatcherThread.actionsCV.wait_for(lock, std::chrono::seconds(1));
-							if (!this->dispatcherThread.isClosing) {
-								if (!this->dispatcherThread.actions.empty()) {
-									auto action = this->dispatcherThread.actions.front();
-									this->dispatcherThread.actions.pop_front();
-									lock.unlock();
-
-									try {
-										action->action();
-										action->promise.set_value();
-									}
-									RULR_CATCH_ALL_TO_ERROR;
-								}
-							}
-						}
-						});
-					this->dispatcherThread.isRunning = true;
 				}
 
 				//----------
 				void Heliostats2::update() {
-					if (this->parameters.dispatcher.pushStaleValues) {
-						// Check if we already have a pushStale in the queue
-						bool havePushStale = false;
-						this->dispatcherThread.actionsLock.lock();
-						{
-							for (const auto& action : this->dispatcherThread.actions) {
-								if (action->containsPushStale) {
-									havePushStale = true;
-									break;
-								}
-							}
-						}
-						this->dispatcherThread.actionsLock.unlock();
+					this->dispatcherQueue.setPipelineDepth((size_t)this->parameters.dispatcher.pipelineDepth.get());
+					this->retryFailedMoves();
 
-						if (!havePushStale) {
+					if (this->parameters.dispatcher.pushStaleValues) {
+						// Only changed servos are enqueued, and these merge with any moves still waiting in the queue
+						if (this->getInput<Dispatcher>()) {
 							try {
 								this->pushStale(false, false);
 							}
@@ -210,6 +171,25 @@ namespace ofxRulr {
 						}
 						RULR_CATCH_ALL_TO_ALERT;
 						});
+
+					inspector->addTitle("Last navigation", ofxCvGui::Widgets::Title::Level::H3);
+					inspector->addLiveValue<size_t>("Solved", [this]() {
+						return this->lastNavigationStatistics.solved;
+						});
+					inspector->addLiveValue<size_t>("From lookup table", [this]() {
+						return this->lastNavigationStatistics.fromLookupTable;
+						});
+					inspector->addLiveValue<size_t>("Unchanged", [this]() {
+						return this->lastNavigationStatistics.unchanged;
+						});
+					inspector->addLiveValue<size_t>("Failed", [this]() {
+						return this->lastNavigationStatistics.failed;
+						});
+					inspector->addLiveValue<float>("Duration (ms)", [this]() {
+						return this->lastNavigationStatistics.duration;
+						});
+
+					this->dispatcherQueue.addToInspector(inspector);
 				}
 
 				//----------
@@ -394,28 +374,16 @@ namespace ofxRulr {
 						return;
 					}
 
-					auto perform = [=]() {
-						dispatcher->multiMoveRequest(moveRequest);
+					// Mark them as pushed now so they aren't enqueued again (failed moves are marked stale again in update)
+					for (auto heliostat : heliostats) {
+						heliostat->parameters.servo1.markGoalPositionPushed();
+						heliostat->parameters.servo2.markGoalPositionPushed();
+					}
 
-						// Mark them as pushed after the request completes succesfully
-						for (auto heliostat : heliostats) {
-							heliostat->parameters.servo1.markGoalPositionPushed();
-							heliostat->parameters.servo2.markGoalPositionPushed();
-						}
-					};
+					auto future = this->dispatcherQueue.enqueueMoves(dispatcher, moveRequest);
 
 					if (blocking) {
-						perform();
-					}
-					else {
-						this->dispatcherThread.actionsLock.lock();
-						{
-							auto action = make_shared<DispatcherThread::Action>(perform, true);
-							this->dispatcherThread.actions.push_back(action);
-						}
-						this->dispatcherThread.actionsLock.unlock();
-
-						this->dispatcherThread.actionsCV.notify_all();
+						future.get();
 					}
 				}
 
@@ -446,22 +414,28 @@ namespace ofxRulr {
 						}
 					}
 
-					auto perform = [=]() {
-						dispatcher->multiMoveRequest(moveRequest);
-					};
+					auto future = this->dispatcherQueue.enqueueMoves(dispatcher, moveRequest);
 
 					if (blocking) {
-						perform();
+						future.get();
+					}
+				}
+
+				//----------
+				void Heliostats2::retryFailedMoves() {
+					auto failedServos = this->dispatcherQueue.takeFailedServos();
+					if (failedServos.empty()) {
+						return;
 					}
-					else {
-						this->dispatcherThread.actionsLock.lock();
-						{
-							auto action = make_shared<DispatcherThread::Action>(perform, true);
-							this->dispatcherThread.actions.push_back(action);
-						}
-						this->dispatcherThread.actionsLock.unlock();
 
-						this->dispatcherThread.actionsCV.notify_all();
+					set<Dispatcher::ServoID> failedServoIDs(failedServos.begin(), failedServos.end());
+					auto heliostats = this->heliostats.getAllCaptures();
+					for (auto heliostat : heliostats) {
+						for (auto servo : { &heliostat->parameters.servo1, &heliostat->parameters.servo2 }) {
+							if (failedServoIDs.find(servo->ID.get()) != failedServoIDs.end()) {
+								servo->markGoalPositionNeedsPush();
+							}
+						}
 					}
 				}
 
@@ -520,10 +494,18 @@ namespace ofxRulr {
 						multiGetRequest.servoIDs.push_back(it.first);
 					}
 
+					// request both limits at once
+					auto maxRequest = multiGetRequest;
+					maxRequest.registerName = "Max Position Limit";
+					auto maxResponseFuture = dispatcher->multiGetRequestAsync(maxRequest);
+
+					auto minRequest = multiGetRequest;
+					minRequest.registerName = "Min Position Limit";
+					auto minResponseFuture = dispatcher->multiGetRequestAsync(minRequest);
+
 					// get the maximum
 					{
-						multiGetRequest.registerName = "Max Position Limit";
-						auto response = dispatcher->multiGetRequest(multiGetRequest);
+						auto response = maxResponseFuture.get();
 						if (servos.size() != response.size()) {
 							throw(ofxRulr::Exception("Size mismatch"));
 						}
@@ -532,10 +514,9 @@ namespace ofxRulr {
 						}
 					}
 
-					// get the maximum
+					// get the minimum
 					{
-						multiGetRequest.registerName = "Min Position Limit";
-						auto response = dispatcher->multiGetRequest(multiGetRequest);
+						auto response = minResponseFuture.get();
 						if (servos.size() != response.size()) {
 							throw(ofxRulr::Exception("Size mismatch"));
 						}
@@ -599,6 +580,116 @@ namespace ofxRulr {
 					}
 				}
 
+				//----------
+				Heliostats2::NavigationStatistics
+					Heliostats2::navigate(const vector<NavigationTarget>& targets
+						, const ofxCeres::SolverSettings& solverSettings
+						, bool throwIfOutsideRange)
+				{
+					auto startTime = chrono::high_resolution_clock::now();
+
+					NavigationStatistics statistics;
+
+					const auto angleTolerance = this->parameters.navigator.updateTolerance.angle.get();
+					const auto distanceTolerance = this->parameters.navigator.updateTolerance.distance.get();
+					const auto useSunLookupTable = this->parameters.navigator.sunLookupTable.enabled.get();
+
+					// Gather the heliostats which need solving
+					vector<Solvers::HeliostatActionModel::BatchNavigator::Task> tasks;
+					vector<shared_ptr<Heliostat>> taskHeliostats;
+					for (const auto& navigationTarget : targets) {
+						auto heliostat = navigationTarget.heliostat;
+
+						Solvers::HeliostatActionModel::BatchNavigator::Task task;
+						{
+							task.parameters = heliostat->getHeliostatActionModelParameters();
+							task.target = navigationTarget.target;
+							task.initialAngles.axis1 = heliostat->parameters.servo1.angle.get();
+							task.initialAngles.axis2 = heliostat->parameters.servo2.angle.get();
+							if (useSunLookupTable) {
+								task.sunLookupTable = heliostat->sunLookupTable;
+							}
+						}
+
+						const auto& last = heliostat->lastBatchNavigation;
+						if (last.valid
+							&& last.axisAngles.axis1 == task.initialAngles.axis1
+							&& last.axisAngles.axis2 == task.initialAngles.axis2
+							&& Solvers::HeliostatActionModel::BatchNavigator::isSameModel(last.hamParameters, task.parameters)
+							&& !Solvers::HeliostatActionModel::BatchNavigator::hasMoved(last.target
+								, task.target
+								, angleTolerance
+								, distanceTolerance)) {
+							statistics.unchanged++;
+							continue;
+						}
+
+						tasks.push_back(task);
+						taskHeliostats.push_back(heliostat);
+					}
+
+					// Solve
+					Solvers::HeliostatActionModel::BatchNavigator::Settings settings;
+					{
+						settings.solverSettings = solverSettings;
+						settings.threadCount = (size_t)max(this->parameters.navigator.threads.get(), 0);
+						settings.lookupTableResolution = (size_t)this->parameters.navigator.sunLookupTable.resolution.get();
+						settings.lookupTableTolerance = this->parameters.navigator.sunLookupTable.tolerance.get();
+					}
+					auto results = Solvers::HeliostatActionModel::BatchNavigator::solve(tasks, settings);
+
+					// Apply the results
+					vector<string> failedNames;
+					for (size_t i = 0; i < results.size(); i++) {
+						const auto& result = results[i];
+						auto heliostat = taskHeliostats[i];
+
+						if (result.success) {
+							heliostat->parameters.servo1.angle = result.axisAngles.axis1;
+							heliostat->parameters.servo2.angle = result.axisAngles.axis2;
+							heliostat->update();
+
+							auto& last = heliostat->lastBatchNavigation;
+							{
+								last.valid = true;
+								last.target = tasks[i].target;
+								last.hamParameters = tasks[i].parameters;
+								last.axisAngles.axis1 = heliostat->parameters.servo1.angle.get();
+								last.axisAngles.axis2 = heliostat->parameters.servo2.angle.get();
+							}
+
+							if (result.source == Solvers::HeliostatActionModel::BatchNavigator::Source::LookupTable) {
+								statistics.fromLookupTable++;
+							}
+							else {
+								statistics.solved++;
+							}
+						}
+						else {
+							heliostat->lastBatchNavigation.valid = false;
+							ofLogError("H : " + heliostat->parameters.name.get() + " navigate") << result.errorMessage;
+							failedNames.push_back(heliostat->parameters.name.get());
+							statistics.failed++;
+						}
+					}
+
+					statistics.duration = (float) chrono::duration_cast<chrono::microseconds>(chrono::high_resolution_clock::now() - startTime).count() / 1000.0f;
+					this->lastNavigationStatistics = statistics;
+
+					if (!failedNames.empty() && throwIfOutsideRange) {
+						throw(ofxRulr::Exception("Could not navigate mirrors within bounds : " + ofJoinString(failedNames, ", ")));
+					}
+
+					return statistics;
+				}
+
+				//----------
+				const Heliostats2::NavigationStatistics&
+					Heliostats2::getLastNavigationStatistics() const
+				{
+					return this->lastNavigationStatistics;
+				}
+
 				//----------
 				cv::Mat Heliostats2::drawMirrorFaceMask(shared_ptr<Heliostat> heliostat, const ofxRay::Camera& cameraView, float mirrorScale) {
 					ofFbo fbo;
@@ -808,6 +899,8 @@ namespace ofxRulr {
 						Utils::serialize(jsonLimits, "servo2MinAngle", this->parameters.servo2.angle.getMin());
 						Utils::serialize(jsonLimits, "servo2MaxAngle", this->parameters.servo2.angle.getMax());
 					}
+
+					this->navigationCache.serialize(json["navigationCache"]);
 				}
 
 				//----------
@@ -830,6 +923,10 @@ namespace ofxRulr {
 							this->parameters.servo2.angle.setMax(value);
 						}
 					}
+
+					if (json.contains("navigationCache")) {
+						this->navigationCache.deserialize(json["navigationCache"]);
+					}
 				}
 
 				//----------
@@ -848,6 +945,7 @@ namespace ofxRulr {
 						}
 						RULR_CATCH_ALL_TO_ALERT;
 						});
+					this->navigationCache.addToInspector(inspector);
 				}
 
 				//----------
@@ -926,59 +1024,42 @@ namespace ofxRulr {
 
 				//----------
 				void Heliostats2::Heliostat::navigateToNormal(const glm::vec3& normal, const ofxCeres::SolverSettings& solverSettings, bool throwIfOutsideRange) {
-					Solvers::HeliostatActionModel::AxisAngles<float> priorAngles{
-						this->parameters.servo1.angle
-						, this->parameters.servo2.angle
-					};
-					auto hamParameters = this->getHeliostatActionModelParameters();
-
-					auto result = Solvers::HeliostatActionModel::Navigator::solveConstrained(hamParameters
-						, [&](const Solvers::HeliostatActionModel::AxisAngles<float>& initialAngles) {
-							return Solvers::HeliostatActionModel::Navigator::solveNormal(hamParameters
-								, normal
-								, initialAngles
-								, solverSettings);
-						}, priorAngles
+					Utils::SolverCache::Key cacheKey;
+					cacheKey.addStructure("Normal")
+						.addStructure(solverSettings.options.max_num_iterations)
+						.add(solverSettings.options.function_tolerance)
+						.add(normal);
+
+					this->navigate(cacheKey
+						, [&](const Solvers::HeliostatActionModel::Parameters<float>& hamParameters
+							, const Solvers::HeliostatActionModel::AxisAngles<float>& initialAngles) {
+								return Solvers::HeliostatActionModel::Navigator::solveNormal(hamParameters
+									, normal
+									, initialAngles
+									, solverSettings);
+						}
 						, throwIfOutsideRange);
-
-					if (!result.isError) {
-						this->parameters.servo1.angle = result.solution.axisAngles.axis1;
-						this->parameters.servo2.angle = result.solution.axisAngles.axis2;
-					}
-					else {
-						ofLogError("H : " + this->parameters.name.get() + " navigate") << result.errorMessage;
-					}
-
-					this->update();
 				}
 
 				//----------
 				void Heliostats2::Heliostat::navigateToReflectPointToPoint(const glm::vec3& pointA, const glm::vec3& pointB, const ofxCeres::SolverSettings& solverSettings, bool throwIfOutsideRange) {
-					Solvers::HeliostatActionModel::AxisAngles<float> priorAngles{
-							this->parameters.servo1.angle
-							, this->parameters.servo2.angle
-					};
-					auto hamParameters = this->getHeliostatActionModelParameters();
-
-					auto result = Solvers::HeliostatActionModel::Navigator::solveConstrained(hamParameters
-						, [&](const Solvers::HeliostatActionModel::AxisAngles<float>& initialAngles) {
-							return Solvers::HeliostatActionModel::Navigator::solvePointToPoint(hamParameters
-								, pointA
-								, pointB
-								, initialAngles
-								, solverSettings);
-						}, priorAngles
+					Utils::SolverCache::Key cacheKey;
+					cacheKey.addStructure("PointToPoint")
+						.addStructure(solverSettings.options.max_num_iterations)
+						.add(solverSettings.options.function_tolerance)
+						.add(pointA)
+						.add(pointB);
+
+					this->navigate(cacheKey
+						, [&](const Solvers::HeliostatActionModel::Parameters<float>& hamParameters
+							, const Solvers::HeliostatActionModel::AxisAngles<float>& initialAngles) {
+								return Solvers::HeliostatActionModel::Navigator::solvePointToPoint(hamParameters
+									, pointA
+									, pointB
+									, initialAngles
+									, solverSettings);
+						}
 						, throwIfOutsideRange);
-
-					if (!result.isError) {
-						this->parameters.servo1.angle = result.solution.axisAngles.axis1;
-						this->parameters.servo2.angle = result.solution.axisAngles.axis2;
-					}
-					else {
-						ofLogError("H : " + this->parameters.name.get() + " navigate") << result.errorMessage;
-					}
-
-					this->update();
 				}
 
 				//----------
@@ -986,25 +1067,84 @@ namespace ofxRulr {
 					, const glm::vec3& point
 					, const ofxCeres::SolverSettings& solverSettings
 					, bool throwIfOutsideRange) {
-					Solvers::HeliostatActionModel::AxisAngles<float> priorAngles{
-							this->parameters.servo1.angle
-							, this->parameters.servo2.angle
-					};
+					Utils::SolverCache::Key cacheKey;
+					cacheKey.addStructure("VectorToPoint")
+						.addStructure(solverSettings.options.max_num_iterations)
+						.add(solverSettings.options.function_tolerance)
+						.add(incidentVector)
+						.add(point);
+
+					this->navigate(cacheKey
+						, [&](const Solvers::HeliostatActionModel::Parameters<float>& hamParameters
+							, const Solvers::HeliostatActionModel::AxisAngles<float>& initialAngles) {
+								return Solvers::HeliostatActionModel::Navigator::solveVectorToPoint(hamParameters
+									, incidentVector
+									, point
+									, initialAngles
+									, solverSettings);
+						}
+						, throwIfOutsideRange);
+				}
+
+				//----------
+				void Heliostats2::Heliostat::navigate(Utils::SolverCache::Key& cacheKey
+					, const function<Solvers::HeliostatActionModel::Navigator::Result(const Solvers::HeliostatActionModel::Parameters<float>&
+						, const Solvers::HeliostatActionModel::AxisAngles<float>&)>& solveFunction
+					, bool throwIfOutsideRange) {
 					auto hamParameters = this->getHeliostatActionModelParameters();
 
+					// The solution also depends on the model of this heliostat
+					cacheKey.add(hamParameters.position)
+						.add(hamParameters.rotationY)
+						.add(hamParameters.mirrorOffset);
+					for (const auto& axis : { hamParameters.axis1, hamParameters.axis2 }) {
+						cacheKey.add(axis.polynomial)
+							.add(axis.rotationAxis)
+							.add(axis.angleRange.minimum)
+							.add(axis.angleRange.maximum);
+					}
+
+					// ...and on the angles the solve starts from
+					cacheKey.add(this->parameters.servo1.angle.get())
+						.add(this->parameters.servo2.angle.get());
+
+					Solvers::HeliostatActionModel::AxisAngles<float> initialAngles{
+						this->parameters.servo1.angle
+						, this->parameters.servo2.angle
+					};
+
+					auto cacheLookup = this->navigationCache.find(cacheKey);
+					if (cacheLookup.solution.size() == 2) {
+						Solvers::HeliostatActionModel::AxisAngles<float> cachedAngles{
+							(float)cacheLookup.solution[0]
+							, (float)cacheLookup.solution[1]
+						};
+
+						if (cacheLookup.match == Utils::SolverCache::Match::Exact) {
+							// Identical target and model : use the stored angles
+							this->parameters.servo1.angle = cachedAngles.axis1;
+							this->parameters.servo2.angle = cachedAngles.axis2;
+							this->update();
+							return;
+						}
+
+						// Near-identical : start from the stored angles
+						initialAngles = cachedAngles;
+					}
+
 					auto result = Solvers::HeliostatActionModel::Navigator::solveConstrained(hamParameters
-						, [&](const Solvers::HeliostatActionModel::AxisAngles<float>& initialAngles) {
-							return Solvers::HeliostatActionModel::Navigator::solveVectorToPoint(hamParameters
-								, incidentVector
-								, point
-								, initialAngles
-								, solverSettings);
-						}, priorAngles
+						, [&](const Solvers::HeliostatActionModel::AxisAngles<float>& angles) {
+							return solveFunction(hamParameters, angles);
+						}, initialAngles
 						, throwIfOutsideRange);
 
 					if (!result.isError) {
 						this->parameters.servo1.angle = result.solution.axisAngles.axis1;
 						this->parameters.servo2.angle = result.solution.axisAngles.axis2;
+
+						this->navigationCache.store(cacheKey
+							, { result.solution.axisAngles.axis1, result.solution.axisAngles.axis2 }
+							, (float)result.residual);
 					}
 					else {
 						ofLogError("H : " + this->parameters.name.get() + " navigate") << result.errorMessage;
@@ -1090,6 +1230,11 @@ namespace ofxRulr {
 					this->cachedGoalPosition = this->goalPosition.get();
 				}
 
+				//----------
+				void Heliostats2::ServoParameters::markGoalPositionNeedsPush() {
+					this->goalPositionNeedsPush = true;
+				}
+
 				//----------
 				void Heliostats2::ServoParameters::calculateGoalPosition() {
 					auto goalPosition = angleToGoalPosition(this->angle.get());
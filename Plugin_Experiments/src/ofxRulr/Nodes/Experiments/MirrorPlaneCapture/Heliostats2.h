@@ -2,6 +2,8 @@
 
 #include "pch_Plugin_Experiments.h"
 #include "ofxRulr/Solvers/HeliostatActionModel.h"
+#include "ofxRulr/Utils/SolverCache.h"
+#include "DispatcherQueue.h"
 
 namespace ofxRulr {
 	namespace Nodes {
@@ -53,6 +55,7 @@ namespace ofxRulr {
 						void update();
 						bool getGoalPositionNeedsPush() const;
 						void markGoalPositionPushed();
+						void markGoalPositionNeedsPush();
 
 						void calculateGoalPosition();
 						int angleToGoalPosition(float angle);
@@ -132,10 +135,44 @@ namespace ofxRulr {
 							, bool throwIfOutsideRange);
 					protected:
 						ofxCvGui::ElementPtr getDataDisplay() override;
+
+						// Adds the heliostat model to the key, then uses the cached angles (exact match), or solves
+						// starting from the cached angles (nearest match) or the current angles
+						void navigate(Utils::SolverCache::Key&
+							, const function<Solvers::HeliostatActionModel::Navigator::Result(const Solvers::HeliostatActionModel::Parameters<float>&
+								, const Solvers::HeliostatActionModel::AxisAngles<float>&)>&
+							, bool throwIfOutsideRange);
+
+						// Navigation solutions against the target and heliostat model
+						Utils::SolverCache navigationCache{ 32 };
+
+						// Last navigation by Heliostats2::navigate, so that heliostats whose target hasn't moved can be skipped
+						struct {
+							bool valid = false;
+							Solvers::HeliostatActionModel::BatchNavigator::Target target;
+							Solvers::HeliostatActionModel::Parameters<float> hamParameters;
+							Solvers::HeliostatActionModel::AxisAngles<float> axisAngles;
+						} lastBatchNavigation;
+
+						shared_ptr<Solvers::HeliostatActionModel::SunLookupTable> sunLookupTable = make_shared<Solvers::HeliostatActionModel::SunLookupTable>();
+
+						friend class Heliostats2;
+					};
+
+					struct NavigationTarget {
+						shared_ptr<Heliostat> heliostat;
+						Solvers::HeliostatActionModel::BatchNavigator::Target target;
+					};
+
+					struct NavigationStatistics {
+						size_t solved = 0;
+						size_t fromLookupTable = 0;
+						size_t unchanged = 0;
+						size_t failed = 0;
+						float duration = 0.0f; // [ms]
 					};
 
 					Heliostats2();
-					~Heliostats2();
 					string getTypeName() const override;
 
 					void init();
@@ -167,19 +204,43 @@ namespace ofxRulr {
 
 					void selectRangeByString(const string&);
 
+					// Navigates the heliostats concurrently, each starting from its current angles.
+					// Heliostats whose model and target haven't moved beyond the update tolerance since they were last
+					// navigated here (and whose angles haven't been changed since) are left as they are.
+					NavigationStatistics navigate(const vector<NavigationTarget>&
+						, const ofxCeres::SolverSettings&
+						, bool throwIfOutsideRange);
+					const NavigationStatistics& getLastNavigationStatistics() const;
+
 					cv::Mat drawMirrorFaceMask(shared_ptr<Heliostat>, const ofxRay::Camera&, float mirrorScale);
 
 				protected:
 					struct : ofParameterGroup {
 						struct : ofParameterGroup {
 							ofParameter<bool> printReport{ "Print report", true };
-							PARAM_DECLARE("Navigator", printReport);
+							ofParameter<int> threads{ "Threads", 0 }; // 0 = solver thread budget
+
+							struct : ofParameterGroup {
+								ofParameter<float> angle{ "Angle (deg)", 0.01f, 0.0f, 10.0f };
+								ofParameter<float> distance{ "Distance (m)", 0.001f, 0.0f, 1.0f };
+								PARAM_DECLARE("Update tolerance", angle, distance);
+							} updateTolerance;
+
+							struct : ofParameterGroup {
+								ofParameter<bool> enabled{ "Enabled", false };
+								ofParameter<int> resolution{ "Resolution", 36, 4, 360 };
+								ofParameter<float> tolerance{ "Tolerance (m)", 0.005f, 0.0f, 1.0f };
+								PARAM_DECLARE("Sun lookup table", enabled, resolution, tolerance);
+							} sunLookupTable;
+
+							PARAM_DECLARE("Navigator", printReport, threads, updateTolerance, sunLookupTable);
 						} navigator;
 
 						struct : ofParameterGroup {
 							ofParameter<bool> pushStaleValues{ "Push stale every frame", true };
 							ofParameter<float> timeout{ "Timeout", 10.0f };
-							PARAM_DECLARE("Dispatcher", pushStaleValues, timeout);
+							ofParameter<int> pipelineDepth{ "Pipeline depth", 4, 1, 32 };
+							PARAM_DECLARE("Dispatcher", pushStaleValues, timeout, pipelineDepth);
 						} dispatcher;
 
 						struct : ofParameterGroup {
@@ -200,28 +261,11 @@ namespace ofxRulr {
 					Utils::CaptureSet<Heliostat> heliostats;
 					shared_ptr<ofxCvGui::Panels::Widgets> panel;
 
-					struct DispatcherThread {
-						struct Action {
-							Action(const function<void()>& action, bool isPushStale)
-								: action(action)
-								, containsPushStale(containsPushStale)
-								, future(promise.get_future())
-							{
+					NavigationStatistics lastNavigationStatistics;
 
-							}
+					void retryFailedMoves();
 
-							function<void()> action;
-							bool containsPushStale;
-							promise<void> promise;
-							future<void> future;
-						};
-						std::deque<shared_ptr<Action>> actions;
-						std::mutex actionsLock;
-						condition_variable actionsCV;
-						std::thread thread;
-						bool isRunning = false;
-						bool isClosing = false;
-					} dispatcherThread;
+					DispatcherQueue dispatcherQueue;
 				};
 			}
 		}
@@ -207,6 +207,7 @@ namespace ofxRulr {
 						haloPlane.setInfinite(true);
 					}
 
+					vector<Heliostats2::NavigationTarget> navigationTargets;
 					for (auto heliostat : heliostats) {
 						auto heliostatPosition = heliostat->parameters.hamParameters.position.get();
 						// Calculate the target point in view space
@@ -242,12 +243,18 @@ namespace ofxRulr {
 
 						this->targetsCache.emplace(heliostat->getName(), cachedTarget);
 
-						heliostat->navigateToReflectVectorToPoint(solarIncidentVector
-							, targetWorldSpace
-							, solverSettings
-							, false);
+						Heliostats2::NavigationTarget navigationTarget;
+						{
+							navigationTarget.heliostat = heliostat;
+							navigationTarget.target.mode = Solvers::HeliostatActionModel::BatchNavigator::Mode::VectorToPoint;
+							navigationTarget.target.a = solarIncidentVector;
+							navigationTarget.target.b = targetWorldSpace;
+						}
+						navigationTargets.push_back(navigationTarget);
 					}
 
+					heliostatsNode->navigate(navigationTargets, solverSettings, false);
+
 					this->lastUpdateTime = chrono::system_clock::now();
 				}
 
@@ -268,11 +275,19 @@ namespace ofxRulr {
 						solverSettings.options.function_tolerance = this->parameters.solver.functionTolerance.get();
 					}
 
+					vector<Heliostats2::NavigationTarget> navigationTargets;
 					for (auto heliostat : heliostats) {
-						auto heliostatPosition = heliostat->parameters.hamParameters.position.get();
-						heliostat->navigateToNormal(-solarIncidentVector, solverSettings, true);
+						Heliostats2::NavigationTarget navigationTarget;
+						{
+							navigationTarget.heliostat = heliostat;
+							navigationTarget.target.mode = Solvers::HeliostatActionModel::BatchNavigator::Mode::Normal;
+							navigationTarget.target.a = -solarIncidentVector;
+						}
+						navigationTargets.push_back(navigationTarget);
 					}
 
+					heliostatsNode->navigate(navigationTargets, solverSettings, true);
+
 					this->lastUpdateTime = chrono::system_clock::now();
 				}
 
@@ -0,0 +1,137 @@
+#include "pch_Plugin_Experiments.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Experiments {
+			namespace MirrorPlaneCapture {
+				//----------
+				SolverBenchmark::SolverBenchmark() {
+					RULR_NODE_INIT_LISTENER;
+				}
+
+				//----------
+				string SolverBenchmark::getTypeName() const {
+					return "Halo::SolverBenchmark";
+				}
+
+				//----------
+				void SolverBenchmark::init() {
+					this->manageParameters(this->parameters);
+				}
+
+				//----------
+				void SolverBenchmark::runTrial(size_t trial) {
+					typedef Solvers::HeliostatActionModel HAM;
+
+					const auto columns = max(this->parameters.heliostats.columns.get(), 1);
+					const auto rows = max(this->parameters.heliostats.rows.get(), 1);
+					const auto pitch = this->parameters.heliostats.pitch.get();
+					const auto lightDistance = this->parameters.scene.lightDistance.get();
+					const auto targetDistance = this->parameters.scene.targetDistance.get();
+					const auto initialAngleError = this->parameters.scene.initialAngleError.get();
+
+					struct Heliostat {
+						HAM::Parameters<float> parameters;
+						HAM::AxisAngles<float> initialAngles;
+						glm::vec3 normal;
+						glm::vec3 pointA;
+						glm::vec3 pointB;
+					};
+
+					// Ground truth
+					vector<Heliostat> heliostats;
+					for (int j = 0; j < rows; j++) {
+						for (int i = 0; i < columns; i++) {
+							Heliostat heliostat;
+
+							auto& parameters = heliostat.parameters;
+							parameters.position = {
+								((float)i - (float)(columns - 1) / 2.0f) * pitch
+								, 0.0f
+								, ((float)j - (float)(rows - 1) / 2.0f) * pitch
+							};
+							parameters.rotationY = ofRandom(-180, 180);
+							parameters.axis1.rotationAxis = { 0, -1, 0 };
+							parameters.axis1.polynomial = { 0, 1, 0 };
+							parameters.axis1.angleRange.minimum = -180;
+							parameters.axis1.angleRange.maximum = 180;
+							parameters.axis2.rotationAxis = { 1, 0, 0 };
+							parameters.axis2.polynomial = { 0, 1, 0 };
+							parameters.axis2.angleRange.minimum = -90;
+							parameters.axis2.angleRange.maximum = 90;
+							parameters.mirrorOffset = 0.136f;
+
+							HAM::AxisAngles<float> axisAngles{
+								ofRandom(-90, 90)
+								, ofRandom(-60, 60)
+							};
+							heliostat.initialAngles = {
+								axisAngles.axis1 + ofRandomf() * initialAngleError
+								, axisAngles.axis2 + ofRandomf() * initialAngleError
+							};
+
+							auto mirrorPlane = HAM::getMirrorPlane(axisAngles, parameters);
+							heliostat.normal = mirrorPlane.normal;
+
+							// Light and target both in front of the mirror, with the target at the reflection of the light
+							glm::vec3 toLight;
+							do {
+								toLight = glm::normalize(glm::vec3(ofRandomf(), ofRandomf(), ofRandomf()));
+							} while (glm::dot(toLight, mirrorPlane.normal) < 0.3f);
+							auto toTarget = glm::reflect(-toLight, mirrorPlane.normal);
+							heliostat.pointA = mirrorPlane.center + toLight * lightDistance;
+							heliostat.pointB = mirrorPlane.center + toTarget * targetDistance;
+
+							heliostats.push_back(heliostat);
+						}
+					}
+
+					auto solverSettings = HAM::Navigator::defaultSolverSettings();
+					solverSettings.printReport = false;
+
+					// Normal
+					this->benchmark.measure("HeliostatActionModel::Navigator::solveNormal", "Heliostats", heliostats.size(), trial, [&](Utils::SolverBenchmark::Record& record) {
+						record.converged = true;
+						for (const auto& heliostat : heliostats) {
+							auto result = HAM::Navigator::solveNormal(heliostat.parameters
+								, heliostat.normal
+								, heliostat.initialAngles
+								, solverSettings);
+							record.addIterations(result.iterations);
+							record.converged &= result.isConverged();
+							record.residual += result.residual;
+
+							auto normal = HAM::getMirrorPlane(result.solution.axisAngles, heliostat.parameters).normal;
+							record.parameterError += acos(ofClamp(glm::dot(normal, heliostat.normal), -1.0f, 1.0f)) * RAD_TO_DEG;
+						}
+						record.residual /= (float)heliostats.size();
+						record.parameterError /= (float)heliostats.size();
+					});
+
+					// Point to point (error is the angle between the reflected beam and the direction to the target)
+					this->benchmark.measure("HeliostatActionModel::Navigator::solvePointToPoint", "Heliostats", heliostats.size(), trial, [&](Utils::SolverBenchmark::Record& record) {
+						record.converged = true;
+						for (const auto& heliostat : heliostats) {
+							auto result = HAM::Navigator::solvePointToPoint(heliostat.parameters
+								, heliostat.pointA
+								, heliostat.pointB
+								, heliostat.initialAngles
+								, solverSettings);
+							record.addIterations(result.iterations);
+							record.converged &= result.isConverged();
+							record.residual += result.residual;
+
+							auto mirrorPlane = HAM::getMirrorPlane(result.solution.axisAngles, heliostat.parameters);
+							auto incident = glm::normalize(mirrorPlane.center - heliostat.pointA);
+							auto reflected = glm::reflect(incident, mirrorPlane.normal);
+							auto desired = glm::normalize(heliostat.pointB - mirrorPlane.center);
+							record.parameterError += acos(ofClamp(glm::dot(reflected, desired), -1.0f, 1.0f)) * RAD_TO_DEG;
+						}
+						record.residual /= (float)heliostats.size();
+						record.parameterError /= (float)heliostats.size();
+					});
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "pch_Plugin_Experiments.h"
+#include "ofxRulr/Nodes/Test/AbstractSolverBenchmark.h"
+#include "ofxRulr/Solvers/HeliostatActionModel.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Experiments {
+			namespace MirrorPlaneCapture {
+				// Navigates a synthetic field of heliostats (known HAM parameters and axis angles)
+				// and records time and pointing error against the known mirror planes
+				class SolverBenchmark : public Test::AbstractSolverBenchmark {
+				public:
+					SolverBenchmark();
+					string getTypeName() const override;
+					void init();
+				protected:
+					void runTrial(size_t trial) override;
+
+					struct : ofParameterGroup {
+						struct : ofParameterGroup {
+							ofParameter<int> columns{ "Columns", 8 };
+							ofParameter<int> rows{ "Rows", 8 };
+							ofParameter<float> pitch{ "Pitch", 1, 0.1, 10 };
+							PARAM_DECLARE("Heliostats", columns, rows, pitch);
+						} heliostats;
+
+						struct : ofParameterGroup {
+							ofParameter<float> lightDistance{ "Light distance", 10, 0.1, 1000 };
+							ofParameter<float> targetDistance{ "Target distance", 10, 0.1, 1000 };
+							ofParameter<float> initialAngleError{ "Initial angle error", 20, 0, 180 };
+							PARAM_DECLARE("Scene", lightDistance, targetDistance, initialAngleError);
+						} scene;
+
+						PARAM_DECLARE("SolverBenchmark", heliostats, scene);
+					} parameters;
+				};
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -61,12 +61,19 @@ namespace ofxRulr {
 					solverSettings.printReport = this->parameters.navigator.printReport.get();
 					solverSettings.options.minimizer_progress_to_stdout = this->parameters.navigator.printReport.get();
 
+					vector<Heliostats2::NavigationTarget> navigationTargets;
 					for (auto heliostat : heliostats) {
-						heliostat->navigateToReflectPointToPoint(cursorInWorld
-							, cursorInWorld
-							, solverSettings
-							, false);
+						Heliostats2::NavigationTarget navigationTarget;
+						{
+							navigationTarget.heliostat = heliostat;
+							navigationTarget.target.mode = Solvers::HeliostatActionModel::BatchNavigator::Mode::PointToPoint;
+							navigationTarget.target.a = cursorInWorld;
+							navigationTarget.target.b = cursorInWorld;
+						}
+						navigationTargets.push_back(navigationTarget);
 					}
+
+					heliostatsNode->navigate(navigationTargets, solverSettings, false);
 				}
 			}
 		}
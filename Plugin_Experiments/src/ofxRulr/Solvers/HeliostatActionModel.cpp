@@ -111,7 +111,11 @@ namespace ofxRulr {
 			// If the angles were altered by constraints, then re-solve
 			if (changedByConstrain) {
 				// Then solve again for tighter accuracy
+				auto firstIterations = result.iterations;
 				result = solveFunction(result.solution.axisAngles);
+				if (firstIterations >= 0 && result.iterations >= 0) {
+					result.iterations += firstIterations;
+				}
 			}
 
 			// Final check if we need to constrain angles
@@ -1,5 +1,6 @@
 #pragma once
 #include "ofxCeres.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 #include <glm/glm.hpp>
 
 #include "ofxRulr/Nodes/Experiments/MirrorPlaneCapture/Dispatcher.h"
@@ -183,7 +184,7 @@ namespace ofxRulr {
 				struct Solution {
 					AxisAngles<float> axisAngles;
 				};
-				typedef ofxCeres::Result<Solution> Result;
+				typedef Utils::SolveResult<Solution> Result;
 
 				static ofxCeres::SolverSettings defaultSolverSettings();
 
@@ -218,6 +219,109 @@ namespace ofxRulr {
 					, bool throwIfOutsideConstraints);
 			};
 
+			// Axis angles which reflect the sun onto a fixed point, precomputed over a grid of sun directions.
+			// Sun directions are stored as azimuth (around +y, from +x towards +z) and altitude (0..90 degrees above the horizon).
+			class SunLookupTable {
+			public:
+				// resolution is the number of azimuth steps. The altitude has resolution / 4 + 1 steps
+				void build(const Parameters<float>&
+					, const glm::vec3& point
+					, size_t resolution
+					, const ofxCeres::SolverSettings& = Navigator::defaultSolverSettings());
+
+				bool isBuiltFor(const Parameters<float>&
+					, const glm::vec3& point
+					, size_t resolution) const;
+
+				// Interpolates between the surrounding samples (or takes the nearest if they straddle a flip of the axes).
+				// Returns false if the sun is below the horizon or a surrounding sample couldn't be solved
+				bool lookup(const glm::vec3& incidentVector, AxisAngles<float>&) const;
+
+				void clear();
+				size_t getResolution() const;
+			protected:
+				struct Sample {
+					AxisAngles<float> axisAngles;
+					bool valid = false;
+				};
+
+				size_t getAltitudeCount() const;
+				const Sample& getSample(size_t azimuthIndex, size_t altitudeIndex) const;
+				static glm::vec3 getIncidentVector(float azimuth, float altitude);
+
+				Parameters<float> parameters;
+				glm::vec3 point;
+				size_t resolution = 0;
+				vector<Sample> samples;
+			};
+
+			// Navigates many heliostats at once, split across worker threads.
+			// Each task starts from its initialAngles (typically the previous solution), and VectorToPoint tasks
+			// can use a SunLookupTable for the initial guess (or as the answer if it lands within tolerance).
+			class BatchNavigator {
+			public:
+				enum class Mode {
+					Normal,
+					PointToPoint,
+					VectorToPoint
+				};
+
+				struct Target {
+					Mode mode = Mode::Normal;
+					glm::vec3 a; // Normal : normal, PointToPoint : point A, VectorToPoint : incident vector
+					glm::vec3 b; // PointToPoint : point B, VectorToPoint : point
+				};
+
+				struct Task {
+					Parameters<float> parameters;
+					Target target;
+					AxisAngles<float> initialAngles;
+
+					// Optional. Only used for VectorToPoint, (re)built by solve if it doesn't match the parameters and point.
+					// Each task must have its own table.
+					shared_ptr<SunLookupTable> sunLookupTable;
+				};
+
+				enum class Source {
+					Solve,
+					LookupTable
+				};
+
+				struct Result {
+					AxisAngles<float> axisAngles;
+					float residual = 0.0f; // see getResidual
+					bool success = false;
+					Source source = Source::Solve;
+					string errorMessage;
+				};
+
+				struct Settings {
+					ofxCeres::SolverSettings solverSettings = Navigator::defaultSolverSettings();
+					size_t threadCount = 0; // 0 = as many as the SolverRuntime's thread budget allows
+					size_t lookupTableResolution = 36;
+					float lookupTableTolerance = 0.005f; // [m] accept the table's answer without solving (0 = always solve)
+				};
+
+				// Results are in the same order as the tasks. Solutions are constrained to the axis ranges
+				static vector<Result> solve(const vector<Task>&, const Settings&);
+
+				// Normal : angle [deg] between the mirror normal and the target normal
+				// PointToPoint / VectorToPoint : distance [m] between the target point and the reflected ray
+				static float getResidual(const Parameters<float>&
+					, const AxisAngles<float>&
+					, const Target&);
+
+				// True if the target has moved by more than either tolerance
+				static bool hasMoved(const Target& previous
+					, const Target& current
+					, float angleTolerance // [deg]
+					, float distanceTolerance); // [m]
+
+				static bool isSameModel(const Parameters<float>&, const Parameters<float>&);
+			protected:
+				static Result solveTask(const Task&, const Settings&);
+			};
+
 			class SolvePosition {
 			public:
 				typedef Nodes::Experiments::MirrorPlaneCapture::Dispatcher::RegisterValue Solution;
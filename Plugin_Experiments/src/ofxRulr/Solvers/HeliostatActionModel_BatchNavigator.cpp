@@ -0,0 +1,191 @@
+#include "pch_Plugin_Experiments.h"
+#include "HeliostatActionModel.h"
+#include "ofxRulr/Utils/SolverRuntime.h"
+
+namespace ofxRulr {
+	namespace Solvers {
+		//----------
+		vector<HeliostatActionModel::BatchNavigator::Result>
+			HeliostatActionModel::BatchNavigator::solve(const vector<Task>& tasks, const Settings& settings)
+		{
+			vector<Result> results(tasks.size());
+			if (tasks.empty()) {
+				return results;
+			}
+
+			// Each solve is small, so we parallelise over heliostats rather than within the solve
+			auto taskSettings = settings;
+			taskSettings.solverSettings.options.num_threads = 1;
+
+			auto threadLease = Utils::SolverRuntime::X().acquireThreads(settings.threadCount);
+			auto threadCount = min(threadLease->getThreadCount(), tasks.size());
+
+			// Workers take the next task from a shared counter (building a lookup table takes much longer than a solve)
+			atomic<size_t> nextTask{ 0 };
+			auto worker = [&]() {
+				for (auto i = nextTask++; i < tasks.size(); i = nextTask++) {
+					try {
+						results[i] = BatchNavigator::solveTask(tasks[i], taskSettings);
+					}
+					catch (const std::exception& e) {
+						results[i].success = false;
+						results[i].errorMessage = e.what();
+					}
+				}
+			};
+
+			if (threadCount <= 1) {
+				worker();
+				return results;
+			}
+
+			vector<future<void>> workers;
+			for (size_t i = 0; i < threadCount; i++) {
+				workers.push_back(std::async(std::launch::async, worker));
+			}
+			for (auto& worker : workers) {
+				worker.get();
+			}
+
+			return results;
+		}
+
+		//----------
+		float
+			HeliostatActionModel::BatchNavigator::getResidual(const Parameters<float>& hamParameters
+				, const AxisAngles<float>& axisAngles
+				, const Target& target)
+		{
+			auto mirrorPlane = HeliostatActionModel::getMirrorPlane(axisAngles, hamParameters);
+
+			switch (target.mode) {
+			case Mode::Normal:
+			{
+				auto cosAngle = ofClamp(glm::dot(mirrorPlane.normal, glm::normalize(target.a)), -1.0f, 1.0f);
+				return acos(cosAngle) * RAD_TO_DEG;
+			}
+			case Mode::PointToPoint:
+			{
+				ofxCeres::Models::Ray<float> incidentRay;
+				incidentRay.s = target.a;
+				incidentRay.t = glm::normalize(mirrorPlane.center - target.a);
+				return mirrorPlane.reflect(incidentRay).distanceTo(target.b);
+			}
+			case Mode::VectorToPoint:
+			default:
+			{
+				ofxCeres::Models::Ray<float> incidentRay;
+				incidentRay.t = target.a;
+				incidentRay.s = mirrorPlane.center - incidentRay.t;
+				return mirrorPlane.reflect(incidentRay).distanceTo(target.b);
+			}
+			}
+		}
+
+		//----------
+		bool
+			HeliostatActionModel::BatchNavigator::hasMoved(const Target& previous
+				, const Target& current
+				, float angleTolerance
+				, float distanceTolerance)
+		{
+			if (previous.mode != current.mode) {
+				return true;
+			}
+
+			auto angleBetween = [](const glm::vec3& a, const glm::vec3& b) {
+				auto cosAngle = ofClamp(glm::dot(glm::normalize(a), glm::normalize(b)), -1.0f, 1.0f);
+				return acos(cosAngle) * RAD_TO_DEG;
+			};
+
+			switch (current.mode) {
+			case Mode::Normal:
+				return angleBetween(previous.a, current.a) > angleTolerance;
+			case Mode::PointToPoint:
+				return glm::distance(previous.a, current.a) > distanceTolerance
+					|| glm::distance(previous.b, current.b) > distanceTolerance;
+			case Mode::VectorToPoint:
+			default:
+				return angleBetween(previous.a, current.a) > angleTolerance
+					|| glm::distance(previous.b, current.b) > distanceTolerance;
+			}
+		}
+
+		//----------
+		bool
+			HeliostatActionModel::BatchNavigator::isSameModel(const Parameters<float>& a, const Parameters<float>& b)
+		{
+			auto isSameAxis = [](const Parameters<float>::Axis& a, const Parameters<float>::Axis& b) {
+				return a.rotationAxis == b.rotationAxis
+					&& a.polynomial == b.polynomial
+					&& a.angleRange.minimum == b.angleRange.minimum
+					&& a.angleRange.maximum == b.angleRange.maximum;
+			};
+
+			return a.position == b.position
+				&& a.rotationY == b.rotationY
+				&& a.mirrorOffset == b.mirrorOffset
+				&& isSameAxis(a.axis1, b.axis1)
+				&& isSameAxis(a.axis2, b.axis2);
+		}
+
+		//----------
+		HeliostatActionModel::BatchNavigator::Result
+			HeliostatActionModel::BatchNavigator::solveTask(const Task& task, const Settings& settings)
+		{
+			Result result;
+
+			auto initialAngles = task.initialAngles;
+
+			if (task.sunLookupTable && task.target.mode == Mode::VectorToPoint) {
+				if (!task.sunLookupTable->isBuiltFor(task.parameters, task.target.b, settings.lookupTableResolution)) {
+					task.sunLookupTable->build(task.parameters
+						, task.target.b
+						, settings.lookupTableResolution
+						, settings.solverSettings);
+				}
+
+				AxisAngles<float> lookupAngles;
+				if (task.sunLookupTable->lookup(task.target.a, lookupAngles)) {
+					auto lookupResidual = BatchNavigator::getResidual(task.parameters, lookupAngles, task.target);
+					if (lookupResidual <= settings.lookupTableTolerance
+						&& Navigator::validate(task.parameters, lookupAngles)) {
+						result.axisAngles = lookupAngles;
+						result.residual = lookupResidual;
+						result.success = true;
+						result.source = Source::LookupTable;
+						return result;
+					}
+
+					initialAngles = lookupAngles;
+				}
+			}
+
+			const auto& hamParameters = task.parameters;
+			const auto& target = task.target;
+			const auto& solverSettings = settings.solverSettings;
+
+			auto solveResult = Navigator::solveConstrained(hamParameters
+				, [&](const AxisAngles<float>& angles) {
+					switch (target.mode) {
+					case Mode::Normal:
+						return Navigator::solveNormal(hamParameters, target.a, angles, solverSettings);
+					case Mode::PointToPoint:
+						return Navigator::solvePointToPoint(hamParameters, target.a, target.b, angles, solverSettings);
+					case Mode::VectorToPoint:
+					default:
+						return Navigator::solveVectorToPoint(hamParameters, target.a, target.b, angles, solverSettings);
+					}
+				}
+				, initialAngles
+				, false);
+
+			result.axisAngles = solveResult.solution.axisAngles;
+			result.residual = BatchNavigator::getResidual(hamParameters, result.axisAngles, target);
+			result.success = !solveResult.isError;
+			result.errorMessage = solveResult.errorMessage;
+			result.source = Source::Solve;
+			return result;
+		}
+	}
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "pch_Plugin_Experiments.h"
 #include "HeliostatActionModel.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 using namespace ofxCeres::VectorMath;
 using namespace ofxRulr::Solvers;
@@ -240,7 +241,8 @@ namespace ofxRulr {
 
 			// Solve the fit
 			ceres::Solver::Summary summary;
-			ceres::Solve(solverSettings.options
+			Utils::solveCeres("HeliostatActionModel::Calibrator"
+				, solverSettings.options
 				, &problem
 				, &summary);
 
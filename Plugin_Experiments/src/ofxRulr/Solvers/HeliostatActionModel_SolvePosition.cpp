@@ -1,5 +1,6 @@
 #include "pch_Plugin_Experiments.h"
 #include "HeliostatActionModel.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 using namespace ofxCeres::VectorMath;
 
@@ -86,7 +87,8 @@ namespace ofxRulr {
 
 			// Solve the fit
 			ceres::Solver::Summary summary;
-			ceres::Solve(solverSettings.options
+			Utils::solveCeres("HeliostatActionModel::SolvePosition"
+				, solverSettings.options
 				, &problem
 				, &summary);
 
@@ -0,0 +1,199 @@
+#include "pch_Plugin_Experiments.h"
+#include "HeliostatActionModel.h"
+
+namespace ofxRulr {
+	namespace Solvers {
+		//----------
+		void
+			HeliostatActionModel::SunLookupTable::build(const Parameters<float>& hamParameters
+				, const glm::vec3& point
+				, size_t resolution
+				, const ofxCeres::SolverSettings& solverSettings)
+		{
+			this->clear();
+			if (resolution < 4) {
+				throw(ofxRulr::Exception("Sun lookup table resolution must be at least 4"));
+			}
+
+			this->parameters = hamParameters;
+			this->point = point;
+			this->resolution = resolution;
+
+			const auto altitudeCount = this->getAltitudeCount();
+			this->samples.resize(resolution * altitudeCount);
+
+			const auto azimuthStep = TWO_PI / (float)resolution;
+			const auto altitudeStep = HALF_PI / (float)(altitudeCount - 1);
+
+			// Walk each row back and forth so that every solve starts from its neighbour's solution
+			AxisAngles<float> priorAngles{ 0.0f, 0.0f };
+			for (size_t altitudeIndex = 0; altitudeIndex < altitudeCount; altitudeIndex++) {
+				for (size_t i = 0; i < resolution; i++) {
+					auto azimuthIndex = altitudeIndex % 2 == 0
+						? i
+						: resolution - 1 - i;
+
+					auto incidentVector = SunLookupTable::getIncidentVector(azimuthIndex * azimuthStep
+						, altitudeIndex * altitudeStep);
+
+					auto & sample = this->samples[altitudeIndex * resolution + azimuthIndex];
+					try {
+						auto result = Navigator::solveConstrained(hamParameters
+							, [&](const AxisAngles<float>& initialAngles) {
+								return Navigator::solveVectorToPoint(hamParameters
+									, incidentVector
+									, point
+									, initialAngles
+									, solverSettings);
+							}
+							, priorAngles
+							, false);
+
+						if (!result.isError) {
+							sample.axisAngles = result.solution.axisAngles;
+							sample.valid = true;
+							priorAngles = sample.axisAngles;
+						}
+					}
+					catch (...) {
+						// Leave the sample invalid
+					}
+				}
+			}
+		}
+
+		//----------
+		bool
+			HeliostatActionModel::SunLookupTable::isBuiltFor(const Parameters<float>& hamParameters
+				, const glm::vec3& point
+				, size_t resolution) const
+		{
+			return this->resolution == resolution
+				&& !this->samples.empty()
+				&& this->point == point
+				&& BatchNavigator::isSameModel(this->parameters, hamParameters);
+		}
+
+		//----------
+		bool
+			HeliostatActionModel::SunLookupTable::lookup(const glm::vec3& incidentVector
+				, AxisAngles<float>& axisAngles) const
+		{
+			if (this->samples.empty()) {
+				return false;
+			}
+
+			auto solarVector = -glm::normalize(incidentVector);
+			if (solarVector.y < 0.0f) {
+				return false;
+			}
+
+			auto azimuth = atan2(solarVector.z, solarVector.x);
+			if (azimuth < 0.0f) {
+				azimuth += TWO_PI;
+			}
+			auto altitude = asin(ofClamp(solarVector.y, 0.0f, 1.0f));
+
+			const auto altitudeCount = this->getAltitudeCount();
+
+			// Fractional position in the grid (azimuth wraps around, altitude is clamped)
+			auto azimuthPosition = azimuth / TWO_PI * (float)this->resolution;
+			auto altitudePosition = altitude / HALF_PI * (float)(altitudeCount - 1);
+
+			auto azimuthIndex = min((size_t)azimuthPosition, this->resolution - 1);
+			auto altitudeIndex = min((size_t)altitudePosition, altitudeCount - 2);
+			auto azimuthFraction = ofClamp(azimuthPosition - (float)azimuthIndex, 0.0f, 1.0f);
+			auto altitudeFraction = ofClamp(altitudePosition - (float)altitudeIndex, 0.0f, 1.0f);
+			auto nextAzimuthIndex = (azimuthIndex + 1) % this->resolution;
+
+			const Sample* corners[4] = {
+				&this->getSample(azimuthIndex, altitudeIndex)
+				, &this->getSample(nextAzimuthIndex, altitudeIndex)
+				, &this->getSample(azimuthIndex, altitudeIndex + 1)
+				, &this->getSample(nextAzimuthIndex, altitudeIndex + 1)
+			};
+			const float weights[4] = {
+				(1.0f - azimuthFraction) * (1.0f - altitudeFraction)
+				, azimuthFraction * (1.0f - altitudeFraction)
+				, (1.0f - azimuthFraction) * altitudeFraction
+				, azimuthFraction * altitudeFraction
+			};
+
+			for (const auto corner : corners) {
+				if (!corner->valid) {
+					return false;
+				}
+			}
+
+			// If the surrounding samples are on different sides of a flip then interpolating would be meaningless
+			bool straddlesFlip = false;
+			for (const auto corner : corners) {
+				if (abs(corner->axisAngles.axis1 - corners[0]->axisAngles.axis1) > 90.0f
+					|| abs(corner->axisAngles.axis2 - corners[0]->axisAngles.axis2) > 90.0f) {
+					straddlesFlip = true;
+					break;
+				}
+			}
+
+			if (straddlesFlip) {
+				size_t nearest = 0;
+				for (size_t i = 1; i < 4; i++) {
+					if (weights[i] > weights[nearest]) {
+						nearest = i;
+					}
+				}
+				axisAngles = corners[nearest]->axisAngles;
+			}
+			else {
+				axisAngles = { 0.0f, 0.0f };
+				for (size_t i = 0; i < 4; i++) {
+					axisAngles.axis1 += corners[i]->axisAngles.axis1 * weights[i];
+					axisAngles.axis2 += corners[i]->axisAngles.axis2 * weights[i];
+				}
+			}
+
+			return true;
+		}
+
+		//----------
+		void
+			HeliostatActionModel::SunLookupTable::clear()
+		{
+			this->samples.clear();
+			this->resolution = 0;
+		}
+
+		//----------
+		size_t
+			HeliostatActionModel::SunLookupTable::getResolution() const
+		{
+			return this->resolution;
+		}
+
+		//----------
+		size_t
+			HeliostatActionModel::SunLookupTable::getAltitudeCount() const
+		{
+			return this->resolution / 4 + 1;
+		}
+
+		//----------
+		const HeliostatActionModel::SunLookupTable::Sample&
+			HeliostatActionModel::SunLookupTable::getSample(size_t azimuthIndex, size_t altitudeIndex) const
+		{
+			return this->samples[altitudeIndex * this->resolution + azimuthIndex];
+		}
+
+		//----------
+		glm::vec3
+			HeliostatActionModel::SunLookupTable::getIncidentVector(float azimuth, float altitude)
+		{
+			glm::vec3 solarVector{
+				cos(altitude) * cos(azimuth)
+				, sin(altitude)
+				, cos(altitude) * sin(azimuth)
+			};
+			return -solarVector;
+		}
+	}
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "pch_Plugin_Experiments.h"
 #include "HeliostatActionModel.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 using namespace ofxCeres::VectorMath;
 
@@ -106,7 +107,8 @@ namespace ofxRulr {
 
 			// Solve the fit
 			ceres::Solver::Summary summary;
-			ceres::Solve(solverSettings.options
+			Utils::solveCeres("HeliostatActionModel::VectorToPoint"
+				, solverSettings.options
 				, &problem
 				, &summary);
 
@@ -1,5 +1,6 @@
 #include "pch_Plugin_Experiments.h"
 #include "MirrorPlanefromRays.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 using namespace ofxCeres::VectorMath;
 
@@ -114,7 +115,8 @@ namespace ofxRulr {
 
 			ceres::Solver::Summary summary;
 
-			ceres::Solve(solverSettings.options
+			Utils::solveCeres("MirrorPlaneFromRays"
+				, solverSettings.options
 				, &problem
 				, &summary);
 
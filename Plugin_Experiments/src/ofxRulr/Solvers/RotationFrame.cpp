@@ -1,5 +1,6 @@
 #include "pch_Plugin_Experiments.h"
 #include "RotationFrame.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 using namespace ofxCeres::VectorMath;
 
@@ -90,7 +91,8 @@ namespace ofxRulr {
 
 			ceres::Solver::Summary summary;
 
-			ceres::Solve(solverSettings.options
+			Utils::solveCeres("RotationFrame"
+				, solverSettings.options
 				, &problem
 				, &summary);
 
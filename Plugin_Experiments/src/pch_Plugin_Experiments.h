@@ -32,6 +32,7 @@
 #include "ofxRulr/Nodes/Experiments/MirrorPlaneCapture/PruneData.h"
 #include "ofxRulr/Nodes/Experiments/MirrorPlaneCapture/FindLightInMirror.h"
 #include "ofxRulr/Nodes/Experiments/MirrorPlaneCapture/DroneLightInMirror.h"
+#include "ofxRulr/Nodes/Experiments/MirrorPlaneCapture/SolverBenchmark.h"
 
 #include "ofxRulr/Nodes/Experiments/PhotoScan/BundlerCamera.h"
 #include "ofxRulr/Nodes/Experiments/PhotoScan/CalibrateProjector.h"
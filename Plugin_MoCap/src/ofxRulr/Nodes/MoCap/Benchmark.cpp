@@ -0,0 +1,364 @@
+#include "pch_Plugin_MoCap.h"
+#include "Benchmark.h"
+#include "ofxRulr/Utils/SolverBenchmark.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace MoCap {
+			//----------
+			Benchmark::Benchmark() {
+				RULR_NODE_INIT_LISTENER;
+			}
+
+			//----------
+			string Benchmark::getTypeName() const {
+				return "MoCap::Benchmark";
+			}
+
+			//----------
+			void Benchmark::init() {
+				RULR_NODE_INSPECTOR_LISTENER;
+				RULR_NODE_SERIALIZATION_LISTENERS;
+
+				this->manageParameters(this->parameters);
+
+				{
+					auto input = this->addInput<ReplayFrames>();
+					input->onNewConnection += [this](shared_ptr<ReplayFrames> replayFrames) {
+						replayFrames->onFrameSent.addListener([this](shared_ptr<ofxMachineVision::Frame> frame) {
+							this->notifyFrameSent(frame);
+						}, this);
+						replayFrames->onReplayStarted.addListener([this]() {
+							this->clear();
+						}, this);
+						replayFrames->onReplayFinished.addListener([this]() {
+							this->notifyReplayFinished();
+						}, this);
+					};
+					input->onDeleteConnection += [this](shared_ptr<ReplayFrames> replayFrames) {
+						if (replayFrames) {
+							replayFrames->onFrameSent.removeListeners(this);
+							replayFrames->onReplayStarted.removeListeners(this);
+							replayFrames->onReplayFinished.removeListeners(this);
+						}
+					};
+				}
+
+				this->listenToStage<FindMarkerCentroids, FindMarkerCentroidsFrame>([this](shared_ptr<FindMarkerCentroidsFrame> frame) {
+					this->notifyStage(Stage::FindMarkerCentroidsStage, frame->imageFrame);
+				});
+				this->listenToStage<MatchMarkers, MatchMarkersFrame>([this](shared_ptr<MatchMarkersFrame> frame) {
+					this->notifyStage(Stage::MatchMarkersStage, frame->incomingFrame->imageFrame);
+				});
+				this->listenToStage<UpdateTracking, UpdateTrackingFrame>([this](shared_ptr<UpdateTrackingFrame> frame) {
+					this->notifyTracking(frame);
+				});
+			}
+
+			//----------
+			void Benchmark::populateInspector(ofxCvGui::InspectArguments & inspectArgs) {
+				auto inspector = inspectArgs.inspector;
+
+				inspector->addLiveValue<string>("Results", [this]() {
+					auto results = this->getResults();
+					stringstream ss;
+					ss << "Frames sent : " << results.framesSent << " in " << results.duration << "s" << endl;
+					for (const auto & stage : results.stages) {
+						ss << stage.name << " : " << stage.frameCount << " frames, " << stage.throughput << "Hz" << endl;
+						ss << "\tlatency p50/p90/p99/max : "
+							<< stage.latencyP50 << " / "
+							<< stage.latencyP90 << " / "
+							<< stage.latencyP99 << " / "
+							<< stage.latencyMax << " ms" << endl;
+					}
+					if (results.accuracy.groundTruthFrames > 0) {
+						ss << "Tracked " << results.accuracy.trackedFrames << " / " << results.accuracy.groundTruthFrames << " ground truth frames" << endl;
+						ss << "\ttranslation error mean/max : " << results.accuracy.translationErrorMean << " / " << results.accuracy.translationErrorMax << " m" << endl;
+						ss << "\trotation error mean/max : " << results.accuracy.rotationErrorMean << " / " << results.accuracy.rotationErrorMax << " deg";
+					}
+					return ss.str();
+				});
+
+				inspector->addButton("Clear", [this]() {
+					this->clear();
+				});
+				inspector->addButton("Save results...", [this]() {
+					try {
+						this->saveResults();
+					}
+					RULR_CATCH_ALL_TO_ALERT;
+				});
+
+				inspector->addSpacer();
+
+				inspector->addLiveValue<size_t>("Ground truth frames", [this]() {
+					return this->groundTruth.size();
+				});
+				inspector->addButton("Load ground truth...", [this]() {
+					try {
+						this->loadGroundTruth();
+					}
+					RULR_CATCH_ALL_TO_ALERT;
+				});
+				inspector->addButton("Save recorded transforms...", [this]() {
+					try {
+						this->saveRecordedTransforms();
+					}
+					RULR_CATCH_ALL_TO_ALERT;
+				});
+			}
+
+			//----------
+			void Benchmark::serialize(nlohmann::json & json) {
+				json["groundTruthPath"] = this->groundTruthPath;
+			}
+
+			//----------
+			void Benchmark::deserialize(const nlohmann::json & json) {
+				if (json.contains("groundTruthPath")) {
+					auto groundTruthPath = json["groundTruthPath"].get<string>();
+					if (!groundTruthPath.empty()) {
+						try {
+							this->loadGroundTruth(groundTruthPath);
+						}
+						RULR_CATCH_ALL_TO_ERROR;
+					}
+				}
+			}
+
+			//----------
+			void Benchmark::clear() {
+				auto lock = unique_lock<mutex>(this->measurementsMutex);
+				this->measurements = Measurements();
+				this->measurements.startTime = chrono::high_resolution_clock::now();
+				this->measurements.endTime = this->measurements.startTime;
+			}
+
+			//----------
+			Benchmark::Results Benchmark::getResults() const {
+				Results results;
+
+				auto lock = unique_lock<mutex>(this->measurementsMutex);
+				const auto & measurements = this->measurements;
+
+				results.framesSent = measurements.framesSent;
+				chrono::duration<float> duration = measurements.endTime - measurements.startTime;
+				results.duration = duration.count();
+
+				const string stageNames[StageCount] = {
+					"FindMarkerCentroids"
+					, "MatchMarkers"
+					, "UpdateTracking"
+				};
+
+				for (int i = 0; i < StageCount; i++) {
+					StageResult stageResult;
+					stageResult.name = stageNames[i];
+
+					auto latencies = measurements.latencies[i];
+					stageResult.frameCount = latencies.size();
+					if (!latencies.empty()) {
+						sort(latencies.begin(), latencies.end());
+						auto percentile = [&latencies](float p) {
+							return latencies[(size_t)(p * (latencies.size() - 1))];
+						};
+
+						stageResult.throughput = results.duration > 0.0f
+							? (float)latencies.size() / results.duration
+							: 0.0f;
+						float sumLatency = 0.0f;
+						for (auto latency : latencies) {
+							sumLatency += latency;
+						}
+						stageResult.latencyMean = sumLatency / (float)latencies.size();
+						stageResult.latencyP50 = percentile(0.5f);
+						stageResult.latencyP90 = percentile(0.9f);
+						stageResult.latencyP99 = percentile(0.99f);
+						stageResult.latencyMax = latencies.back();
+					}
+
+					results.stages.push_back(stageResult);
+				}
+
+				//accuracy
+				{
+					auto & accuracy = results.accuracy;
+					accuracy.groundTruthFrames = this->groundTruth.size();
+
+					float sumTranslationError = 0.0f;
+					float sumRotationError = 0.0f;
+					for (const auto & groundTruthTransform : this->groundTruth) {
+						auto findRecorded = measurements.recordedTransforms.find(groundTruthTransform.first);
+						if (findRecorded == measurements.recordedTransforms.end()) {
+							continue;
+						}
+
+						const auto & expected = groundTruthTransform.second;
+						const auto & actual = findRecorded->second;
+
+						auto translationError = glm::distance(glm::vec3(expected[3]), glm::vec3(actual[3]));
+
+						auto rotationDelta = glm::transpose(glm::mat3(expected)) * glm::mat3(actual);
+						auto cosAngle = ofClamp((rotationDelta[0][0] + rotationDelta[1][1] + rotationDelta[2][2] - 1.0f) / 2.0f, -1.0f, 1.0f);
+						auto rotationError = (float) (acos(cosAngle) * RAD_TO_DEG);
+
+						sumTranslationError += translationError;
+						sumRotationError += rotationError;
+						accuracy.translationErrorMax = max(accuracy.translationErrorMax, translationError);
+						accuracy.rotationErrorMax = max(accuracy.rotationErrorMax, rotationError);
+						accuracy.trackedFrames++;
+					}
+
+					if (accuracy.trackedFrames > 0) {
+						accuracy.translationErrorMean = sumTranslationError / (float)accuracy.trackedFrames;
+						accuracy.rotationErrorMean = sumRotationError / (float)accuracy.trackedFrames;
+					}
+				}
+
+				return results;
+			}
+
+			//----------
+			void Benchmark::saveResults(string filename) const {
+				if (filename.empty()) {
+					auto result = ofSystemSaveDialog("benchmark.json", "Save benchmark results");
+					if (!result.bSuccess) {
+						return;
+					}
+					filename = result.filePath;
+				}
+
+				auto results = this->getResults();
+
+				nlohmann::json json;
+				json["framesSent"] = results.framesSent;
+				json["duration"] = results.duration;
+				for (const auto & stage : results.stages) {
+					nlohmann::json jsonStage;
+					jsonStage["name"] = stage.name;
+					jsonStage["frameCount"] = stage.frameCount;
+					jsonStage["throughput"] = stage.throughput;
+					jsonStage["latencyMean"] = stage.latencyMean;
+					jsonStage["latencyP50"] = stage.latencyP50;
+					jsonStage["latencyP90"] = stage.latencyP90;
+					jsonStage["latencyP99"] = stage.latencyP99;
+					jsonStage["latencyMax"] = stage.latencyMax;
+					json["stages"].push_back(jsonStage);
+				}
+				{
+					auto & jsonAccuracy = json["accuracy"];
+					jsonAccuracy["groundTruthFrames"] = results.accuracy.groundTruthFrames;
+					jsonAccuracy["trackedFrames"] = results.accuracy.trackedFrames;
+					jsonAccuracy["translationErrorMean"] = results.accuracy.translationErrorMean;
+					jsonAccuracy["translationErrorMax"] = results.accuracy.translationErrorMax;
+					jsonAccuracy["rotationErrorMean"] = results.accuracy.rotationErrorMean;
+					jsonAccuracy["rotationErrorMax"] = results.accuracy.rotationErrorMax;
+				}
+
+				ofstream file(ofToDataPath(filename, true), ios::out);
+				file << json.dump(4);
+			}
+
+			//----------
+			void Benchmark::loadGroundTruth(string filename) {
+				if (filename.empty()) {
+					auto result = ofSystemLoadDialog("Select ground truth (saved from 'Save recorded transforms')");
+					if (!result.bSuccess) {
+						return;
+					}
+					filename = result.filePath;
+				}
+
+				ifstream file(ofToDataPath(filename, true), ios::in);
+				if (!file.is_open()) {
+					throw(ofxRulr::Exception("Cannot open ground truth file " + filename));
+				}
+				nlohmann::json json;
+				file >> json;
+
+				this->groundTruth.clear();
+				for (const auto & jsonFrame : json["frames"]) {
+					glm::mat4 transform;
+					Utils::deserialize(jsonFrame["transform"], transform);
+					this->groundTruth.emplace(jsonFrame["timestamp"].get<int64_t>(), transform);
+				}
+				this->groundTruthPath = filename;
+			}
+
+			//----------
+			void Benchmark::saveRecordedTransforms(string filename) const {
+				if (filename.empty()) {
+					auto result = ofSystemSaveDialog("groundTruth.json", "Save recorded transforms");
+					if (!result.bSuccess) {
+						return;
+					}
+					filename = result.filePath;
+				}
+
+				nlohmann::json json;
+				json["frames"] = nlohmann::json::array();
+				{
+					auto lock = unique_lock<mutex>(this->measurementsMutex);
+					for (const auto & recordedTransform : this->measurements.recordedTransforms) {
+						nlohmann::json jsonFrame;
+						jsonFrame["timestamp"] = recordedTransform.first;
+						Utils::serialize(jsonFrame["transform"], recordedTransform.second);
+						json["frames"].push_back(jsonFrame);
+					}
+				}
+
+				ofstream file(ofToDataPath(filename, true), ios::out);
+				file << json.dump(4);
+			}
+
+			//----------
+			void Benchmark::notifyFrameSent(shared_ptr<ofxMachineVision::Frame> frame) {
+				auto now = chrono::high_resolution_clock::now();
+				auto lock = unique_lock<mutex>(this->measurementsMutex);
+				this->measurements.sendTimes[frame->getFrameIndex()] = now;
+				this->measurements.framesSent++;
+				this->measurements.endTime = now;
+			}
+
+			//----------
+			void Benchmark::notifyStage(Stage stage, const shared_ptr<ofxMachineVision::Frame> & frame) {
+				auto now = chrono::high_resolution_clock::now();
+				auto lock = unique_lock<mutex>(this->measurementsMutex);
+
+				auto findSendTime = this->measurements.sendTimes.find(frame->getFrameIndex());
+				if (findSendTime == this->measurements.sendTimes.end()) {
+					//frame wasn't sent during this benchmark (e.g. live camera)
+					return;
+				}
+
+				chrono::duration<float, milli> latency = now - findSendTime->second;
+				this->measurements.latencies[stage].push_back(latency.count());
+				this->measurements.endTime = max(this->measurements.endTime, now);
+			}
+
+			//----------
+			void Benchmark::notifyTracking(shared_ptr<UpdateTrackingFrame> frame) {
+				if (frame->isPrediction) {
+					return;
+				}
+
+				const auto & imageFrame = frame->incomingFrame->incomingFrame->imageFrame;
+				this->notifyStage(Stage::UpdateTrackingStage, imageFrame);
+
+				if (this->parameters.recordTransforms) {
+					auto lock = unique_lock<mutex>(this->measurementsMutex);
+					this->measurements.recordedTransforms[imageFrame->getTimestamp().count()] = frame->transform;
+				}
+			}
+
+			//----------
+			void Benchmark::notifyReplayFinished() {
+				Utils::SolverBenchmark::finishUnattended(this->parameters.onReplayFinished.resultsPath.get()
+					, this->parameters.onReplayFinished.exitApp.get()
+					, [this](const string & resultsPath) {
+						this->saveResults(resultsPath);
+					});
+			}
+		}
+	}
+}
\ No newline at end of file
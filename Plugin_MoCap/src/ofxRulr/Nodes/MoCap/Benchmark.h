@@ -0,0 +1,109 @@
+#pragma once
+
+#include "ReplayFrames.h"
+#include "FindMarkerCentroids.h"
+#include "MatchMarkers.h"
+#include "UpdateTracking.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace MoCap {
+			//Measures the MoCap chain whilst a ReplayFrames node is playing
+			//Latency of each stage is measured from the moment ReplayFrames sends the frame
+			//Tracking accuracy is measured against a ground truth (transforms by frame timestamp) recorded from an earlier run
+			class Benchmark : public Nodes::Base {
+			public:
+				struct StageResult {
+					string name;
+					size_t frameCount = 0;
+					float throughput = 0.0f; // [Hz]
+					float latencyMean = 0.0f; // [ms]
+					float latencyP50 = 0.0f;
+					float latencyP90 = 0.0f;
+					float latencyP99 = 0.0f;
+					float latencyMax = 0.0f;
+				};
+
+				struct AccuracyResult {
+					size_t groundTruthFrames = 0;
+					size_t trackedFrames = 0;
+					float translationErrorMean = 0.0f; // [m]
+					float translationErrorMax = 0.0f;
+					float rotationErrorMean = 0.0f; // [degrees]
+					float rotationErrorMax = 0.0f;
+				};
+
+				struct Results {
+					size_t framesSent = 0;
+					float duration = 0.0f; // [s]
+					vector<StageResult> stages;
+					AccuracyResult accuracy;
+				};
+
+				Benchmark();
+				string getTypeName() const override;
+				void init();
+				void populateInspector(ofxCvGui::InspectArguments &);
+				void serialize(nlohmann::json &);
+				void deserialize(const nlohmann::json &);
+
+				void clear();
+				Results getResults() const;
+				void saveResults(string filename = "") const;
+
+				void loadGroundTruth(string filename = "");
+				void saveRecordedTransforms(string filename = "") const;
+			protected:
+				enum Stage {
+					FindMarkerCentroidsStage = 0,
+					MatchMarkersStage,
+					UpdateTrackingStage,
+					StageCount
+				};
+
+				void notifyFrameSent(shared_ptr<ofxMachineVision::Frame>);
+				void notifyStage(Stage, const shared_ptr<ofxMachineVision::Frame> &);
+				void notifyTracking(shared_ptr<UpdateTrackingFrame>);
+				void notifyReplayFinished();
+
+				template<typename NodeType, typename FrameType>
+				void listenToStage(function<void(shared_ptr<FrameType>)> action) {
+					auto input = this->addInput<NodeType>();
+					input->onNewConnection += [this, action](shared_ptr<NodeType> node) {
+						node->onNewFrame.addListener(action, this);
+					};
+					input->onDeleteConnection += [this](shared_ptr<NodeType> node) {
+						if (node) {
+							node->onNewFrame.removeListeners(this);
+						}
+					};
+				}
+
+				struct : ofParameterGroup {
+					ofParameter<bool> recordTransforms{ "Record transforms", true };
+
+					struct : ofParameterGroup {
+						ofParameter<string> resultsPath{ "Results path", "" };
+						ofParameter<bool> exitApp{ "Exit app", false };
+						PARAM_DECLARE("On replay finished", resultsPath, exitApp);
+					} onReplayFinished;
+
+					PARAM_DECLARE("Benchmark", recordTransforms, onReplayFinished);
+				} parameters;
+
+				struct Measurements {
+					chrono::high_resolution_clock::time_point startTime;
+					chrono::high_resolution_clock::time_point endTime;
+					size_t framesSent = 0;
+					map<size_t, chrono::high_resolution_clock::time_point> sendTimes; // by frame index
+					vector<float> latencies[StageCount]; // [ms]
+					map<int64_t, glm::mat4> recordedTransforms; // by frame timestamp [ns]
+				} measurements;
+				mutable mutex measurementsMutex;
+
+				map<int64_t, glm::mat4> groundTruth;
+				string groundTruthPath;
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -134,6 +134,17 @@ namespace ofxRulr {
 					}
 				}
 
+				//apply filter settings
+				{
+					PoseFilter::Settings settings;
+					settings.enabled = this->parameters.kalmanFilter.enabled;
+					settings.processNoise = this->parameters.kalmanFilter.processNoise;
+					settings.measurementNoise = this->parameters.kalmanFilter.measurementNoise;
+					settings.errorPost = this->parameters.kalmanFilter.errorPost;
+					settings.maxPredictionTime = this->parameters.kalmanFilter.maxPredictionTime;
+					this->poseFilter->setSettings(settings);
+				}
+
 				//rebuild body description
 				if (!this->getBodyDescription()) {
 					auto bodyDescription = make_shared<Description>();
@@ -146,6 +157,7 @@ namespace ofxRulr {
 					}
 
 					bodyDescription->markerDiameter = this->parameters.markerDiameter;
+					bodyDescription->poseFilter = this->poseFilter;
 					bodyDescription->markerCount = markers.size();
 
 					bodyDescription->modelTransform = this->getTransform();
@@ -286,6 +298,22 @@ namespace ofxRulr {
 				return this->parameters.markerDiameter.get();
 			}
 
+			//----------
+			bool Body::getTrackingPrediction(cv::Mat & rotationVector, cv::Mat & translation) {
+				PoseFilter::Prediction prediction;
+				if (!this->poseFilter->predictNow(prediction)) {
+					return false;
+				}
+				rotationVector = prediction.rotationVector;
+				translation = prediction.translation;
+				return true;
+			}
+
+			//----------
+			shared_ptr<PoseFilter> Body::getPoseFilter() const {
+				return this->poseFilter;
+			}
+
 			//----------
 			void Body::loadCSV(string filename /*= ""*/) {
 				if (filename == "") {
@@ -2,6 +2,7 @@
 
 #include "ofxRulr.h"
 #include "ofxRulr/Utils/CaptureSet.h"
+#include "PoseFilter.h"
 
 namespace ofxRulr {
 	namespace Nodes {
@@ -23,6 +24,8 @@ namespace ofxRulr {
 					glm::mat4 modelTransform;
 					cv::Mat rotationVector;
 					cv::Mat translation;
+
+					shared_ptr<PoseFilter> poseFilter; // shared between descriptions
 				};
 
 				Body();
@@ -49,6 +52,7 @@ namespace ofxRulr {
 				void saveCSV(string filename = "");
 
 				bool getTrackingPrediction(cv::Mat & rotationVector, cv::Mat & translation); // returns true if prediction is used
+				shared_ptr<PoseFilter> getPoseFilter() const;
 			protected:
 				class Marker : public Utils::AbstractCaptureSet::BaseCapture {
 				public:
@@ -69,7 +73,8 @@ namespace ofxRulr {
 						ofParameter<float> processNoise{ "Process noise", 1e-5, 0, 1 };
 						ofParameter<float> measurementNoise{ "Measurement noise", 1e-2, 0, 1 };
 						ofParameter<float> errorPost{ "Error post", 1, 0, 10 };
-						PARAM_DECLARE("Kalman filter", enabled, processNoise, measurementNoise, errorPost);
+						ofParameter<float> maxPredictionTime{ "Max prediction time [s]", 0.5, 0, 10 };
+						PARAM_DECLARE("Kalman filter", enabled, processNoise, measurementNoise, errorPost, maxPredictionTime);
 					} kalmanFilter;
 
 					struct : ofParameterGroup {
@@ -92,6 +97,8 @@ namespace ofxRulr {
 				shared_ptr<Description> bodyDescription;
 				mutable mutex bodyDescriptionMutex;
 
+				shared_ptr<PoseFilter> poseFilter = make_shared<PoseFilter>();
+
 				ofThreadChannel<ofMatrix4x4> transformIncoming;
 
 				friend Marker;
@@ -2,10 +2,62 @@
 #include "MatchMarkers.h"
 
 #include "ofxRulr/Nodes/Item/Camera.h"
+#include "ofxRulr/Utils/SolverRuntime.h"
 
 namespace ofxRulr {
 	namespace Nodes {
 		namespace MoCap {
+#pragma mark CentroidIndex
+			//----------
+			void CentroidIndex::build(const vector<cv::Point2f> & centroids, float cellSize) {
+				this->cellStarts.clear();
+				this->sortedIndices.clear();
+				this->columns = 0;
+				this->rows = 0;
+
+				if (centroids.empty()) {
+					return;
+				}
+
+				//find the bounds of the centroids
+				auto minimum = centroids.front();
+				auto maximum = centroids.front();
+				for (const auto & centroid : centroids) {
+					minimum.x = min(minimum.x, centroid.x);
+					minimum.y = min(minimum.y, centroid.y);
+					maximum.x = max(maximum.x, centroid.x);
+					maximum.y = max(maximum.y, centroid.y);
+				}
+
+				//don't let a tiny threshold explode the number of cells
+				const auto extent = max(maximum.x - minimum.x, maximum.y - minimum.y);
+				this->cellSize = max(max(cellSize, extent / 256.0f), 1.0f);
+				this->origin = minimum;
+				this->columns = (size_t)floor((maximum.x - minimum.x) / this->cellSize) + 1;
+				this->rows = (size_t)floor((maximum.y - minimum.y) / this->cellSize) + 1;
+
+				//counting sort of centroids into cells
+				vector<size_t> cellIndices;
+				cellIndices.reserve(centroids.size());
+				this->cellStarts.assign(this->columns * this->rows + 1, 0);
+				for (const auto & centroid : centroids) {
+					const auto i = min((size_t)((centroid.x - this->origin.x) / this->cellSize), this->columns - 1);
+					const auto j = min((size_t)((centroid.y - this->origin.y) / this->cellSize), this->rows - 1);
+					const auto cellIndex = j * this->columns + i;
+					cellIndices.push_back(cellIndex);
+					this->cellStarts[cellIndex + 1]++;
+				}
+				for (size_t i = 1; i < this->cellStarts.size(); i++) {
+					this->cellStarts[i] += this->cellStarts[i - 1];
+				}
+
+				this->sortedIndices.resize(centroids.size());
+				auto cellFill = this->cellStarts;
+				for (size_t centroidIndex = 0; centroidIndex < centroids.size(); centroidIndex++) {
+					this->sortedIndices[cellFill[cellIndices[centroidIndex]]++] = centroidIndex;
+				}
+			}
+
 #pragma mark Capture
 			//----------
 			MatchMarkers::Capture::Capture() {
@@ -197,6 +249,13 @@ namespace ofxRulr {
 				}
 
 
+				//build the spatial index of centroids (shared by the tracking search and the known pose checks)
+				{
+					auto cellSize = max(this->parameters.trackingDistanceThreshold.get(), this->parameters.refindTrackingThreshold.get());
+					outputFrame->centroidIndex = make_shared<CentroidIndex>();
+					outputFrame->centroidIndex->build(incomingFrame->centroids, cellSize);
+				}
+
 				//get the distance threshold
 				outputFrame->distanceThresholdSquared = this->parameters.trackingDistanceThreshold.get();
 				outputFrame->distanceThresholdSquared *= outputFrame->distanceThresholdSquared;
@@ -253,21 +312,59 @@ namespace ofxRulr {
 
 			//----------
 			void MatchMarkers::processTrackingSearch(shared_ptr<MatchMarkersFrame> & outputFrame) {
+				//take the body pose, or the filter's prediction of it at the time of this frame
+				cv::Mat bodyRotationVector = outputFrame->bodyDescription->rotationVector;
+				cv::Mat bodyTranslation = outputFrame->bodyDescription->translation;
+				glm::mat4 bodyTransform = outputFrame->bodyDescription->modelTransform;
+				PoseFilter::Prediction prediction;
+				if (outputFrame->bodyDescription->poseFilter
+					&& outputFrame->bodyDescription->poseFilter->predict(outputFrame->incomingFrame->imageFrame->getTimestamp(), prediction)) {
+					bodyRotationVector = prediction.rotationVector;
+					bodyTranslation = prediction.translation;
+					bodyTransform = ofxCv::makeMatrix(bodyRotationVector, bodyTranslation);
+					outputFrame->search.usedPrediction = true;
+				}
+
 				//combine the camera and body transforms
-				cv::composeRT(outputFrame->bodyDescription->rotationVector
-					, outputFrame->bodyDescription->translation
+				cv::composeRT(bodyRotationVector
+					, bodyTranslation
 					, outputFrame->cameraDescription->inverseRotationVector
 					, outputFrame->cameraDescription->inverseTranslation
 					, outputFrame->modelViewRotationVector
 					, outputFrame->modelViewTranslation);
 
+				//shrink the search radius to the uncertainty of the prediction
+				if (outputFrame->search.usedPrediction) {
+					float bodyRadius = 0.0f;
+					for (const auto & position : outputFrame->bodyDescription->markers.positions) {
+						bodyRadius = max(bodyRadius, glm::length(position));
+					}
+
+					cv::Mat_<double> modelViewTranslation;
+					outputFrame->modelViewTranslation.reshape(1, 3).convertTo(modelViewTranslation, CV_64F);
+					cv::Mat_<double> cameraMatrix;
+					outputFrame->cameraDescription->cameraMatrix.convertTo(cameraMatrix, CV_64F);
+
+					const auto depth = modelViewTranslation(2);
+					if (depth > 0.0) {
+						const auto deviationWorld = prediction.translationDeviation + prediction.rotationDeviation * bodyRadius;
+						const auto deviationImage = (float) (cameraMatrix(0, 0) * deviationWorld / depth);
+						const auto searchRadius = ofClamp(deviationImage * this->parameters.prediction.searchSigmas.get()
+							, this->parameters.prediction.minimumSearchRadius.get()
+							, this->parameters.trackingDistanceThreshold.get());
+						outputFrame->distanceThresholdSquared = searchRadius * searchRadius;
+					}
+				}
+
 				//first check the markers are inside the camera image
 				//(cvProjectPoints will happily give us weird results for markers outside view, e.g. distortion loop back, behind cam)
 				{
+					const auto & bodyDescription = outputFrame->bodyDescription;
+					const auto & cameraDescription = outputFrame->cameraDescription;
 					vector<glm::vec3> matrixProjections;
 					for (int i = 0; i < bodyDescription->markerCount; i++) {
 						const auto & objectSpacePoint = bodyDescription->markers.positions[i];
-						const auto worldSpace = Utils::applyTransform(bodyDescription->modelTransform, objectSpacePoint);
+						const auto worldSpace = Utils::applyTransform(bodyTransform, objectSpacePoint);
 						const auto projectionSpace = Utils::applyTransform(cameraDescription->viewProjectionMatrix, worldSpace);
 						if (projectionSpace.z < -1 || projectionSpace.z > 1) {
 							//outside of depth clipping range
@@ -292,32 +389,75 @@ namespace ofxRulr {
 			//----------
 			shared_ptr<MatchMarkersFrame> MatchMarkers::processCheckKnownPoses(shared_ptr<MatchMarkersFrame> & outputFrame) {
 				auto captures = this->captures.getSelection();
-				for (auto capture : captures) {
-					auto searchFrame = make_shared<MatchMarkersFrame>(* outputFrame);
+				if (captures.empty()) {
+					return nullptr;
+				}
 
-					searchFrame->modelViewRotationVector = cv::Mat(capture->modelViewRotationVector);
-					searchFrame->modelViewTranslation = cv::Mat(capture->modelViewTranslation);
-					
-					searchFrame->distanceThresholdSquared = this->parameters.refindTrackingThreshold;
-					searchFrame->distanceThresholdSquared *= searchFrame->distanceThresholdSquared;
+				const auto refindThresholdSquared = this->parameters.refindTrackingThreshold.get() * this->parameters.refindTrackingThreshold.get();
+				const auto trackingThresholdSquared = this->parameters.trackingDistanceThreshold.get() * this->parameters.trackingDistanceThreshold.get();
+
+				//poses are checked in parallel. We keep the result with the lowest capture index (as the serial search did)
+				//and skip any capture after the best result found so far
+				vector<shared_ptr<MatchMarkersFrame>> results(captures.size());
+				atomic<size_t> nextCaptureIndex = 0;
+				atomic<size_t> firstFoundIndex = captures.size();
+
+				auto checkPoses = [&]() {
+					for (auto captureIndex = nextCaptureIndex++; captureIndex < captures.size(); captureIndex = nextCaptureIndex++) {
+						if (captureIndex > firstFoundIndex.load()) {
+							return;
+						}
+
+						auto & capture = captures[captureIndex];
+						auto searchFrame = make_shared<MatchMarkersFrame>(*outputFrame);
+
+						searchFrame->modelViewRotationVector = cv::Mat(capture->modelViewRotationVector);
+						searchFrame->modelViewTranslation = cv::Mat(capture->modelViewTranslation);
 
-					this->processModelViewTransform(searchFrame);
-					capture->reprojectionError = searchFrame->result.reprojectionError;
+						searchFrame->distanceThresholdSquared = refindThresholdSquared;
 
-					if (searchFrame->result.success) {
-						//now check it with the tracking distance threshold
-						searchFrame->distanceThresholdSquared = this->parameters.trackingDistanceThreshold;
 						this->processModelViewTransform(searchFrame);
+						capture->reprojectionError = searchFrame->result.reprojectionError;
 
 						if (searchFrame->result.success) {
-							//great we passed the test!
+							//now check it with the tracking distance threshold
+							searchFrame->distanceThresholdSquared = trackingThresholdSquared;
+							this->processModelViewTransform(searchFrame);
 
-							//mark that we've jumped to somewhere new
-							searchFrame->result.trackingWasLost = true;
-							
-							return searchFrame;
+							if (searchFrame->result.success) {
+								//great we passed the test!
+
+								//mark that we've jumped to somewhere new
+								searchFrame->result.trackingWasLost = true;
+
+								results[captureIndex] = searchFrame;
+
+								auto currentFirst = firstFoundIndex.load();
+								while (captureIndex < currentFirst
+									&& !firstFoundIndex.compare_exchange_weak(currentFirst, captureIndex)) {
+								}
+							}
 						}
 					}
+				};
+
+				{
+					//threads come from the shared solver budget, so we don't compete with solves running elsewhere
+					auto threadLease = Utils::SolverRuntime::X().acquireThreads(0);
+					auto workerCount = min(threadLease->getThreadCount(), captures.size());
+					vector<future<void>> workers;
+					for (size_t i = 1; i < workerCount; i++) {
+						workers.push_back(std::async(std::launch::async, checkPoses));
+					}
+					checkPoses();
+					for (auto & worker : workers) {
+						worker.get();
+					}
+				}
+
+				auto foundIndex = firstFoundIndex.load();
+				if (foundIndex < captures.size()) {
+					return results[foundIndex];
 				}
 
 				//we failed
@@ -341,29 +481,39 @@ namespace ofxRulr {
 				//clear the result
 				outputFrame->result = MatchMarkersFrame::Result();
 
-				for (size_t centroidIndex = 0; centroidIndex < outputFrame->incomingFrame->centroids.size(); centroidIndex++) {
-					const auto & centroid = outputFrame->incomingFrame->centroids[centroidIndex];
-
-					map<float, size_t> matchesByDistance; // { distanceSquared, marker index in incoming frame vector}
+				const auto & centroids = outputFrame->incomingFrame->centroids;
+				if (!outputFrame->centroidIndex) {
+					outputFrame->centroidIndex = make_shared<CentroidIndex>();
+					outputFrame->centroidIndex->build(centroids, sqrt(outputFrame->distanceThresholdSquared));
+				}
 
-														  //find all matching markers
+				//for each centroid find the closest projected marker within the threshold
+				//(ties go to the lowest marker index)
+				vector<float> closestDistanceSquared(centroids.size(), outputFrame->distanceThresholdSquared);
+				vector<size_t> closestMarkerIndex(centroids.size(), outputFrame->search.count);
+				{
+					const auto distanceThreshold = sqrt(outputFrame->distanceThresholdSquared);
 					for (size_t i = 0; i < outputFrame->search.count; i++) {
-						//find distance
 						const auto & markerProjected = outputFrame->search.projectedMarkerImagePoints[i];
-						const auto delta = centroid - markerProjected;
-						const auto distanceSquared = delta.x * delta.x + delta.y * delta.y;
-
-						if (distanceSquared < outputFrame->distanceThresholdSquared) {
-							matchesByDistance.emplace(distanceSquared, i);
-						}
+						outputFrame->centroidIndex->forEachCandidate(markerProjected, distanceThreshold, [&](size_t centroidIndex) {
+							const auto delta = centroids[centroidIndex] - markerProjected;
+							const auto distanceSquared = delta.x * delta.x + delta.y * delta.y;
+							if (distanceSquared < closestDistanceSquared[centroidIndex]) {
+								closestDistanceSquared[centroidIndex] = distanceSquared;
+								closestMarkerIndex[centroidIndex] = i;
+							}
+						});
 					}
+				}
 
-					if (matchesByDistance.empty()) {
+				for (size_t centroidIndex = 0; centroidIndex < centroids.size(); centroidIndex++) {
+					const auto & centroid = centroids[centroidIndex];
+					const auto matchIndex = closestMarkerIndex[centroidIndex];
+					if (matchIndex >= outputFrame->search.count) {
 						//no match found
 						continue;
 					}
 
-					auto matchIndex = matchesByDistance.begin()->second;
 					outputFrame->result.markerListIndicies.push_back(matchIndex);
 					outputFrame->result.markerIDs.push_back(outputFrame->search.markerIDs[matchIndex]);
 					outputFrame->result.projectedPoints.push_back(outputFrame->search.projectedMarkerImagePoints[matchIndex]);
@@ -16,15 +16,60 @@ namespace ofxRulr {
 				ofMatrix4x4 viewProjectionMatrix;
 			};
 
+			//Uniform grid over the centroids of one incoming frame
+			//Built once per frame and shared between the tracking search and the known pose checks
+			struct CentroidIndex {
+				void build(const vector<cv::Point2f> & centroids, float cellSize);
+
+				//calls action(centroidIndex) for every centroid which may be within radius of position
+				template<typename Action>
+				void forEachCandidate(const cv::Point2f & position, float radius, Action && action) const {
+					if (this->sortedIndices.empty() || !(position.x == position.x) || !(position.y == position.y)) {
+						return;
+					}
+
+					const float x0 = floor((position.x - radius - this->origin.x) / this->cellSize);
+					const float x1 = floor((position.x + radius - this->origin.x) / this->cellSize);
+					const float y0 = floor((position.y - radius - this->origin.y) / this->cellSize);
+					const float y1 = floor((position.y + radius - this->origin.y) / this->cellSize);
+					if (x1 < 0 || y1 < 0 || x0 >= (float) this->columns || y0 >= (float) this->rows) {
+						return;
+					}
+
+					const auto columnStart = (size_t) max(x0, 0.0f);
+					const auto columnEnd = (size_t) min(x1, (float) this->columns - 1);
+					const auto rowStart = (size_t) max(y0, 0.0f);
+					const auto rowEnd = (size_t) min(y1, (float) this->rows - 1);
+
+					for (size_t j = rowStart; j <= rowEnd; j++) {
+						const auto rowOffset = j * this->columns;
+						const auto begin = this->cellStarts[rowOffset + columnStart];
+						const auto end = this->cellStarts[rowOffset + columnEnd + 1];
+						for (size_t k = begin; k < end; k++) {
+							action(this->sortedIndices[k]);
+						}
+					}
+				}
+
+				cv::Point2f origin;
+				float cellSize = 1.0f;
+				size_t columns = 0;
+				size_t rows = 0;
+				vector<size_t> cellStarts; // rows * columns + 1 offsets into sortedIndices
+				vector<size_t> sortedIndices; // centroid indices sorted by cell
+			};
+
 			struct MatchMarkersFrame {
 				shared_ptr<FindMarkerCentroidsFrame> incomingFrame;
 				shared_ptr<Body::Description> bodyDescription;
 				shared_ptr<CameraDescription> cameraDescription;
+				shared_ptr<CentroidIndex> centroidIndex;
 
 				cv::Mat modelViewRotationVector;
 				cv::Mat modelViewTranslation;
 
 				struct Search {
+					bool usedPrediction = false;
 					size_t count;
 					vector<MarkerID> markerIDs;
 					vector<cv::Point3f> objectSpacePoints;
@@ -91,7 +136,14 @@ namespace ofxRulr {
 					ofParameter<float> trackingDistanceThreshold{ "Tracking distance threshold [px]", 20, 0, 300 };
 					ofParameter<float> refindTrackingThreshold{ "Re-find tracking threshold [px]", 30, 0, 300 };
 					ofParameter<WhenDrawWorld> whenDraw{ "Draw when", WhenDrawWorld::Selected };
-					PARAM_DECLARE("MatchMarkers", trackingDistanceThreshold, refindTrackingThreshold, whenDraw);
+
+					struct : ofParameterGroup {
+						ofParameter<float> searchSigmas{ "Search sigmas", 3, 0, 10 };
+						ofParameter<float> minimumSearchRadius{ "Minimum search radius [px]", 3, 0, 100 };
+						PARAM_DECLARE("Prediction", searchSigmas, minimumSearchRadius);
+					} prediction;
+
+					PARAM_DECLARE("MatchMarkers", trackingDistanceThreshold, refindTrackingThreshold, whenDraw, prediction);
 				} parameters;
 
 				Utils::CaptureSet<Capture> captures;
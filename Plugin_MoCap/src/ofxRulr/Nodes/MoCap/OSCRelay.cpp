@@ -9,6 +9,12 @@ namespace ofxRulr {
 				RULR_NODE_INIT_LISTENER;
 			}
 
+			//----------
+			OSCRelay::~OSCRelay() {
+				auto lock = unique_lock<mutex>(this->cachedParametersMutex);
+				Utils::PosePublisher::releaseShared(this->publisher);
+			}
+
 			//----------
 			std::string OSCRelay::getTypeName() const {
 				return "MoCap::OSCRelay";
@@ -28,45 +34,42 @@ namespace ofxRulr {
 			//----------
 			void OSCRelay::deserialize(const nlohmann::json & json) {
 				Utils::deserialize(json, this->parameters);
-				this->invalidateSender();
 			}
 
 			//----------
 			void OSCRelay::populateInspector(ofxCvGui::InspectArguments & inspectArgs) {
 				auto inspector = inspectArgs.inspector;
-
-				inspector->addEditableValue<string>(this->parameters.remoteAddress)->onValueChange += [this](const string &) {
-					this->invalidateSender();
-				};
-				inspector->addEditableValue<int>(this->parameters.remotePort)->onValueChange += [this](const int &) {
-					this->invalidateSender();
+				inspector->addParameterGroup(this->parameters);
+				auto getPublisher = [this]() {
+					auto lock = unique_lock<mutex>(this->cachedParametersMutex);
+					return this->publisher;
 				};
+				inspector->addLiveValue<uint32_t>("Sequence", [getPublisher]() {
+					auto publisher = getPublisher();
+					return publisher ? publisher->getSequence() : 0;
+				});
+				inspector->addLiveValue<size_t>("Poses coalesced", [getPublisher]() {
+					auto publisher = getPublisher();
+					return publisher ? publisher->getPosesCoalesced() : 0;
+				});
+				inspector->addLiveValue<size_t>("Bodies sharing publisher", [getPublisher]() {
+					auto publisher = getPublisher();
+					return publisher ? publisher->getSourceCount() : 0;
+				});
 			}
 
 			//----------
 			void OSCRelay::processFrame(shared_ptr<UpdateTrackingFrame> incomingFrame) {
-				auto sender = this->getSender();
-				if (!sender) {
-					sender = this->tryMakeSender();
-					this->setSender(sender);
-				}
-				if (!sender) {
-					return;
-				}
+				Utils::PoseFormat format;
+				auto publisher = this->updatePublisher(format);
 
-				ofxOscBundle bundle;
-				//send OSC message
+				Utils::PosePublisher::Pose pose;
 				{
-					{
-						ofxOscMessage message;
-						message.setAddress("/transform");
-						for (int i = 0; i < 16; i++) {
-							message.addFloatArg(incomingFrame->transform.getPtr()[i]);
-						}
-						bundle.addMessage(message);
-					}
+					pose.ID = (uint32_t) max(this->parameters.bodyID.get(), 0);
+					pose.transform = incomingFrame->transform;
+					pose.oscAddress = "/transform";
 
-					{
+					if (format == Utils::PoseFormat::OSC) {
 						ofxOscMessage message;
 						message.setAddress("/marker/positions");
 						auto & markerPositions = incomingFrame->incomingFrame->bodyDescription->markers.positions;
@@ -75,40 +78,46 @@ namespace ofxRulr {
 							message.addFloatArg(markerPositions[i].y);
 							message.addFloatArg(markerPositions[i].z);
 						}
-						bundle.addMessage(message);
+						pose.oscMessages.push_back(message);
 					}
-
-					sender->sendBundle(bundle);
 				}
-				
+
+				//returns immediately, packet is sent from the publisher's thread
+				publisher->publish({ pose }
+					, incomingFrame->incomingFrame->incomingFrame->imageFrame->getTimestamp());
+
 				this->onNewFrame.notifyListeners(shared_ptr<void*>());
 			}
 
 			//----------
-			shared_ptr<ofxOscSender> OSCRelay::getSender() const {
-				this->senderMutex.lock();
-				auto sender = this->sender;
-				this->senderMutex.unlock();
-				return sender;
-			}
+			shared_ptr<Utils::PosePublisher> OSCRelay::updatePublisher(Utils::PoseFormat & format) {
+				auto lock = unique_lock<mutex>(this->cachedParametersMutex);
+				if (this->publisher
+					&& this->parameters.remoteAddress.get() == this->cachedParameters.remoteAddress
+					&& this->parameters.remotePort.get() == this->cachedParameters.remotePort
+					&& this->parameters.additionalDestinations.get() == this->cachedParameters.additionalDestinations
+					&& this->parameters.format.get() == this->cachedParameters.format) {
+					format = this->cachedParameters.format;
+					return this->publisher;
+				}
 
-			//----------
-			shared_ptr<ofxOscSender> OSCRelay::tryMakeSender() const {
-				auto sender = make_shared<ofxOscSender>();
-				sender->setup(this->parameters.remoteAddress, this->parameters.remotePort);
-				return sender;
-			}
+				this->cachedParameters.remoteAddress = this->parameters.remoteAddress.get();
+				this->cachedParameters.remotePort = this->parameters.remotePort.get();
+				this->cachedParameters.additionalDestinations = this->parameters.additionalDestinations.get();
+				this->cachedParameters.format = this->parameters.format.get();
 
-			//----------
-			void OSCRelay::setSender(shared_ptr<ofxOscSender> sender) {
-				auto lock = unique_lock<mutex>(this->senderMutex);
-				this->sender = sender;
-			}
+				Utils::PosePublisher::Settings settings;
+				{
+					settings.destinations.push_back({ this->cachedParameters.remoteAddress, this->cachedParameters.remotePort });
+					auto additionalDestinations = Utils::PosePublisher::parseDestinations(this->cachedParameters.additionalDestinations, this->cachedParameters.remotePort);
+					settings.destinations.insert(settings.destinations.end(), additionalDestinations.begin(), additionalDestinations.end());
+					settings.format = this->cachedParameters.format;
+				}
+				Utils::PosePublisher::releaseShared(this->publisher);
+				this->publisher = Utils::PosePublisher::acquireShared(settings);
 
-			//----------
-			void OSCRelay::invalidateSender() {
-				auto lock = unique_lock<mutex>(this->senderMutex);
-				this->sender.reset();
+				format = this->cachedParameters.format;
+				return this->publisher;
 			}
 		}
 	}
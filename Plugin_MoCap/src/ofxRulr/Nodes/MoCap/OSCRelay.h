@@ -2,7 +2,7 @@
 
 #include "ThreadedProcessNode.h"
 #include "UpdateTracking.h"
-#include "ofxOsc.h"
+#include "ofxRulr/Utils/PosePublisher.h"
 
 namespace ofxRulr {
 	namespace Nodes {
@@ -12,28 +12,36 @@ namespace ofxRulr {
 			, void *> {
 			public:
 				OSCRelay();
+				~OSCRelay();
 				string getTypeName() const override;
 				void init();
 				void serialize(nlohmann::json &);
 				void deserialize(const nlohmann::json &);
 				void populateInspector(ofxCvGui::InspectArguments &);
 			protected:
-				struct : ofParameterGroup {
+				struct Parameters : ofParameterGroup {
 					ofParameter<string> remoteAddress{ "Remote address", "localhost" };
 					ofParameter<int> remotePort{ "Remote port", 5000 };
-					PARAM_DECLARE("OSCRelay", remoteAddress, remotePort);
+					ofParameter<string> additionalDestinations{ "Additional destinations", "" }; // host:port, host:port (may be multicast groups)
+					ofParameter<Utils::PoseFormat> format{ "Format", Utils::PoseFormat::OSC };
+					ofParameter<int> bodyID{ "Body ID", 0 };
+					PARAM_DECLARE("OSCRelay", remoteAddress, remotePort, additionalDestinations, format, bodyID);
 				} parameters;
 
 				void processFrame(shared_ptr<UpdateTrackingFrame> incomingFrame) override;
+				shared_ptr<Utils::PosePublisher> updatePublisher(Utils::PoseFormat &); // returns the publisher and format in use
 
-				shared_ptr<ofxOscSender> getSender() const;
-				shared_ptr<ofxOscSender> tryMakeSender() const;
+				//shared with the other relays which send to the same destinations, so that all bodies leave in one packet
+				//per frame. Sends from its own thread so that the tracking thread isn't held up by the network
+				shared_ptr<Utils::PosePublisher> publisher;
 
-				void setSender(shared_ptr<ofxOscSender>);
-				void invalidateSender();
-
-				shared_ptr<ofxOscSender> sender;
-				mutable mutex senderMutex;
+				struct {
+					string remoteAddress;
+					int remotePort = 0;
+					string additionalDestinations;
+					Utils::PoseFormat format;
+				} cachedParameters;
+				mutex cachedParametersMutex; // guards publisher. processFrame is called from several pool threads
 			};
 		}
 	}
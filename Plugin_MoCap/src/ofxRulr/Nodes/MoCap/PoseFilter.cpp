@@ -0,0 +1,161 @@
+#include "pch_Plugin_MoCap.h"
+#include "PoseFilter.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace MoCap {
+			//State is [translation, rotation vector, velocity, angular velocity]
+			const int stateSize = 12;
+			const int measurementSize = 6;
+
+			//----------
+			PoseFilter::PoseFilter()
+			: kalmanFilter(stateSize, measurementSize, 0, CV_32F) {
+				cv::setIdentity(this->kalmanFilter.measurementMatrix);
+			}
+
+			//----------
+			void PoseFilter::setSettings(const Settings & settings) {
+				auto lock = unique_lock<mutex>(this->filterMutex);
+				if (settings.enabled != this->settings.enabled) {
+					this->hasState = false;
+				}
+				this->settings = settings;
+			}
+
+			//----------
+			PoseFilter::Settings PoseFilter::getSettings() const {
+				auto lock = unique_lock<mutex>(this->filterMutex);
+				return this->settings;
+			}
+
+			//----------
+			bool PoseFilter::isActive() const {
+				auto lock = unique_lock<mutex>(this->filterMutex);
+				return this->settings.enabled && this->hasState;
+			}
+
+			//----------
+			void PoseFilter::reset() {
+				auto lock = unique_lock<mutex>(this->filterMutex);
+				this->hasState = false;
+			}
+
+			//----------
+			void PoseFilter::correct(chrono::nanoseconds frameTimestamp, const cv::Mat & rotationVectorIn, const cv::Mat & translationIn) {
+				auto lock = unique_lock<mutex>(this->filterMutex);
+				if (!this->settings.enabled) {
+					return;
+				}
+
+				cv::Mat rotationVector;
+				cv::Mat translation;
+				rotationVectorIn.reshape(1, 3).convertTo(rotationVector, CV_32F);
+				translationIn.reshape(1, 3).convertTo(translation, CV_32F);
+
+				chrono::duration<float> dt = frameTimestamp - this->lastFrameTimestamp;
+				if (this->hasState && (dt.count() <= 0.0f || dt.count() > this->settings.maxPredictionTime)) {
+					//out of order or too old to predict from
+					this->hasState = false;
+				}
+
+				cv::setIdentity(this->kalmanFilter.measurementNoiseCov, cv::Scalar::all(this->settings.measurementNoise));
+
+				if (!this->hasState) {
+					this->kalmanFilter.statePost = cv::Mat::zeros(stateSize, 1, CV_32F);
+					translation.copyTo(this->kalmanFilter.statePost.rowRange(0, 3));
+					rotationVector.copyTo(this->kalmanFilter.statePost.rowRange(3, 6));
+					cv::setIdentity(this->kalmanFilter.errorCovPost, cv::Scalar::all(this->settings.errorPost));
+					this->hasState = true;
+				}
+				else {
+					this->kalmanFilter.transitionMatrix = getTransitionMatrix(dt.count());
+					this->kalmanFilter.processNoiseCov = this->getProcessNoise(dt.count());
+					const auto & predicted = this->kalmanFilter.predict();
+
+					//the same rotation can be expressed as r or r - 2pi * axis. Take whichever is closest to the prediction
+					{
+						auto angle = cv::norm(rotationVector);
+						if (angle > 0.0) {
+							cv::Mat alternative = rotationVector * (float)((angle - 2.0 * PI) / angle);
+							cv::Mat predictedRotation = predicted.rowRange(3, 6);
+							if (cv::norm(alternative - predictedRotation) < cv::norm(rotationVector - predictedRotation)) {
+								rotationVector = alternative;
+							}
+						}
+					}
+
+					cv::Mat measurement(measurementSize, 1, CV_32F);
+					translation.copyTo(measurement.rowRange(0, 3));
+					rotationVector.copyTo(measurement.rowRange(3, 6));
+					this->kalmanFilter.correct(measurement);
+				}
+
+				this->lastFrameTimestamp = frameTimestamp;
+				this->lastCorrectionTime = chrono::high_resolution_clock::now();
+			}
+
+			//----------
+			bool PoseFilter::predict(chrono::nanoseconds frameTimestamp, Prediction & prediction) const {
+				auto lock = unique_lock<mutex>(this->filterMutex);
+				chrono::duration<float> dt = frameTimestamp - this->lastFrameTimestamp;
+				return this->predictUnlocked(dt.count(), prediction);
+			}
+
+			//----------
+			bool PoseFilter::predictNow(Prediction & prediction) const {
+				auto lock = unique_lock<mutex>(this->filterMutex);
+				chrono::duration<float> dt = chrono::high_resolution_clock::now() - this->lastCorrectionTime;
+				return this->predictUnlocked(dt.count(), prediction);
+			}
+
+			//----------
+			cv::Mat PoseFilter::getTransitionMatrix(float dt) {
+				cv::Mat transitionMatrix = cv::Mat::eye(stateSize, stateSize, CV_32F);
+				for (int i = 0; i < 6; i++) {
+					transitionMatrix.at<float>(i, i + 6) = dt;
+				}
+				return transitionMatrix;
+			}
+
+			//----------
+			cv::Mat PoseFilter::getProcessNoise(float dt) const {
+				//white noise acceleration model
+				const auto q = this->settings.processNoise;
+				const auto dt2 = dt * dt;
+				cv::Mat processNoise = cv::Mat::zeros(stateSize, stateSize, CV_32F);
+				for (int i = 0; i < 6; i++) {
+					processNoise.at<float>(i, i) = q * dt2 * dt2 / 4.0f;
+					processNoise.at<float>(i, i + 6) = q * dt2 * dt / 2.0f;
+					processNoise.at<float>(i + 6, i) = q * dt2 * dt / 2.0f;
+					processNoise.at<float>(i + 6, i + 6) = q * dt2;
+				}
+				return processNoise;
+			}
+
+			//----------
+			bool PoseFilter::predictUnlocked(float dt, Prediction & prediction) const {
+				if (!this->settings.enabled || !this->hasState) {
+					return false;
+				}
+				if (dt < 0.0f || dt > this->settings.maxPredictionTime) {
+					return false;
+				}
+
+				auto transitionMatrix = getTransitionMatrix(dt);
+				cv::Mat state = transitionMatrix * this->kalmanFilter.statePost;
+				cv::Mat covariance = transitionMatrix * this->kalmanFilter.errorCovPost * transitionMatrix.t() + this->getProcessNoise(dt);
+
+				state.rowRange(0, 3).convertTo(prediction.translation, CV_64F);
+				state.rowRange(3, 6).convertTo(prediction.rotationVector, CV_64F);
+
+				auto translationVariance = cv::trace(covariance(cv::Range(0, 3), cv::Range(0, 3)))[0] / 3.0;
+				auto rotationVariance = cv::trace(covariance(cv::Range(3, 6), cv::Range(3, 6)))[0] / 3.0;
+				prediction.translationDeviation = sqrt(translationVariance);
+				prediction.rotationDeviation = sqrt(rotationVariance);
+
+				return true;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "ofxRulr.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace MoCap {
+			//Constant velocity Kalman filter over a rigid body pose (translation + rotation vector)
+			//Thread safe. Measurements are corrected in frame time (camera timestamps),
+			//and predictions can be made either in frame time or extrapolated by the wall clock.
+			class PoseFilter {
+			public:
+				struct Settings {
+					bool enabled = false;
+					float processNoise = 1e-5;
+					float measurementNoise = 1e-2;
+					float errorPost = 1;
+					float maxPredictionTime = 0.5f; // [s] beyond this we consider the prediction invalid
+				};
+
+				struct Prediction {
+					cv::Mat rotationVector;
+					cv::Mat translation;
+					float translationDeviation = 0.0f; // [m]
+					float rotationDeviation = 0.0f; // [rad]
+				};
+
+				PoseFilter();
+
+				void setSettings(const Settings &);
+				Settings getSettings() const;
+				bool isActive() const; // enabled and has a state
+
+				void reset();
+				void correct(chrono::nanoseconds frameTimestamp, const cv::Mat & rotationVector, const cv::Mat & translation);
+
+				bool predict(chrono::nanoseconds frameTimestamp, Prediction &) const;
+				bool predictNow(Prediction &) const;
+			protected:
+				static cv::Mat getTransitionMatrix(float dt);
+				cv::Mat getProcessNoise(float dt) const;
+				bool predictUnlocked(float dt, Prediction &) const;
+
+				Settings settings;
+				cv::KalmanFilter kalmanFilter;
+				bool hasState = false;
+				chrono::nanoseconds lastFrameTimestamp;
+				chrono::high_resolution_clock::time_point lastCorrectionTime;
+				mutable mutex filterMutex;
+			};
+		}
+	}
+}
\ No newline at end of file
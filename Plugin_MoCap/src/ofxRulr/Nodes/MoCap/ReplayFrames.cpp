@@ -0,0 +1,244 @@
+#include "pch_Plugin_MoCap.h"
+#include "ReplayFrames.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace MoCap {
+			//----------
+			ReplayFrames::ReplayFrames() {
+				RULR_NODE_INIT_LISTENER;
+			}
+
+			//----------
+			ReplayFrames::~ReplayFrames() {
+				this->stop();
+			}
+
+			//----------
+			string ReplayFrames::getTypeName() const {
+				return "MoCap::ReplayFrames";
+			}
+
+			//----------
+			void ReplayFrames::init() {
+				RULR_NODE_UPDATE_LISTENER;
+				RULR_NODE_INSPECTOR_LISTENER;
+
+				this->manageParameters(this->parameters);
+
+				this->addInput<Item::Camera>();
+
+				this->onDeserialize += [this](const nlohmann::json &) {
+					try {
+						this->loadFolder();
+						this->needsAutoPlay = this->parameters.playOnLoad.get();
+					}
+					RULR_CATCH_ALL_TO_ERROR;
+				};
+			}
+
+			//----------
+			void ReplayFrames::update() {
+				if (this->needsAutoPlay && this->getInput<Item::Camera>()) {
+					this->needsAutoPlay = false;
+					try {
+						this->play();
+					}
+					RULR_CATCH_ALL_TO_ERROR;
+				}
+
+				//notify finish in the main thread
+				if (this->replayFinished.exchange(false)) {
+					if (this->replayThread.joinable()) {
+						this->replayThread.join();
+					}
+					this->onReplayFinished.notifyListeners();
+				}
+			}
+
+			//----------
+			void ReplayFrames::populateInspector(ofxCvGui::InspectArguments & inspectArgs) {
+				auto inspector = inspectArgs.inspector;
+
+				inspector->addButton("Select folder...", [this]() {
+					try {
+						this->selectFolder();
+					}
+					RULR_CATCH_ALL_TO_ALERT;
+				});
+				inspector->addLiveValue<size_t>("Frames in folder", [this]() {
+					return this->getFrameCount();
+				});
+				inspector->addLiveValue<size_t>("Frames sent", [this]() {
+					return this->getFramesSent();
+				});
+				inspector->addIndicatorBool("Playing", [this]() {
+					return this->isPlaying();
+				});
+				inspector->addButton("Play", [this]() {
+					try {
+						this->play();
+					}
+					RULR_CATCH_ALL_TO_ALERT;
+				}, ' ');
+				inspector->addButton("Stop", [this]() {
+					this->stop();
+				});
+			}
+
+			//----------
+			void ReplayFrames::selectFolder(string path) {
+				if (path.empty()) {
+					auto result = ofSystemLoadDialog("Select folder of recorded frames", true);
+					if (!result.bSuccess) {
+						return;
+					}
+					path = result.filePath;
+				}
+				this->parameters.folder = path;
+				this->loadFolder();
+			}
+
+			//----------
+			void ReplayFrames::loadFolder() {
+				this->stop();
+				this->recordedFrames.clear();
+
+				const auto folder = this->parameters.folder.get();
+				if (folder.empty()) {
+					return;
+				}
+				if (!filesystem::is_directory(folder)) {
+					throw(ofxRulr::Exception("Replay folder " + folder + " does not exist"));
+				}
+
+				for (const auto & entry : filesystem::directory_iterator(folder)) {
+					if (entry.path().extension() != ".png") {
+						continue;
+					}
+
+					RecordedFrame recordedFrame;
+					try {
+						recordedFrame.timestamp = chrono::nanoseconds(stoll(entry.path().stem().string()));
+					}
+					catch (...) {
+						//not a recorded frame
+						continue;
+					}
+					recordedFrame.path = entry.path().string();
+					this->recordedFrames.push_back(move(recordedFrame));
+				}
+
+				sort(this->recordedFrames.begin(), this->recordedFrames.end(), [](const RecordedFrame & a, const RecordedFrame & b) {
+					return a.timestamp < b.timestamp;
+				});
+
+				if (this->parameters.preload) {
+					Utils::ScopedProcess scopedProcess("Preloading frames", false, this->recordedFrames.size());
+					for (auto & recordedFrame : this->recordedFrames) {
+						Utils::ScopedProcess frameScopedProcess(recordedFrame.path, false);
+						recordedFrame.image = cv::imread(recordedFrame.path, cv::IMREAD_GRAYSCALE);
+					}
+					scopedProcess.end();
+				}
+			}
+
+			//----------
+			void ReplayFrames::play() {
+				this->stop();
+
+				auto camera = this->getInput<Item::Camera>();
+				if (!camera) {
+					throw(ofxRulr::Exception("ReplayFrames needs a Camera to send frames through"));
+				}
+				if (this->recordedFrames.empty()) {
+					throw(ofxRulr::Exception("No frames to replay"));
+				}
+
+				this->framesSent.store(0);
+				this->replayClosing.store(false);
+				this->replayRunning.store(true);
+
+				auto playbackRate = this->parameters.playbackRate.get();
+				auto loop = this->parameters.loop.get();
+
+				//listeners (e.g. Benchmark clearing its results) must finish before the first frame is sent
+				this->onReplayStarted.notifyListeners();
+
+				this->replayThread = std::thread([this, camera, playbackRate, loop]() {
+					size_t frameIndex = 0;
+					do {
+						auto startTime = chrono::high_resolution_clock::now();
+						auto firstTimestamp = this->recordedFrames.front().timestamp;
+
+						for (const auto & recordedFrame : this->recordedFrames) {
+							if (this->replayClosing.load()) {
+								break;
+							}
+
+							try {
+								auto frame = this->makeFrame(recordedFrame, frameIndex++);
+
+								if (playbackRate == PlaybackRate::Recorded) {
+									std::this_thread::sleep_until(startTime + (recordedFrame.timestamp - firstTimestamp));
+								}
+
+								this->onFrameSent.notifyListeners(frame);
+								camera->onNewFrame.notifyListeners(move(frame));
+								this->framesSent++;
+							}
+							RULR_CATCH_ALL_TO_ERROR;
+						}
+					} while (loop && !this->replayClosing.load());
+
+					this->replayRunning.store(false);
+					this->replayFinished.store(true);
+				});
+			}
+
+			//----------
+			void ReplayFrames::stop() {
+				this->replayClosing.store(true);
+				if (this->replayThread.joinable()) {
+					this->replayThread.join();
+				}
+				this->replayRunning.store(false);
+			}
+
+			//----------
+			bool ReplayFrames::isPlaying() const {
+				return this->replayRunning.load();
+			}
+
+			//----------
+			size_t ReplayFrames::getFrameCount() const {
+				return this->recordedFrames.size();
+			}
+
+			//----------
+			size_t ReplayFrames::getFramesSent() const {
+				return this->framesSent.load();
+			}
+
+			//----------
+			shared_ptr<ofxMachineVision::Frame> ReplayFrames::makeFrame(const RecordedFrame & recordedFrame, size_t frameIndex) const {
+				auto image = recordedFrame.image.empty()
+					? cv::imread(recordedFrame.path, cv::IMREAD_GRAYSCALE)
+					: recordedFrame.image;
+				if (image.empty()) {
+					throw(ofxRulr::Exception("Failed to load " + recordedFrame.path));
+				}
+
+				auto frame = ofxMachineVision::FramePool::X().getAvailableAllocatedFrame(image.cols, image.rows, ofPixelFormat::OF_PIXELS_GRAY);
+				auto & pixels = frame->getPixels();
+				for (int y = 0; y < image.rows; y++) {
+					memcpy(pixels.getData() + y * image.cols, image.ptr(y), image.cols);
+				}
+
+				frame->setTimestamp(recordedFrame.timestamp);
+				frame->setFrameIndex(frameIndex);
+				return frame;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "ofxRulr/Nodes/Base.h"
+#include "ofxRulr/Nodes/Item/Camera.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace MoCap {
+			//Replays a folder of frames recorded by RecordMarkerImages (<timestamp>.png)
+			//Frames are sent through the connected Camera's onNewFrame, so the
+			//FindMarkerCentroids -> MatchMarkers -> UpdateTracking chain runs as it would live
+			//(close the camera's device first). For a lossless deterministic replay, enable
+			//'Perform in parent thread' on the downstream nodes.
+			class ReplayFrames : public Nodes::Base {
+			public:
+				MAKE_ENUM(PlaybackRate
+					, (Recorded, Maximum)
+					, ("Recorded", "Maximum"));
+
+				ReplayFrames();
+				~ReplayFrames();
+				string getTypeName() const override;
+				void init();
+				void update();
+				void populateInspector(ofxCvGui::InspectArguments &);
+
+				void selectFolder(string path = "");
+				void loadFolder();
+				void play();
+				void stop();
+				bool isPlaying() const;
+
+				size_t getFrameCount() const;
+				size_t getFramesSent() const;
+
+				//happens in the replay thread, just before the frame is sent to the camera's listeners
+				ofxLiquidEvent<shared_ptr<ofxMachineVision::Frame>> onFrameSent;
+
+				//happen in the main thread (onReplayStarted completes before the first frame is sent)
+				ofxLiquidEvent<void> onReplayStarted;
+				ofxLiquidEvent<void> onReplayFinished;
+			protected:
+				struct RecordedFrame {
+					chrono::nanoseconds timestamp;
+					string path;
+					cv::Mat image; // only when preloaded
+				};
+
+				shared_ptr<ofxMachineVision::Frame> makeFrame(const RecordedFrame &, size_t frameIndex) const;
+
+				struct : ofParameterGroup {
+					ofParameter<string> folder{ "Folder", "" };
+					ofParameter<PlaybackRate> playbackRate{ "Playback rate", PlaybackRate::Recorded };
+					ofParameter<bool> preload{ "Preload into memory", true };
+					ofParameter<bool> loop{ "Loop", false };
+					ofParameter<bool> playOnLoad{ "Play on load", false };
+					PARAM_DECLARE("ReplayFrames", folder, playbackRate, preload, loop, playOnLoad);
+				} parameters;
+
+				vector<RecordedFrame> recordedFrames;
+
+				std::thread replayThread;
+				atomic<bool> replayRunning = false;
+				atomic<bool> replayClosing = false;
+				atomic<bool> replayFinished = false;
+				atomic<size_t> framesSent = 0;
+				bool needsAutoPlay = false;
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "ofxRulr/Nodes/Item/Camera.h"
 #include "ofxRulr/Nodes/Item/AbstractBoard.h"
 
+#include "ofxRulr/Solvers/StereoPnP.h"
+
 namespace ofxRulr {
 	namespace Nodes {
 		namespace MoCap {
@@ -354,6 +356,56 @@ namespace ofxRulr {
 					ofxCv::decomposeMatrix(stereoTransformInverse, rotationVectorStereoInverse, translationStereoInverse);
 				}
 
+				//solve all hypotheses from both cameras in parallel and refine jointly
+				//hypotheses need 4 points in one camera, otherwise we fall through to the common points path below
+				if (this->parameters.solve.mode.get() == StereoSolveMode::MultiHypothesis
+					&& (imagePointsA.size() >= 4 || imagePointsB.size() >= 4)) {
+					auto cameraNodeA = stereoCalibrateNode->getInput<Item::Camera>("Camera A");
+					auto cameraNodeB = stereoCalibrateNode->getInput<Item::Camera>("Camera B");
+
+					//undistort once per camera, shared by all hypotheses
+					auto prepareStart = chrono::high_resolution_clock::now();
+					auto futureViewA = std::async(std::launch::async, [&] {
+						return Solvers::StereoPnP::prepareView(imagePointsA
+							, objectPointsA
+							, cameraNodeA->getCameraMatrix()
+							, cameraNodeA->getDistortionCoefficients());
+					});
+					auto viewB = Solvers::StereoPnP::prepareView(imagePointsB
+						, objectPointsB
+						, cameraNodeB->getCameraMatrix()
+						, cameraNodeB->getDistortionCoefficients());
+					auto viewA = futureViewA.get();
+					auto prepareDuration = chrono::duration<float, milli>(chrono::high_resolution_clock::now() - prepareStart).count();
+
+					Solvers::StereoPnP::Settings settings;
+					settings.hypothesisCount = (size_t) max(this->parameters.solve.hypothesisCount.get(), 1);
+					settings.inlierThreshold = this->parameters.solve.inlierThreshold.get();
+
+					auto result = Solvers::StereoPnP::solve(viewA
+						, viewB
+						, openCVCalibration.rotationVector
+						, openCVCalibration.translation
+						, settings
+						, useExtrinsicGuess ? rotationVector : cv::Mat()
+						, useExtrinsicGuess ? translation : cv::Mat());
+
+					const auto & solution = result.solution;
+					this->solveTimings.prepare.store(prepareDuration + solution.timings.prepare);
+					this->solveTimings.hypotheses.store(solution.timings.hypotheses);
+					this->solveTimings.refine.store(solution.timings.refine);
+					this->solveTimings.inlierCount.store(solution.inlierCount);
+
+					if (result.isError) {
+						return false;
+					}
+
+					rotationVector = solution.rotationVector;
+					translation = solution.translation;
+					this->dataPreview.transformStereoResult = ofxCv::makeMatrix(rotationVector, translation);
+					return true;
+				}
+
 				//HACK in either of these cases we disable useExtrinsicGuess
 				if (imagePointsA.empty() || imagePointsB.empty()) {
 					//we do this because we want to use the single view procedure in this case (which is what we use to make our guess)
@@ -429,23 +481,20 @@ namespace ofxRulr {
 								errorRMS = sqrt(errorSquaredSum);
 							}
 								
-							//check if our solution is best so far
-							if (errorRMS < bestResult.reprojectionError) {
-								//if so set ours as best
-
-								//first cancel out camera rotation, translation
-								if (!cameraRotationInverse.empty()) {
-									cv::composeRT(rotationVector
-										, translation
-										, cameraRotationInverse
-										, cameraTranslationInverse
-										, rotationVector
-										, translation);
-								}
+							//first cancel out camera rotation, translation
+							if (!cameraRotationInverse.empty()) {
+								cv::composeRT(rotationVector
+									, translation
+									, cameraRotationInverse
+									, cameraTranslationInverse
+									, rotationVector
+									, translation);
+							}
 
-								//save the result
-								{
-									auto lock = unique_lock<mutex>(bestResultMutex);
+							//check if our solution is best so far (both cameras may arrive here at once)
+							{
+								auto lock = unique_lock<mutex>(bestResultMutex);
+								if (errorRMS < bestResult.reprojectionError) {
 									bestResult = Result{ rotationVector
 										, translation
 										, errorRMS
@@ -639,6 +688,7 @@ namespace ofxRulr {
 			//----------
 			void StereoSolvePnP::init() {
 				RULR_NODE_UPDATE_LISTENER;
+				RULR_NODE_INSPECTOR_LISTENER;
 				RULR_NODE_DRAW_WORLD_LISTENER;
 
 				this->addInput<Procedure::Calibrate::StereoCalibrate>();
@@ -745,6 +795,23 @@ namespace ofxRulr {
 				RULR_CATCH_ALL_TO_ERROR;
 			}
 
+			//----------
+			void StereoSolvePnP::populateInspector(ofxCvGui::InspectArguments & inspectArgs) {
+				auto inspector = inspectArgs.inspector;
+				inspector->addLiveValueHistory("Prepare [ms]", [this]() {
+					return this->solveTimings.prepare.load();
+				});
+				inspector->addLiveValueHistory("Hypotheses [ms]", [this]() {
+					return this->solveTimings.hypotheses.load();
+				});
+				inspector->addLiveValueHistory("Refine [ms]", [this]() {
+					return this->solveTimings.refine.load();
+				});
+				inspector->addLiveValueHistory("Inliers", [this]() {
+					return (float) this->solveTimings.inlierCount.load();
+				});
+			}
+
 			//----------
 			ofxCvGui::PanelPtr StereoSolvePnP::getPanel() {
 				return this->panel;
@@ -9,12 +9,17 @@
 namespace ofxRulr {
 	namespace Nodes {
 		namespace MoCap {
+			MAKE_ENUM(StereoSolveMode
+				, (BestSingleView, MultiHypothesis)
+				, ("Best single view", "Multi hypothesis"));
+
 			class StereoSolvePnP : public Nodes::Base {
 			public:
 				StereoSolvePnP();
 				string getTypeName() const override;
 				void init();
 				void update();
+				void populateInspector(ofxCvGui::InspectArguments &);
 				ofxCvGui::PanelPtr getPanel() override;
 				void drawWorldStage();
 				
@@ -31,6 +36,13 @@ namespace ofxRulr {
 				struct : ofParameterGroup {
 					ofParameter<FindBoardMode> findBoardMode{ "Mode", FindBoardMode::Optimized };
 
+					struct : ofParameterGroup {
+						ofParameter<StereoSolveMode> mode{ "Mode", StereoSolveMode::MultiHypothesis };
+						ofParameter<int> hypothesisCount{ "Hypothesis count", 32 };
+						ofParameter<float> inlierThreshold{ "Inlier threshold [px]", 3.0f };
+						PARAM_DECLARE("Solve", mode, hypothesisCount, inlierThreshold);
+					} solve;
+
 					struct : ofParameterGroup {
 						ofParameter<bool> a{ "A", true };
 						ofParameter<bool> b{ "B", true };
@@ -38,7 +50,7 @@ namespace ofxRulr {
 						PARAM_DECLARE("Draw", a, b, stereo);
 					} draw;
 
-					PARAM_DECLARE("StereoSolvePnP", findBoardMode, draw);
+					PARAM_DECLARE("StereoSolvePnP", findBoardMode, solve, draw);
 				} parameters;
 
 				struct {
@@ -51,6 +63,14 @@ namespace ofxRulr {
 					ofMatrix4x4 transformStereoResult;
 				} dataPreview;
 
+				//written from the solve thread, read by the inspector [ms]
+				struct {
+					atomic<float> prepare{ 0.0f };
+					atomic<float> hypotheses{ 0.0f };
+					atomic<float> refine{ 0.0f };
+					atomic<size_t> inlierCount{ 0 };
+				} solveTimings;
+
 				ofxCvGui::PanelPtr panel;
 			};
 		}
@@ -12,6 +12,11 @@ namespace ofxRulr {
 				RULR_NODE_INIT_LISTENER;
 			}
 
+			//----------
+			UpdateTracking::~UpdateTracking() {
+				this->stopPredictionOutput();
+			}
+
 			//----------
 			std::string UpdateTracking::getTypeName() const {
 				return "MoCap::UpdateTracking";
@@ -29,6 +34,16 @@ namespace ofxRulr {
 
 			//----------
 			void UpdateTracking::update() {
+				{
+					auto predictionEnabled = this->parameters.predictionOutputRate.get() > 0.0f;
+					if (predictionEnabled && !this->predictionOutputRunning.load()) {
+						this->startPredictionOutput();
+					}
+					else if (!predictionEnabled && this->predictionOutputThread.joinable()) {
+						this->stopPredictionOutput();
+					}
+				}
+
 				{
 					auto rigidBodyNode = this->getInput<Item::RigidBody>();
 					if (rigidBodyNode) {
@@ -121,10 +136,23 @@ namespace ofxRulr {
 						, outgoingFrame->modelTranslation);
 				}
 
+				//feed the measurement to the body's filter (which predicts the next search for MatchMarkers)
+				//for either target, since MatchMarkers searches with the body pose relative to the camera's current transform
+				{
+					auto poseFilter = incomingFrame->bodyDescription->poseFilter;
+					if (poseFilter) {
+						if (incomingFrame->result.trackingWasLost || incomingFrame->result.forceTakeTransform) {
+							poseFilter->reset();
+						}
+						poseFilter->correct(incomingFrame->incomingFrame->imageFrame->getTimestamp()
+							, outgoingFrame->modelRotationVector
+							, outgoingFrame->modelTranslation);
+					}
+				}
+
 				switch (outgoingFrame->updateTarget.get()) {
 					case UpdateTarget::Body:
 					{
-						//nothing to do
 						outgoingFrame->transform = ofxCv::makeMatrix(outgoingFrame->modelRotationVector
 							, outgoingFrame->modelTranslation);
 						break;
@@ -140,9 +168,108 @@ namespace ofxRulr {
 						break;
 				}
 
-				this->onNewFrame.notifyListeners(outgoingFrame);
+				{
+					auto lock = unique_lock<mutex>(this->lastFrameMutex);
+					this->lastFrame = outgoingFrame;
+					this->onNewFrame.notifyListeners(outgoingFrame);
+				}
+
 				this->trackingUpdateToMainThread.send(outgoingFrame);
 			}
+
+			//----------
+			void UpdateTracking::startPredictionOutput() {
+				this->stopPredictionOutput();
+
+				this->predictionOutputClosing.store(false);
+				this->predictionOutputRunning.store(true);
+				this->predictionOutputThread = std::thread([this]() {
+					this->predictionOutputLoop();
+					this->predictionOutputRunning.store(false);
+				});
+			}
+
+			//----------
+			void UpdateTracking::stopPredictionOutput() {
+				this->predictionOutputClosing.store(true);
+				if (this->predictionOutputThread.joinable()) {
+					this->predictionOutputThread.join();
+				}
+			}
+
+			//----------
+			void UpdateTracking::predictionOutputLoop() {
+				auto nextOutputTime = chrono::high_resolution_clock::now();
+
+				while (!this->predictionOutputClosing.load()) {
+					auto rate = this->parameters.predictionOutputRate.get();
+					if (rate <= 0.0f) {
+						//prediction disabled, update() will join us
+						break;
+					}
+
+					nextOutputTime += chrono::duration_cast<chrono::high_resolution_clock::duration>(chrono::duration<float>(1.0f / rate));
+					std::this_thread::sleep_until(nextOutputTime);
+
+					//hold the lock whilst predicting and notifying so that we never overtake a measured frame
+					{
+						auto lock = unique_lock<mutex>(this->lastFrameMutex);
+						auto lastFrame = this->lastFrame;
+						if (!lastFrame) {
+							continue;
+						}
+
+						auto poseFilter = lastFrame->incomingFrame->bodyDescription->poseFilter;
+						PoseFilter::Prediction prediction;
+						if (!poseFilter || !poseFilter->predictNow(prediction)) {
+							continue;
+						}
+
+						auto predictedFrame = make_shared<UpdateTrackingFrame>(*lastFrame);
+						predictedFrame->isPrediction = true;
+						predictedFrame->modelRotationVector = prediction.rotationVector;
+						predictedFrame->modelTranslation = prediction.translation;
+
+						switch (predictedFrame->updateTarget.get()) {
+							case UpdateTarget::Body:
+							{
+								predictedFrame->transform = ofxCv::makeMatrix(prediction.rotationVector
+									, prediction.translation);
+								break;
+							}
+							case UpdateTarget::Camera:
+							{
+								//as in processFrame, the transform is of the camera
+								//(compose into new Mats, the copied frame shares its data with lastFrame)
+								const auto & cameraDescription = lastFrame->incomingFrame->cameraDescription;
+								cv::Mat bodyModelViewRotationVector;
+								cv::Mat bodyModelViewTranslation;
+								cv::composeRT(prediction.rotationVector
+									, prediction.translation
+									, cameraDescription->inverseRotationVector
+									, cameraDescription->inverseTranslation
+									, bodyModelViewRotationVector
+									, bodyModelViewTranslation);
+								predictedFrame->bodyModelViewRotationVector = bodyModelViewRotationVector;
+								predictedFrame->bodyModelViewTranslation = bodyModelViewTranslation;
+								predictedFrame->transform = glm::inverse(ofxCv::makeMatrix(bodyModelViewRotationVector
+									, bodyModelViewTranslation)) * lastFrame->incomingFrame->bodyDescription->modelTransform;
+								break;
+							}
+							default:
+								break;
+						}
+
+						try {
+							this->onNewFrame.notifyListeners(predictedFrame);
+						}
+						RULR_CATCH_ALL_TO_ERROR;
+					}
+
+					//don't try to catch up if we fell behind
+					nextOutputTime = max(nextOutputTime, chrono::high_resolution_clock::now());
+				}
+			}
 		}
 	}
 }
\ No newline at end of file
@@ -15,6 +15,7 @@ namespace ofxRulr {
 				shared_ptr<MatchMarkersFrame> incomingFrame;
 
 				UpdateTarget updateTarget;
+				bool isPrediction = false; // emitted by the prediction output rather than measured
 
 				cv::Mat bodyModelViewRotationVector;
 				cv::Mat bodyModelViewTranslation;
@@ -31,6 +32,7 @@ namespace ofxRulr {
 				, UpdateTrackingFrame> {
 			public:
 				UpdateTracking();
+				~UpdateTracking();
 				string getTypeName() const override;
 				void init();
 				void update();
@@ -41,9 +43,21 @@ namespace ofxRulr {
 				struct : ofParameterGroup {
 					ofParameter<UpdateTarget> updateTarget{ "Update target", UpdateTarget::Camera };
 					ofParameter<float> reprojectionThreshold{ "Reprojection threshold [px]", 5 };
-					PARAM_DECLARE("UpdateTracking", updateTarget, reprojectionThreshold);
+					ofParameter<float> predictionOutputRate{ "Prediction output rate [Hz]", 0, 0, 1000 }; // 0 = off. Needs Body's Kalman filter
+					PARAM_DECLARE("UpdateTracking", updateTarget, reprojectionThreshold, predictionOutputRate);
 				} parameters;
 
+				//the prediction output thread only runs whilst predictionOutputRate > 0
+				void startPredictionOutput();
+				void stopPredictionOutput();
+				void predictionOutputLoop();
+
+				shared_ptr<UpdateTrackingFrame> lastFrame;
+				mutex lastFrameMutex; // also held whilst notifying, so measured and predicted frames leave in order
+				std::thread predictionOutputThread;
+				atomic<bool> predictionOutputClosing = false;
+				atomic<bool> predictionOutputRunning = false;
+
 				ofThreadChannel<shared_ptr<UpdateTrackingFrame>> trackingUpdateToMainThread;
 				atomic<float> reprojectionError;
 			};
@@ -0,0 +1,436 @@
+#include "pch_Plugin_MoCap.h"
+#include "StereoPnP.h"
+#include <ceres/rotation.h>
+#include "ofxRulr/Utils/SolveCeres.h"
+#include "ofxRulr/Utils/SolverRuntime.h"
+
+struct StereoPnP_Cost
+{
+	// stereoRotation / stereoTranslation are identity / zero for camera A
+	StereoPnP_Cost(const cv::Point3f & objectPoint
+		, const cv::Point2f & normalizedImagePoint
+		, float focalLength
+		, const double * stereoRotation
+		, const double * stereoTranslation)
+		: objectPoint(objectPoint)
+		, normalizedImagePoint(normalizedImagePoint)
+		, focalLength(focalLength)
+	{
+		for (int i = 0; i < 3; i++) {
+			this->stereoRotation[i] = stereoRotation[i];
+			this->stereoTranslation[i] = stereoTranslation[i];
+		}
+	}
+
+	template<typename T>
+	bool
+		operator()(const T* const poseParameters
+			, T* residuals) const
+	{
+		const T objectPoint[3] = {
+			(T)this->objectPoint.x
+			, (T)this->objectPoint.y
+			, (T)this->objectPoint.z
+		};
+
+		// Object -> camera A
+		T pointA[3];
+		ceres::AngleAxisRotatePoint(poseParameters, objectPoint, pointA);
+		for (int i = 0; i < 3; i++) {
+			pointA[i] += poseParameters[i + 3];
+		}
+
+		// Camera A -> this camera
+		const T stereoRotation[3] = {
+			(T)this->stereoRotation[0]
+			, (T)this->stereoRotation[1]
+			, (T)this->stereoRotation[2]
+		};
+		T point[3];
+		ceres::AngleAxisRotatePoint(stereoRotation, pointA, point);
+		for (int i = 0; i < 3; i++) {
+			point[i] += (T)this->stereoTranslation[i];
+		}
+
+		residuals[0] = (point[0] / point[2] - (T)this->normalizedImagePoint.x) * (T)this->focalLength;
+		residuals[1] = (point[1] / point[2] - (T)this->normalizedImagePoint.y) * (T)this->focalLength;
+
+		return true;
+	}
+
+	static ceres::CostFunction*
+		Create(const cv::Point3f & objectPoint
+			, const cv::Point2f & normalizedImagePoint
+			, float focalLength
+			, const double * stereoRotation
+			, const double * stereoTranslation)
+	{
+		return new ceres::AutoDiffCostFunction<StereoPnP_Cost, 2, 6>(
+			new StereoPnP_Cost(objectPoint, normalizedImagePoint, focalLength, stereoRotation, stereoTranslation)
+			);
+	}
+
+	const cv::Point3f objectPoint;
+	const cv::Point2f normalizedImagePoint;
+	const float focalLength;
+	double stereoRotation[3];
+	double stereoTranslation[3];
+};
+
+namespace ofxRulr {
+	namespace Solvers {
+		namespace {
+			struct Hypothesis {
+				cv::Mat rotationVector;
+				cv::Mat translation;
+				size_t inlierCount = 0;
+				float errorSum = 0.0f;
+			};
+
+			//----------
+			// Inverse of x_B = R x_A + T
+			void invertStereo(const cv::Mat & rotationVector, const cv::Mat & translation, cv::Mat & rotationVectorInverse, cv::Mat & translationInverse) {
+				cv::Mat rotation;
+				cv::Rodrigues(rotationVector, rotation);
+				cv::Mat rotationInverse = rotation.t();
+				cv::Rodrigues(rotationInverse, rotationVectorInverse);
+				translationInverse = -rotationInverse * translation;
+			}
+
+			//----------
+			// Project all points of a view under a pose (in camera A) and count inliers
+			void scoreView(const StereoPnP::View & view
+				, const cv::Matx33d & rotation
+				, const cv::Vec3d & translation
+				, float inlierThreshold
+				, vector<bool> * inliers
+				, size_t & inlierCount
+				, float & errorSum) {
+				const auto thresholdSquared = inlierThreshold * inlierThreshold;
+				for (size_t i = 0; i < view.objectPoints.size(); i++) {
+					const auto & objectPoint = view.objectPoints[i];
+					auto point = rotation * cv::Vec3d(objectPoint.x, objectPoint.y, objectPoint.z) + translation;
+					bool isInlier = false;
+					if (point[2] > 0.0) {
+						const auto & imagePoint = view.normalizedImagePoints[i];
+						const auto dx = (float)(point[0] / point[2] - imagePoint.x) * view.focalLength;
+						const auto dy = (float)(point[1] / point[2] - imagePoint.y) * view.focalLength;
+						const auto errorSquared = dx * dx + dy * dy;
+						if (errorSquared < thresholdSquared) {
+							isInlier = true;
+							inlierCount++;
+							errorSum += errorSquared;
+						}
+					}
+					if (inliers) {
+						(*inliers)[i] = isInlier;
+					}
+				}
+			}
+		}
+
+		//----------
+		ofxCeres::SolverSettings
+			StereoPnP::defaultSolverSettings()
+		{
+			ofxCeres::SolverSettings solverSettings;
+			solverSettings.printReport = false;
+			solverSettings.options.minimizer_progress_to_stdout = false;
+			solverSettings.options.logging_type = ceres::SILENT;
+			solverSettings.options.max_num_iterations = 50;
+			solverSettings.options.function_tolerance = 1e-8;
+
+			// Only 6 parameters
+			solverSettings.options.linear_solver_type = ceres::LinearSolverType::DENSE_QR;
+
+			return solverSettings;
+		}
+
+		//----------
+		StereoPnP::View
+			StereoPnP::prepareView(const vector<cv::Point2f> & imagePoints
+				, const vector<cv::Point3f> & objectPoints
+				, const cv::Mat & cameraMatrix
+				, const cv::Mat & distortionCoefficients)
+		{
+			if (imagePoints.size() != objectPoints.size()) {
+				throw(ofxRulr::Exception("StereoPnP requires image points and object points with equal length per camera."));
+			}
+
+			View view;
+			view.objectPoints = objectPoints;
+			if (!imagePoints.empty()) {
+				cv::undistortPoints(imagePoints
+					, view.normalizedImagePoints
+					, cameraMatrix
+					, distortionCoefficients);
+			}
+
+			cv::Mat_<double> cameraMatrixDouble;
+			cameraMatrix.convertTo(cameraMatrixDouble, CV_64F);
+			view.focalLength = (float)((cameraMatrixDouble(0, 0) + cameraMatrixDouble(1, 1)) / 2.0);
+
+			return view;
+		}
+
+		//----------
+		StereoPnP::Result
+			StereoPnP::solve(const View & viewA
+				, const View & viewB
+				, const cv::Mat & stereoRotationVector
+				, const cv::Mat & stereoTranslation
+				, const Settings & settings
+				, const cv::Mat & initialRotationVector
+				, const cv::Mat & initialTranslation)
+		{
+			Timings timings;
+			auto stageStart = chrono::high_resolution_clock::now();
+			auto endStage = [&stageStart](float & duration) {
+				auto now = chrono::high_resolution_clock::now();
+				duration = chrono::duration<float, milli>(now - stageStart).count();
+				stageStart = now;
+			};
+
+			cv::Mat stereoRotationVectorInverse;
+			cv::Mat stereoTranslationInverse;
+			invertStereo(stereoRotationVector, stereoTranslation, stereoRotationVectorInverse, stereoTranslationInverse);
+
+			cv::Matx33d stereoRotation;
+			cv::Rodrigues(stereoRotationVector, stereoRotation);
+			cv::Vec3d stereoTranslationVec((double*)cv::Mat_<double>(stereoTranslation.reshape(1, 3)).data);
+
+			endStage(timings.prepare);
+
+			// Build the hypotheses
+			// Each is solved with identity intrinsics since the views are already normalized
+			vector<Hypothesis> hypotheses;
+			{
+				const auto identity = cv::Mat::eye(3, 3, CV_64F);
+				const auto noDistortion = cv::Mat();
+
+				// Seeds : an optional guess, and the full point set of each camera
+				if (!initialRotationVector.empty() && !initialTranslation.empty()) {
+					Hypothesis hypothesis;
+					initialRotationVector.convertTo(hypothesis.rotationVector, CV_64F);
+					initialTranslation.convertTo(hypothesis.translation, CV_64F);
+					hypotheses.push_back(hypothesis);
+				}
+				if (viewA.objectPoints.size() >= 4) {
+					hypotheses.emplace_back();
+				}
+				if (viewB.objectPoints.size() >= 4) {
+					hypotheses.emplace_back();
+				}
+
+				// Minimal subsets alternating between cameras
+				while (hypotheses.size() < settings.hypothesisCount
+					&& (viewA.objectPoints.size() >= 4 || viewB.objectPoints.size() >= 4)) {
+					hypotheses.emplace_back();
+				}
+
+				if (hypotheses.empty()) {
+					throw(ofxRulr::Exception("Not enough data points to perform stereo solvePnP"));
+				}
+
+				auto seedCount = (size_t)(!initialRotationVector.empty() && !initialTranslation.empty());
+
+				// Solve and score all hypotheses in parallel
+				atomic<size_t> nextIndex = seedCount;
+				auto solveHypotheses = [&]() {
+					for (auto index = nextIndex++; index < hypotheses.size(); index = nextIndex++) {
+						auto & hypothesis = hypotheses[index];
+
+						// Choose which view this hypothesis comes from
+						auto hypothesisIndex = index - seedCount;
+						const View * sourceView;
+						if (viewA.objectPoints.size() >= 4 && viewB.objectPoints.size() >= 4) {
+							sourceView = hypothesisIndex % 2 == 0 ? &viewA : &viewB;
+						}
+						else {
+							sourceView = viewA.objectPoints.size() >= 4 ? &viewA : &viewB;
+						}
+
+						try {
+							cv::Mat rotationVector;
+							cv::Mat translation;
+
+							if (hypothesisIndex < 2) {
+								// All points of the source view
+								cv::solvePnP(sourceView->objectPoints
+									, sourceView->normalizedImagePoints
+									, identity
+									, noDistortion
+									, rotationVector
+									, translation
+									, false
+									, cv::SOLVEPNP_EPNP);
+							}
+							else {
+								// Random minimal subset (seeded by index so results are repeatable)
+								cv::RNG rng(0x9E3779B9 + index);
+								vector<cv::Point3f> objectPoints;
+								vector<cv::Point2f> imagePoints;
+								set<int> chosen;
+								while (chosen.size() < 4) {
+									chosen.insert(rng.uniform(0, (int)sourceView->objectPoints.size()));
+								}
+								for (auto i : chosen) {
+									objectPoints.push_back(sourceView->objectPoints[i]);
+									imagePoints.push_back(sourceView->normalizedImagePoints[i]);
+								}
+								if (!cv::solvePnP(objectPoints
+									, imagePoints
+									, identity
+									, noDistortion
+									, rotationVector
+									, translation
+									, false
+									, cv::SOLVEPNP_P3P)) {
+									continue;
+								}
+							}
+
+							// Bring hypotheses from camera B into camera A
+							if (sourceView == &viewB) {
+								cv::composeRT(rotationVector
+									, translation
+									, stereoRotationVectorInverse
+									, stereoTranslationInverse
+									, rotationVector
+									, translation);
+							}
+
+							hypothesis.rotationVector = rotationVector;
+							hypothesis.translation = translation;
+						}
+						catch (...) {
+							// Degenerate subset
+						}
+					}
+				};
+
+				{
+					auto threadLease = Utils::SolverRuntime::X().acquireThreads(settings.threadCount);
+					auto workerCount = min(threadLease->getThreadCount(), hypotheses.size());
+					vector<future<void>> workers;
+					for (size_t i = 1; i < workerCount; i++) {
+						workers.push_back(std::async(std::launch::async, solveHypotheses));
+					}
+					solveHypotheses();
+					for (auto & worker : workers) {
+						worker.get();
+					}
+				}
+
+				// Score (cheap, so serial)
+				for (auto & hypothesis : hypotheses) {
+					if (hypothesis.rotationVector.empty()) {
+						continue;
+					}
+
+					cv::Matx33d rotationA;
+					cv::Rodrigues(hypothesis.rotationVector, rotationA);
+					cv::Vec3d translationA((double*)cv::Mat_<double>(hypothesis.translation.reshape(1, 3)).data);
+
+					scoreView(viewA, rotationA, translationA, settings.inlierThreshold, nullptr, hypothesis.inlierCount, hypothesis.errorSum);
+					scoreView(viewB, stereoRotation * rotationA, stereoRotation * translationA + stereoTranslationVec, settings.inlierThreshold, nullptr, hypothesis.inlierCount, hypothesis.errorSum);
+				}
+			}
+
+			// Choose the best
+			const Hypothesis * best = nullptr;
+			for (const auto & hypothesis : hypotheses) {
+				if (hypothesis.rotationVector.empty()) {
+					continue;
+				}
+				if (!best
+					|| hypothesis.inlierCount > best->inlierCount
+					|| (hypothesis.inlierCount == best->inlierCount && hypothesis.errorSum < best->errorSum)) {
+					best = &hypothesis;
+				}
+			}
+			if (!best || best->inlierCount < 3) {
+				throw(ofxRulr::Exception("StereoPnP found no hypothesis with enough inliers"));
+			}
+
+			endStage(timings.hypotheses);
+
+			// Refine the winner jointly over the inliers of both cameras
+			double poseParameters[6];
+			{
+				cv::Mat_<double> rotationVector(best->rotationVector.reshape(1, 3));
+				cv::Mat_<double> translation(best->translation.reshape(1, 3));
+				for (int i = 0; i < 3; i++) {
+					poseParameters[i] = rotationVector(i);
+					poseParameters[i + 3] = translation(i);
+				}
+			}
+
+			const double identityRotation[3] = { 0.0, 0.0, 0.0 };
+			const double zeroTranslation[3] = { 0.0, 0.0, 0.0 };
+			double stereoRotationParameters[3];
+			double stereoTranslationParameters[3];
+			{
+				cv::Mat_<double> rotationVector(stereoRotationVector.reshape(1, 3));
+				for (int i = 0; i < 3; i++) {
+					stereoRotationParameters[i] = rotationVector(i);
+					stereoTranslationParameters[i] = stereoTranslationVec[i];
+				}
+			}
+
+			ceres::Problem problem;
+			size_t inlierCount = 0;
+			{
+				cv::Matx33d rotationA;
+				cv::Rodrigues(best->rotationVector, rotationA);
+				cv::Vec3d translationA(poseParameters[3], poseParameters[4], poseParameters[5]);
+
+				auto addView = [&](const View & view, const cv::Matx33d & rotation, const cv::Vec3d & translation, const double * viewRotation, const double * viewTranslation) {
+					vector<bool> inliers(view.objectPoints.size());
+					float errorSum = 0.0f;
+					scoreView(view, rotation, translation, settings.inlierThreshold, &inliers, inlierCount, errorSum);
+					for (size_t i = 0; i < inliers.size(); i++) {
+						if (inliers[i]) {
+							problem.AddResidualBlock(StereoPnP_Cost::Create(view.objectPoints[i]
+								, view.normalizedImagePoints[i]
+								, view.focalLength
+								, viewRotation
+								, viewTranslation)
+								, new ceres::HuberLoss(settings.inlierThreshold)
+								, poseParameters);
+						}
+					}
+				};
+
+				addView(viewA, rotationA, translationA, identityRotation, zeroTranslation);
+				addView(viewB, stereoRotation * rotationA, stereoRotation * translationA + stereoTranslationVec, stereoRotationParameters, stereoTranslationParameters);
+			}
+
+			ceres::Solver::Summary summary;
+			Utils::solveCeres("StereoPnP"
+				, settings.solverSettings.options
+				, &problem
+				, &summary);
+
+			if (settings.solverSettings.printReport) {
+				std::cout << summary.FullReport() << "\n";
+			}
+
+			endStage(timings.refine);
+
+			// Build the result
+			Result result(summary);
+			{
+				result.solution.rotationVector = (cv::Mat_<double>(3, 1) << poseParameters[0], poseParameters[1], poseParameters[2]);
+				result.solution.translation = (cv::Mat_<double>(3, 1) << poseParameters[3], poseParameters[4], poseParameters[5]);
+				result.solution.inlierCount = inlierCount;
+				result.solution.reprojectionError = inlierCount > 0
+					? (float) sqrt(2.0 * summary.final_cost / (double)inlierCount)
+					: 0.0f;
+				result.solution.timings = timings;
+			}
+
+			return result;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+#include "ofxCeres.h"
+
+namespace ofxRulr {
+	namespace Solvers {
+		//Solve the pose of an object seen by a calibrated stereo pair
+		//Pose is of the object in camera A's coordinates. Stereo transform is OpenCV's (x_B = R x_A + T)
+		class StereoPnP {
+		public:
+			//Per camera data, prepared once per frame and shared by all hypotheses
+			struct View {
+				vector<cv::Point3f> objectPoints;
+				vector<cv::Point2f> normalizedImagePoints; // undistorted, in normalized camera coordinates
+				float focalLength = 1.0f; // to express normalized errors in pixels
+			};
+
+			struct Settings {
+				size_t hypothesisCount = 32;
+				float inlierThreshold = 3.0f; // [px]
+				size_t threadCount = 0; // for solving hypotheses. 0 = as many as the SolverRuntime budget allows
+				ofxCeres::SolverSettings solverSettings = defaultSolverSettings();
+			};
+
+			struct Timings {
+				float prepare = 0.0f; // [ms] only the stereo transforms. Callers add their prepareView time
+				float hypotheses = 0.0f;
+				float refine = 0.0f;
+			};
+
+			struct Solution {
+				cv::Mat rotationVector;
+				cv::Mat translation;
+				size_t inlierCount = 0;
+				float reprojectionError = 0.0f; // RMS [px] over inliers
+				Timings timings;
+			};
+
+			typedef ofxCeres::Result<Solution> Result;
+
+			static ofxCeres::SolverSettings defaultSolverSettings();
+
+			static View prepareView(const vector<cv::Point2f> & imagePoints
+				, const vector<cv::Point3f> & objectPoints
+				, const cv::Mat & cameraMatrix
+				, const cv::Mat & distortionCoefficients);
+
+			static Result solve(const View & viewA
+				, const View & viewB
+				, const cv::Mat & stereoRotationVector
+				, const cv::Mat & stereoTranslation
+				, const Settings & settings
+				, const cv::Mat & initialRotationVector = cv::Mat() // optional extra hypothesis
+				, const cv::Mat & initialTranslation = cv::Mat());
+		};
+	}
+}
\ No newline at end of file
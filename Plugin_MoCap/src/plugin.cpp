@@ -15,6 +15,8 @@
 #include "ofxRulr/Nodes/MoCap/PreviewRecordMarkerImageFrame.h"
 #include "ofxRulr/Nodes/MoCap/MarkerTagger.h"
 #include "ofxRulr/Nodes/MoCap/AddMarkerFromStereo.h"
+#include "ofxRulr/Nodes/MoCap/ReplayFrames.h"
+#include "ofxRulr/Nodes/MoCap/Benchmark.h"
 
 OFXPLUGIN_PLUGIN_MODULES_BEGIN(ofxRulr::Nodes::Base)
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::MoCap::FindMarkerCentroids);
@@ -30,4 +32,6 @@ OFXPLUGIN_PLUGIN_MODULES_BEGIN(ofxRulr::Nodes::Base)
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::MoCap::PreviewRecordMarkerImagesFrame);
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::MoCap::MarkerTagger);
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::MoCap::AddMarkerFromStereo);
+	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::MoCap::ReplayFrames);
+	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::MoCap::Benchmark);
 OFXPLUGIN_PLUGIN_MODULES_END
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "pch_MultiTrack.h"
+#include "FrameDecoder.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace MultiTrack {
+#pragma mark Pool
+			//----------
+			FrameDecoder::Pool & FrameDecoder::Pool::X() {
+				static Pool pool;
+				return pool;
+			}
+
+			//----------
+			FrameDecoder::Pool::Pool() {
+				auto threadCount = std::max(std::thread::hardware_concurrency() / 2, 2u);
+				for (unsigned int i = 0; i < threadCount; i++) {
+					this->threads.emplace_back([this]() {
+						this->threadFunction();
+					});
+				}
+			}
+
+			//----------
+			FrameDecoder::Pool::~Pool() {
+				{
+					unique_lock<std::mutex> lock(this->mutex);
+					this->closing = true;
+				}
+				this->queueCondition.notify_all();
+				for (auto & thread : this->threads) {
+					thread.join();
+				}
+			}
+
+			//----------
+			void FrameDecoder::Pool::schedule(FrameDecoder * frameDecoder) {
+				{
+					unique_lock<std::mutex> lock(this->mutex);
+					if (frameDecoder->scheduled) {
+						//still receiving the last one
+						return;
+					}
+					frameDecoder->scheduled = true;
+					this->queue.push_back(frameDecoder);
+				}
+				this->queueCondition.notify_one();
+			}
+
+			//----------
+			void FrameDecoder::Pool::cancel(FrameDecoder * frameDecoder) {
+				unique_lock<std::mutex> lock(this->mutex);
+
+				auto findQueued = std::find(this->queue.begin(), this->queue.end(), frameDecoder);
+				if (findQueued != this->queue.end()) {
+					this->queue.erase(findQueued);
+					frameDecoder->scheduled = false;
+				}
+
+				//wait for any receive in progress on a pool thread
+				this->idleCondition.wait(lock, [frameDecoder]() {
+					return !frameDecoder->scheduled;
+				});
+			}
+
+			//----------
+			void FrameDecoder::Pool::threadFunction() {
+				while (true) {
+					FrameDecoder * frameDecoder;
+					{
+						unique_lock<std::mutex> lock(this->mutex);
+						this->queueCondition.wait(lock, [this]() {
+							return this->closing || !this->queue.empty();
+						});
+						if (this->closing) {
+							break;
+						}
+						frameDecoder = this->queue.front();
+						this->queue.pop_front();
+					}
+
+					frameDecoder->receive();
+
+					{
+						unique_lock<std::mutex> lock(this->mutex);
+						frameDecoder->scheduled = false;
+					}
+					this->idleCondition.notify_all();
+				}
+			}
+
+#pragma mark FrameDecoder
+			//----------
+			FrameDecoder::FrameDecoder() {
+
+			}
+
+			//----------
+			FrameDecoder::~FrameDecoder() {
+				this->stop();
+			}
+
+			//----------
+			void FrameDecoder::start(const ReceiveFunction & receiveFunction) {
+				this->stop();
+
+				this->receiveFunction = receiveFunction;
+				this->frameIndex = 0;
+				this->lastFrameTime = chrono::high_resolution_clock::now();
+				this->running = true;
+				Pool::X().schedule(this);
+			}
+
+			//----------
+			void FrameDecoder::stop() {
+				if (this->running) {
+					this->running = false;
+					Pool::X().cancel(this);
+					this->receiveFunction = ReceiveFunction();
+				}
+			}
+
+			//----------
+			bool FrameDecoder::isRunning() const {
+				return this->running;
+			}
+
+			//----------
+			void FrameDecoder::setPointCloudSettings(const PointCloudSettings & pointCloudSettings) {
+				unique_lock<std::mutex> lock(this->stateMutex);
+				this->pointCloudSettings = pointCloudSettings;
+			}
+
+			//----------
+			bool FrameDecoder::update() {
+				auto isFrameNew = this->frames.update();
+				if (this->running) {
+					Pool::X().schedule(this);
+				}
+				return isFrameNew;
+			}
+
+			//----------
+			const FrameDecoder::DecodedFrame & FrameDecoder::getFrame() const {
+				return this->frames.getFront();
+			}
+
+			//----------
+			FrameDecoder::Statistics FrameDecoder::getStatistics() const {
+				unique_lock<std::mutex> lock(this->stateMutex);
+				return this->statistics;
+			}
+
+			//----------
+			void FrameDecoder::receive() {
+				auto & decodedFrame = this->frames.getBack();
+
+				auto startTime = chrono::high_resolution_clock::now();
+				bool received = false;
+				try {
+					//the frame's pixels keep their allocation when the dimensions are unchanged
+					received = this->receiveFunction(decodedFrame.frame);
+				}
+				RULR_CATCH_ALL_TO_ERROR;
+
+				if (!received) {
+					return;
+				}
+
+				PointCloudSettings pointCloudSettings;
+				{
+					unique_lock<std::mutex> lock(this->stateMutex);
+					pointCloudSettings = this->pointCloudSettings;
+				}
+				buildPointCloud(decodedFrame, pointCloudSettings);
+				decodedFrame.frameIndex = this->frameIndex++;
+
+				auto endTime = chrono::high_resolution_clock::now();
+				auto frameInterval = chrono::duration<float>(endTime - this->lastFrameTime).count();
+				this->lastFrameTime = endTime;
+
+				auto wasPickedUp = this->frames.publish();
+
+				{
+					unique_lock<std::mutex> lock(this->stateMutex);
+					this->statistics.framesDecoded++;
+					if (!wasPickedUp) {
+						this->statistics.framesSkipped++;
+					}
+					this->statistics.decodeDuration = chrono::duration<float, milli>(endTime - startTime).count();
+					if (frameInterval > 0.0f) {
+						this->statistics.incomingFramerate = 1.0f / frameInterval;
+					}
+				}
+			}
+
+			//----------
+			void FrameDecoder::buildPointCloud(DecodedFrame & decodedFrame, const PointCloudSettings & pointCloudSettings) {
+				const auto & depthPixels = decodedFrame.frame.getDepth();
+				const auto & depthToWorldLUT = pointCloudSettings.depthToWorldLUT;
+
+				if (!depthToWorldLUT || !depthPixels.isAllocated()
+					|| depthToWorldLUT->getWidth() != depthPixels.getWidth()
+					|| depthToWorldLUT->getHeight() != depthPixels.getHeight()) {
+					decodedFrame.pointCloudVertices.clear();
+					decodedFrame.pointCloudColors.clear();
+					return;
+				}
+
+				const auto & infraredPixels = decodedFrame.frame.getInfrared();
+				auto useIR = pointCloudSettings.applyIR
+					&& infraredPixels.isAllocated()
+					&& infraredPixels.size() == depthPixels.size();
+
+				auto size = depthPixels.size();
+				auto depth = depthPixels.getData();
+				auto depthToXY = depthToWorldLUT->getData();
+
+				//resize keeps the capacity from previous frames
+				decodedFrame.pointCloudVertices.resize(size);
+				auto vertex = decodedFrame.pointCloudVertices.data();
+				for (size_t i = 0; i < size; i++) {
+					auto z = (float)depth[i] / 1000.0f;
+					vertex[i].set(z * depthToXY[i * 2 + 0]
+						, z * depthToXY[i * 2 + 1]
+						, z);
+				}
+
+				if (useIR) {
+					decodedFrame.pointCloudColors.resize(size);
+					auto color = decodedFrame.pointCloudColors.data();
+					auto IR = infraredPixels.getData();
+					auto colorScale = pointCloudSettings.IRAmplitude / (float)0xffff;
+					for (size_t i = 0; i < size; i++) {
+						color[i] = ofFloatColor((float)IR[i] * colorScale);
+					}
+				}
+				else {
+					decodedFrame.pointCloudColors.clear();
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
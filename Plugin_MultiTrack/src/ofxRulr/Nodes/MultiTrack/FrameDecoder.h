@@ -0,0 +1,108 @@
+#pragma once
+
+#include "ofxRulr/Utils/TripleBuffer.h"
+
+#include "ofxMultiTrack.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace MultiTrack {
+			/// <summary>
+			/// Receives and decodes the frames of one MultiTrack stream on a worker pool shared by all streams.
+			///
+			/// Each call to update() schedules one receive on the pool (workers sleep on a condition variable until
+			/// then, so idle streams cost nothing). Each frame is decoded into one of three recycled frames and handed
+			/// to the main thread through a triple buffer, so the main thread only uploads textures. The CPU point
+			/// cloud is also built on the worker.
+			/// </summary>
+			class FrameDecoder {
+			public:
+				/// Called on the worker thread. Should return true if a new frame was written into the argument.
+				typedef function<bool(ofxMultiTrack::Frame &)> ReceiveFunction;
+
+				struct PointCloudSettings {
+					shared_ptr<const ofFloatPixels> depthToWorldLUT; // points are only built when this is set
+					bool applyIR = false;
+					float IRAmplitude = 256.0f;
+				};
+
+				struct DecodedFrame {
+					ofxMultiTrack::Frame frame;
+					vector<ofVec3f> pointCloudVertices;
+					vector<ofFloatColor> pointCloudColors;
+					size_t frameIndex = 0;
+				};
+
+				struct Statistics {
+					size_t framesDecoded = 0;
+					size_t framesSkipped = 0; // decoded but replaced before the main thread picked them up
+					float decodeDuration = 0.0f; // [ms] of the last frame
+					float incomingFramerate = 0.0f;
+				};
+
+				FrameDecoder();
+				~FrameDecoder();
+
+				void start(const ReceiveFunction &);
+				void stop();
+				bool isRunning() const;
+
+				void setPointCloudSettings(const PointCloudSettings &);
+
+				/// Main thread only. Returns true if a new frame is available in getFrame(). Also schedules the next receive.
+				bool update();
+
+				/// Main thread only. Valid until the next call to update()
+				const DecodedFrame & getFrame() const;
+
+				Statistics getStatistics() const;
+			protected:
+				class Pool {
+				public:
+					static Pool & X();
+					~Pool();
+
+					void schedule(FrameDecoder *);
+					void cancel(FrameDecoder *);
+				protected:
+					Pool();
+					void threadFunction();
+
+					std::mutex mutex;
+					std::condition_variable queueCondition;
+					std::condition_variable idleCondition;
+					std::deque<FrameDecoder *> queue;
+					bool closing = false;
+					vector<std::thread> threads;
+				};
+
+				void receive();
+				static void buildPointCloud(DecodedFrame &, const PointCloudSettings &);
+
+				Utils::TripleBuffer<DecodedFrame> frames;
+
+				// Only changed whilst stopped
+				ReceiveFunction receiveFunction;
+				bool running = false;
+
+				// Guarded by the pool's mutex. True whilst queued or being received on a pool thread
+				bool scheduled = false;
+
+				// Only used on the pool (one receive at a time)
+				size_t frameIndex = 0;
+				chrono::high_resolution_clock::time_point lastFrameTime;
+
+				// Guarded by stateMutex
+				PointCloudSettings pointCloudSettings;
+				Statistics statistics;
+
+				mutable std::mutex stateMutex;
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,504 @@
+#include "pch_MultiTrack.h"
+#include "Fusion.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace MultiTrack {
+			//----------
+			Fusion::Fusion() {
+				this->snapshot = make_shared<CombinedBodySet>();
+				this->thread = std::thread([this]() {
+					this->threadFunction();
+				});
+			}
+
+			//----------
+			Fusion::~Fusion() {
+				{
+					unique_lock<std::mutex> lock(this->stateMutex);
+					this->closing = true;
+				}
+				this->condition.notify_all();
+				this->thread.join();
+			}
+
+			//----------
+			void Fusion::pushInput(Input && input, const Settings & settings) {
+				{
+					unique_lock<std::mutex> lock(this->stateMutex);
+					if (this->hasNewInput) {
+						this->statistics.framesDropped++;
+					}
+					this->input = move(input);
+					this->settings = settings;
+					this->hasNewInput = true;
+				}
+				this->condition.notify_one();
+			}
+
+			//----------
+			shared_ptr<const CombinedBodySet> Fusion::getSnapshot() const {
+				unique_lock<std::mutex> lock(this->stateMutex);
+				return this->snapshot;
+			}
+
+			//----------
+			Fusion::Statistics Fusion::getStatistics() const {
+				unique_lock<std::mutex> lock(this->stateMutex);
+				return this->statistics;
+			}
+
+			//----------
+			void Fusion::threadFunction() {
+				Input input;
+				Settings settings;
+
+				while (true) {
+					{
+						unique_lock<std::mutex> lock(this->stateMutex);
+						this->condition.wait(lock, [this]() {
+							return this->hasNewInput || this->closing;
+						});
+						if (this->closing) {
+							break;
+						}
+						swap(input, this->input);
+						settings = this->settings;
+						this->hasNewInput = false;
+					}
+
+					try {
+						this->fuse(input, settings);
+					}
+					RULR_CATCH_ALL_TO_ERROR;
+				}
+			}
+
+			//----------
+			void Fusion::fuse(const Input & input, const Settings & settings) {
+				auto startTime = chrono::high_resolution_clock::now();
+				size_t comparisons = 0;
+
+				const auto & mergeDistanceThreshold = settings.mergeDistanceThreshold;
+				this->cellSize = max(mergeDistanceThreshold, 0.01f);
+
+				//--
+				//Gather the tracked bodies in world space
+				//--
+				//
+				this->sources.clear();
+				for (const auto & sensorFrame : input) {
+					for (const auto & body : sensorFrame.second.bodies) {
+						if (body.tracked) {
+							Source source;
+							source.subscriberID = sensorFrame.first;
+							source.body = body * sensorFrame.second.transform;
+							this->sources.push_back(move(source));
+						}
+					}
+				}
+				//
+				//--
+
+
+
+				//--
+				//Continue bodies seen previously
+				//--
+				//
+				for (auto & track : this->tracks) {
+					track.second.combinedBody.originalBodiesWorldSpace.clear();
+					for (auto & jointMean : track.second.jointMeans) {
+						jointMean = JointMean();
+					}
+					track.second.seen = false;
+				}
+
+				for (auto & source : this->sources) {
+					auto findTrack = this->trackBySource.find(SourceKey(source.subscriberID, (uint64_t) source.body.bodyId));
+					if (findTrack != this->trackBySource.end()) {
+						auto & track = this->tracks[findTrack->second];
+						this->assign(track, source, settings);
+						source.assigned = true;
+					}
+				}
+
+				//combined bodies which lost all their source bodies are removed
+				for (auto it = this->tracks.begin(); it != this->tracks.end(); ) {
+					if (it->second.seen) {
+						it++;
+					}
+					else {
+						it = this->tracks.erase(it);
+					}
+				}
+				//
+				//--
+
+
+
+				//--
+				//Match remaining bodies to nearby combined bodies, minimising the total cost
+				//--
+				//
+				this->cells.clear();
+				for (const auto & track : this->tracks) {
+					this->addToCells(track.first, track.second);
+				}
+
+				this->candidates.clear();
+				for (size_t sourceIndex = 0; sourceIndex < this->sources.size(); sourceIndex++) {
+					const auto & source = this->sources[sourceIndex];
+					if (source.assigned) {
+						continue;
+					}
+
+					this->findNearbyTracks(source.body, settings, this->nearbyTracks);
+					for (const auto & bodyIndex : this->nearbyTracks) {
+						const auto & track = this->tracks[bodyIndex];
+
+						//each sensor can only contribute one body to a combined body
+						if (track.combinedBody.originalBodiesWorldSpace.find(source.subscriberID) != track.combinedBody.originalBodiesWorldSpace.end()) {
+							continue;
+						}
+
+						auto distance = getDistance(source.body, track);
+						comparisons++;
+						if (distance < mergeDistanceThreshold) {
+							this->candidates.push_back({ distance, sourceIndex, bodyIndex });
+						}
+					}
+				}
+
+				//A combined body takes at most one body from each sensor, so the bodies of each sensor can be
+				//assigned independently : one optimal (Hungarian) assignment per sensor.
+				sort(this->candidates.begin(), this->candidates.end(), [this](const Candidate & a, const Candidate & b) {
+					const auto & subscriberA = this->sources[a.sourceIndex].subscriberID;
+					const auto & subscriberB = this->sources[b.sourceIndex].subscriberID;
+					if (subscriberA != subscriberB) {
+						return subscriberA < subscriberB;
+					}
+					return a.sourceIndex < b.sourceIndex;
+				});
+
+				for (auto groupBegin = this->candidates.begin(); groupBegin != this->candidates.end(); ) {
+					const auto & subscriberID = this->sources[groupBegin->sourceIndex].subscriberID;
+					auto groupEnd = find_if(groupBegin, this->candidates.end(), [this, &subscriberID](const Candidate & candidate) {
+						return this->sources[candidate.sourceIndex].subscriberID != subscriberID;
+					});
+
+					//rows are this sensor's bodies, columns are the combined bodies near to them
+					this->rowSources.clear();
+					this->columnTracks.clear();
+					for (auto it = groupBegin; it != groupEnd; it++) {
+						if (this->rowSources.empty() || this->rowSources.back() != it->sourceIndex) {
+							this->rowSources.push_back(it->sourceIndex);
+						}
+						this->columnTracks.push_back(it->bodyIndex);
+					}
+					sort(this->columnTracks.begin(), this->columnTracks.end());
+					this->columnTracks.erase(unique(this->columnTracks.begin(), this->columnTracks.end()), this->columnTracks.end());
+
+					//one extra column per row means 'not matched' at the cost of the threshold, so pairs over the
+					//threshold (given a higher cost) are never chosen
+					auto rowCount = this->rowSources.size();
+					auto columnCount = this->columnTracks.size() + rowCount;
+					this->assignmentCosts.assign(rowCount * columnCount, mergeDistanceThreshold * 2.0f + 1.0f);
+					for (size_t row = 0; row < rowCount; row++) {
+						for (size_t column = this->columnTracks.size(); column < columnCount; column++) {
+							this->assignmentCosts[row * columnCount + column] = mergeDistanceThreshold;
+						}
+					}
+					{
+						size_t row = 0;
+						for (auto it = groupBegin; it != groupEnd; it++) {
+							while (this->rowSources[row] != it->sourceIndex) {
+								row++;
+							}
+							auto column = lower_bound(this->columnTracks.begin(), this->columnTracks.end(), it->bodyIndex) - this->columnTracks.begin();
+							this->assignmentCosts[row * columnCount + column] = it->cost;
+						}
+					}
+
+					solveAssignment(this->assignmentCosts, rowCount, columnCount, this->assignment);
+
+					for (size_t row = 0; row < rowCount; row++) {
+						auto column = (size_t) this->assignment[row];
+						if (column >= this->columnTracks.size()) {
+							continue;
+						}
+						auto & source = this->sources[this->rowSources[row]];
+						this->assign(this->tracks[this->columnTracks[column]], source, settings);
+						source.assigned = true;
+					}
+
+					groupBegin = groupEnd;
+				}
+				//
+				//--
+
+
+
+				//--
+				//Remaining bodies join a new combined body (possibly started by another remaining body) or start one
+				//--
+				//
+				for (auto & source : this->sources) {
+					if (source.assigned) {
+						continue;
+					}
+
+					Track * bestTrack = nullptr;
+					{
+						auto bestDistance = mergeDistanceThreshold;
+						this->findNearbyTracks(source.body, settings, this->nearbyTracks);
+						for (const auto & bodyIndex : this->nearbyTracks) {
+							auto & track = this->tracks[bodyIndex];
+							if (track.combinedBody.originalBodiesWorldSpace.find(source.subscriberID) != track.combinedBody.originalBodiesWorldSpace.end()) {
+								continue;
+							}
+
+							auto distance = getDistance(source.body, track);
+							comparisons++;
+							if (distance < bestDistance) {
+								bestDistance = distance;
+								bestTrack = &track;
+							}
+						}
+					}
+
+					if (bestTrack) {
+						this->assign(*bestTrack, source, settings);
+					}
+					else {
+						auto bodyIndex = this->nextBodyIndex++;
+						auto & track = this->tracks[bodyIndex];
+						this->assign(track, source, settings);
+						this->addToCells(bodyIndex, track);
+					}
+					source.assigned = true;
+				}
+				//
+				//--
+
+
+
+				//--
+				//Calculate the merged bodies, remove inactive bodies and publish
+				//--
+				//
+				auto newSnapshot = make_shared<CombinedBodySet>();
+				this->trackBySource.clear();
+				for (auto it = this->tracks.begin(); it != this->tracks.end(); ) {
+					auto & combinedBody = it->second.combinedBody;
+					combinedBody.combinedBody = mean(combinedBody.originalBodiesWorldSpace, settings.mergeSettings);
+
+					if (!combinedBody.combinedBody.tracked) {
+						it = this->tracks.erase(it);
+						continue;
+					}
+
+					for (const auto & originalBody : combinedBody.originalBodiesWorldSpace) {
+						this->trackBySource[SourceKey(originalBody.first, (uint64_t) originalBody.second.bodyId)] = it->first;
+					}
+					newSnapshot->emplace(it->first, combinedBody);
+					it++;
+				}
+
+				auto duration = chrono::duration_cast<chrono::microseconds>(chrono::high_resolution_clock::now() - startTime);
+
+				{
+					unique_lock<std::mutex> lock(this->stateMutex);
+					this->snapshot = newSnapshot;
+					this->statistics.framesProcessed++;
+					this->statistics.bodyCount = this->sources.size();
+					this->statistics.combinedBodyCount = newSnapshot->size();
+					this->statistics.comparisons = comparisons;
+					this->statistics.duration = (float) duration.count() / 1000.0f;
+				}
+				//
+				//--
+			}
+
+			//----------
+			void Fusion::assign(Track & track, const Source & source, const Settings & settings) {
+				track.combinedBody.originalBodiesWorldSpace[source.subscriberID] = source.body;
+				track.seen = true;
+
+				for (const auto & joint : source.body.joints) {
+					if (joint.first < 0 || joint.first >= JointType_Count) {
+						continue;
+					}
+					if (joint.second.getTrackingState() == TrackingState::TrackingState_Tracked) {
+						auto weight = getWeight(joint.second.getPositionInDepthMap(), settings.mergeSettings);
+						auto & jointMean = track.jointMeans[joint.first];
+						jointMean.positionSum += joint.second.getPosition() * weight;
+						jointMean.weight += weight;
+					}
+				}
+			}
+
+			//----------
+			float Fusion::getDistance(const ofxKinectForWindows2::Data::Body & body, const Track & track) {
+				//same measure as meanDistance(.., .., true) against the mean of the combined body
+				float distance = 0.0f;
+				float countFound = 0;
+				for (const auto & joint : body.joints) {
+					if (joint.first < 0 || joint.first >= JointType_Count) {
+						continue;
+					}
+					const auto & jointMean = track.jointMeans[joint.first];
+					if (jointMean.weight > 0.0f && joint.second.getTrackingState() == TrackingState::TrackingState_Tracked) {
+						auto meanPosition = jointMean.positionSum / jointMean.weight;
+						distance += (joint.second.getPosition() * ofVec3f(1, 0, 1)).distanceSquared(meanPosition * ofVec3f(1, 0, 1));
+						countFound++;
+					}
+				}
+
+				if (countFound == 0) {
+					return numeric_limits<float>::max();
+				}
+				return sqrt(distance / countFound);
+			}
+
+			//----------
+			const vector<JointType> & Fusion::getAnchorJointTypes() {
+				static const vector<JointType> anchorJointTypes{ JointType::JointType_SpineBase, JointType::JointType_Head };
+				return anchorJointTypes;
+			}
+
+			//----------
+			float Fusion::getSearchRadius(const ofxKinectForWindows2::Data::Body & body, float mergeDistanceThreshold) {
+				//getDistance is the RMS over the K joints which both bodies track, so a match under the threshold can
+				//have any one of those joints (e.g. the anchor) up to threshold * sqrt(K) away. K is at most the number
+				//of joints this body tracks.
+				size_t trackedJointCount = 0;
+				for (const auto & joint : body.joints) {
+					if (joint.first >= 0 && joint.first < JointType_Count
+						&& joint.second.getTrackingState() == TrackingState::TrackingState_Tracked) {
+						trackedJointCount++;
+					}
+				}
+				return mergeDistanceThreshold * sqrt((float) max(trackedJointCount, (size_t) 1));
+			}
+
+			//----------
+			int64_t Fusion::getCellKey(JointType jointType, int64_t x, int64_t z) {
+				return (int64_t) ((((uint64_t) x << 32) ^ ((uint64_t) z & 0xFFFFFFFF)) * JointType_Count + (uint64_t) jointType);
+			}
+
+			//----------
+			void Fusion::addToCells(BodyIndex bodyIndex, const Track & track) {
+				//the track is indexed by each anchor joint it has, so that bodies are compared anchor joint to the same
+				//anchor joint
+				for (const auto & jointType : getAnchorJointTypes()) {
+					const auto & jointMean = track.jointMeans[jointType];
+					if (jointMean.weight > 0.0f) {
+						auto position = jointMean.positionSum / jointMean.weight;
+						auto key = getCellKey(jointType
+							, (int64_t) floor(position.x / this->cellSize)
+							, (int64_t) floor(position.z / this->cellSize));
+						this->cells[key].push_back(bodyIndex);
+					}
+				}
+			}
+
+			//----------
+			void Fusion::findNearbyTracks(const ofxKinectForWindows2::Data::Body & body, const Settings & settings, vector<BodyIndex> & bodyIndices) const {
+				bodyIndices.clear();
+
+				auto searchRadius = getSearchRadius(body, settings.mergeDistanceThreshold);
+				auto cellRange = (int64_t) ceil(searchRadius / this->cellSize);
+
+				for (const auto & jointType : getAnchorJointTypes()) {
+					auto findJoint = body.joints.find(jointType);
+					if (findJoint == body.joints.end() || findJoint->second.getTrackingState() != TrackingState::TrackingState_Tracked) {
+						continue;
+					}
+					auto anchor = findJoint->second.getPosition();
+					auto cellX = (int64_t) floor(anchor.x / this->cellSize);
+					auto cellZ = (int64_t) floor(anchor.z / this->cellSize);
+
+					for (auto x = cellX - cellRange; x <= cellX + cellRange; x++) {
+						for (auto z = cellZ - cellRange; z <= cellZ + cellRange; z++) {
+							auto findCell = this->cells.find(getCellKey(jointType, x, z));
+							if (findCell == this->cells.end()) {
+								continue;
+							}
+							for (const auto & bodyIndex : findCell->second) {
+								//check the same anchor joint of the track is within the search radius
+								const auto & jointMean = this->tracks.at(bodyIndex).jointMeans[jointType];
+								auto trackAnchor = jointMean.positionSum / jointMean.weight;
+								if ((anchor * ofVec3f(1, 0, 1)).distance(trackAnchor * ofVec3f(1, 0, 1)) <= searchRadius) {
+									bodyIndices.push_back(bodyIndex);
+								}
+							}
+						}
+					}
+				}
+
+				//a track can be found through more than one anchor joint
+				sort(bodyIndices.begin(), bodyIndices.end());
+				bodyIndices.erase(unique(bodyIndices.begin(), bodyIndices.end()), bodyIndices.end());
+			}
+
+			//----------
+			void Fusion::solveAssignment(const vector<float> & costs, size_t rowCount, size_t columnCount, vector<int> & rowToColumn) {
+				//Hungarian algorithm (Kuhn-Munkres with potentials), O(rows^2 * columns). Needs rowCount <= columnCount.
+				//Indices below are 1-based, with column 0 as the starting point of each augmenting path.
+				const auto infinity = numeric_limits<float>::max();
+				vector<float> u(rowCount + 1, 0.0f), v(columnCount + 1, 0.0f);
+				vector<size_t> p(columnCount + 1, 0), way(columnCount + 1, 0);
+
+				for (size_t i = 1; i <= rowCount; i++) {
+					p[0] = i;
+					size_t j0 = 0;
+					vector<float> minv(columnCount + 1, infinity);
+					vector<bool> used(columnCount + 1, false);
+					do {
+						used[j0] = true;
+						auto i0 = p[j0];
+						auto delta = infinity;
+						size_t j1 = 0;
+						for (size_t j = 1; j <= columnCount; j++) {
+							if (!used[j]) {
+								auto current = costs[(i0 - 1) * columnCount + (j - 1)] - u[i0] - v[j];
+								if (current < minv[j]) {
+									minv[j] = current;
+									way[j] = j0;
+								}
+								if (minv[j] < delta) {
+									delta = minv[j];
+									j1 = j;
+								}
+							}
+						}
+						for (size_t j = 0; j <= columnCount; j++) {
+							if (used[j]) {
+								u[p[j]] += delta;
+								v[j] -= delta;
+							}
+							else {
+								minv[j] -= delta;
+							}
+						}
+						j0 = j1;
+					} while (p[j0] != 0);
+
+					do {
+						auto j1 = way[j0];
+						p[j0] = p[j1];
+						j0 = j1;
+					} while (j0 != 0);
+				}
+
+				rowToColumn.assign(rowCount, -1);
+				for (size_t j = 1; j <= columnCount; j++) {
+					if (p[j] != 0) {
+						rowToColumn[p[j] - 1] = (int) j - 1;
+					}
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Utils.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace MultiTrack {
+			/// <summary>
+			/// Combines the bodies seen by all the subscribers into one set of bodies, on a worker thread.
+			///
+			/// Combined bodies are kept in a table between frames, and a body from a sensor stays with the combined body
+			/// it joined for as long as that sensor keeps tracking it. Other bodies are compared against the combined
+			/// bodies near to them, using the running mean of each combined body's joints. Nearby combined bodies are
+			/// found with a spatial hash of the spine base / head joints (compared joint to the same joint), searching
+			/// the radius within which a match under the merge distance threshold must lie. The pairs under the
+			/// threshold are then assigned with an optimal (Hungarian) assignment for each sensor, and bodies which
+			/// match nothing start a new combined body.
+			/// </summary>
+			class Fusion {
+			public:
+				struct Settings {
+					float mergeDistanceThreshold = 0.3f;
+					MergeSettings mergeSettings{ true, 50.0f };
+				};
+
+				struct SensorFrame {
+					vector<ofxKinectForWindows2::Data::Body> bodies; // camera space
+					glm::mat4 transform; // camera to world
+				};
+				typedef map<SubscriberID, SensorFrame> Input;
+
+				struct Statistics {
+					size_t framesProcessed = 0;
+					size_t framesDropped = 0; // replaced by a newer input before being processed
+					size_t bodyCount = 0; // tracked source bodies in the last frame
+					size_t combinedBodyCount = 0;
+					size_t comparisons = 0; // body to combined body distance checks in the last frame
+					float duration = 0.0f; // [ms] to process the last frame
+				};
+
+				Fusion();
+				~Fusion();
+
+				/// Replaces any input which hasn't been processed yet
+				void pushInput(Input &&, const Settings &);
+
+				/// The latest combined bodies (never null)
+				shared_ptr<const CombinedBodySet> getSnapshot() const;
+
+				Statistics getStatistics() const;
+			protected:
+				struct JointMean {
+					ofVec3f positionSum;
+					float weight = 0.0f;
+				};
+
+				struct Track {
+					CombinedBody combinedBody;
+
+					// Running means of the tracked joints of the bodies assigned this frame
+					array<JointMean, JointType_Count> jointMeans;
+
+					bool seen = false;
+				};
+
+				struct Source {
+					SubscriberID subscriberID;
+					ofxKinectForWindows2::Data::Body body;
+					bool assigned = false;
+				};
+
+				struct Candidate {
+					float cost;
+					size_t sourceIndex;
+					BodyIndex bodyIndex;
+				};
+
+				typedef pair<SubscriberID, uint64_t> SourceKey;
+				struct SourceKeyHash {
+					size_t operator()(const SourceKey & key) const {
+						return std::hash<uint64_t>()((uint64_t)key.first * 0x9E3779B97F4A7C15ull ^ key.second);
+					}
+				};
+
+				void threadFunction();
+				void fuse(const Input &, const Settings &);
+
+				void assign(Track &, const Source &, const Settings &);
+				static float getDistance(const ofxKinectForWindows2::Data::Body &, const Track &);
+				static const vector<JointType> & getAnchorJointTypes();
+				static float getSearchRadius(const ofxKinectForWindows2::Data::Body &, float mergeDistanceThreshold);
+
+				static int64_t getCellKey(JointType, int64_t x, int64_t z);
+				void addToCells(BodyIndex, const Track &);
+				void findNearbyTracks(const ofxKinectForWindows2::Data::Body &, const Settings &, vector<BodyIndex> & bodyIndices) const;
+
+				// Minimum cost assignment of rows to distinct columns (costs is row major). Needs rowCount <= columnCount.
+				static void solveAssignment(const vector<float> & costs, size_t rowCount, size_t columnCount, vector<int> & rowToColumn);
+
+				// Worker thread only
+				unordered_map<BodyIndex, Track> tracks;
+				unordered_map<SourceKey, BodyIndex, SourceKeyHash> trackBySource;
+				unordered_map<int64_t, vector<BodyIndex>> cells;
+				float cellSize = 0.3f;
+				BodyIndex nextBodyIndex = 0;
+
+				// Reused between frames
+				vector<Source> sources;
+				vector<Candidate> candidates;
+				vector<BodyIndex> nearbyTracks;
+				vector<size_t> rowSources;
+				vector<BodyIndex> columnTracks;
+				vector<float> assignmentCosts;
+				vector<int> assignment;
+
+				// Guarded by stateMutex
+				Input input;
+				Settings settings;
+				bool hasNewInput = false;
+				bool closing = false;
+				shared_ptr<const CombinedBodySet> snapshot;
+				Statistics statistics;
+
+				mutable std::mutex stateMutex;
+				condition_variable condition;
+				std::thread thread;
+			};
+		}
+	}
+}
\ No newline at end of file
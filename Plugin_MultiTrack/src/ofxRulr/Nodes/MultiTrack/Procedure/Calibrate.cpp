@@ -431,24 +431,23 @@ namespace ofxRulr {
 						auto weak_subscriber = it.second;
 						if (!weak_subscriber.expired()) {
 							auto subscriberNode = weak_subscriber.lock();
-							auto subscriber = subscriberNode->getSubscriber();
-							if (subscriber) {
+							if (subscriberNode->isConnected()) {
 								//Make sure all the data is ready before proceeding.
-								auto width = subscriber->getFrame().getDepth().getWidth();
+								auto width = subscriberNode->getFrame().getDepth().getWidth();
 								if (width == 0) continue;
 								 
-								auto height = subscriber->getFrame().getDepth().getHeight();
+								auto height = subscriberNode->getFrame().getDepth().getHeight();
 								if (height == 0) continue;
 
-								auto depth = subscriber->getFrame().getDepth().getData();
+								auto depth = subscriberNode->getFrame().getDepth().getData();
 								if (depth == nullptr) continue;
 
 								auto lut = subscriberNode->getDepthToWorldLUT().getData();
 								if (lut == nullptr)  continue;
 
-								//if (subscriber->isFrameNew()) {
+								//if (subscriberNode->isFrameNew()) {
 									//Find the Markers in the frame.
-									vector<Marker> markers = findMarkersInFrame(subscriber->getFrame());
+									vector<Marker> markers = findMarkersInFrame(subscriberNode->getFrame());
 
 									for (auto & marker : markers) {
 										this->mapMarkerToWorld(marker, width, height, depth, lut);
@@ -21,7 +21,7 @@ namespace ofxRulr {
 
 			//----------
 			void Receiver::init() {
-				RULR_NODE_DRAW_WORLD_LISTENER;
+				RULR_NODE_DRAW_WORLD_LISTENER;
 				RULR_NODE_UPDATE_LISTENER;
 				RULR_NODE_INSPECTOR_LISTENER;
 				RULR_NODE_SERIALIZATION_LISTENERS;
@@ -86,12 +86,18 @@ namespace ofxRulr {
 				}
 
 				if (this->receiver) {
-					if (this->receiver->getReceiver().getPort() != this->parameters.connection.receivingPort) {
+					if (this->receivingPort != this->parameters.connection.receivingPort) {
 						// Port value changed, reinitialize.
-						this->receiver->init(this->parameters.connection.receivingPort);
+						this->openReceiver();
 					}
 
-					this->receiver->update();
+					this->frameNew = this->frameDecoder.update();
+					if (this->frameNew && this->parameters.previews.enabled) {
+						const auto & colorPixels = this->getFrame().getColor();
+						if (colorPixels.isAllocated()) {
+							this->colorPreview.loadData(colorPixels);
+						}
+					}
 				}
 			}
 
@@ -106,7 +112,7 @@ namespace ofxRulr {
 				//this->setTransform()  // Use getTransform for the initial values in ofxNonLinearFit
 				//ofxCv::estimateAffine3D()
 
-				auto & frame = this->receiver->getFrame();
+				auto & frame = this->getFrame();
 				const auto & bodies = frame.getBodies();
 				for (const auto & body : bodies) {
 					body.drawWorld();
@@ -120,36 +126,19 @@ namespace ofxRulr {
 				if (this->receiver) {
 					inspector->addTitle("Status", Widgets::Title::Level::H2);
 					inspector->addLiveValueHistory("Framerate", [this]() {
-						if (this->receiver) {
-							return this->receiver->getReceiver().getIncomingFramerate();
-						}
-						else {
-							return 0.0f;
-						}
+						return this->frameDecoder.getStatistics().incomingFramerate;
 					});
 					inspector->addIndicator("New frame arrived", [this]() {
-						if (this->receiver) {
-							if (this->receiver->getReceiver().isFrameNew()) {
-								return Widgets::Indicator::Status::Good;
-							}
+						if (this->isFrameNew()) {
+							return Widgets::Indicator::Status::Good;
 						}
 						return Widgets::Indicator::Status::Clear;
 					});
 					inspector->addLiveValueHistory("Dropped frames", [this]() {
-						if (this->receiver) {
-							return (float)this->receiver->getReceiver().getDroppedFrames().size();
-						}
-						else {
-							return 0.0f;
-						}
+						return (float)this->droppedFrameCount;
 					});
-					inspector->addIndicator("New frame arrived", [this]() {
-						if (this->receiver) {
-							if (this->receiver->getReceiver().isFrameNew()) {
-								return Widgets::Indicator::Status::Good;
-							}
-						}
-						return Widgets::Indicator::Status::Clear;
+					inspector->addLiveValueHistory("Decode time [ms]", [this]() {
+						return this->frameDecoder.getStatistics().decodeDuration;
 					});
 				}
 
@@ -178,8 +167,33 @@ namespace ofxRulr {
 			}
 
 			//----------
-			shared_ptr<ofxMultiTrack::Receiver> Receiver::getReceiver() const {
-				return this->receiver;
+			bool Receiver::isFrameNew() const {
+				return this->frameNew;
+			}
+
+			//----------
+			const ofxMultiTrack::Frame & Receiver::getFrame() const {
+				return this->frameDecoder.getFrame().frame;
+			}
+
+			//----------
+			void Receiver::openReceiver() {
+				this->frameDecoder.stop();
+
+				this->receivingPort = this->parameters.connection.receivingPort;
+				this->receiver->init(this->receivingPort);
+
+				//from here the receiver is only used on the decoder thread
+				auto receiver = this->receiver;
+				this->frameDecoder.start([this, receiver](ofxMultiTrack::Frame & frame) {
+					receiver->update();
+					this->droppedFrameCount = receiver->getReceiver().getDroppedFrames().size();
+					if (!receiver->getReceiver().isFrameNew()) {
+						return false;
+					}
+					frame = receiver->getFrame();
+					return true;
+				});
 			}
 
 			//----------
@@ -189,7 +203,7 @@ namespace ofxRulr {
 				this->panel->clear();
 				if (this->receiver) {
 					if (this->parameters.previews.enabled) {
-						this->panel->add(ofxCvGui::Panels::makePixels(this->receiver->getFrame().getColor()));
+						this->panel->add(ofxCvGui::Panels::makeTexture(this->colorPreview));
 					}
 					else {
 						this->panel->clear();
@@ -4,6 +4,7 @@
 
 #include "ofxRulr/Nodes/Item/RigidBody.h"
 #include "ofxRulr/Utils/ControlSocket.h"
+#include "FrameDecoder.h"
 
 #include "ofxMultiTrack.h"
 
@@ -25,8 +26,12 @@ namespace ofxRulr {
 				void serialize(Json::Value &);
 				void deserialize(const Json::Value &);
 
-				shared_ptr<ofxMultiTrack::Receiver> getReceiver() const;
+				bool isFrameNew() const;
+
+				/// The latest decoded frame (valid until the next update)
+				const ofxMultiTrack::Frame & getFrame() const;
 			protected:
+				void openReceiver();
 				void rebuildGui();
 
 				void previewsChangeCallback(bool &);
@@ -51,7 +56,15 @@ namespace ofxRulr {
 					PARAM_DECLARE("Receiver", connection, previews);
 				} parameters;
 
+				//owned by the frame decoder's thread once opened
 				shared_ptr<ofxMultiTrack::Receiver> receiver;
+				int receivingPort = 0;
+				atomic<size_t> droppedFrameCount{ 0 };
+
+				FrameDecoder frameDecoder;
+				bool frameNew = false;
+				ofTexture colorPreview;
+
 				unique_ptr<Utils::ControlSocket> controlSocket;
 
 				ofFloatPixels depthToCameraRays;
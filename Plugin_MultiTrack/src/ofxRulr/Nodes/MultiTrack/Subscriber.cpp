@@ -13,7 +13,7 @@ namespace ofxRulr {
 
 			//----------
 			Subscriber::~Subscriber() {
-				
+				this->disconnect();
 			}
 
 			//----------
@@ -45,12 +45,7 @@ namespace ofxRulr {
 				}, this, +1);
 				this->uiPanel = ofxCvGui::Panels::makeWidgets();
 				this->uiPanel->addLiveValue<float>("Framerate", [this]() {
-					if (this->subscriber) {
-						return this->subscriber->getSubscriber().getIncomingFramerate();
-					}
-					else {
-						return 0.0f;
-					}
+					return this->getIncomingFramerate();
 				});
 				this->uiPanel->addToggle(this->parameters.draw.gpuPointCloud.style.applyIndexColor);
 				this->uiPanel->addIndicator("Depth to World loaded", [this]() {
@@ -67,20 +62,13 @@ namespace ofxRulr {
 					}
 				});
 				this->uiPanel->addIndicator("New frame arrived", [this]() {
-					if (this->subscriber) {
-						if (this->subscriber->getSubscriber().isFrameNew()) {
-							return Widgets::Indicator::Status::Good;
-						}
+					if (this->isFrameNew()) {
+						return Widgets::Indicator::Status::Good;
 					}
 					return Widgets::Indicator::Status::Clear;
 				});
 				this->uiPanel->addLiveValue<float>("Dropped frames", [this]() {
-					if (this->subscriber) {
-						return (float)this->subscriber->getSubscriber().getDroppedFrames().size();
-					}
-					else {
-						return 0.0f;
-					}
+					return (float)this->getDroppedFrameCount();
 				});
 				this->uiPanel->addListenersToParent(this->previewPanel);
 				this->previewPanel->onBoundsChange += [this](ofxCvGui::BoundsChangeArguments& args) {
@@ -112,35 +100,41 @@ namespace ofxRulr {
 			//----------
 			void Subscriber::update() {
 				//connect/disconnect
-				if (!this->subscriber && this->parameters.connection.connect) {
-					this->subscriber = make_shared<ofxMultiTrack::Subscriber>();
-					this->subscriber->init(this->parameters.connection.publisherAddress, this->parameters.connection.publisherPort);
+				if (!this->isConnected() && this->parameters.connection.connect) {
+					this->connect();
 				}
-				else if (this->subscriber && !this->parameters.connection.connect) {
-					this->subscriber.reset();
+				else if (this->isConnected() && !this->parameters.connection.connect) {
+					this->disconnect();
 				}
 
 				//change connection properties
-				if (this->subscriber) {
-					if (this->subscriber->getSubscriber().getAddress().compare(this->parameters.connection.publisherAddress) != 0 ||
-						this->subscriber->getSubscriber().getPort() != this->parameters.connection.publisherPort) {
-
-						this->subscriber->init(this->parameters.connection.publisherAddress, this->parameters.connection.publisherPort);
+				if (this->isConnected()) {
+					if (this->connectedAddress.compare(this->parameters.connection.publisherAddress) != 0 ||
+						this->connectedPort != this->parameters.connection.publisherPort) {
+						// Address or Port value changed, reinitialize.
+						this->connect();
 					}
 				}
 
-				if (this->subscriber) {
-					if (this->subscriber->getSubscriber().getAddress().compare(this->parameters.connection.publisherAddress) != 0 ||
-						this->subscriber->getSubscriber().getPort() != this->parameters.connection.publisherPort) {
-						// Address or Port value changed, reinitialize.
-						this->subscriber->init(this->parameters.connection.publisherAddress, this->parameters.connection.publisherPort);
+				this->frameNew = false;
+				if (this->isConnected()) {
+					//the points for the CPU point cloud are built on the decoder thread
+					{
+						FrameDecoder::PointCloudSettings pointCloudSettings;
+						if (this->parameters.draw.cpuPointCloud.enabled) {
+							pointCloudSettings.depthToWorldLUT = this->depthToWorldLUTShared;
+						}
+						pointCloudSettings.applyIR = this->parameters.draw.cpuPointCloud.applyIRTexture;
+						pointCloudSettings.IRAmplitude = this->parameters.draw.IRAmplitude;
+						this->frameDecoder.setPointCloudSettings(pointCloudSettings);
 					}
 
-					this->subscriber->update();
+					this->frameNew = this->frameDecoder.update();
 
-					if (this->subscriber->getSubscriber().isFrameNew()) {
-						const auto & depthPixels = this->subscriber->getFrame().getDepth();
-						const auto & irPixels = this->subscriber->getFrame().getInfrared();
+					if (this->frameNew) {
+						const auto & decodedFrame = this->frameDecoder.getFrame();
+						const auto & depthPixels = decodedFrame.frame.getDepth();
+						const auto & irPixels = decodedFrame.frame.getInfrared();
 
 						if (depthPixels.isAllocated()) {
 							this->depthTexture.loadData(depthPixels);
@@ -149,16 +143,40 @@ namespace ofxRulr {
 							this->irTexture.loadData(irPixels);
 						}
 
-						//Mesh update.
+						//Mesh update. Subscribers with the same resolution share one mesh
 						if (this->parameters.draw.gpuPointCloud.enabled) {
-							auto & meshDimensions = this->meshProvider.getDimensions();
-							if (meshDimensions.x != depthPixels.getWidth() || meshDimensions.y != depthPixels.getHeight()) {
-								this->meshProvider.setDimensions(ofVec2f(depthPixels.getWidth(), depthPixels.getHeight()));
+							auto dimensions = ofVec2f(depthPixels.getWidth(), depthPixels.getHeight());
+							const auto & downsampleExp = this->parameters.draw.gpuPointCloud.downsampleExp.get();
+							if (!this->meshProvider
+								|| this->meshProvider->getDimensions() != dimensions
+								|| this->meshProvider->getDownsampleExp() != downsampleExp) {
+								this->meshProvider = Utils::MeshProvider::getShared(dimensions, downsampleExp);
 							}
+						}
 
-							if (this->parameters.draw.gpuPointCloud.downsampleExp != this->meshProvider.getDownsampleExp()) {
-								this->meshProvider.setDownsampleExp(this->parameters.draw.gpuPointCloud.downsampleExp);
+						//CPU point cloud upload (reusing the buffer whilst the size is unchanged)
+						const auto & vertices = decodedFrame.pointCloudVertices;
+						const auto & colors = decodedFrame.pointCloudColors;
+						if (!vertices.empty()) {
+							auto hasColors = !colors.empty();
+							if (vertices.size() != this->pointCloudVboSize || hasColors != this->pointCloudVboHasColors) {
+								this->pointCloudVbo.clear();
+								this->pointCloudVbo.setVertexData(vertices.data(), vertices.size(), GL_DYNAMIC_DRAW);
+								if (hasColors) {
+									this->pointCloudVbo.setColorData(colors.data(), colors.size(), GL_DYNAMIC_DRAW);
+								}
+								this->pointCloudVboSize = vertices.size();
+								this->pointCloudVboHasColors = hasColors;
 							}
+							else {
+								this->pointCloudVbo.updateVertexData(vertices.data(), vertices.size());
+								if (hasColors) {
+									this->pointCloudVbo.updateColorData(colors.data(), colors.size());
+								}
+							}
+						}
+						else {
+							this->pointCloudVboSize = 0;
 						}
 					}
 				}
@@ -176,8 +194,8 @@ namespace ofxRulr {
 					{
 						ofSetColor(this->debugColor);
 
-						if (this->subscriber) {
-							const auto & bodies = this->subscriber->getFrame().getBodies();
+						if (this->isConnected()) {
+							const auto & bodies = this->getFrame().getBodies();
 							for (const auto & body : bodies) {
 								body.drawWorld(); // actually this is in kinect camera space
 							}
@@ -202,31 +220,25 @@ namespace ofxRulr {
 			void Subscriber::populateInspector(ofxCvGui::InspectArguments & args) {
 				auto inspector = args.inspector;
 
-				if (this->subscriber) {
+				if (this->isConnected()) {
 					inspector->addTitle("Status", Widgets::Title::Level::H2);
 					inspector->addLiveValueHistory("Framerate", [this]() {
-						if (this->subscriber) {
-							return this->subscriber->getSubscriber().getIncomingFramerate();
-						}
-						else {
-							return 0.0f;
-						}
+						return this->getIncomingFramerate();
 					});
 					inspector->addIndicator("New frame arrived", [this]() {
-						if (this->subscriber) {
-							if (this->subscriber->getSubscriber().isFrameNew()) {
-								return Widgets::Indicator::Status::Good;
-							}
+						if (this->isFrameNew()) {
+							return Widgets::Indicator::Status::Good;
 						}
 						return Widgets::Indicator::Status::Clear;
 					});
 					inspector->addLiveValueHistory("Dropped frames", [this]() {
-						if (this->subscriber) {
-							return (float)this->subscriber->getSubscriber().getDroppedFrames().size();
-						}
-						else {
-							return 0.0f;
-						}
+						return (float)this->getDroppedFrameCount();
+					});
+					inspector->addLiveValueHistory("Decode time [ms]", [this]() {
+						return this->frameDecoder.getStatistics().decodeDuration;
+					});
+					inspector->addLiveValue<size_t>("Decoded frames skipped", [this]() {
+						return this->frameDecoder.getStatistics().framesSkipped;
 					});
 				}
 
@@ -267,8 +279,33 @@ namespace ofxRulr {
 			}
 
 			//----------
-			shared_ptr<ofxMultiTrack::Subscriber> Subscriber::getSubscriber() const {
-				return this->subscriber;
+			bool Subscriber::isConnected() const {
+				return this->frameDecoder.isRunning();
+			}
+
+			//----------
+			bool Subscriber::isFrameNew() const {
+				return this->frameNew;
+			}
+
+			//----------
+			const ofxMultiTrack::Frame & Subscriber::getFrame() const {
+				return this->frameDecoder.getFrame().frame;
+			}
+
+			//----------
+			float Subscriber::getIncomingFramerate() const {
+				if (this->isConnected()) {
+					return this->frameDecoder.getStatistics().incomingFramerate;
+				}
+				else {
+					return 0.0f;
+				}
+			}
+
+			//----------
+			size_t Subscriber::getDroppedFrameCount() const {
+				return this->droppedFrameCount;
 			}
 
 			//----------
@@ -293,43 +330,18 @@ namespace ofxRulr {
 
 			//----------
 			void Subscriber::drawPointCloudCpu() {
-				if (this->depthToWorldLUT.isAllocated() && this->subscriber) {
-					const auto & frame = this->subscriber->getFrame();
-
-					vector<ofVec3f> vertices;
-					vector<ofFloatColor> colors;
-
-					auto depth = frame.getDepth().getData();
-
-					auto useIR = this->parameters.draw.cpuPointCloud.applyIRTexture.get() && frame.getInfrared().isAllocated();
-					auto IR = frame.getInfrared().getData();
-					auto depthToXY = this->depthToWorldLUT.getData();
-
-					auto colorAmplitude = this->parameters.draw.IRAmplitude;
-
-					for (int i = 0; i < frame.getDepth().size(); i++) {
-						vertices.emplace_back(ofVec3f{
-							(float)depth[i] * depthToXY[i * 2 + 0] / 1000.0f,
-							(float)depth[i] * depthToXY[i * 2 + 1] / 1000.0f,
-							(float)depth[i] / 1000.0f
-						});
-						if (useIR) {
-							colors.emplace_back(ofFloatColor{
-								(float)IR[i] / (float)0xffff * colorAmplitude
-							});
-						}
-					}
-					ofVbo vbo;
-					vbo.setVertexData(vertices.data(), vertices.size(), GL_STATIC_DRAW);
-					if (useIR) {
-						vbo.setColorData(colors.data(), colors.size(), GL_STATIC_DRAW);
-					}
-					vbo.draw(GL_POINTS, 0, vertices.size());
+				//the points are built on the decoder thread and uploaded in update()
+				if (this->isConnected() && this->pointCloudVboSize > 0) {
+					this->pointCloudVbo.draw(GL_POINTS, 0, this->pointCloudVboSize);
 				}
 			}
 
 			//----------
 			void Subscriber::drawPointCloudGpu(PointCloudStyle pointCloudStyle) {
+				if (!this->meshProvider) {
+					return;
+				}
+
 				auto & worldShader = this->getWorldShader();
 				worldShader.begin();
 				{
@@ -354,7 +366,7 @@ namespace ofxRulr {
 							worldShader.setUniform1f("uColorScale", 1.0f);
 						}
 
-						this->meshProvider.getMesh().draw(OF_MESH_FILL);
+						this->meshProvider->getMesh().draw(OF_MESH_FILL);
 					}
 					ofPopStyle();
 				}
@@ -394,6 +406,40 @@ namespace ofxRulr {
 				{
 					this->depthToWorldTexture.loadData(this->depthToWorldLUT);
 				}
+
+				//the decoder thread reads its own copy
+				this->depthToWorldLUTShared = make_shared<ofFloatPixels>(this->depthToWorldLUT);
+			}
+
+			//----------
+			void Subscriber::connect() {
+				this->disconnect();
+
+				this->connectedAddress = this->parameters.connection.publisherAddress;
+				this->connectedPort = this->parameters.connection.publisherPort;
+
+				this->subscriber = make_shared<ofxMultiTrack::Subscriber>();
+				this->subscriber->init(this->connectedAddress, this->connectedPort);
+
+				//from here until disconnect() the subscriber is only used on the decoder thread
+				auto subscriber = this->subscriber;
+				this->frameDecoder.start([this, subscriber](ofxMultiTrack::Frame & frame) {
+					subscriber->update();
+					this->droppedFrameCount = subscriber->getSubscriber().getDroppedFrames().size();
+					if (!subscriber->getSubscriber().isFrameNew()) {
+						return false;
+					}
+					frame = subscriber->getFrame();
+					return true;
+				});
+			}
+
+			//----------
+			void Subscriber::disconnect() {
+				this->frameDecoder.stop();
+				this->subscriber.reset();
+				this->droppedFrameCount = 0;
+				this->frameNew = false;
 			}
 
 			//----------
@@ -2,6 +2,7 @@
 
 #include "ofxRulr/Nodes/Item/RigidBody.h"
 #include "ofxRulr/Utils/MeshProvider.h"
+#include "FrameDecoder.h"
 
 #include "ofxMultiTrack.h"
 
@@ -24,7 +25,14 @@ namespace ofxRulr {
 				void serialize(Json::Value &);
 				void deserialize(const Json::Value &);
 
-				shared_ptr<ofxMultiTrack::Subscriber> getSubscriber() const;
+				bool isConnected() const;
+				bool isFrameNew() const;
+
+				/// The latest decoded frame (valid until the next update)
+				const ofxMultiTrack::Frame & getFrame() const;
+				float getIncomingFramerate() const;
+				size_t getDroppedFrameCount() const;
+
 				const ofFloatPixels & getDepthToWorldLUT() const;
 
 				const ofTexture & getDepthTexture() const;
@@ -87,16 +95,31 @@ namespace ofxRulr {
 					PARAM_DECLARE("Subscriber", connection, calibration, draw);
 				} parameters;
 
+				void connect();
+				void disconnect();
+
+				//owned by the frame decoder's thread whilst connected
 				shared_ptr<ofxMultiTrack::Subscriber> subscriber;
+				string connectedAddress;
+				int connectedPort = 0;
+				atomic<size_t> droppedFrameCount{ 0 };
+
+				FrameDecoder frameDecoder;
+				bool frameNew = false;
 
 				ofFloatPixels depthToWorldLUT;
+				shared_ptr<const ofFloatPixels> depthToWorldLUTShared;
 				ofTexture depthToWorldTexture;
 
 				ofTexture depthTexture;
 				ofTexture irTexture;
 
 				ofShader & getWorldShader();
-				Utils::MeshProvider meshProvider;
+				shared_ptr<Utils::MeshProvider> meshProvider;
+
+				ofVbo pointCloudVbo;
+				size_t pointCloudVboSize = 0;
+				bool pointCloudVboHasColors = false;
 
 				ofFloatColor debugColor;
 
@@ -66,11 +66,10 @@ namespace ofxRulr {
 
 					auto subscriberNode = this->getInput<Subscriber>();
 					if (subscriberNode) {
-						auto subscriber = subscriberNode->getSubscriber();
-						if (subscriber) {
-							if (subscriber->isFrameNew()) {
+						if (subscriberNode->isConnected()) {
+							if (subscriberNode->isFrameNew()) {
 								try {
-									auto & frame = subscriber->getFrame();
+									auto & frame = subscriberNode->getFrame();
 
 									const auto & infrared = frame.getInfrared();
 									this->infrared.loadData(infrared);
@@ -74,7 +74,7 @@ namespace ofxRulr {
 			void World::drawWorldStage() {
 				ofPushStyle();
 				{
-					for (const auto & combinedBody : this->combinedBodies) {
+					for (const auto & combinedBody : *this->combinedBodies) {
 						ofColor color(255, 100, 100);
 						color.setHueAngle((combinedBody.first * 60) % 360);
 
@@ -146,15 +146,25 @@ namespace ofxRulr {
 				args.inspector->addLiveValue<size_t>("Connected subscribers", [this]() {
 					return this->subscribers.size();
 				});
+				args.inspector->addLiveValue<string>("Fusion bodies (source / combined)", [this]() {
+					auto statistics = this->fusion.getStatistics();
+					return ofToString(statistics.bodyCount) + " / " + ofToString(statistics.combinedBodyCount);
+				});
+				args.inspector->addLiveValue<size_t>("Fusion comparisons", [this]() {
+					return this->fusion.getStatistics().comparisons;
+				});
+				args.inspector->addLiveValueHistory("Fusion duration [ms]", [this]() {
+					return this->fusion.getStatistics().duration;
+				});
+				args.inspector->addLiveValue<size_t>("Fusion frames dropped", [this]() {
+					return this->fusion.getStatistics().framesDropped;
+				});
 				for (auto subscriberIt : this->subscribers) {
 					auto subscriberWeak = subscriberIt.second;
 					args.inspector->addLiveValueHistory("Subscriber " + ofToString(subscriberIt.first), [subscriberWeak] {
 						auto subscriberNode = subscriberWeak.lock();
 						if (subscriberNode) {
-							auto subscriber = subscriberNode->getSubscriber();
-							if (subscriber) {
-								return subscriber->getSubscriber().getIncomingFramerate();
-							}
+							return subscriberNode->getIncomingFramerate();
 						}
 
 						return 0.0f;
@@ -170,165 +180,32 @@ namespace ofxRulr {
 
 			//----------
 			void World::performFusion() {
-				auto worldBodiesUnmerged = this->getWorldBodiesUnmerged();
-				this->combinedBodies = this->combineWorldBodies(worldBodiesUnmerged);
+				//Fusion is performed on the worker thread, we pick up the latest result here
+				Fusion::Settings settings;
+				{
+					settings.mergeDistanceThreshold = this->parameters.fusion.mergeDistanceThreshold.get();
+					settings.mergeSettings = this->getMergeSettings();
+				}
+				this->fusion.pushInput(this->getFusionInput(), settings);
+				this->combinedBodies = this->fusion.getSnapshot();
 			}
 
 			//----------
-			World::WorldBodiesUnmerged World::getWorldBodiesUnmerged() const {
-				//This function accumulates all the bodies from the whole network of sensors.
-				//And transforms them using the rigid body transforms from the Subscriber nodes
-				WorldBodiesUnmerged worldBodiesUnmerged;
+			Fusion::Input World::getFusionInput() const {
+				//This function accumulates all the bodies from the whole network of sensors,
+				//with the rigid body transforms from the Subscriber nodes
+				Fusion::Input input;
 
 				for (auto subscriberIt : this->subscribers) {
 					auto subscriberNode = subscriberIt.second.lock();
-					if (subscriberNode) {
-						auto subscriber = subscriberNode->getSubscriber();
-						if (subscriber) {
-							const auto & bodiesInCameraSpace = subscriber->getFrame().getBodies();
-							auto & BodiesInWorldSpace = worldBodiesUnmerged[subscriberIt.first];
-
-							for (const auto & body : bodiesInCameraSpace) {
-								if (body.tracked) {
-									BodiesInWorldSpace.push_back(body * subscriberNode->getTransform());
-								}
-							}
-						}
-					}
-				}
-
-				return worldBodiesUnmerged;
-			}
-
-			//----------
-			CombinedBodySet World::combineWorldBodies(WorldBodiesUnmerged worldBodiesUnmerged) const {
-				const auto & mergeDistanceThreshold = this->parameters.fusion.mergeDistanceThreshold.get();
-				Bodies mergedWorldBodies;
-
-				auto previousFrameCombinedBodies = this->combinedBodies;
-				CombinedBodySet newCombinedBodies;
-
-				// 1. Update any bodies which had been seen previously
-				// 2. Add any bodies which weren't seen previously (adding them to existing when distance is low)
-				// 3. Calculate the merged position
-				// as bodies are handled, we remove them from our WorldBodiesUnmerged set
-				// 4. Remove inactive bodies
-
-				//--
-				//Update bodies seen previously
-				//--
-				//
-				// 1. Go through existing bodies
-				// 2. Go through the sources of that body
-				// 3. See if it still has this body index
-				for (const auto & oldCombinedBodyIterator : previousFrameCombinedBodies) {
-					const auto & bodyIndex = oldCombinedBodyIterator.first;
-
-					for (const auto & originalBodiesIterator : oldCombinedBodyIterator.second.originalBodiesWorldSpace) {
-						const auto & originalBodyIndex = originalBodiesIterator.second.bodyId;
-						const auto & subscriberID = originalBodiesIterator.first;
-
-						auto findSubscriber = worldBodiesUnmerged.find(subscriberID);
-						if (findSubscriber != worldBodiesUnmerged.end()) {
-							auto & subscriber = findSubscriber->second;
-							//find if we have matching body index
-							for (auto subscriberBodyIterator = subscriber.begin(); subscriberBodyIterator != subscriber.end(); ) {
-								if (subscriberBodyIterator->bodyId == originalBodyIndex) {
-									//we've found a body which we'd tagged before
-									auto & combinedBody = newCombinedBodies[oldCombinedBodyIterator.first];
-
-									//assign it the new body
-									combinedBody.originalBodiesWorldSpace[subscriberID] = *subscriberBodyIterator;
-
-									//remove it from the unassigned set
-									subscriberBodyIterator = subscriber.erase(subscriberBodyIterator);
-								}
-								else {
-									subscriberBodyIterator++;
-								}
-							}
-						}
-					}
-				}
-				//
-				//--
-
-
-
-				//--
-				//Add subscriber body to existing combined bodies
-				//--
-				//
-				for (auto & subscriber : worldBodiesUnmerged) {
-					auto & bodies = subscriber.second;
-					for (auto bodyIterator = bodies.begin(); bodyIterator != bodies.end(); ) {
-						// now we have a body belonging to a subscriber
-
-						bool addedToExistingBody = false;
-
-						//check this body against any built bodies so far (this is often empty)
-						for (auto & combinedBody : newCombinedBodies) {
-							//find the mean of the combinedBody
-							auto meanOfExistingBodies = mean(combinedBody.second.originalBodiesWorldSpace, this->getMergeSettings());
-
-							//if the distance between this body and that body is < threshold, add it to the combined body
-							auto distance = meanDistance(meanOfExistingBodies, *bodyIterator, true);
-							if (distance < this->parameters.fusion.mergeDistanceThreshold) {
-								combinedBody.second.originalBodiesWorldSpace[subscriber.first] = *bodyIterator;
-								addedToExistingBody = true;
-								break;
-							}
-						}
-
-						if (!addedToExistingBody) {
-							static BodyIndex bodyIndex = 0;
-							auto & combinedBody = newCombinedBodies[bodyIndex];
-							combinedBody.originalBodiesWorldSpace[subscriber.first] = *bodyIterator;
-							bodyIndex++;
-						}
-
-						//erase this body from unassigned bodies
-						bodyIterator = bodies.erase(bodyIterator);
-					}
-				}
-				//
-				//--
-
-
-
-				// now newCombinedBodies is populated
-
-
-
-				//--
-				//Calculate the merged position
-				//--
-				//
-				for (auto & newCombinedBody : newCombinedBodies) {
-					newCombinedBody.second.combinedBody = mean(newCombinedBody.second.originalBodiesWorldSpace, this->getMergeSettings());
-				}
-				//
-				//--
-
-
-
-				//--
-				//Remove inactive bodies
-				//--
-				//
-				for (auto newCombinedBodyIterator = newCombinedBodies.begin(); newCombinedBodyIterator != newCombinedBodies.end(); ) {
-					if (newCombinedBodyIterator->second.combinedBody.tracked) {
-						newCombinedBodyIterator++;
-					}
-					else {
-						newCombinedBodyIterator = newCombinedBodies.erase(newCombinedBodyIterator);
+					if (subscriberNode && subscriberNode->isConnected()) {
+						auto & sensorFrame = input[subscriberIt.first];
+						sensorFrame.bodies = subscriberNode->getFrame().getBodies();
+						sensorFrame.transform = subscriberNode->getTransform();
 					}
-
 				}
-				//
-				//--
 
-				return newCombinedBodies;
+				return input;
 			}
 
 			//----------
@@ -336,10 +213,10 @@ namespace ofxRulr {
 				auto & combined = rootChannel["combined"];
 				{
 					auto & bodies = combined["bodies"];
-					bodies["count"] = (int) this->combinedBodies.size();
+					bodies["count"] = (int) this->combinedBodies->size();
 
 					vector<int> indices;
-					for (auto body : this->combinedBodies) {
+					for (const auto & body : *this->combinedBodies) {
 						indices.push_back((int) body.first);
 					}
 					bodies["indices"] = indices;
@@ -349,7 +226,7 @@ namespace ofxRulr {
 						auto & bodyChannels = bodies["body"].getSubChannels();
 						for (auto bodyChannelIterator = bodyChannels.begin(); bodyChannelIterator != bodyChannels.end(); ) {
 							const auto bodyIndex = ofToInt(bodyChannelIterator->first);
-							if (this->combinedBodies.find(bodyIndex) == this->combinedBodies.end()) {
+							if (this->combinedBodies->find(bodyIndex) == this->combinedBodies->end()) {
 								bodyChannelIterator = bodyChannels.erase(bodyChannelIterator);
 							}
 							else {
@@ -360,7 +237,7 @@ namespace ofxRulr {
 
 
 					//set data for tracked bodies
-					for (auto & combinedBody : this->combinedBodies) {
+					for (auto & combinedBody : *this->combinedBodies) {
 						auto & bodyChannel = bodies["body"][ofToString(combinedBody.first)];
 
 						auto & body = combinedBody.second.combinedBody;
@@ -2,6 +2,7 @@
 
 #include "Subscriber.h"
 #include "Utils.h"
+#include "Fusion.h"
 
 #include "ofxRulr/Data/Channels/Channel.h"
 
@@ -46,14 +47,11 @@ namespace ofxRulr {
 
 				Subscribers subscribers;
 
-				CombinedBodySet combinedBodies;
-
-				typedef vector<ofxKinectForWindows2::Data::Body> Bodies;
-				typedef map<SubscriberID, Bodies> WorldBodiesUnmerged;
+				Fusion fusion;
+				shared_ptr<const CombinedBodySet> combinedBodies = make_shared<CombinedBodySet>();
 
 				void performFusion();
-				WorldBodiesUnmerged getWorldBodiesUnmerged() const;
-				CombinedBodySet combineWorldBodies(WorldBodiesUnmerged worldBodiesUnmerged) const;
+				Fusion::Input getFusionInput() const;
 				void populateDatabase(Data::Channels::Channel & rootChannel);
 			};
 		}
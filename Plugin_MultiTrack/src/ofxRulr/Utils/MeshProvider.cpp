@@ -9,6 +9,21 @@ namespace ofxRulr {
 			, downsampleExp(0)
 			, dirty(true) {}
 
+		//----------
+		shared_ptr<MeshProvider> MeshProvider::getShared(const ofVec2f & dimensions, int downsampleExp) {
+			static map<tuple<int, int, int>, weak_ptr<MeshProvider>> sharedMeshProviders;
+
+			auto key = make_tuple((int) dimensions.x, (int) dimensions.y, downsampleExp);
+			auto meshProvider = sharedMeshProviders[key].lock();
+			if (!meshProvider) {
+				meshProvider = make_shared<MeshProvider>();
+				meshProvider->setDimensions(dimensions);
+				meshProvider->setDownsampleExp(downsampleExp);
+				sharedMeshProviders[key] = meshProvider;
+			}
+			return meshProvider;
+		}
+
 		//----------
 		void MeshProvider::setDimensions(const ofVec2f & dimensions) {
 			if (this->dimensions == dimensions) return;
@@ -8,6 +8,10 @@ namespace ofxRulr {
 		public:
 			MeshProvider();
 
+			/// A mesh provider which is shared with all other users of the same dimensions and downsampling,
+			/// e.g. so that many sensors with the same resolution draw with one mesh
+			static shared_ptr<MeshProvider> getShared(const ofVec2f & dimensions, int downsampleExp);
+
 			void setDimensions(const ofVec2f & dimensions);
 			void setDownsampleExp(int exponent);
 			void setDirty();
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace ofxRulr {
+	namespace Utils {
+		/// <summary>
+		/// Hands values from one writer thread to one reader thread without locking or copying.
+		///
+		/// The writer fills getBack() and calls publish(). The reader calls update() and then reads getFront(), which
+		/// stays valid until its next update(). Neither side ever waits for the other : if the writer publishes twice
+		/// before the reader updates then the older value is skipped, and its slot is reused (so any buffers inside
+		/// the values are recycled rather than reallocated).
+		/// </summary>
+		template<typename T>
+		class TripleBuffer {
+		public:
+			/// Writer thread only
+			T & getBack() {
+				return this->slots[this->back];
+			}
+
+			/// Writer thread only. Returns false if the previously published value was skipped by the reader
+			bool publish() {
+				auto previous = this->middle.exchange(this->back | FreshFlag);
+				this->back = previous & IndexMask;
+				return !(previous & FreshFlag);
+			}
+
+			/// Reader thread only. Returns true if a newly published value is now at the front
+			bool update() {
+				if (!(this->middle.load() & FreshFlag)) {
+					return false;
+				}
+				auto previous = this->middle.exchange(this->front);
+				this->front = previous & IndexMask;
+				return true;
+			}
+
+			/// Reader thread only
+			const T & getFront() const {
+				return this->slots[this->front];
+			}
+		protected:
+			enum : uint8_t {
+				IndexMask = 0x3,
+				FreshFlag = 0x4
+			};
+
+			array<T, 3> slots;
+			uint8_t front = 0;
+			atomic<uint8_t> middle{ 1 };
+			uint8_t back = 2;
+		};
+	}
+}
\ No newline at end of file
@@ -290,6 +290,16 @@ namespace ofxRulr {
 				this->parameters.calibrationParameters.axisAngleOffsets.B.set(0);
 			}
 
+			//----------
+			shared_ptr<Solvers::Reworld::Navigate::LookupTable>
+				Module::getNavigationLookupTable()
+			{
+				if (!this->navigationLookupTable) {
+					this->navigationLookupTable = make_shared<Solvers::Reworld::Navigate::LookupTable>();
+				}
+				return this->navigationLookupTable;
+			}
+
 			//----------
 			ofxCvGui::ElementPtr
 				Module::getDataDisplay()
@@ -6,6 +6,7 @@
 
 #include "ofxRulr/Models/Reworld/Module.h"
 #include "ofxRulr/Models/Reworld/AxisAngles.h"
+#include "ofxRulr/Solvers/Reworld/Navigate/LookupTable.h"
 
 namespace ofxRulr {
 	namespace Nodes {
@@ -61,6 +62,9 @@ namespace ofxRulr {
 
 				void clearCalibration();
 
+				// Built on demand by navigation (not serialised)
+				shared_ptr<Solvers::Reworld::Navigate::LookupTable> getNavigationLookupTable();
+
 				struct : ofParameterGroup {
 					ofParameter<int> ID{ "ID", 1 };
 
@@ -115,6 +119,7 @@ namespace ofxRulr {
 				ofxCvGui::ElementPtr getDataDisplay() override;
 				Column * parent = nullptr;
 				vector<string> oscOutbox;
+				shared_ptr<Solvers::Reworld::Navigate::LookupTable> navigationLookupTable;
 			};
 		}
 	}
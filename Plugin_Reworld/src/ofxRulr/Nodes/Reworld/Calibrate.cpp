@@ -239,6 +239,7 @@ namespace ofxRulr {
 				Calibrate::serialize(nlohmann::json& json)
 			{
 				this->captures.serialize(json["captures"]);
+				this->solverCache.serialize(json["solverCache"]);
 			}
 
 			//----------
@@ -248,6 +249,9 @@ namespace ofxRulr {
 				if (json.contains("captures")) {
 					this->captures.deserialize(json["captures"]);
 				}
+				if (json.contains("solverCache")) {
+					this->solverCache.deserialize(json["solverCache"]);
+				}
 				this->initCaptures();
 			}
 
@@ -281,6 +285,8 @@ namespace ofxRulr {
 					}
 					RULR_CATCH_ALL_TO_ALERT;
 					});
+
+				this->solverCache.addToInspector(inspector);
 			}
 
 			//----------
@@ -392,30 +398,41 @@ namespace ofxRulr {
 					throw(Exception("No target is set for this capture yet"));
 				}
 
-				auto columns = installation->getAllColumns();
-				for (int i = 0; i < columns.size(); i++) {
-					const auto& column = columns[i];
-					const auto modules = column->getAllModules();
-					for (int j = 0; j < modules.size(); j++) {
-						auto module = modules[j];
-						auto result = Solvers::Reworld::Navigate::PointToPoint::solve(module->getModel()
-							, module->getCurrentAxisAngles()
-							, lightPosition
-							, capture->getTarget());
-
-						capture->setModuleDataEstimate(i, j, result.solution.axisAngles);
-
-						if (filteringEnabled) {
-							// Check if we're outside acceptable range and deselect the module
-
-							auto vector = Models::Reworld::axisAnglesToVector(result.solution.axisAngles);
-							auto r = glm::length(vector);
-
-							if (result.residual > this->parameters.control.estimation.filterModules.maxResidual.get()
-								|| r < this->parameters.control.estimation.filterModules.deadZone.get()) {
-								// if the module lands too close to the see-through singularity it will be impossible to calibrate
-								module->setSelected(false);
-							}
+				// Gather all modules
+				vector<shared_ptr<Data::Reworld::Module>> modules;
+				vector<pair<Data::Reworld::ColumnIndex, Data::Reworld::ModuleIndex>> moduleIndices;
+				{
+					auto columns = installation->getAllColumns();
+					for (int i = 0; i < columns.size(); i++) {
+						const auto columnModules = columns[i]->getAllModules();
+						for (int j = 0; j < columnModules.size(); j++) {
+							modules.push_back(columnModules[j]);
+							moduleIndices.emplace_back(i, j);
+						}
+					}
+				}
+
+				// Navigate all modules to the target together
+				auto results = installation->navigatePointToPoint(modules
+					, lightPosition
+					, vector<glm::vec3>(modules.size(), capture->getTarget())
+					, this->parameters.control.estimation.solverSettings.getSolverSettings());
+
+				for (size_t i = 0; i < modules.size(); i++) {
+					const auto& result = results[i];
+					capture->setModuleDataEstimate(moduleIndices[i].first, moduleIndices[i].second, result.axisAngles);
+
+					if (filteringEnabled) {
+						// Check if we're outside acceptable range and deselect the module
+
+						auto vector = Models::Reworld::axisAnglesToVector(result.axisAngles);
+						auto r = glm::length(vector);
+
+						if (!result.success
+							|| result.residual > this->parameters.control.estimation.filterModules.maxResidual.get()
+							|| r < this->parameters.control.estimation.filterModules.deadZone.get()) {
+							// if the module lands too close to the see-through singularity it will be impossible to calibrate
+							modules[i]->setSelected(false);
 						}
 					}
 				}
@@ -695,10 +712,13 @@ namespace ofxRulr {
 					}
 				}
 
-				// Create problem
-				Solvers::Reworld::Calibrate::ModuleFromProjections::Problem problem(initialSolution, data.targetPositions);
-
-				// Add observations (only datapoints with state >= Good)
+				// Gather observations (only datapoints with state >= Good)
+				struct Observation {
+					int flatIdx;
+					int targetIdx;
+					Models::Reworld::AxisAngles<float> axisAngles;
+				};
+				vector<Observation> observations;
 				{
 					for (size_t targetIdx = 0; targetIdx < data.captures.size(); targetIdx++) {
 						const auto& capture = data.captures[targetIdx];
@@ -714,88 +734,254 @@ namespace ofxRulr {
 								continue; // skip unless Good (or higher if you add states later)
 							}
 
-							problem.addProjectionObservation((int)flatIdx, (int)targetIdx, dp->axisAngles);
+							observations.push_back({ (int)flatIdx, (int)targetIdx, dp->axisAngles });
 						}
 					}
 				}
 
-				// Set which parameters are fixed/variable
+				auto solverSettings = this->parameters.solve.solverSettings.getSolverSettings();
 				{
-					if (this->parameters.solve.fixLightPosition.get()) {
-						problem.setLightPositionFixed();
-					}
-					else {
-						problem.setLightPositionVariable();
+					solverSettings.options.linear_solver_type = ceres::LinearSolverType::DENSE_SCHUR;
+				}
+
+				// Look for a prior solve of the same observations and fixed parameters
+				Utils::SolverCache::Key cacheKey;
+				{
+					const auto& solve = this->parameters.solve;
+
+					cacheKey.addStructure("ModuleFromProjections")
+						.addStructure(solverSettings.options.max_num_iterations)
+						.add(solverSettings.options.function_tolerance)
+						.addStructure(solve.fixLightPosition.get())
+						.addStructure(solve.fixInterPrismDistance.get())
+						.addStructure(solve.fixPrismAngle.get())
+						.addStructure(solve.fixIOR.get())
+						.addStructure(solve.fixAllModulePositions.get())
+						.addStructure(solve.fixAllModuleRotations.get())
+						.addStructure(solve.fixAllAxisAngleOffsets.get());
+
+					cacheKey.addStructure(data.flatToIndexed.size());
+					for (const auto& [columnIdx, moduleIdx] : data.flatToIndexed) {
+						cacheKey.addStructure(columnIdx)
+							.addStructure(moduleIdx);
 					}
 
-					if (this->parameters.solve.fixInterPrismDistance.get()) {
-						problem.setInterPrismDistanceFixed();
+					for (const auto& targetPosition : data.targetPositions) {
+						cacheKey.add(targetPosition);
 					}
-					else {
-						problem.setInterPrismDistanceVariable();
+
+					cacheKey.addStructure(observations.size());
+					for (const auto& observation : observations) {
+						cacheKey.addStructure(observation.flatIdx)
+							.addStructure(observation.targetIdx)
+							.add(observation.axisAngles.A)
+							.add(observation.axisAngles.B);
 					}
 
-					if (this->parameters.solve.fixPrismAngle.get()) {
-						problem.setPrismAngleFixed();
+					// The solution also depends on the values of anything that's fixed
+					if (solve.fixLightPosition.get()) {
+						cacheKey.add(initialSolution.lightPosition);
 					}
-					else {
-						problem.setPrismAngleVariable();
+					if (solve.fixInterPrismDistance.get()) {
+						cacheKey.add(initialSolution.interPrismDistance);
 					}
-
-					if (this->parameters.solve.fixIOR.get()) {
-						problem.setIORFixed();
+					if (solve.fixPrismAngle.get()) {
+						cacheKey.add(initialSolution.prismAngleRadians);
 					}
-					else {
-						problem.setIORVariable();
+					if (solve.fixIOR.get()) {
+						cacheKey.add(initialSolution.ior);
+					}
+					for (const auto& module : initialSolution.modules) {
+						if (solve.fixAllModulePositions.get()) {
+							cacheKey.add(module.transformOffset.translation);
+						}
+						if (solve.fixAllModuleRotations.get()) {
+							cacheKey.add(module.transformOffset.rotationVector);
+						}
+						if (solve.fixAllAxisAngleOffsets.get()) {
+							cacheKey.add(module.axisAngleOffsets.A)
+								.add(module.axisAngleOffsets.B);
+						}
 					}
+				}
 
-					if (this->parameters.solve.fixAllModulePositions.get()) {
-						problem.setAllModulePositionsFixed();
+				// Solution is packed as light position, inter-prism distance, prism angle, IOR
+				// then translation, rotation vector and axis-angle offsets per module
+				auto packSolution = [](const Solvers::Reworld::Calibrate::ModuleFromProjections::Solution& solution) {
+					vector<double> packed{
+						solution.lightPosition.x
+						, solution.lightPosition.y
+						, solution.lightPosition.z
+						, solution.interPrismDistance
+						, solution.prismAngleRadians
+						, solution.ior
+					};
+					for (const auto& module : solution.modules) {
+						const auto& translation = module.transformOffset.translation;
+						const auto& rotationVector = module.transformOffset.rotationVector;
+						packed.insert(packed.end(), {
+							translation.x, translation.y, translation.z
+							, rotationVector.x, rotationVector.y, rotationVector.z
+							, module.axisAngleOffsets.A, module.axisAngleOffsets.B
+							});
 					}
-					else {
-						problem.setAllModulePositionsVariable();
+					return packed;
+				};
+				auto unpackSolution = [](const vector<double>& packed
+					, Solvers::Reworld::Calibrate::ModuleFromProjections::Solution& solution) {
+					if (packed.size() != 6 + solution.modules.size() * 8) {
+						return false;
 					}
-
-					if (this->parameters.solve.fixAllModuleRotations.get()) {
-						problem.setAllModuleRotationsFixed();
+					auto value = packed.begin();
+					solution.lightPosition.x = (float)*value++;
+					solution.lightPosition.y = (float)*value++;
+					solution.lightPosition.z = (float)*value++;
+					solution.interPrismDistance = (float)*value++;
+					solution.prismAngleRadians = (float)*value++;
+					solution.ior = (float)*value++;
+					for (auto& module : solution.modules) {
+						auto& translation = module.transformOffset.translation;
+						auto& rotationVector = module.transformOffset.rotationVector;
+						translation.x = (float)*value++;
+						translation.y = (float)*value++;
+						translation.z = (float)*value++;
+						rotationVector.x = (float)*value++;
+						rotationVector.y = (float)*value++;
+						rotationVector.z = (float)*value++;
+						module.axisAngleOffsets.A = (float)*value++;
+						module.axisAngleOffsets.B = (float)*value++;
 					}
-					else {
-						problem.setAllModuleRotationsVariable();
+					return true;
+				};
+
+				auto solution = initialSolution;
+				auto cacheLookup = this->solverCache.find(cacheKey);
+				if (cacheLookup.match == Utils::SolverCache::Match::Exact
+					&& unpackSolution(cacheLookup.solution, solution)) {
+					// Identical inputs : use the stored solution
+					ofLogNotice("Reworld::Calibrate") << "Using cached solution (residual " << cacheLookup.residual << ")";
+				}
+				else {
+					// Near-identical inputs : start from the closest stored solution (only for parameters which are free)
+					if (cacheLookup.match == Utils::SolverCache::Match::Nearest) {
+						auto warmStart = initialSolution;
+						if (unpackSolution(cacheLookup.solution, warmStart)) {
+							const auto& solve = this->parameters.solve;
+							if (!solve.fixLightPosition.get()) {
+								initialSolution.lightPosition = warmStart.lightPosition;
+							}
+							if (!solve.fixInterPrismDistance.get()) {
+								initialSolution.interPrismDistance = warmStart.interPrismDistance;
+							}
+							if (!solve.fixPrismAngle.get()) {
+								initialSolution.prismAngleRadians = warmStart.prismAngleRadians;
+							}
+							if (!solve.fixIOR.get()) {
+								initialSolution.ior = warmStart.ior;
+							}
+							for (size_t i = 0; i < initialSolution.modules.size(); i++) {
+								auto& module = initialSolution.modules[i];
+								const auto& warmStartModule = warmStart.modules[i];
+								if (!solve.fixAllModulePositions.get()) {
+									module.transformOffset.translation = warmStartModule.transformOffset.translation;
+								}
+								if (!solve.fixAllModuleRotations.get()) {
+									module.transformOffset.rotationVector = warmStartModule.transformOffset.rotationVector;
+								}
+								if (!solve.fixAllAxisAngleOffsets.get()) {
+									module.axisAngleOffsets = warmStartModule.axisAngleOffsets;
+								}
+							}
+						}
 					}
 
-					if (this->parameters.solve.fixAllAxisAngleOffsets.get()) {
-						problem.setAllAxisAngleOffsetsFixed();
+					// Create problem
+					Solvers::Reworld::Calibrate::ModuleFromProjections::Problem problem(initialSolution, data.targetPositions);
+
+					// Add observations
+					for (const auto& observation : observations) {
+						problem.addProjectionObservation(observation.flatIdx, observation.targetIdx, observation.axisAngles);
 					}
-					else {
-						problem.setAllAxisAngleOffsetsVariable();
+
+					// Set which parameters are fixed/variable
+					{
+						if (this->parameters.solve.fixLightPosition.get()) {
+							problem.setLightPositionFixed();
+						}
+						else {
+							problem.setLightPositionVariable();
+						}
+
+						if (this->parameters.solve.fixInterPrismDistance.get()) {
+							problem.setInterPrismDistanceFixed();
+						}
+						else {
+							problem.setInterPrismDistanceVariable();
+						}
+
+						if (this->parameters.solve.fixPrismAngle.get()) {
+							problem.setPrismAngleFixed();
+						}
+						else {
+							problem.setPrismAngleVariable();
+						}
+
+						if (this->parameters.solve.fixIOR.get()) {
+							problem.setIORFixed();
+						}
+						else {
+							problem.setIORVariable();
+						}
+
+						if (this->parameters.solve.fixAllModulePositions.get()) {
+							problem.setAllModulePositionsFixed();
+						}
+						else {
+							problem.setAllModulePositionsVariable();
+						}
+
+						if (this->parameters.solve.fixAllModuleRotations.get()) {
+							problem.setAllModuleRotationsFixed();
+						}
+						else {
+							problem.setAllModuleRotationsVariable();
+						}
+
+						if (this->parameters.solve.fixAllAxisAngleOffsets.get()) {
+							problem.setAllAxisAngleOffsetsFixed();
+						}
+						else {
+							problem.setAllAxisAngleOffsetsVariable();
+						}
 					}
-				}
 
-				// Solve
-				auto solverSettings = this->parameters.solve.solverSettings.getSolverSettings();
-				{
-					solverSettings.options.linear_solver_type = ceres::LinearSolverType::DENSE_SCHUR;
+					// Solve
+					Solvers::Reworld::Calibrate::ModuleFromProjections::Result result =
+						problem.solve(solverSettings);
+					solution = result.solution;
+
+					if (!result.isError) {
+						this->solverCache.store(cacheKey, packSolution(solution), (float)result.residual);
+					}
 				}
-				Solvers::Reworld::Calibrate::ModuleFromProjections::Result result =
-					problem.solve(solverSettings);
 
 				// Write back results
 				{
 					// Light
-					lightNode->setPosition(result.solution.lightPosition);
+					lightNode->setPosition(solution.lightPosition);
 
 					// Physical parameters
 					{
 						auto physical = installation->getPhysicalParameters();
-						physical.interPrismDistanceMM.set(result.solution.interPrismDistance * 1000.0f);     // m -> mm
-						physical.prismAngle.set(result.solution.prismAngleRadians * (float)RAD_TO_DEG);      // rad -> deg
-						physical.ior.set(result.solution.ior);
+						physical.interPrismDistanceMM.set(solution.interPrismDistance * 1000.0f);     // m -> mm
+						physical.prismAngle.set(solution.prismAngleRadians * (float)RAD_TO_DEG);      // rad -> deg
+						physical.ior.set(solution.ior);
 						installation->setPhysicalParameters(physical);
 					}
 
 					// Modules (order matches filtered data.modules)
 					{
-						const auto& solvedModules = result.solution.modules;
+						const auto& solvedModules = solution.modules;
 						const size_t n = std::min(solvedModules.size(), data.modules.size());
 						for (size_t i = 0; i < n; i++) {
 							const auto& solved = solvedModules[i];
@@ -2,6 +2,7 @@
 
 #include "ofxRulr.h"
 #include "ofxRulr/Data/Reworld/Capture.h"
+#include "ofxRulr/Utils/SolverCache.h"
 
 #include "ofxRulr/Data/Reworld/Column.h"
 #include "ofxRulr/Data/Reworld/Module.h"
@@ -165,6 +166,9 @@ namespace ofxRulr {
 				vector<string> oscOutbox;
 
 				float lastResidual = 0.0f;
+
+				// Solutions of calibrate() against the observations and fixed parameters
+				Utils::SolverCache solverCache;
 			};
 		}
 	}
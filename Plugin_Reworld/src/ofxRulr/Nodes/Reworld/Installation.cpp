@@ -163,6 +163,12 @@ namespace ofxRulr {
 					}
 					RULR_CATCH_ALL_TO_ALERT;
 					});
+				inspector->addButton("Poll positions", [this]() {
+					try {
+						this->pollPositions();
+					}
+					RULR_CATCH_ALL_TO_ALERT;
+					});
 			}
 
 			//---------
@@ -276,7 +282,6 @@ namespace ofxRulr {
 				bool sendOnChange = this->parameters.transmit.onChange.get();
 
 				if (sendOnChange) {
-					map<Router::Address, Models::Reworld::AxisAngles<float>> dataToSend;
 					for (int columnIndex = 0; columnIndex < columns.size(); columnIndex++) {
 						auto column = columns[columnIndex];
 
@@ -304,7 +309,7 @@ namespace ofxRulr {
 								}
 
 								auto axisValues = module->getAxisAnglesForSend();
-								dataToSend.emplace(addressZeroIndexed, axisValues);
+								router->setAxisValues(addressZeroIndexed, axisValues, forceSend);
 							}
 
 							// check if there's anything in the outbox
@@ -330,10 +335,6 @@ namespace ofxRulr {
 							}
 						}
 					}
-
-					if (!dataToSend.empty()) {
-						router->sendAxisValues(dataToSend);
-					}
 				}
 			}
 
@@ -405,6 +406,100 @@ namespace ofxRulr {
 				ofs.close();
 			}
 
+			//---------
+			void
+				Installation::pollPositions()
+			{
+				this->throwIfMissingAConnection<Router>();
+				auto router = this->getInput<Router>();
+
+				vector<Router::Address> addresses;
+				{
+					auto columns = this->getAllColumns();
+					for (int columnIndex = 0; columnIndex < columns.size(); columnIndex++) {
+						auto column = columns[columnIndex];
+						if (!column->isSelected()) {
+							continue;
+						}
+
+						auto modules = column->getAllModules();
+						for (auto module : modules) {
+							if (!module->isSelected()) {
+								continue;
+							}
+
+							Router::Address address;
+							{
+								address.column = columnIndex;
+								address.portal = module->parameters.ID.get();
+							}
+							addresses.push_back(address);
+						}
+					}
+				}
+
+				if (addresses.empty()) {
+					return;
+				}
+
+				router->poll(addresses);
+				auto positions = router->getPositions(addresses);
+				auto targetPositions = router->getTargetPositions(addresses);
+				auto inPosition = router->isInPosition(addresses);
+
+				size_t inPositionCount = 0;
+				for (size_t i = 0; i < addresses.size(); i++) {
+					if (inPosition[i]) {
+						inPositionCount++;
+					}
+					else {
+						ofLogNotice("Installation") << "Module " << addresses[i].column << "/" << (int)addresses[i].portal
+							<< " at " << positions[i] << ", target " << targetPositions[i];
+					}
+				}
+				ofLogNotice("Installation") << inPositionCount << " of " << addresses.size() << " modules in position";
+			}
+
+			//---------
+			vector<Solvers::Reworld::Navigate::Batch::Result>
+				Installation::navigatePointToPoint(const vector<shared_ptr<Data::Reworld::Module>>& modules
+					, const glm::vec3& point1
+					, const vector<glm::vec3>& point2s
+					, const ofxCeres::SolverSettings& solverSettings) const
+			{
+				if (modules.size() != point2s.size()) {
+					throw(Exception("navigatePointToPoint : modules and targets must be the same size"));
+				}
+
+				const auto lookupTableEnabled = this->parameters.navigation.lookupTable.enabled.get();
+
+				vector<Solvers::Reworld::Navigate::Batch::Task> tasks;
+				tasks.reserve(modules.size());
+				for (size_t i = 0; i < modules.size(); i++) {
+					Solvers::Reworld::Navigate::Batch::Task task;
+					task.module = modules[i]->getModel();
+					task.initialAxisAngles = modules[i]->getCurrentAxisAngles();
+					task.point1 = point1;
+					task.point2 = point2s[i];
+					if (lookupTableEnabled) {
+						task.lookupTable = modules[i]->getNavigationLookupTable();
+					}
+					tasks.push_back(task);
+				}
+
+				Solvers::Reworld::Navigate::Batch::Settings settings;
+				{
+					settings.solverSettings = solverSettings;
+					settings.threadCount = (size_t) max(this->parameters.navigation.threads.get(), 0);
+					settings.lookupTableResolution = (size_t) max(this->parameters.navigation.lookupTable.resolution.get(), 2);
+					settings.lookupTableTolerance = lookupTableEnabled
+						? this->parameters.navigation.lookupTable.tolerance.get()
+						: 0.0f;
+				}
+
+				return Solvers::Reworld::Navigate::Batch::solve(tasks, settings);
+			}
+
 			//---------
 			vector<shared_ptr<Data::Reworld::Module>>
 				Installation::getSelectedModules() const
@@ -3,6 +3,7 @@
 #include "ofxRulr/Nodes/IHasVertices.h"
 #include "ofxRulr/Data/Reworld/Column.h"
 #include "ofxRulr/Utils/EditSelection.h"
+#include "ofxRulr/Solvers/Reworld/Navigate/Batch.h"
 
 namespace ofxRulr {
 	namespace Nodes {
@@ -50,6 +51,16 @@ namespace ofxRulr {
 
 				void exportPositionsCSV() const;
 
+				// Ask the router for the reported positions of the selected modules (all requests in flight at once)
+				void pollPositions();
+
+				// Navigate each module so that light from point1 lands on its target (one target per module).
+				// Runs in parallel, using the navigation lookup tables if enabled. Doesn't move the modules.
+				vector<Solvers::Reworld::Navigate::Batch::Result> navigatePointToPoint(const vector<shared_ptr<Data::Reworld::Module>>&
+					, const glm::vec3& point1
+					, const vector<glm::vec3>& point2s
+					, const ofxCeres::SolverSettings&) const;
+
 				Utils::EditSelection<Data::Reworld::Column> ourSelection;
 
 				vector<shared_ptr<Data::Reworld::Module>> getSelectedModules() const;
@@ -88,12 +99,25 @@ namespace ofxRulr {
 						PARAM_DECLARE("Transmit", onChange, onPeriod, periodEnabled);
 					} transmit;
 
+					struct : ofParameterGroup {
+						ofParameter<int> threads{ "Threads", 0 }; // 0 = thread budget
+
+						struct : ofParameterGroup {
+							ofParameter<bool> enabled{ "Enabled", false };
+							ofParameter<int> resolution{ "Resolution", 64, 8, 512 };
+							ofParameter<float> tolerance{ "Tolerance [m]", 0.005, 0, 1 };
+							PARAM_DECLARE("Lookup table", enabled, resolution, tolerance);
+						} lookupTable;
+
+						PARAM_DECLARE("Navigation", threads, lookupTable);
+					} navigation;
+
 					struct : ofParameterGroup {
 						LabelDraws labels;
 						PARAM_DECLARE("Draw", labels);
 					} draw;
 
-					PARAM_DECLARE("Installation", builder, physicalParameters, transmit, draw);
+					PARAM_DECLARE("Installation", builder, physicalParameters, transmit, navigation, draw);
 				} parameters;
 
 				shared_ptr<ofxCvGui::Panels::Widgets> panel;
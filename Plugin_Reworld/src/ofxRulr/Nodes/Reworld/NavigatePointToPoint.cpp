@@ -93,15 +93,14 @@ namespace ofxRulr {
 				auto point2 = point2Node->getPosition();
 
 				auto modules = installationNode->getSelectedModules();
-				for(auto module : modules) {
-					auto result = Solvers::Reworld::Navigate::PointToPoint::solve(module->getModel()
-						, module->getCurrentAxisAngles()
-						, point1
-						, point2
-						, this->parameters.solverSettings.getSolverSettings());
+				auto results = installationNode->navigatePointToPoint(modules
+					, point1
+					, vector<glm::vec3>(modules.size(), point2)
+					, this->parameters.solverSettings.getSolverSettings());
 
-					module->setTargetAxisAngles(result.solution.axisAngles);
-					cout << result.residual << endl;
+				for (size_t i = 0; i < modules.size(); i++) {
+					modules[i]->setTargetAxisAngles(results[i].axisAngles);
+					cout << results[i].residual << endl;
 				}
 
 				this->needsPerform = false;
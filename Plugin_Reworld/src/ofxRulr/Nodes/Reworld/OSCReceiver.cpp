@@ -107,46 +107,59 @@ namespace ofxRulr {
 									}
 								}
 
-								auto columns = installation->getAllColumns();
-								for (size_t columnIndex = columnOffset; columnIndex < columns.size(); columnIndex++) {
-									auto column = columns[columnIndex];
-									auto modules = column->getAllModules();
-									for (size_t moduleIndex = 0; moduleIndex < modules.size(); moduleIndex++) {
-										auto module = modules[moduleIndex];
-
-										// continue until we run out of data
-										if (argIndex + 3 <= argCount) {
-											glm::vec3 target{
-												message.getArgAsFloat(argIndex++)
-												, message.getArgAsFloat(argIndex++)
-												, message.getArgAsFloat(argIndex++)
-											};
-
-											auto result = Solvers::Reworld::Navigate::PointToPoint::solve(module->getModel()
-												, module->getCurrentAxisAngles()
-												, lightPosition
-												, target
-												, this->parameters.solverSettings.getSolverSettings());
-											module->setTargetAxisAngles(result.solution.axisAngles);
-
-											if (previewEnabled) {
-												PreviewPoint previewPoint{
-													target
-													, module->getPosition()
-													, module->color.get()
+								// Gather the targets for each module
+								vector<shared_ptr<Data::Reworld::Module>> modules;
+								vector<glm::vec3> targets;
+								vector<Router::Address> addresses;
+								{
+									auto columns = installation->getAllColumns();
+									for (size_t columnIndex = columnOffset; columnIndex < columns.size(); columnIndex++) {
+										auto column = columns[columnIndex];
+										auto columnModules = column->getAllModules();
+										for (size_t moduleIndex = 0; moduleIndex < columnModules.size(); moduleIndex++) {
+											// continue until we run out of data
+											if (argIndex + 3 <= argCount) {
+												glm::vec3 target{
+													message.getArgAsFloat(argIndex++)
+													, message.getArgAsFloat(argIndex++)
+													, message.getArgAsFloat(argIndex++)
 												};
+
 												Router::Address address;
 												{
 													address.portal = moduleIndex;
 													address.column = columnIndex;
 												}
-												this->previewData[address] = previewPoint;
 
-												this->previewDataDirty = true;
+												modules.push_back(columnModules[moduleIndex]);
+												targets.push_back(target);
+												addresses.push_back(address);
 											}
 										}
 									}
 								}
+
+								// Navigate all modules together
+								auto results = installation->navigatePointToPoint(modules
+									, lightPosition
+									, targets
+									, this->parameters.solverSettings.getSolverSettings());
+
+								for (size_t i = 0; i < modules.size(); i++) {
+									auto module = modules[i];
+									module->setTargetAxisAngles(results[i].axisAngles);
+
+									if (previewEnabled) {
+										PreviewPoint previewPoint{
+											targets[i]
+											, module->getPosition()
+											, module->color.get()
+										};
+										this->previewData[addresses[i]] = previewPoint;
+
+										this->previewDataDirty = true;
+									}
+								}
 							}
 						}
 						RULR_CATCH_ALL_TO_ERROR;
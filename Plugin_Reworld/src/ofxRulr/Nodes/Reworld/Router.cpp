@@ -50,6 +50,37 @@ namespace ofxRulr {
 						}
 						RULR_CATCH_ALL_TO_ALERT;
 						}, ' ');
+
+					this->httpClient.addToInspector(inspector);
+
+					inspector->addTitle("Transmit", ofxCvGui::Widgets::Title::Level::H3);
+					inspector->addLiveValue<size_t>("Values sent", [this]() {
+						return this->transmitter.getStatistics().valuesSent;
+						});
+					inspector->addLiveValue<size_t>("Values skipped", [this]() {
+						return this->transmitter.getStatistics().valuesSkipped;
+						});
+					inspector->addLiveValue<size_t>("Values coalesced", [this]() {
+						return this->transmitter.getStatistics().valuesCoalesced;
+						});
+					inspector->addLiveValue<size_t>("Messages sent", [this]() {
+						return this->transmitter.getStatistics().messagesSent;
+						});
+					inspector->addLiveValue<size_t>("Packets sent", [this]() {
+						return this->transmitter.getStatistics().packetsSent;
+						});
+					inspector->addLiveValue<size_t>("Bytes sent", [this]() {
+						return this->transmitter.getStatistics().bytesSent;
+						});
+					inspector->addLiveValue<float>("Last send duration [ms]", [this]() {
+						return this->transmitter.getStatistics().lastSendDuration;
+						});
+					inspector->addLiveValue<float>("Send rate [Hz]", [this]() {
+						return this->transmitter.getStatistics().sendRate;
+						});
+					inspector->addButton("Reset statistics", [this]() {
+						this->transmitter.resetStatistics();
+						});
 					};
 			}
 
@@ -57,19 +88,44 @@ namespace ofxRulr {
 			void
 				Router::update()
 			{
-				// OSC settings
+				// REST settings
+				if (this->httpClient.getMaxInFlight() != (size_t) this->parameters.rest.maxInFlight.get()) {
+					this->httpClient.setMaxInFlight((size_t) this->parameters.rest.maxInFlight.get());
+				}
+
+				// Transmit settings (only pushed to the transmitter when they change, since that forces a resend of all values)
 				{
-					if (this->oscSender) {
-						if (this->oscSender->getPort() != this->parameters.osc.port.get()) {
-							this->oscSender.reset();
-						}
-						else if (this->oscSender->getHost() != this->parameters.hostname.get()) {
-							this->oscSender.reset();
+					auto& cached = this->cachedTransmitSettings;
+					if (cached.hostname != this->parameters.hostname.get()
+						|| cached.port != this->parameters.osc.port.get()
+						|| cached.format != this->parameters.transmit.format.get()
+						|| cached.maxPortalsPerMessage != this->parameters.osc.maxPortalsPerMessage.get()
+						|| cached.bundles != this->parameters.transmit.bundles.get()
+						|| cached.maxPacketSize != this->parameters.transmit.maxPacketSize.get()
+						|| cached.maxRate != this->parameters.transmit.maxRate.get()
+						|| cached.stepsPerRevolution != this->parameters.transmit.stepsPerRevolution.get()) {
+
+						cached.hostname = this->parameters.hostname.get();
+						cached.port = this->parameters.osc.port.get();
+						cached.format = this->parameters.transmit.format.get();
+						cached.maxPortalsPerMessage = this->parameters.osc.maxPortalsPerMessage.get();
+						cached.bundles = this->parameters.transmit.bundles.get();
+						cached.maxPacketSize = this->parameters.transmit.maxPacketSize.get();
+						cached.maxRate = this->parameters.transmit.maxRate.get();
+						cached.stepsPerRevolution = this->parameters.transmit.stepsPerRevolution.get();
+
+						Utils::Reworld::AxisTransmitter::Settings settings;
+						{
+							settings.hostname = cached.hostname;
+							settings.port = cached.port;
+							settings.format = cached.format;
+							settings.maxPortalsPerMessage = (size_t) max(cached.maxPortalsPerMessage, 1);
+							settings.bundles = cached.bundles;
+							settings.maxPacketSize = (size_t) max(cached.maxPacketSize, 64);
+							settings.maxRate = cached.maxRate;
+							settings.stepsPerRevolution = (uint32_t) max(cached.stepsPerRevolution, 1);
 						}
-					}
-					if (!this->oscSender) {
-						this->oscSender = make_shared<ofxOscSender>();
-						this->oscSender->setup(this->parameters.hostname.get(), this->parameters.osc.port.get());
+						this->transmitter.setSettings(settings);
 					}
 				}
 			}
@@ -92,17 +148,36 @@ namespace ofxRulr {
 			nlohmann::json
 				Router::loadURI(const string& uri)
 			{
-				auto response = ofLoadURL(uri);
+				return this->loadURIs({ uri }).front();
+			}
 
-				if (response.status != 200) {
-					throw(ofxRulr::Exception(ofToString(response.status) + "\n" + response.error + "\n" + (string)response.data));
-				}
-				if (response.data.size() == 0) {
-					return nlohmann::json();
+			//----------
+			vector<nlohmann::json>
+				Router::loadURIs(const vector<string>& uris)
+			{
+				vector<Utils::HttpClient::Request> requests;
+				for (const auto& uri : uris) {
+					Utils::HttpClient::Request request;
+					request.url = uri;
+					request.timeout = this->parameters.rest.timeout.get();
+					requests.push_back(request);
 				}
-				else {
-					return nlohmann::json::parse((string)response.data);
+
+				auto responses = this->httpClient.requestAll(requests);
+
+				vector<nlohmann::json> results;
+				for (const auto& response : responses) {
+					if (response.status != 200) {
+						throw(ofxRulr::Exception(ofToString(response.status) + "\n" + response.error + "\n" + response.data));
+					}
+					if (response.data.size() == 0) {
+						results.push_back(nlohmann::json());
+					}
+					else {
+						results.push_back(nlohmann::json::parse(response.data));
+					}
 				}
+				return results;
 			}
 
 			//----------
@@ -181,79 +256,138 @@ namespace ofxRulr {
 			}
 
 			//----------
-			void
-				Router::sendAxisValues(const map<Address, Models::Reworld::AxisAngles<float>>& axisAnglesByIndex)
+			vector<glm::vec2>
+				Router::getPositions(const vector<Address>& addresses)
 			{
-				if (!this->oscSender) {
-					return;
+				vector<string> uris;
+				for (const auto& address : addresses) {
+					uris.push_back(this->getBaseURI(address) + "/getPosition");
 				}
-				ofxOscMessage message;
-				auto address = "/axesMoveByInidices";
-				message.setAddress(address);
-				for (const auto& it : axisAnglesByIndex) {
-					message.addIntArg(it.first.column);
-					message.addIntArg(it.first.portal);
-					message.addFloatArg(it.second.A);
-					message.addFloatArg(it.second.B);
-
-					// clear out the message if it's getting too big
-					if (message.getNumArgs() / 4 >= this->parameters.osc.maxPortalsPerMessage.get()) {
-						// send this batch
-						this->oscSender->sendMessage(message);
-
-						// reset the message
-						message.clear();
-						message.setAddress(address);
+
+				vector<glm::vec2> positions;
+				for (const auto& responseJson : this->loadURIs(uris)) {
+					if (responseJson.contains("x") && responseJson.contains("y")) {
+						positions.push_back(glm::vec2{
+							responseJson["x"].get<float>()
+							, responseJson["y"].get<float>()
+							});
+					}
+					else {
+						throw(ofxRulr::Exception("Malformed json response"));
 					}
 				}
-				
-				if (message.getNumArgs() > 0) {
-					this->oscSender->sendMessage(message);
+				return positions;
+			}
+
+			//----------
+			vector<glm::vec2>
+				Router::getTargetPositions(const vector<Address>& addresses)
+			{
+				vector<string> uris;
+				for (const auto& address : addresses) {
+					uris.push_back(this->getBaseURI(address) + "/getTargetPosition");
+				}
+
+				vector<glm::vec2> positions;
+				for (const auto& responseJson : this->loadURIs(uris)) {
+					if (responseJson.contains("x") && responseJson.contains("y")) {
+						positions.push_back(glm::vec2{
+							responseJson["x"].get<float>()
+							, responseJson["y"].get<float>()
+							});
+					}
+					else {
+						throw(ofxRulr::Exception("Malformed json response"));
+					}
+				}
+				return positions;
+			}
+
+			//----------
+			vector<bool>
+				Router::isInPosition(const vector<Address>& addresses)
+			{
+				vector<string> uris;
+				for (const auto& address : addresses) {
+					uris.push_back(this->getBaseURI(address) + "/isInPosition");
+				}
+
+				vector<bool> results;
+				for (const auto& responseJson : this->loadURIs(uris)) {
+					results.push_back((bool)responseJson);
 				}
+				return results;
 			}
 
 			//----------
 			void
-				Router::sendOSCMessageToAll(string oscAddress)
+				Router::poll(const vector<Address>& addresses)
+			{
+				vector<string> uris;
+				for (const auto& address : addresses) {
+					uris.push_back(this->getBaseURI(address) + "/poll");
+				}
+				this->loadURIs(uris);
+			}
+
+			//----------
+			void
+				Router::push(const vector<Address>& addresses)
 			{
-				if (!this->oscSender) {
-					return;
+				vector<string> uris;
+				for (const auto& address : addresses) {
+					uris.push_back(this->getBaseURI(address) + "/push");
 				}
-				auto address = "/" + oscAddress;
+				this->loadURIs(uris);
+			}
 
-				ofxOscMessage message;
-				message.setAddress(address);
-				this->oscSender->sendMessage(message);
+			//----------
+			void
+				Router::setAxisValues(const Address& address, const Models::Reworld::AxisAngles<float>& axisAngles, bool force)
+			{
+				this->transmitter.setAxisAngles(address.column, address.portal, axisAngles, force);
 			}
 
 			//----------
 			void
-				Router::sendOSCMessageToColumn(int columnIndex, string oscAddress)
+				Router::sendAxisValues(const map<Address, Models::Reworld::AxisAngles<float>>& axisAnglesByIndex)
 			{
-				if (!this->oscSender) {
-					return;
+				for (const auto& it : axisAnglesByIndex) {
+					this->transmitter.setAxisAngles(it.first.column, it.first.portal, it.second, true);
 				}
+			}
+
+			//----------
+			void
+				Router::sendOSCMessageToAll(string oscAddress)
+			{
+				this->transmitter.sendMessage("/" + oscAddress);
+			}
+
+			//----------
+			void
+				Router::sendOSCMessageToColumn(int columnIndex, string oscAddress)
+			{
 				auto address = "/" + ofToString((int) columnIndex)
 					+ "/" + oscAddress;
-
-				ofxOscMessage message;
-				message.setAddress(address);
-				this->oscSender->sendMessage(message);
+				this->transmitter.sendMessage(address);
 			}
 
 			//----------
 			void
 				Router::sendOSCMessageToModule(Address moduleAddress, string oscAddress)
 			{
-				if (!this->oscSender) {
-					return;
-				}
 				auto address = "/" + ofToString((int) moduleAddress.column)
 					+ "/" + ofToString((int) moduleAddress.portal)
 					+ "/" + oscAddress;
-				ofxOscMessage message;
-				message.setAddress(address);
-				this->oscSender->sendMessage(message);
+				this->transmitter.sendMessage(address);
+			}
+
+			//----------
+			Utils::Reworld::AxisTransmitter::Statistics
+				Router::getTransmitStatistics() const
+			{
+				return this->transmitter.getStatistics();
 			}
 		}
 	}
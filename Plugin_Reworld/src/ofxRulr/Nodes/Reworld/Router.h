@@ -4,6 +4,8 @@
 #include "ofxOsc.h"
 
 #include "ofxRulr/Models/Reworld/AxisAngles.h"
+#include "ofxRulr/Utils/Reworld/AxisTransmitter.h"
+#include "ofxRulr/Utils/HttpClient.h"
 
 namespace ofxRulr {
 	namespace Nodes {
@@ -27,6 +29,9 @@ namespace ofxRulr {
 
 				nlohmann::json loadURI(const string& uri);
 
+				// Requests are made concurrently. Throws the first error after all have completed
+				vector<nlohmann::json> loadURIs(const vector<string>& uris);
+
 				void test();
 				void setPosition(const Address&, const glm::vec2&);
 				glm::vec2 getPosition(const Address&);
@@ -35,17 +40,30 @@ namespace ofxRulr {
 				void poll(const Address&);
 				void push(const Address&);
 
+				// Batch versions of the above, with all requests in flight at once
+				vector<glm::vec2> getPositions(const vector<Address>&);
+				vector<glm::vec2> getTargetPositions(const vector<Address>&);
+				vector<bool> isInPosition(const vector<Address>&);
+				void poll(const vector<Address>&);
+				void push(const vector<Address>&);
+
+				// Queued for the transmitter's thread. Values which haven't changed since they were last sent are skipped unless forced.
+				void setAxisValues(const Address&, const Models::Reworld::AxisAngles<float>&, bool force);
 				void sendAxisValues(const map<Address, Models::Reworld::AxisAngles<float>>&);
 				void sendOSCMessageToAll(string oscAddress);
 				void sendOSCMessageToColumn(int columnIndex, string oscAddress);
 				void sendOSCMessageToModule(Address moduleAddress, string oscAddress);
+
+				Utils::Reworld::AxisTransmitter::Statistics getTransmitStatistics() const;
 			protected:
 
 				struct : ofParameterGroup {
 					ofParameter<string> hostname{ "Hostname", "localhost" };
 					struct : ofParameterGroup {
 						ofParameter<int> port{ "Port", 8080 };
-						PARAM_DECLARE("REST", port);
+						ofParameter<int> maxInFlight{ "Max in flight", 32, 1, 256 };
+						ofParameter<float> timeout{ "Timeout [s]", 5.0f };
+						PARAM_DECLARE("REST", port, maxInFlight, timeout);
 					} rest;
 
 					struct : ofParameterGroup {
@@ -53,10 +71,31 @@ namespace ofxRulr {
 						ofParameter<int> maxPortalsPerMessage{ "Max portals per message", 64 };
 						PARAM_DECLARE("OSC", port, maxPortalsPerMessage);
 					} osc;
-					PARAM_DECLARE("Router", hostname, rest, osc);
+
+					struct : ofParameterGroup {
+						ofParameter<Utils::Reworld::AxisTransmitFormat> format{ "Format", Utils::Reworld::AxisTransmitFormat::OSC };
+						ofParameter<bool> bundles{ "Bundles", false };
+						ofParameter<int> maxPacketSize{ "Max packet size", 1472 };
+						ofParameter<float> maxRate{ "Max rate [Hz]", 60, 0, 1000 };
+						ofParameter<int> stepsPerRevolution{ "Steps per revolution", 65536 };
+						PARAM_DECLARE("Transmit", format, bundles, maxPacketSize, maxRate, stepsPerRevolution);
+					} transmit;
+					PARAM_DECLARE("Router", hostname, rest, osc, transmit);
 				} parameters;
 
-				shared_ptr<ofxOscSender> oscSender;
+				Utils::Reworld::AxisTransmitter transmitter;
+				Utils::HttpClient httpClient;
+
+				struct {
+					string hostname;
+					int port = 0;
+					Utils::Reworld::AxisTransmitFormat format;
+					int maxPortalsPerMessage = 0;
+					bool bundles = true;
+					int maxPacketSize = 0;
+					float maxRate = 0.0f;
+					int stepsPerRevolution = 0;
+				} cachedTransmitSettings;
 			};
 		}
 	}
@@ -0,0 +1,162 @@
+#include "pch_Plugin_Reworld.h"
+#include "SolverBenchmark.h"
+#include "ofxRulr/Solvers/Reworld/Navigate/PointToPoint.h"
+#include "ofxRulr/Solvers/Reworld/Navigate/Batch.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Reworld {
+			//----------
+			SolverBenchmark::SolverBenchmark()
+			{
+				RULR_NODE_INIT_LISTENER;
+			}
+
+			//----------
+			string
+				SolverBenchmark::getTypeName() const
+			{
+				return "Reworld::SolverBenchmark";
+			}
+
+			//----------
+			void
+				SolverBenchmark::init()
+			{
+				this->manageParameters(this->parameters);
+			}
+
+			//----------
+			void
+				SolverBenchmark::runTrial(size_t trial)
+			{
+				const auto columns = max(this->parameters.modules.columns.get(), 1);
+				const auto rows = max(this->parameters.modules.rows.get(), 1);
+				const auto pitch = this->parameters.modules.pitch.get();
+				const auto positionOffset = this->parameters.modules.positionOffset.get();
+				const auto rotationOffset = this->parameters.modules.rotationOffset.get();
+
+				// Light behind the lenses (light travels +z to -z)
+				const glm::vec3 point1{ 0, 0, this->parameters.scene.lightDistance.get() };
+				const auto targetDistance = this->parameters.scene.targetDistance.get();
+
+				// Ground truth
+				vector<Models::Reworld::Module<float>> modules;
+				vector<glm::vec3> targets;
+				for (int j = 0; j < rows; j++) {
+					for (int i = 0; i < columns; i++) {
+						Models::Reworld::Module<float> module;
+						module.bulkTransform = glm::translate(glm::vec3(
+							((float)i - (float)(columns - 1) / 2.0f) * pitch
+							, ((float)j - (float)(rows - 1) / 2.0f) * pitch
+							, 0.0f));
+						module.transformOffset.translation = glm::vec3(ofRandomf(), ofRandomf(), ofRandomf()) * positionOffset;
+						module.transformOffset.rotationVector = glm::vec3(ofRandomf(), ofRandomf(), ofRandomf()) * rotationOffset;
+						module.axisAngleOffsets.A = ofRandom(1.0f);
+						module.axisAngleOffsets.B = ofRandom(1.0f);
+						module.installationParameters.interPrismDistance = 0.0188f;
+						module.installationParameters.prismAngleRadians = 30.0f * DEG_TO_RAD;
+						module.installationParameters.ior = 1.491f;
+
+						Models::Reworld::AxisAngles<float> axisAngles{
+							ofRandom(1.0f)
+							, ofRandom(1.0f)
+						};
+
+						ofxCeres::Models::Ray<float> incomingRay;
+						incomingRay.s = point1;
+						incomingRay.t = glm::normalize(module.getPosition() - point1);
+						auto outputRay = module.refract(incomingRay, axisAngles).outputRay;
+
+						modules.push_back(module);
+						targets.push_back(outputRay.s + glm::normalize(outputRay.t) * targetDistance);
+					}
+				}
+
+				auto solverSettings = Solvers::Reworld::Navigate::PointToPoint::defaultSolverSettings();
+				solverSettings.printReport = false;
+
+				this->benchmark.measure("Reworld::Navigate::PointToPoint", "Modules", modules.size(), trial, [&](Utils::SolverBenchmark::Record& record) {
+					record.converged = true;
+					for (size_t i = 0; i < modules.size(); i++) {
+						auto result = Solvers::Reworld::Navigate::PointToPoint::solve(modules[i]
+							, { 0, 0 }
+							, point1
+							, targets[i]
+							, solverSettings);
+						record.addIterations(result.iterations);
+						record.converged &= result.isConverged();
+						record.residual += result.residual;
+						record.parameterError += SolverBenchmark::getPointingError(modules[i]
+							, result.solution.axisAngles
+							, point1
+							, targets[i]);
+					}
+					record.residual /= (float)modules.size();
+					record.parameterError /= (float)modules.size();
+					});
+
+				// The same modules navigated in parallel, then with lookup tables (built on the first run, reused on the second)
+				{
+					vector<Solvers::Reworld::Navigate::Batch::Task> tasks;
+					for (size_t i = 0; i < modules.size(); i++) {
+						Solvers::Reworld::Navigate::Batch::Task task;
+						task.module = modules[i];
+						task.initialAxisAngles = { 0, 0 };
+						task.point1 = point1;
+						task.point2 = targets[i];
+						tasks.push_back(task);
+					}
+
+					Solvers::Reworld::Navigate::Batch::Settings settings;
+					settings.solverSettings = solverSettings;
+
+					auto measureBatch = [&](const string& solverName) {
+						this->benchmark.measure(solverName, "Modules", modules.size(), trial, [&](Utils::SolverBenchmark::Record& record) {
+							auto results = Solvers::Reworld::Navigate::Batch::solve(tasks, settings);
+
+							record.converged = true;
+							for (size_t i = 0; i < modules.size(); i++) {
+								record.addIterations(results[i].iterations);
+								record.converged &= results[i].success;
+								record.residual += results[i].residual;
+								record.parameterError += SolverBenchmark::getPointingError(modules[i]
+									, results[i].axisAngles
+									, point1
+									, targets[i]);
+							}
+							record.residual /= (float)modules.size();
+							record.parameterError /= (float)modules.size();
+							});
+					};
+
+					measureBatch("Reworld::Navigate::Batch");
+
+					for (auto& task : tasks) {
+						task.lookupTable = make_shared<Solvers::Reworld::Navigate::LookupTable>();
+					}
+					settings.lookupTableTolerance = 0.005f;
+					measureBatch("Reworld::Navigate::Batch (build lookup table)");
+					measureBatch("Reworld::Navigate::Batch (lookup table)");
+				}
+			}
+
+			//----------
+			float
+				SolverBenchmark::getPointingError(const Models::Reworld::Module<float>& module
+					, const Models::Reworld::AxisAngles<float>& axisAngles
+					, const glm::vec3& point1
+					, const glm::vec3& point2)
+			{
+				ofxCeres::Models::Ray<float> incomingRay;
+				incomingRay.s = point1;
+				incomingRay.t = glm::normalize(module.getPosition() - point1);
+				auto outputRay = module.refract(incomingRay, axisAngles).outputRay;
+
+				auto desired = glm::normalize(point2 - outputRay.s);
+				auto actual = glm::normalize(outputRay.t);
+				return acos(ofClamp(glm::dot(desired, actual), -1.0f, 1.0f)) * RAD_TO_DEG;
+			}
+		}
+	}
+}
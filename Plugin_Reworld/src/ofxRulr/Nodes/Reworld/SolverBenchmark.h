@@ -0,0 +1,48 @@
+#pragma once
+
+#include "ofxRulr.h"
+#include "ofxRulr/Nodes/Test/AbstractSolverBenchmark.h"
+#include "ofxRulr/Models/Reworld/Module.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace Reworld {
+			// Navigates a synthetic array of modules (known module parameters and axis angles)
+			// and records time and pointing error against the known targets
+			class SolverBenchmark : public Test::AbstractSolverBenchmark
+			{
+			public:
+				SolverBenchmark();
+				string getTypeName() const override;
+				void init();
+			protected:
+				void runTrial(size_t trial) override;
+
+				// Angle [degrees] between the beam leaving the module and the direction to the target
+				static float getPointingError(const Models::Reworld::Module<float>&
+					, const Models::Reworld::AxisAngles<float>&
+					, const glm::vec3& point1
+					, const glm::vec3& point2);
+
+				struct : ofParameterGroup {
+					struct : ofParameterGroup {
+						ofParameter<int> columns{ "Columns", 10 };
+						ofParameter<int> rows{ "Rows", 10 };
+						ofParameter<float> pitch{ "Pitch", 0.1, 0.01, 1 };
+						ofParameter<float> positionOffset{ "Position offset", 0.005, 0, 0.1 };
+						ofParameter<float> rotationOffset{ "Rotation offset", 0.02, 0, 1 };
+						PARAM_DECLARE("Modules", columns, rows, pitch, positionOffset, rotationOffset);
+					} modules;
+
+					struct : ofParameterGroup {
+						ofParameter<float> lightDistance{ "Light distance", 2, 0.1, 100 };
+						ofParameter<float> targetDistance{ "Target distance", 5, 0.1, 100 };
+						PARAM_DECLARE("Scene", lightDistance, targetDistance);
+					} scene;
+
+					PARAM_DECLARE("SolverBenchmark", modules, scene);
+				} parameters;
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "pch_Plugin_Reworld.h"
 #include "ModulesFromProjections.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 struct ProjectionFromModuleCost {
 	//----------
@@ -358,7 +359,8 @@ namespace ofxRulr {
 							cout << "Solve ModuleFromProjections" << endl;
 						}
 
-						ceres::Solve(solverSettings.options
+						Utils::solveCeres("Reworld::Calibrate::ModulesFromProjections"
+							, solverSettings.options
 							, &this->problem
 							, &summary);
 
@@ -0,0 +1,114 @@
+#include "pch_Plugin_Reworld.h"
+#include "Batch.h"
+#include "ofxRulr/Utils/SolverRuntime.h"
+
+namespace ofxRulr {
+	namespace Solvers {
+		namespace Reworld {
+			namespace Navigate {
+				//---------
+				vector<Batch::Result>
+					Batch::solve(const vector<Task>& tasks, const Settings& settings)
+				{
+					vector<Result> results(tasks.size());
+					if (tasks.empty()) {
+						return results;
+					}
+
+					// Each solve is small, so we parallelise over modules rather than within the solve
+					auto taskSettings = settings;
+					taskSettings.solverSettings.options.num_threads = 1;
+
+					auto threadLease = Utils::SolverRuntime::X().acquireThreads(settings.threadCount);
+					auto threadCount = min(threadLease->getThreadCount(), tasks.size());
+
+					// Workers take the next task from a shared counter (solve times vary a lot between modules)
+					atomic<size_t> nextTask{ 0 };
+					auto worker = [&]() {
+						for (auto i = nextTask++; i < tasks.size(); i = nextTask++) {
+							try {
+								results[i] = Batch::solveTask(tasks[i], taskSettings);
+							}
+							catch (const std::exception& e) {
+								results[i].success = false;
+								results[i].errorMessage = e.what();
+							}
+						}
+					};
+
+					if (threadCount <= 1) {
+						worker();
+						return results;
+					}
+
+					vector<future<void>> workers;
+					for (size_t i = 0; i < threadCount; i++) {
+						workers.push_back(std::async(std::launch::async, worker));
+					}
+					for (auto& worker : workers) {
+						worker.get();
+					}
+
+					return results;
+				}
+
+				//---------
+				float
+					Batch::getResidual(const Models::Reworld::Module<float>& module
+						, const Models::Reworld::AxisAngles<float>& axisAngles
+						, const glm::vec3& point1
+						, const glm::vec3& point2)
+				{
+					ofxCeres::Models::Ray<float> incomingRay;
+					incomingRay.s = point1;
+					incomingRay.t = glm::normalize(module.getPosition() - point1);
+					auto outputRay = module.refract(incomingRay, axisAngles).outputRay;
+					return glm::distance(point2, outputRay.closestPointOnRayTo(point2));
+				}
+
+				//---------
+				Batch::Result
+					Batch::solveTask(const Task& task, const Settings& settings)
+				{
+					Result result;
+
+					auto initialAxisAngles = task.initialAxisAngles;
+
+					if (task.lookupTable) {
+						auto inVector = glm::normalize(task.module.getPosition() - task.point1);
+						if (!task.lookupTable->isBuiltFor(task.module, inVector, settings.lookupTableResolution)) {
+							task.lookupTable->build(task.module, inVector, settings.lookupTableResolution);
+						}
+
+						auto lookupAxisAngles = task.lookupTable->lookup(task.point2 - task.module.getPosition());
+						auto lookupResidual = Batch::getResidual(task.module, lookupAxisAngles, task.point1, task.point2);
+
+						if (lookupResidual <= settings.lookupTableTolerance) {
+							result.axisAngles = lookupAxisAngles;
+							result.residual = lookupResidual;
+							result.success = true;
+							result.source = Source::LookupTable;
+							return result;
+						}
+
+						initialAxisAngles = lookupAxisAngles;
+					}
+
+					auto solveResult = PointToPoint::solve(task.module
+						, initialAxisAngles
+						, task.point1
+						, task.point2
+						, settings.solverSettings);
+
+					result.axisAngles = solveResult.solution.axisAngles;
+					result.residual = Batch::getResidual(task.module, result.axisAngles, task.point1, task.point2);
+					result.success = !solveResult.isError;
+					result.errorMessage = solveResult.errorMessage;
+					result.source = Source::Solve;
+					result.iterations = solveResult.iterations;
+					return result;
+				}
+			}
+		}
+	}
+}
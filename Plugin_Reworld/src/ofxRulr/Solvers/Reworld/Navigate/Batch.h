@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ofxRulr/Models/Reworld/Module.h"
+#include "LookupTable.h"
+#include "PointToPoint.h"
+
+namespace ofxRulr {
+	namespace Solvers {
+		namespace Reworld {
+			namespace Navigate {
+				// Point to point navigation of many modules at once, split across worker threads.
+				// If a lookup table is given for a task, the table's answer is used as the initial guess,
+				// or as the final answer if it lands within the tolerance of the target.
+				class Batch {
+				public:
+					struct Task {
+						Models::Reworld::Module<float> module;
+						Models::Reworld::AxisAngles<float> initialAxisAngles;
+						glm::vec3 point1;
+						glm::vec3 point2;
+
+						// Optional. (Re)built by solve if it doesn't match the module and incoming direction.
+						// Each task must have its own table.
+						shared_ptr<LookupTable> lookupTable;
+					};
+
+					enum class Source {
+						Solve,
+						LookupTable
+					};
+
+					struct Result {
+						Models::Reworld::AxisAngles<float> axisAngles;
+						float residual = 0.0f; // [m] distance between point2 and the output ray
+						bool success = false;
+						Source source = Source::Solve;
+						int iterations = 0; // of the solve (0 if answered by the lookup table)
+						string errorMessage;
+					};
+
+					struct Settings {
+						ofxCeres::SolverSettings solverSettings = PointToPoint::defaultSolverSettings();
+						size_t threadCount = 0; // 0 = as many as the SolverRuntime's thread budget allows
+						size_t lookupTableResolution = 64;
+						float lookupTableTolerance = 0.0f; // [m] accept the table's answer without solving (0 = always solve)
+					};
+
+					static vector<Result> solve(const vector<Task>&, const Settings&);
+
+					// Distance [m] between point2 and the output ray of the module at these axis angles
+					static float getResidual(const Models::Reworld::Module<float>&
+						, const Models::Reworld::AxisAngles<float>&
+						, const glm::vec3& point1
+						, const glm::vec3& point2);
+				protected:
+					static Result solveTask(const Task&, const Settings&);
+				};
+			}
+		}
+	}
+}
\ No newline at end of file
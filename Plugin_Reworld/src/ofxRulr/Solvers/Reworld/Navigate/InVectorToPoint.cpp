@@ -1,6 +1,7 @@
 #include "pch_Plugin_Reworld.h"
 #include "InVectorToPoint.h"
 #include "ofxCeres.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 struct NavigateInVectorToPointCost
 {
@@ -97,7 +98,8 @@ namespace ofxRulr {
 
 					ceres::Solver::Summary summary;
 					{
-						ceres::Solve(solverSettings.options
+						Utils::solveCeres("Reworld::Navigate::InVectorToPoint"
+							, solverSettings.options
 							, &problem
 							, &summary);
 
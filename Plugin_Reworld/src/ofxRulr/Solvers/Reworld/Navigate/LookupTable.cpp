@@ -0,0 +1,150 @@
+#include "pch_Plugin_Reworld.h"
+#include "LookupTable.h"
+
+namespace ofxRulr {
+	namespace Solvers {
+		namespace Reworld {
+			namespace Navigate {
+				//---------
+				static bool
+					modulesMatch(const Models::Reworld::Module<float>& a, const Models::Reworld::Module<float>& b)
+				{
+					return a.bulkTransform == b.bulkTransform
+						&& a.transformOffset.translation == b.transformOffset.translation
+						&& a.transformOffset.rotationVector == b.transformOffset.rotationVector
+						&& a.axisAngleOffsets.A == b.axisAngleOffsets.A
+						&& a.axisAngleOffsets.B == b.axisAngleOffsets.B
+						&& a.installationParameters.interPrismDistance == b.installationParameters.interPrismDistance
+						&& a.installationParameters.prismAngleRadians == b.installationParameters.prismAngleRadians
+						&& a.installationParameters.ior == b.installationParameters.ior;
+				}
+
+				//---------
+				void
+					LookupTable::build(const Models::Reworld::Module<float>& module
+						, const glm::vec3& inVector
+						, size_t resolution)
+				{
+					this->module = module;
+					this->inVector = inVector;
+					this->resolution = resolution;
+					this->outVectors.resize(resolution * resolution);
+
+					ofxCeres::Models::Ray<float> incomingRay;
+					incomingRay.s = module.getPosition() - inVector;
+					incomingRay.t = inVector;
+
+					for (size_t b = 0; b < resolution; b++) {
+						for (size_t a = 0; a < resolution; a++) {
+							Models::Reworld::AxisAngles<float> axisAngles{
+								(float)a / (float)resolution
+								, (float)b / (float)resolution
+							};
+							auto outputRay = module.refract(incomingRay, axisAngles).outputRay;
+							this->outVectors[b * resolution + a] = glm::normalize(outputRay.t);
+						}
+					}
+				}
+
+				//---------
+				bool
+					LookupTable::isBuiltFor(const Models::Reworld::Module<float>& module
+						, const glm::vec3& inVector
+						, size_t resolution) const
+				{
+					return this->resolution == resolution
+						&& !this->outVectors.empty()
+						&& this->inVector == inVector
+						&& modulesMatch(this->module, module);
+				}
+
+				//---------
+				bool
+					LookupTable::empty() const
+				{
+					return this->outVectors.empty();
+				}
+
+				//---------
+				size_t
+					LookupTable::getResolution() const
+				{
+					return this->resolution;
+				}
+
+				//---------
+				Models::Reworld::AxisAngles<float>
+					LookupTable::lookup(const glm::vec3& outVector) const
+				{
+					if (this->outVectors.empty()) {
+						throw(ofxRulr::Exception("LookupTable::lookup : table has not been built"));
+					}
+
+					const auto desired = glm::normalize(outVector);
+
+					// Closest sample
+					size_t bestIndex = 0;
+					{
+						float bestDot = -2.0f;
+						for (size_t i = 0; i < this->outVectors.size(); i++) {
+							auto dot = glm::dot(this->outVectors[i], desired);
+							if (dot > bestDot) {
+								bestDot = dot;
+								bestIndex = i;
+							}
+						}
+					}
+
+					const auto resolution = (int)this->resolution;
+					const int a = (int)bestIndex % resolution;
+					const int b = (int)bestIndex / resolution;
+					const auto step = 1.0f / (float)resolution;
+
+					Models::Reworld::AxisAngles<float> axisAngles{
+						(float)a * step
+						, (float)b * step
+					};
+
+					// Refine with a linear fit to the neighbouring samples (central differences)
+					{
+						auto dA = (this->getSample(a + 1, b) - this->getSample(a - 1, b)) / (2.0f * step);
+						auto dB = (this->getSample(a, b + 1) - this->getSample(a, b - 1)) / (2.0f * step);
+						auto error = desired - this->getSample(a, b);
+
+						// Normal equations of the 3x2 system
+						auto jAA = glm::dot(dA, dA);
+						auto jAB = glm::dot(dA, dB);
+						auto jBB = glm::dot(dB, dB);
+						auto det = jAA * jBB - jAB * jAB;
+
+						// Skip near the singularities (e.g. the see-through position)
+						if (det > 1e-9f) {
+							auto eA = glm::dot(dA, error);
+							auto eB = glm::dot(dB, error);
+							auto deltaA = (jBB * eA - jAB * eB) / det;
+							auto deltaB = (jAA * eB - jAB * eA) / det;
+
+							// Only trust the fit within one cell
+							axisAngles.A += ofClamp(deltaA, -step, step);
+							axisAngles.B += ofClamp(deltaB, -step, step);
+						}
+					}
+
+					// Same cycle convention as the solvers
+					return Models::Reworld::findClosestCycleValue(Models::Reworld::AxisAngles<float>{ 0, 0 }
+						, axisAngles);
+				}
+
+				//---------
+				const glm::vec3&
+					LookupTable::getSample(int a, int b) const
+				{
+					const auto resolution = (int)this->resolution;
+					a = ((a % resolution) + resolution) % resolution;
+					b = ((b % resolution) + resolution) % resolution;
+					return this->outVectors[b * resolution + a];
+				}
+			}
+		}
+	}
+}
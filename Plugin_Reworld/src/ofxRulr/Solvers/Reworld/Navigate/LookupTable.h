@@ -0,0 +1,40 @@
+#pragma once
+
+#include "ofxRulr/Models/Reworld/Module.h"
+
+namespace ofxRulr {
+	namespace Solvers {
+		namespace Reworld {
+			namespace Navigate {
+				// Output directions of one module sampled over a grid of axis angles (for one incoming direction).
+				// The inverse lookup finds the sample closest to a desired output direction and refines it with
+				// a linear fit to the neighbouring samples. The table must be rebuilt if the module's
+				// calibration or the incoming direction change (see isBuiltFor).
+				class LookupTable {
+				public:
+					void build(const Models::Reworld::Module<float>& module
+						, const glm::vec3& inVector
+						, size_t resolution = 64);
+
+					bool isBuiltFor(const Models::Reworld::Module<float>& module
+						, const glm::vec3& inVector
+						, size_t resolution) const;
+
+					bool empty() const;
+					size_t getResolution() const;
+
+					Models::Reworld::AxisAngles<float> lookup(const glm::vec3& outVector) const;
+				protected:
+					const glm::vec3& getSample(int a, int b) const; // wraps the cyclic axis angles
+
+					Models::Reworld::Module<float> module;
+					glm::vec3 inVector;
+					size_t resolution = 0;
+
+					// Normalised output direction at (A, B) = (a, b) / resolution, stored [b * resolution + a]
+					vector<glm::vec3> outVectors;
+				};
+			}
+		}
+	}
+}
\ No newline at end of file
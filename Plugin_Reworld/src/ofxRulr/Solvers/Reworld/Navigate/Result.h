@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ofxRulr/Models/Reworld/Module.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 namespace ofxRulr {
 	namespace Solvers {
@@ -9,7 +10,7 @@ namespace ofxRulr {
 				struct Solution {
 					Models::Reworld::AxisAngles<float> axisAngles;
 				};
-				typedef ofxCeres::Result<Solution> Result;
+				typedef Utils::SolveResult<Solution> Result;
 			}
 
 		}
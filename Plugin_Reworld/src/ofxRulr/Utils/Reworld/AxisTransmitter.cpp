@@ -0,0 +1,463 @@
+#include "pch_Plugin_Reworld.h"
+#include "AxisTransmitter.h"
+
+#include "ofxOscSender.h"
+#include "ofxOscBundle.h"
+#include "UdpSocket.h"
+
+namespace ofxRulr {
+	namespace Utils {
+		namespace Reworld {
+			const uint16_t binaryVersion = 1;
+			const size_t binaryHeaderSize = 4 + 2 + 2 + 4 + 2 + 2 + 4;
+			const size_t binaryEntrySize = 2 + 1 + 1 + 4 + 4;
+			const size_t portalsPerColumn = 256; // portal is a uint8
+			const int32_t notSent = numeric_limits<int32_t>::min();
+
+			//----------
+			template<typename T>
+			static void writeValue(uint8_t*& cursor, const T& value) {
+				memcpy(cursor, &value, sizeof(T));
+				cursor += sizeof(T);
+			}
+
+			//----------
+			static int32_t quantize(float value, uint32_t stepsPerRevolution) {
+				return (int32_t)std::round((double)value * (double)stepsPerRevolution);
+			}
+
+			//----------
+			// Size of an OSC message with this address and argument count (all 4-byte arguments)
+			static size_t getOSCMessageSize(const string& address, size_t argumentCount) {
+				auto pad4 = [](size_t size) {
+					return (size + 3) & ~(size_t)3;
+				};
+				return pad4(address.size() + 1) // address + null
+					+ pad4(argumentCount + 2) // ',' + type tags + null
+					+ 4 * argumentCount;
+			}
+
+#pragma mark Column
+			//----------
+			AxisTransmitter::Column::Column()
+				: requested(portalsPerColumn * 2, 0.0f)
+				, queued(portalsPerColumn * 2, notSent)
+				, pending(portalsPerColumn, 0)
+			{
+
+			}
+
+#pragma mark AxisTransmitter
+			//----------
+			AxisTransmitter::AxisTransmitter() {
+				this->thread = std::thread([this]() {
+					this->threadedFunction();
+				});
+			}
+
+			//----------
+			AxisTransmitter::~AxisTransmitter() {
+				{
+					auto lock = unique_lock<mutex>(this->pendingMutex);
+					this->closing = true;
+				}
+				this->pendingCondition.notify_all();
+				if (this->thread.joinable()) {
+					this->thread.join();
+				}
+			}
+
+			//----------
+			void AxisTransmitter::setSettings(const Settings& settings) {
+				{
+					auto lock = unique_lock<mutex>(this->pendingMutex);
+					this->settings = settings;
+					this->settingsChanged = true;
+
+					// Resend everything we've sent or are sending (e.g. the router or the quantization changed)
+					for (size_t columnIndex = 0; columnIndex < this->columns.size(); columnIndex++) {
+						auto& column = this->columns[columnIndex];
+						for (size_t portal = 0; portal < portalsPerColumn; portal++) {
+							if (column.queued[portal * 2] != notSent && column.pending[portal] == 0) {
+								column.pending[portal] = 2;
+								column.pendingCount++;
+								this->pendingCount++;
+							}
+						}
+					}
+				}
+				this->pendingCondition.notify_one();
+			}
+
+			//----------
+			AxisTransmitter::Settings AxisTransmitter::getSettings() const {
+				auto lock = unique_lock<mutex>(this->pendingMutex);
+				return this->settings;
+			}
+
+			//----------
+			void AxisTransmitter::setAxisAngles(int columnIndex
+				, uint8_t portal
+				, const Models::Reworld::AxisAngles<float>& axisAngles
+				, bool force) {
+				if (columnIndex < 0 || columnIndex > numeric_limits<uint16_t>::max()) {
+					throw(ofxRulr::Exception("AxisTransmitter : column index " + ofToString(columnIndex) + " is out of range"));
+				}
+
+				bool skipped = false;
+				bool coalesced = false;
+				bool notify = false;
+				{
+					auto lock = unique_lock<mutex>(this->pendingMutex);
+					if (columnIndex >= this->columns.size()) {
+						this->columns.resize(columnIndex + 1);
+					}
+					auto& column = this->columns[columnIndex];
+					auto& pending = column.pending[portal];
+
+					column.requested[portal * 2 + 0] = axisAngles.A;
+					column.requested[portal * 2 + 1] = axisAngles.B;
+
+					// Compare against the value in flight (not only what has been confirmed sent), otherwise moving back
+					// to the previously sent value whilst a send is in flight would be skipped
+					auto changed = quantize(axisAngles.A, this->settings.stepsPerRevolution) != column.queued[portal * 2 + 0]
+						|| quantize(axisAngles.B, this->settings.stepsPerRevolution) != column.queued[portal * 2 + 1];
+
+					if (force || changed) {
+						if (pending == 0) {
+							column.pendingCount++;
+							this->pendingCount++;
+							notify = true;
+						}
+						else {
+							coalesced = true;
+						}
+						pending = max<uint8_t>(pending, force ? 2 : 1);
+					}
+					else if (pending == 1) {
+						// Moved back to the value which was last queued
+						pending = 0;
+						column.pendingCount--;
+						this->pendingCount--;
+						coalesced = true;
+					}
+					else if (pending == 2) {
+						coalesced = true;
+					}
+					else {
+						skipped = true;
+					}
+				}
+
+				if (skipped || coalesced) {
+					auto lock = unique_lock<mutex>(this->statisticsMutex);
+					if (skipped) {
+						this->statistics.valuesSkipped++;
+					}
+					if (coalesced) {
+						this->statistics.valuesCoalesced++;
+					}
+				}
+
+				if (notify) {
+					this->pendingCondition.notify_one();
+				}
+			}
+
+			//----------
+			void AxisTransmitter::sendMessage(const string& oscAddress) {
+				{
+					auto lock = unique_lock<mutex>(this->pendingMutex);
+					this->pendingMessages.push_back(oscAddress);
+				}
+				this->pendingCondition.notify_one();
+			}
+
+			//----------
+			AxisTransmitter::Statistics AxisTransmitter::getStatistics() const {
+				auto lock = unique_lock<mutex>(this->statisticsMutex);
+				return this->statistics;
+			}
+
+			//----------
+			void AxisTransmitter::resetStatistics() {
+				auto lock = unique_lock<mutex>(this->statisticsMutex);
+				this->statistics = Statistics();
+			}
+
+			//----------
+			void AxisTransmitter::threadedFunction() {
+				Settings settings;
+				vector<string> messages;
+				vector<Entry> entries;
+				auto lastSendTime = chrono::steady_clock::now() - chrono::hours(1);
+
+				while (true) {
+					bool settingsChanged = false;
+
+					//wait for data and take it all
+					{
+						auto lock = unique_lock<mutex>(this->pendingMutex);
+						this->pendingCondition.wait(lock, [this]() {
+							return this->closing
+								|| this->pendingCount > 0
+								|| !this->pendingMessages.empty();
+						});
+
+						//rate limit (values keep coalescing whilst we wait)
+						if (this->settings.maxRate > 0.0f) {
+							auto nextSendTime = lastSendTime + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(1.0 / (double)this->settings.maxRate));
+							this->pendingCondition.wait_until(lock, nextSendTime, [this]() {
+								return this->closing;
+							});
+						}
+						if (this->closing) {
+							break;
+						}
+
+						if (this->settingsChanged) {
+							settings = this->settings;
+							settingsChanged = true;
+							this->settingsChanged = false;
+						}
+
+						swap(messages, this->pendingMessages);
+
+						entries.clear();
+						for (size_t columnIndex = 0; columnIndex < this->columns.size() && this->pendingCount > 0; columnIndex++) {
+							auto& column = this->columns[columnIndex];
+							if (column.pendingCount == 0) {
+								continue;
+							}
+							for (size_t portal = 0; portal < portalsPerColumn; portal++) {
+								if (column.pending[portal] == 0) {
+									continue;
+								}
+								Entry entry;
+								{
+									entry.column = (uint16_t)columnIndex;
+									entry.portal = (uint8_t)portal;
+									entry.A = quantize(column.requested[portal * 2 + 0], settings.stepsPerRevolution);
+									entry.B = quantize(column.requested[portal * 2 + 1], settings.stepsPerRevolution);
+								}
+								entries.push_back(entry);
+
+								column.queued[portal * 2 + 0] = entry.A;
+								column.queued[portal * 2 + 1] = entry.B;
+								column.pending[portal] = 0;
+							}
+							this->pendingCount -= column.pendingCount;
+							column.pendingCount = 0;
+						}
+					}
+
+					auto sendStartTime = chrono::steady_clock::now();
+					auto sendInterval = chrono::duration<float>(sendStartTime - lastSendTime).count();
+					lastSendTime = sendStartTime;
+
+					bool success = false;
+					try {
+						if (settingsChanged) {
+							this->rebuildSockets(settings);
+						}
+
+						switch (settings.format.get()) {
+						case AxisTransmitFormat::Binary:
+							this->sendOSC(messages, {}, settings);
+							this->sendBinary(entries, settings);
+							break;
+						case AxisTransmitFormat::OSC:
+						default:
+							this->sendOSC(messages, entries, settings);
+							break;
+						}
+						success = true;
+					}
+					catch (const std::exception& e) {
+						RULR_ERROR << "AxisTransmitter : " << e.what();
+					}
+					catch (...) {
+						RULR_ERROR << "AxisTransmitter : Unknown error";
+					}
+
+					// Queue the values again if the send failed
+					if (!entries.empty() && !success) {
+						auto lock = unique_lock<mutex>(this->pendingMutex);
+						for (const auto& entry : entries) {
+							auto& column = this->columns[entry.column];
+							if (column.pending[entry.portal] == 0) {
+								// Forced, since the requested value equals the value which failed
+								column.pending[entry.portal] = 2;
+								column.pendingCount++;
+								this->pendingCount++;
+							}
+						}
+
+						// Don't retry in a tight loop whilst the network is down
+						this->pendingCondition.wait_for(lock, chrono::milliseconds(100), [this]() {
+							return this->closing;
+						});
+					}
+
+					{
+						auto lock = unique_lock<mutex>(this->statisticsMutex);
+						if (success) {
+							this->statistics.valuesSent += entries.size();
+						}
+						this->statistics.lastSendDuration = chrono::duration<float, milli>(chrono::steady_clock::now() - sendStartTime).count();
+						if (sendInterval > 0.0f) {
+							this->statistics.sendRate = ofLerp(this->statistics.sendRate, 1.0f / sendInterval, 0.1f);
+						}
+					}
+
+					messages.clear();
+				}
+			}
+
+			//----------
+			void AxisTransmitter::rebuildSockets(const Settings& settings) {
+				this->oscSender.reset();
+				this->socket.reset();
+
+				// OSC is always needed for the text messages
+				this->oscSender = make_unique<ofxOscSender>();
+				this->oscSender->setup(settings.hostname, settings.port);
+
+				if (settings.format.get() == AxisTransmitFormat::Binary) {
+					this->socket = make_unique<UdpTransmitSocket>(IpEndpointName(settings.hostname.c_str(), settings.port));
+				}
+			}
+
+			//----------
+			void AxisTransmitter::sendOSC(const vector<string>& messages
+				, const vector<Entry>& entries
+				, const Settings& settings) {
+				if (!this->oscSender) {
+					return;
+				}
+
+				const string axesAddress = "/axesMoveByInidices";
+				const size_t bundleHeaderSize = 8 + 8; // "#bundle" + time tag
+
+				uint64_t messagesSent = 0;
+				uint64_t packetsSent = 0;
+				uint64_t bytesSent = 0;
+
+				ofxOscBundle bundle;
+				size_t bundleSize = bundleHeaderSize;
+				auto flush = [&]() {
+					if (bundle.getMessageCount() == 0) {
+						return;
+					}
+					this->oscSender->sendBundle(bundle);
+					messagesSent += bundle.getMessageCount();
+					packetsSent++;
+					bytesSent += bundleSize;
+					bundle.clear();
+					bundleSize = bundleHeaderSize;
+				};
+				auto add = [&](const ofxOscMessage& message, size_t messageSize) {
+					if (!settings.bundles) {
+						// Wrapped in its own bundle (ofxOsc's default), the framing which the Router has always received
+						this->oscSender->sendMessage(message);
+						messagesSent++;
+						packetsSent++;
+						bytesSent += bundleHeaderSize + 4 + messageSize;
+						return;
+					}
+					if (bundle.getMessageCount() > 0 && bundleSize + 4 + messageSize > settings.maxPacketSize) {
+						flush();
+					}
+					bundle.addMessage(message);
+					bundleSize += 4 + messageSize;
+				};
+
+				for (const auto& address : messages) {
+					ofxOscMessage message;
+					message.setAddress(address);
+					add(message, getOSCMessageSize(address, 0));
+				}
+
+				if (!entries.empty()) {
+					// Fit each message into a packet
+					auto maxPortalsPerMessage = max<size_t>(settings.maxPortalsPerMessage, 1);
+					while (maxPortalsPerMessage > 1
+						&& bundleHeaderSize + 4 + getOSCMessageSize(axesAddress, maxPortalsPerMessage * 4) > settings.maxPacketSize) {
+						maxPortalsPerMessage--;
+					}
+
+					const auto stepsPerRevolution = (float)settings.stepsPerRevolution;
+					for (size_t begin = 0; begin < entries.size(); begin += maxPortalsPerMessage) {
+						auto end = min(begin + maxPortalsPerMessage, entries.size());
+
+						ofxOscMessage message;
+						message.setAddress(axesAddress);
+						for (auto i = begin; i < end; i++) {
+							message.addIntArg(entries[i].column);
+							message.addIntArg(entries[i].portal);
+							message.addFloatArg((float)entries[i].A / stepsPerRevolution);
+							message.addFloatArg((float)entries[i].B / stepsPerRevolution);
+						}
+						add(message, getOSCMessageSize(axesAddress, (end - begin) * 4));
+					}
+				}
+
+				flush();
+
+				auto lock = unique_lock<mutex>(this->statisticsMutex);
+				this->statistics.messagesSent += messagesSent;
+				this->statistics.packetsSent += packetsSent;
+				this->statistics.bytesSent += bytesSent;
+			}
+
+			//----------
+			void AxisTransmitter::sendBinary(const vector<Entry>& entries, const Settings& settings) {
+				if (!this->socket || entries.empty()) {
+					return;
+				}
+
+				const size_t packetSize = max(settings.maxPacketSize, binaryHeaderSize + binaryEntrySize);
+				const size_t entriesPerPacket = (packetSize - binaryHeaderSize) / binaryEntrySize;
+				const auto packetCount = (uint16_t)((entries.size() + entriesPerPacket - 1) / entriesPerPacket);
+				const auto sequence = this->sequence++;
+
+				this->packetBuffer.resize(packetSize);
+
+				uint64_t bytesSent = 0;
+				for (uint16_t packetIndex = 0; packetIndex < packetCount; packetIndex++) {
+					auto entryBegin = packetIndex * entriesPerPacket;
+					auto entryEnd = min(entryBegin + entriesPerPacket, entries.size());
+
+					auto cursor = this->packetBuffer.data();
+					{
+						const char magic[4] = { 'R', 'W', 'A', 'X' };
+						memcpy(cursor, magic, 4);
+						cursor += 4;
+						writeValue(cursor, binaryVersion);
+						writeValue(cursor, (uint16_t)(entryEnd - entryBegin));
+						writeValue(cursor, sequence);
+						writeValue(cursor, packetIndex);
+						writeValue(cursor, packetCount);
+						writeValue(cursor, settings.stepsPerRevolution);
+					}
+
+					for (auto i = entryBegin; i < entryEnd; i++) {
+						writeValue(cursor, entries[i].column);
+						writeValue(cursor, entries[i].portal);
+						writeValue(cursor, (uint8_t)0);
+						writeValue(cursor, entries[i].A);
+						writeValue(cursor, entries[i].B);
+					}
+
+					auto size = (size_t)(cursor - this->packetBuffer.data());
+					this->socket->Send((const char*)this->packetBuffer.data(), size);
+					bytesSent += size;
+				}
+
+				auto lock = unique_lock<mutex>(this->statisticsMutex);
+				this->statistics.packetsSent += packetCount;
+				this->statistics.bytesSent += bytesSent;
+			}
+		}
+	}
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "ofxRulr.h"
+#include "ofxRulr/Models/Reworld/AxisAngles.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+class ofxOscSender;
+class UdpTransmitSocket;
+
+namespace ofxRulr {
+	namespace Utils {
+		namespace Reworld {
+			MAKE_ENUM(AxisTransmitFormat
+				, (OSC, Binary)
+				, ("OSC", "Binary"));
+
+			//Sends module axis angles to the Router from a dedicated thread, so that the GUI thread which calls
+			//setAxisAngles() never waits on the network.
+			//
+			//Values are held in a flat buffer per column, quantized to stepsPerRevolution. Only values which have
+			//changed (after quantization) since they were last queued for sending go out, unless forced. Values set several times
+			//between sends are coalesced (latest wins), and sends are limited to maxRate.
+			//
+			//OSC format : /axesMoveByInidices messages (int column, int portal, float A, float B repeating).
+			//Messages are always framed in bundles, as ofxOscSender::sendMessage does by default (the Router expects this).
+			//If bundles is set, several messages are packed into each bundle up to maxPacketSize, otherwise each
+			//message has its own bundle and packet.
+			//
+			//Binary format (little endian), split into as many datagrams as needed to fit maxPacketSize:
+			//	Header	: char[4] "RWAX", uint16 version, uint16 entryCount, uint32 sequence, uint16 packetIndex, uint16 packetCount, uint32 stepsPerRevolution
+			//	Entry	: uint16 column, uint8 portal, uint8 reserved, int32 A, int32 B (in steps)
+			//
+			//Text messages (e.g. /home) are always sent as OSC, before the axis values of the same send.
+			class AxisTransmitter {
+			public:
+				struct Settings {
+					string hostname = "localhost";
+					int port = 4000;
+					AxisTransmitFormat format = AxisTransmitFormat::OSC;
+					size_t maxPortalsPerMessage = 64;
+					bool bundles = false; // OSC only. Pack several messages per bundle, otherwise one message per bundle
+					size_t maxPacketSize = 1472; // Ethernet MTU - IP and UDP headers
+					float maxRate = 60.0f; // [Hz]
+					uint32_t stepsPerRevolution = 65536;
+				};
+
+				struct Statistics {
+					uint64_t valuesSent = 0;
+					uint64_t valuesSkipped = 0; // unchanged after quantization
+					uint64_t valuesCoalesced = 0; // overwritten before being sent
+					uint64_t messagesSent = 0;
+					uint64_t packetsSent = 0;
+					uint64_t bytesSent = 0;
+					float lastSendDuration = 0.0f; // [ms]
+					float sendRate = 0.0f; // [Hz]
+				};
+
+				AxisTransmitter();
+				~AxisTransmitter();
+
+				void setSettings(const Settings&);
+				Settings getSettings() const;
+
+				//Thread safe, doesn't block on sending
+				void setAxisAngles(int column, uint8_t portal, const Models::Reworld::AxisAngles<float>&, bool force);
+				void sendMessage(const string& oscAddress);
+
+				Statistics getStatistics() const;
+				void resetStatistics();
+			protected:
+				struct Entry {
+					uint16_t column;
+					uint8_t portal;
+					int32_t A;
+					int32_t B;
+				};
+
+				//Flat buffer for one column (A, B interleaved, indexed by portal)
+				struct Column {
+					Column();
+					vector<float> requested;
+					vector<int32_t> queued; // quantized, last value taken by the sending thread (in flight or sent)
+					vector<uint8_t> pending; // 0 = none, 1 = changed, 2 = forced
+					size_t pendingCount = 0;
+				};
+
+				void threadedFunction();
+				void rebuildSockets(const Settings&);
+				void sendOSC(const vector<string>& messages, const vector<Entry>&, const Settings&);
+				void sendBinary(const vector<Entry>&, const Settings&);
+
+				Settings settings;
+				bool settingsChanged = true;
+
+				vector<Column> columns;
+				size_t pendingCount = 0;
+				vector<string> pendingMessages;
+				bool closing = false;
+				mutable mutex pendingMutex;
+				condition_variable pendingCondition;
+
+				//owned by the sending thread
+				unique_ptr<ofxOscSender> oscSender;
+				unique_ptr<UdpTransmitSocket> socket;
+				vector<uint8_t> packetBuffer;
+				uint32_t sequence = 0;
+
+				Statistics statistics;
+				mutable mutex statisticsMutex;
+
+				std::thread thread;
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "ofxRulr/Nodes/Reworld/CalibrateController.h"
 #include "ofxRulr/Nodes/Reworld/CaptureView.h"
 #include "ofxRulr/Nodes/Reworld/OSCReceiver.h"
+#include "ofxRulr/Nodes/Reworld/SolverBenchmark.h"
 
 
 OFXPLUGIN_PLUGIN_MODULES_BEGIN(ofxRulr::Nodes::Base)
@@ -26,4 +27,5 @@ OFXPLUGIN_PLUGIN_MODULES_BEGIN(ofxRulr::Nodes::Base)
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::Reworld::CalibrateController);
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::Reworld::CaptureView);
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::Reworld::OSCReceiver);
+	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::Reworld::SolverBenchmark);
 OFXPLUGIN_PLUGIN_MODULES_END
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "FleetCommand.h"
+
+#include "OscOutboundPacketStream.h"
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace ofxRulr {
+	namespace Data {
+		namespace AnotherMoon {
+#pragma mark EncodedMessage
+			//----------
+			// Written as the index whilst encoding, so we can check that we patch the right bytes
+			static const osc::int64 indexPlaceholder = 0x7ead5a7e0ddba115;
+
+			//----------
+			EncodedMessage::EncodedMessage(const ofxOscMessage& message)
+				: address(message.getAddress())
+			{
+				this->indexOffset = EncodedMessage::encode(message, this->packet);
+			}
+
+			//----------
+			EncodedMessage::EncodedMessage(const Message::Address& address, const string& packet, size_t indexOffset)
+				: address(address)
+				, packet(packet)
+				, indexOffset(indexOffset)
+			{
+			}
+
+			//----------
+			size_t
+				EncodedMessage::encode(const ofxOscMessage& message, string& packet)
+			{
+				// Wrapped in an immediate bundle, as ofxOscSender::sendMessage does
+				vector<char> buffer(1024);
+				size_t size = 0;
+				while (true) {
+					try {
+						osc::OutboundPacketStream stream(buffer.data(), buffer.size());
+						stream << osc::BeginBundleImmediate
+							<< osc::BeginMessage(message.getAddress().c_str())
+							<< indexPlaceholder;
+
+						for (size_t i = 0; i < message.getNumArgs(); i++) {
+							switch (message.getArgType(i)) {
+							case OFXOSC_TYPE_INT32:
+								stream << (osc::int32)message.getArgAsInt32(i);
+								break;
+							case OFXOSC_TYPE_INT64:
+								stream << (osc::int64)message.getArgAsInt64(i);
+								break;
+							case OFXOSC_TYPE_FLOAT:
+								stream << message.getArgAsFloat(i);
+								break;
+							case OFXOSC_TYPE_DOUBLE:
+								stream << message.getArgAsDouble(i);
+								break;
+							case OFXOSC_TYPE_STRING:
+								stream << message.getArgAsString(i).c_str();
+								break;
+							case OFXOSC_TYPE_SYMBOL:
+								stream << osc::Symbol(message.getArgAsSymbol(i).c_str());
+								break;
+							case OFXOSC_TYPE_TRUE:
+							case OFXOSC_TYPE_FALSE:
+								stream << message.getArgAsBool(i);
+								break;
+							case OFXOSC_TYPE_BLOB:
+							{
+								const auto& blob = message.getArgAsBlob(i);
+								stream << osc::Blob(blob.getData(), (osc::osc_bundle_element_size_t)blob.size());
+								break;
+							}
+							default:
+								throw(runtime_error("Unsupported argument type in message " + message.getAddress()));
+							}
+						}
+
+						stream << osc::EndMessage
+							<< osc::EndBundle;
+						size = stream.Size();
+						break;
+					}
+					catch (const osc::OutOfBufferMemoryException&) {
+						buffer.resize(buffer.size() * 2);
+					}
+				}
+				packet.assign(buffer.data(), size);
+
+				// "#bundle", time tag, element size, then the message's address and type tags (all padded to 4 bytes)
+				auto pad4 = [](size_t size) {
+					return (size + 3) & ~(size_t)3;
+				};
+				auto argCount = message.getNumArgs() + 1;
+				auto indexOffset = 8 + 8 + 4
+					+ pad4(message.getAddress().size() + 1)
+					+ pad4(argCount + 2);
+
+				// Check we found the placeholder (big-endian)
+				if (indexOffset + 8 > packet.size()) {
+					throw(runtime_error("Failed to locate the index in message " + message.getAddress()));
+				}
+				for (size_t i = 0; i < 8; i++) {
+					if ((uint8_t)packet[indexOffset + i] != (uint8_t)((uint64_t)indexPlaceholder >> (8 * (7 - i)))) {
+						throw(runtime_error("Failed to locate the index in message " + message.getAddress()));
+					}
+				}
+
+				return indexOffset;
+			}
+
+			//----------
+			const Message::Address&
+				EncodedMessage::getAddress() const
+			{
+				return this->address;
+			}
+
+			//----------
+			const string&
+				EncodedMessage::getPacket() const
+			{
+				return this->packet;
+			}
+
+			//----------
+			void
+				EncodedMessage::writePacket(Message::Index index, vector<char>& buffer) const
+			{
+				buffer.assign(this->packet.begin(), this->packet.end());
+
+				// OSC is big-endian
+				auto destination = buffer.data() + this->indexOffset;
+				for (size_t i = 0; i < 8; i++) {
+					destination[i] = (char)((uint64_t)index >> (8 * (7 - i)));
+				}
+			}
+
+#pragma mark FleetCommand
+			//----------
+			FleetCommand::FleetCommand(const shared_ptr<const EncodedMessage>& message
+				, const vector<Message::HostName>& targetHosts)
+				: message(message)
+				, targetHosts(targetHosts)
+				, baseIndex(OutgoingMessage::allocateIndices(targetHosts.size()))
+				, isRetry(false)
+				, targetStates(targetHosts.size(), TargetState::Pending)
+				, pendingCount(targetHosts.size())
+			{
+
+			}
+
+			//----------
+			FleetCommand::FleetCommand(const shared_ptr<const EncodedMessage>& message
+				, const vector<Message::HostName>& targetHosts
+				, const chrono::system_clock::duration& retryDuration
+				, const chrono::system_clock::duration& retryPeriod)
+				: FleetCommand(message, targetHosts)
+			{
+				this->isRetry = true;
+				this->retryDuration = retryDuration;
+				this->retryPeriod = retryPeriod;
+				this->retryDeadline = chrono::system_clock::now() + retryDuration;
+			}
+
+			//----------
+			const EncodedMessage&
+				FleetCommand::getMessage() const
+			{
+				return *this->message;
+			}
+
+			//----------
+			const vector<Message::HostName>&
+				FleetCommand::getTargetHosts() const
+			{
+				return this->targetHosts;
+			}
+
+			//----------
+			size_t
+				FleetCommand::size() const
+			{
+				return this->targetHosts.size();
+			}
+
+			//----------
+			bool
+				FleetCommand::getIsRetry() const
+			{
+				return this->isRetry;
+			}
+
+			//----------
+			Message::Index
+				FleetCommand::getBaseIndex() const
+			{
+				return this->baseIndex;
+			}
+
+			//----------
+			bool
+				FleetCommand::contains(Message::Index index) const
+			{
+				return index >= this->baseIndex
+					&& index < this->baseIndex + (Message::Index)this->targetHosts.size();
+			}
+
+			//----------
+			size_t
+				FleetCommand::getPendingCount() const
+			{
+				return this->pendingCount;
+			}
+
+			//----------
+			size_t
+				FleetCommand::getAckedCount() const
+			{
+				return this->ackedCount;
+			}
+
+			//----------
+			chrono::system_clock::duration
+				FleetCommand::getAge() const
+			{
+				return chrono::system_clock::now() - this->birthTime;
+			}
+		}
+	}
+}
\ No newline at end of file
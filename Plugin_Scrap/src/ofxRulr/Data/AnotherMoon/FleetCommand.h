@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Message.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <future>
+#include <atomic>
+
+namespace ofxRulr {
+	namespace Data {
+		namespace AnotherMoon {
+			class MessageRouter;
+
+			/// <summary>
+			/// An OSC packet which is encoded once and then sent many times.
+			/// The message index (always the first argument) is left as a placeholder which is patched per send.
+			/// The message is wrapped in a bundle, as ofxOscSender sends it, so the lasers see the same framing.
+			/// </summary>
+			class EncodedMessage {
+			public:
+				// The message should not contain the index argument
+				EncodedMessage(const ofxOscMessage&);
+
+				// From a packet already made by encode
+				EncodedMessage(const Message::Address&, const std::string& packet, size_t indexOffset);
+
+				// Encode into packet (reusing its allocation). Returns the byte offset of the index argument.
+				static size_t encode(const ofxOscMessage&, std::string& packet);
+
+				const Message::Address& getAddress() const;
+				const std::string& getPacket() const;
+
+				// Copy the packet into buffer with the index filled in
+				void writePacket(Message::Index, std::vector<char>& buffer) const;
+			protected:
+				Message::Address address;
+				std::string packet;
+				size_t indexOffset;
+			};
+
+			/// <summary>
+			/// One message sent to many lasers.
+			/// Each target is given its own index (from a block reserved for the command) so that acks are still
+			/// matched per laser, but the packet, the retry timer and the promise are shared by the whole fleet.
+			/// </summary>
+			class FleetCommand {
+			public:
+				enum class TargetState : uint8_t {
+					Pending,
+					Acked,
+					Replaced,
+					TimedOut
+				};
+
+				// Send once (no ack expected)
+				FleetCommand(const std::shared_ptr<const EncodedMessage>&
+					, const std::vector<Message::HostName>& targetHosts);
+
+				// Retry until all targets ack or retryDuration passes
+				FleetCommand(const std::shared_ptr<const EncodedMessage>&
+					, const std::vector<Message::HostName>& targetHosts
+					, const std::chrono::system_clock::duration& retryDuration
+					, const std::chrono::system_clock::duration& retryPeriod);
+
+				const EncodedMessage& getMessage() const;
+				const std::vector<Message::HostName>& getTargetHosts() const;
+				size_t size() const;
+
+				bool getIsRetry() const;
+				Message::Index getBaseIndex() const;
+				bool contains(Message::Index) const;
+
+				size_t getPendingCount() const;
+				size_t getAckedCount() const;
+
+				std::chrono::system_clock::duration getAge() const;
+
+				// Fulfilled when every target has acked or been replaced by a newer message (retry),
+				// or when the message has been sent (once). Set to an exception if any target times out.
+				std::promise<void> onSent;
+			protected:
+				friend MessageRouter;
+
+				std::shared_ptr<const EncodedMessage> message;
+				std::vector<Message::HostName> targetHosts;
+				Message::Index baseIndex;
+
+				bool isRetry;
+				std::chrono::system_clock::time_point birthTime = std::chrono::system_clock::now();
+				std::chrono::system_clock::duration retryDuration{};
+				std::chrono::system_clock::duration retryPeriod{};
+				std::chrono::system_clock::time_point retryDeadline;
+				std::chrono::system_clock::time_point lastSendTime; // value initialise to zeros
+				size_t sendCount = 0;
+
+				// Guarded by the router's stateMutex
+				std::vector<TargetState> targetStates;
+				size_t timedOutCount = 0;
+
+				std::atomic<size_t> pendingCount;
+				std::atomic<size_t> ackedCount{ 0 };
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "FleetScheduler.h"
+#include "MessageRouter.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace ofxRulr {
+	namespace Data {
+		namespace AnotherMoon {
+			//----------
+			FleetScheduler::FleetScheduler()
+			{
+				ofxOscMessage keepAlive;
+				keepAlive.setAddress("/keepAlive");
+				this->keepAliveMessage = make_shared<EncodedMessage>(keepAlive);
+			}
+
+			//----------
+			void
+				FleetScheduler::queue(const Message::HostName& targetHost, const ofxOscMessage& message)
+			{
+				// Find (or create) the group sending exactly this packet
+				auto indexOffset = EncodedMessage::encode(message, this->encodeBuffer);
+				auto findGroup = this->groups.find(this->encodeBuffer);
+				if (findGroup == this->groups.end()) {
+					Group group;
+					group.message = make_shared<EncodedMessage>(message.getAddress(), this->encodeBuffer, indexOffset);
+					findGroup = this->groups.emplace(this->encodeBuffer, move(group)).first;
+				}
+				auto group = &findGroup->second;
+
+				// Replace anything already queued for this target and address
+				auto& groupForTarget = this->groupByTarget[make_pair(targetHost, message.getAddress())];
+				if (groupForTarget == group) {
+					return;
+				}
+				if (groupForTarget) {
+					auto& targetHosts = groupForTarget->targetHosts;
+					targetHosts.erase(std::remove(targetHosts.begin(), targetHosts.end(), targetHost), targetHosts.end());
+				}
+				groupForTarget = group;
+
+				if (!group->queued) {
+					group->queued = true;
+					this->queuedGroups.push_back(group);
+				}
+				group->targetHosts.push_back(targetHost);
+				this->statistics.messagesQueued++;
+			}
+
+			//----------
+			void
+				FleetScheduler::queueKeepAlive(const Message::HostName& targetHost)
+			{
+				this->keepAliveHosts.push_back(targetHost);
+				this->statistics.keepAlivesQueued++;
+			}
+
+			//----------
+			void
+				FleetScheduler::flush(MessageRouter& messageRouter
+					, const chrono::system_clock::duration& retryDuration
+					, const chrono::system_clock::duration& retryPeriod)
+			{
+				for (auto group : this->queuedGroups) {
+					group->queued = false;
+
+					// All of its targets may have been given a different message since
+					if (group->targetHosts.empty()) {
+						continue;
+					}
+
+					messageRouter.sendFleetCommand(make_shared<FleetCommand>(group->message
+						, group->targetHosts
+						, retryDuration
+						, retryPeriod));
+					this->statistics.commandsSent++;
+
+					// Keep the capacity for the next frame
+					group->targetHosts.clear();
+				}
+				this->queuedGroups.clear();
+				this->groupByTarget.clear();
+
+				if (!this->keepAliveHosts.empty()) {
+					messageRouter.sendFleetCommand(make_shared<FleetCommand>(this->keepAliveMessage
+						, this->keepAliveHosts));
+					this->statistics.commandsSent++;
+					this->keepAliveHosts.clear();
+				}
+
+				// e.g. if parameters are being animated then most packets won't be seen again
+				if (this->groups.size() > this->maxCachedGroups) {
+					this->groups.clear();
+				}
+			}
+
+			//----------
+			void
+				FleetScheduler::clear()
+			{
+				for (auto group : this->queuedGroups) {
+					group->queued = false;
+					group->targetHosts.clear();
+				}
+				this->queuedGroups.clear();
+				this->groupByTarget.clear();
+				this->keepAliveHosts.clear();
+			}
+
+			//----------
+			FleetScheduler::Statistics
+				FleetScheduler::getStatistics() const
+			{
+				auto statistics = this->statistics;
+				statistics.encodedCacheSize = this->groups.size();
+				return statistics;
+			}
+		}
+	}
+}
\ No newline at end of file
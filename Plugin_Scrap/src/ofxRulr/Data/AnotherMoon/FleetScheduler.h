@@ -0,0 +1,66 @@
+#pragma once
+
+#include "FleetCommand.h"
+
+#include <map>
+#include <unordered_map>
+
+namespace ofxRulr {
+	namespace Data {
+		namespace AnotherMoon {
+			class MessageRouter;
+
+			/// <summary>
+			/// Collects the device commands for the whole fleet during a frame and sends them as FleetCommands.
+			/// Lasers which are sent an identical message share one command (one encoding, one retry timer, one
+			/// promise), and all keep-alives of the frame go out as one command. Commands are sent in the order
+			/// that their messages were first queued during the frame.
+			/// Each queued message is encoded once (into a reused buffer) to find its command. Encoded packets are
+			/// cached between frames, so steady state traffic doesn't allocate packets.
+			/// </summary>
+			class FleetScheduler {
+			public:
+				struct Statistics {
+					size_t messagesQueued = 0;
+					size_t keepAlivesQueued = 0;
+					size_t commandsSent = 0;
+					size_t encodedCacheSize = 0;
+				};
+
+				FleetScheduler();
+
+				// The message should not contain the index argument. It will be sent with retries.
+				// Replaces any message queued this frame to the same host with the same address.
+				void queue(const Message::HostName&, const ofxOscMessage&);
+				void queueKeepAlive(const Message::HostName&);
+
+				void flush(MessageRouter&
+					, const std::chrono::system_clock::duration& retryDuration
+					, const std::chrono::system_clock::duration& retryPeriod);
+
+				// Drop anything queued
+				void clear();
+
+				Statistics getStatistics() const;
+			protected:
+				struct Group {
+					std::shared_ptr<const EncodedMessage> message;
+					std::vector<Message::HostName> targetHosts;
+					bool queued = false; // in queuedGroups this frame
+				};
+
+				// Keyed by encoded packet. Groups are kept between frames as the cache of encoded messages
+				std::unordered_map<std::string, Group> groups;
+				std::vector<Group*> queuedGroups; // this frame, in call order
+				std::map<std::pair<Message::HostName, Message::Address>, Group*> groupByTarget;
+				std::string encodeBuffer;
+				size_t maxCachedGroups = 1024;
+
+				std::vector<Message::HostName> keepAliveHosts;
+				std::shared_ptr<const EncodedMessage> keepAliveMessage;
+
+				Statistics statistics;
+			};
+		}
+	}
+}
\ No newline at end of file
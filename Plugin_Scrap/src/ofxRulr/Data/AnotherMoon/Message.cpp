@@ -31,6 +31,29 @@ namespace ofxRulr {
 			{
 			}
 
+			//----------
+			Message::TimeoutException::TimeoutException(const std::chrono::system_clock::duration& duration
+				, const Address& address
+				, const vector<HostName>& timedOutTargets
+				, size_t targetCount)
+				: duration(duration)
+				, address(address)
+				, target([&timedOutTargets]() {
+					string targets;
+					for (const auto& target : timedOutTargets) {
+						targets += (targets.empty() ? "" : ", ") + target;
+					}
+					return targets;
+				}())
+			{
+				snprintf(this->message, sizeof(this->message), "Timeout sending '%s' to %d of %d lasers (%s), (%d ms)"
+					, this->address.c_str()
+					, (int32_t) timedOutTargets.size()
+					, (int32_t) targetCount
+					, this->target.c_str()
+					, (int32_t) (std::chrono::duration_cast<std::chrono::milliseconds>(this->duration)).count());
+			}
+
 			//----------
 			char const *
 				Message::TimeoutException::what() const noexcept
@@ -61,7 +84,7 @@ namespace ofxRulr {
 
 #pragma mark OutgoingMessage
 			//-----------
-			size_t OutgoingMessage::nextIndex = 0;
+			atomic<Message::Index> OutgoingMessage::nextIndex{ 0 };
 
 			//----------
 			OutgoingMessage::OutgoingMessage(const HostName& targetHost)
@@ -72,6 +95,14 @@ namespace ofxRulr {
 				this->targetHost = targetHost;
 			}
 
+			//----------
+			Message::Index
+				OutgoingMessage::allocateIndices(size_t count)
+			{
+				// Messages are also created on the receive thread (acks), so this must be atomic
+				return nextIndex.fetch_add((Index)count);
+			}
+
 			//----------
 			const Message::HostName&
 				OutgoingMessage::getTargetHost() const
@@ -176,6 +207,27 @@ namespace ofxRulr {
 				return this->retryDuration;
 			}
 
+			//----------
+			std::chrono::system_clock::duration
+				OutgoingMessageRetry::getRetryPeriod() const
+			{
+				return this->retryPeriod;
+			}
+
+			//----------
+			std::chrono::system_clock::time_point
+				OutgoingMessageRetry::getRetryDeadline() const
+			{
+				return this->retryDeadline;
+			}
+
+			//----------
+			std::chrono::system_clock::time_point
+				OutgoingMessageRetry::getLastSendTime() const
+			{
+				return this->lastSendTime;
+			}
+
 #pragma mark AckknowledgeMessage
 			//----------
 			AckMessageOutgoing::AckMessageOutgoing(const IncomingMessage& incomingMessage)
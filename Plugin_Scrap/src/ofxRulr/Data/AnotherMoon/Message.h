@@ -3,6 +3,8 @@
 #include "ofxOsc.h"
 
 #include <future>
+#include <atomic>
+#include <vector>
 
 namespace ofxRulr {
 	namespace Data {
@@ -20,11 +22,18 @@ namespace ofxRulr {
 						, const Address&
 						, const HostName& target);
 					TimeoutException(const OutgoingMessageRetry&);
+
+					// One message sent to many targets (e.g. a FleetCommand), of which some timed out
+					TimeoutException(const std::chrono::system_clock::duration&
+						, const Address&
+						, const std::vector<HostName>& timedOutTargets
+						, size_t targetCount);
+
 					char const* what() const noexcept override;
 
 					const std::chrono::system_clock::duration duration;
-					const Address& address;
-					const HostName& target;
+					const Address address;
+					const HostName target; // comma separated if many targets timed out
 					char message[256];
 				};
 
@@ -65,8 +74,11 @@ namespace ofxRulr {
 				virtual bool getShouldDestroy() const = 0;
 
 				std::promise<void> onSent;
+
+				// Reserve a contiguous block of indices (e.g. one per target of a FleetCommand)
+				static Index allocateIndices(size_t count);
 			protected:
-				static size_t nextIndex;
+				static std::atomic<Index> nextIndex;
 				HostName targetHost;
 				size_t sendCount = 0;
 				std::chrono::system_clock::time_point birthTime = std::chrono::system_clock::now();
@@ -92,6 +104,9 @@ namespace ofxRulr {
 				bool getShouldDestroy() const override;
 
 				std::chrono::system_clock::duration getRetryDuration() const;
+				std::chrono::system_clock::duration getRetryPeriod() const;
+				std::chrono::system_clock::time_point getRetryDeadline() const;
+				std::chrono::system_clock::time_point getLastSendTime() const;
 
 			protected:
 				std::chrono::system_clock::time_point lastSendTime; // value initialise to zeros
@@ -1,10 +1,93 @@
 #include "MessageRouter.h"
 
+#include "ofLog.h"
+#include "OscPacketListener.h"
+#include "OscReceivedElements.h"
+#include "UdpSocket.h"
+#include "IpEndpointName.h"
+
+#include <stdexcept>
+
 using namespace std;
 
 namespace ofxRulr {
 	namespace Data {
 		namespace AnotherMoon {
+#pragma mark Listener
+			/// <summary>
+			/// Receives on the receive thread (blocking in the socket) and passes messages to the router
+			/// </summary>
+			class MessageRouter::Listener : public osc::OscPacketListener {
+			public:
+				Listener(MessageRouter& router)
+					: router(router)
+				{
+
+				}
+
+			protected:
+				void ProcessMessage(const osc::ReceivedMessage& receivedMessage, const IpEndpointName& remoteEndpoint) override
+				{
+					try {
+						ofxOscMessage message;
+						message.setAddress(receivedMessage.AddressPattern());
+
+						char remoteHost[IpEndpointName::ADDRESS_STRING_LENGTH];
+						remoteEndpoint.AddressAsString(remoteHost);
+						message.setRemoteEndpoint(remoteHost, remoteEndpoint.port);
+
+						// Only the argument types which the lasers send are supported
+						for (auto argument = receivedMessage.ArgumentsBegin(); argument != receivedMessage.ArgumentsEnd(); ++argument) {
+							if (argument->IsInt32()) {
+								message.addIntArg(argument->AsInt32Unchecked());
+							}
+							else if (argument->IsInt64()) {
+								message.addInt64Arg(argument->AsInt64Unchecked());
+							}
+							else if (argument->IsFloat()) {
+								message.addFloatArg(argument->AsFloatUnchecked());
+							}
+							else if (argument->IsDouble()) {
+								message.addDoubleArg(argument->AsDoubleUnchecked());
+							}
+							else if (argument->IsString()) {
+								message.addStringArg(argument->AsStringUnchecked());
+							}
+							else if (argument->IsSymbol()) {
+								message.addSymbolArg(argument->AsSymbolUnchecked());
+							}
+							else if (argument->IsBool()) {
+								message.addBoolArg(argument->AsBoolUnchecked());
+							}
+							else if (argument->IsBlob()) {
+								const void* data;
+								osc::osc_bundle_element_size_t size;
+								argument->AsBlobUnchecked(data, size);
+								ofBuffer buffer((const char*)data, size);
+								message.addBlobArg(buffer);
+							}
+							else {
+								ofLogWarning("MessageRouter") << "Unsupported argument type '" << argument->TypeTag() << "' in message " << message.getAddress();
+							}
+						}
+
+						this->router.processIncomingMessage(message);
+					}
+					catch (const std::exception& e) {
+						ofLogError("MessageRouter") << e.what();
+					}
+				}
+
+				MessageRouter& router;
+			};
+
+#pragma mark MessageRouter
+			//----------
+			MessageRouter::MessageRouter()
+			{
+
+			}
+
 			//----------
 			MessageRouter::~MessageRouter()
 			{
@@ -15,21 +98,34 @@ namespace ofxRulr {
 			void
 				MessageRouter::init(int portLocal, int portRemote)
 			{
+				this->close();
+
 				this->portLocal = portLocal;
 				this->portRemote = portRemote;
+				this->isClosing = false;
 
-				this->close();
+				this->listener = make_unique<Listener>(*this);
+				try {
+					this->receiveSocket = make_unique<UdpListeningReceiveSocket>(IpEndpointName(IpEndpointName::ANY_ADDRESS, portLocal)
+						, this->listener.get());
 
-				this->receiveThread = std::thread([this]() {
-					while (!this->isClosing) {
-						this->receiveThreadLoop();
-					}
-					});
+					this->receiveThread = std::thread([this]() {
+						try {
+							// Blocks until AsynchronousBreak
+							this->receiveSocket->Run();
+						}
+						catch (const std::exception& e) {
+							ofLogError("MessageRouter") << "Receive : " << e.what();
+						}
+						});
+				}
+				catch (const std::exception& e) {
+					ofLogError("MessageRouter") << "Couldn't listen on port " << portLocal << " : " << e.what();
+					this->receiveSocket.reset();
+				}
 
 				this->sendThread = std::thread([this]() {
-					while (!this->isClosing) {
-						this->sendThreadLoop();
-					}
+					this->sendThreadFunction();
 					});
 
 				this->isOpen = true;
@@ -40,9 +136,28 @@ namespace ofxRulr {
 				MessageRouter::close()
 			{
 				if (this->isOpen) {
-					this->isClosing = true;
-					this->receiveThread.join();
-					this->sendThread.join();
+					{
+						unique_lock<mutex> lock(this->stateMutex);
+						this->isClosing = true;
+					}
+					this->sendCondition.notify_all();
+
+					if (this->receiveSocket) {
+						this->receiveSocket->AsynchronousBreak();
+					}
+					if (this->receiveThread.joinable()) {
+						this->receiveThread.join();
+					}
+					if (this->sendThread.joinable()) {
+						this->sendThread.join();
+					}
+
+					this->receiveSocket.reset();
+					this->listener.reset();
+					this->fleetSocket.reset();
+					this->destinations.clear();
+					this->queuedCount = 0;
+
 					this->isOpen = false;
 				}
 			}
@@ -65,7 +180,27 @@ namespace ofxRulr {
 			void
 				MessageRouter::sendOutgoingMessage(const std::shared_ptr<OutgoingMessage>& message)
 			{
-				this->outgoingMessages.send(message);
+				{
+					unique_lock<mutex> lock(this->stateMutex);
+					this->newOutgoingMessages.push_back(message);
+				}
+				this->sendCondition.notify_one();
+			}
+
+			//----------
+			void
+				MessageRouter::sendFleetCommand(const std::shared_ptr<FleetCommand>& command)
+			{
+				if (command->size() == 0) {
+					command->onSent.set_value();
+					return;
+				}
+
+				{
+					unique_lock<mutex> lock(this->stateMutex);
+					this->newFleetCommands.push_back(command);
+				}
+				this->sendCondition.notify_one();
 			}
 
 			//----------
@@ -76,206 +211,549 @@ namespace ofxRulr {
 			}
 
 			//----------
-			void
-				MessageRouter::receiveThreadLoop()
+			size_t
+				MessageRouter::getActiveOutgoingMessageCount() const
 			{
-				// Check server settings
-				if (this->receiver) {
-					if (this->receiver->getPort() != this->portLocal) {
-						this->receiver.reset();
-					}
-				}
+				unique_lock<mutex> lock(this->stateMutex);
+				return this->activeOutgoingMessages.size();
+			}
 
-				// Create receiver if required
-				if (!this->receiver) {
-					this->receiver = make_unique<ofxOscReceiver>();
-					this->receiver->setup(this->portLocal);
+			//----------
+			MessageRouter::FleetStatistics
+				MessageRouter::getFleetStatistics() const
+			{
+				unique_lock<mutex> lock(this->stateMutex);
+				auto statistics = this->fleetStatistics;
+				statistics.activeCommands = this->activeFleetCommands.size();
+				statistics.pendingTargets = 0;
+				for (const auto& it : this->activeFleetCommands) {
+					statistics.pendingTargets += it.second->getPendingCount();
 				}
+				return statistics;
+			}
 
-				// Take incoming messages
-				ofxOscMessage oscMessage;
-				if (this->receiver->getNextMessage(oscMessage)) {
-					auto incomingMessage = make_shared<IncomingMessage>(oscMessage);
+			//----------
+			void
+				MessageRouter::sendThreadFunction()
+			{
+				struct Send {
+					Destination* destination;
+					const Message::HostName* targetHost;
+					shared_ptr<OutgoingMessage> message;
+				};
+				vector<Send> toSend;
+				vector<shared_ptr<OutgoingMessageRetry>> sentRetryMessages;
+
+				struct FleetSend {
+					Destination* destination;
+					const Message::HostName* targetHost;
+					const FleetCommand* command;
+					Message::Index index;
+				};
+				vector<FleetSend> toSendFleet;
+				vector<shared_ptr<FleetCommand>> sentFleetCommands;
+				vector<char> packet;
+
+				while (true) {
+					toSend.clear();
+					sentRetryMessages.clear();
+					toSendFleet.clear();
+					sentFleetCommands.clear();
+
+					// Wait for something to do and take it
+					{
+						unique_lock<mutex> lock(this->stateMutex);
+
+						auto isReady = [this]() {
+							return this->isClosing
+								|| !this->newOutgoingMessages.empty()
+								|| !this->newFleetCommands.empty()
+								|| !this->fleetSendQueue.empty()
+								|| this->queuedCount > 0;
+						};
+						if (this->retryTimers.empty()) {
+							this->sendCondition.wait(lock, isReady);
+						}
+						else {
+							this->sendCondition.wait_until(lock, this->retryTimers.getNextTickTime(), isReady);
+						}
 
-					// Check if it's an ack
-					if (incomingMessage->getAddress() == Message::ackAddress) {
-						// RECEIVED AN ACK
-
-						auto ackIncoming = make_shared<AckMessageIncoming>(*incomingMessage);
-
-						// Delete outgoing messages waiting for this ack
-						{
-							this->activeOutgoingMessagesMutex.lock();
-							{
-								// Delete all outbox messages waiting for this ack
-								for (auto it = this->activeOutgoingMessages.begin(); it != this->activeOutgoingMessages.end();)
-								{
-									if ((*it)->index == ackIncoming->index)
-									{
-										// Alert listeners that it worked
-										(*it)->onSent.set_value();
-
-										// Send to histogram if enabled
-										if (this->ackTimeLoggingEnabled) {
-											auto ackTimeMillis = chrono::duration_cast<chrono::milliseconds>((*it)->getAge()).count();
-											this->ackTime.send(ackTimeMillis);
-										}
-
-										// Delete it from the queue
-										it = this->activeOutgoingMessages.erase(it);
-									}
-									else {
-										it++;
+						if (this->isClosing) {
+							break;
+						}
+
+						this->processNewOutgoingMessages();
+						this->processNewFleetCommands();
+						this->processRetryTimers(chrono::system_clock::now());
+
+						// Take from each destination's queue in turn, so that one busy laser doesn't hold up the others
+						bool anyTaken = true;
+						while (anyTaken) {
+							anyTaken = false;
+							for (auto& it : this->destinations) {
+								auto& queue = it.second.queue;
+								if (queue.empty()) {
+									continue;
+								}
+
+								auto message = queue.front();
+								queue.pop_front();
+								anyTaken = true;
+
+								// Skip messages which were acked or replaced whilst queued
+								auto retryMessage = dynamic_pointer_cast<OutgoingMessageRetry>(message);
+								if (retryMessage) {
+									auto findActive = this->activeOutgoingMessages.find(retryMessage->index);
+									if (findActive == this->activeOutgoingMessages.end()
+										|| findActive->second != retryMessage) {
+										continue;
 									}
 								}
+
+								toSend.push_back({ &it.second, &it.first, message });
 							}
-							this->activeOutgoingMessagesMutex.unlock();
 						}
+						this->queuedCount = 0;
 
-						// Transmit ACK to main thread
-						this->incomingAcks.send(make_shared<AckMessageIncoming>(oscMessage));
+						// Take the targets of fleet commands which are still waiting for an ack
+						for (const auto& command : this->fleetSendQueue) {
+							for (size_t i = 0; i < command->size(); i++) {
+								if (command->targetStates[i] != FleetCommand::TargetState::Pending) {
+									continue;
+								}
+								auto destination = this->destinations.find(command->targetHosts[i]);
+								if (destination == this->destinations.end()) {
+									destination = this->destinations.emplace(command->targetHosts[i], Destination()).first;
+								}
+								toSendFleet.push_back({ &destination->second
+									, &destination->first
+									, command.get()
+									, command->baseIndex + (Message::Index)i });
+							}
+						}
+						swap(sentFleetCommands, this->fleetSendQueue);
 					}
-					else {
-						// RECEIVED A STANDARD MESSAGE
 
-						// Send message to main thread
-						this->incomingMessages.send(incomingMessage);
+					// Send (without holding the lock)
+					for (auto& send : toSend) {
+						if (this->sendMessageInner(*send.destination, *send.targetHost, send.message)) {
+							send.message->markAsSent();
+						}
 
-						// Send an ACK
-						this->outgoingAcks.send(make_shared<AckMessageOutgoing>(*incomingMessage));
+						auto retryMessage = dynamic_pointer_cast<OutgoingMessageRetry>(send.message);
+						if (retryMessage) {
+							sentRetryMessages.push_back(retryMessage);
+						}
+					}
+
+					// Send fleet commands (the packet is encoded once per command, we only patch the index)
+					size_t packetsSent = 0;
+					for (auto& send : toSendFleet) {
+						send.command->message->writePacket(send.index, packet);
+						if (this->sendPacketInner(*send.destination, *send.targetHost, packet)) {
+							packetsSent++;
+						}
+					}
+
+					// Schedule retries of what we sent
+					if (!sentRetryMessages.empty() || !sentFleetCommands.empty()) {
+						unique_lock<mutex> lock(this->stateMutex);
+						for (const auto& retryMessage : sentRetryMessages) {
+							if (this->activeOutgoingMessages.count(retryMessage->index)) {
+								this->scheduleRetry(retryMessage);
+							}
+						}
+
+						auto now = chrono::system_clock::now();
+						for (const auto& command : sentFleetCommands) {
+							command->sendCount++;
+							command->lastSendTime = now;
+
+							if (!command->isRetry) {
+								// Nothing to wait for
+								command->pendingCount = 0;
+								command->onSent.set_value();
+							}
+							else if (this->activeFleetCommands.count(command->baseIndex)) {
+								this->scheduleRetry(command);
+							}
+						}
+						this->fleetStatistics.packetsSent += packetsSent;
 					}
-				}
-				else {
-					ofSleepMillis(10);
 				}
 			}
 
 			//----------
 			void
-				MessageRouter::sendThreadLoop()
+				MessageRouter::processIncomingMessage(const ofxOscMessage& oscMessage)
 			{
-				// Receive messages to send from main thread
-				{
-					std::shared_ptr<OutgoingMessage> activeOutgoingMessage;
-					while (this->outgoingMessages.tryReceive(activeOutgoingMessage, 10)) {
-
-						// Strip messages from outbox, with same address as new message (if it's not an ACK)
-						if (activeOutgoingMessage->getAddress() != Message::ackAddress) {
-
-							this->activeOutgoingMessagesMutex.lock();
-							{
-								for (auto it = this->activeOutgoingMessages.begin(); it != this->activeOutgoingMessages.end(); )
-								{
-									const auto& otherExistingActiveMessage = *it;
-									// If matching address and target host
-									if (otherExistingActiveMessage->getAddress() == activeOutgoingMessage->getAddress()
-										&& otherExistingActiveMessage->getTargetHost() == activeOutgoingMessage->getTargetHost()) {
-										// erase the old one
-										it = this->activeOutgoingMessages.erase(it);
-									}
-									else {
-										it++;
-									}
+				if (oscMessage.getAddress() == Message::ackAddress) {
+					// RECEIVED AN ACK
+
+					auto ackIncoming = make_shared<AckMessageIncoming>(oscMessage);
+
+					// Take the outgoing message waiting for this ack
+					shared_ptr<OutgoingMessageRetry> ackedMessage;
+					shared_ptr<FleetCommand> ackedCommand;
+					{
+						unique_lock<mutex> lock(this->stateMutex);
+						auto findActive = this->activeOutgoingMessages.find(ackIncoming->index);
+						if (findActive != this->activeOutgoingMessages.end()) {
+							ackedMessage = findActive->second;
+							this->eraseActiveOutgoingMessage(ackIncoming->index);
+						}
+						else {
+							// Or the target of a fleet command
+							auto command = this->findFleetCommand(ackIncoming->index);
+							if (command) {
+								auto target = (size_t)(ackIncoming->index - command->baseIndex);
+								if (this->completeFleetTarget(command, target, FleetCommand::TargetState::Acked)) {
+									ackedCommand = command;
 								}
 							}
-							this->activeOutgoingMessagesMutex.unlock();
 						}
+					}
+
+					if (ackedMessage) {
+						// Alert listeners that it worked
+						ackedMessage->onSent.set_value();
 
-						// Put this message into outgoing loop
-						this->activeOutgoingMessagesMutex.lock();
-						{
-							this->activeOutgoingMessages.push_back(activeOutgoingMessage);
+						// Send to histogram if enabled
+						if (this->ackTimeLoggingEnabled) {
+							auto ackTimeMillis = chrono::duration_cast<chrono::milliseconds>(ackedMessage->getAge()).count();
+							this->ackTime.send((int)ackTimeMillis);
+						}
+					}
+					else if (ackedCommand) {
+						if (this->ackTimeLoggingEnabled) {
+							auto ackTimeMillis = chrono::duration_cast<chrono::milliseconds>(ackedCommand->getAge()).count();
+							this->ackTime.send((int)ackTimeMillis);
 						}
-						this->activeOutgoingMessagesMutex.unlock();
 					}
+
+					// Transmit ACK to main thread
+					this->incomingAcks.send(ackIncoming);
 				}
+				else {
+					// RECEIVED A STANDARD MESSAGE
 
-				// Process the outgoing active messages
-				this->activeOutgoingMessagesMutex.lock();
-				{
-					for (auto it = this->activeOutgoingMessages.begin(); it != this->activeOutgoingMessages.end(); ) {
-						auto outgoingMessage = *it;
-						if (outgoingMessage->getShouldDestroy()) {
-							auto outgoingMessageRetry = dynamic_pointer_cast<OutgoingMessageRetry>(outgoingMessage);
-							if (outgoingMessageRetry) {
-								// The message has expired - send an exception
-								outgoingMessage->onSent.set_exception(make_exception_ptr(Message::TimeoutException(*outgoingMessageRetry)));
-							}
-							
-							it = this->activeOutgoingMessages.erase(it);
+					auto incomingMessage = make_shared<IncomingMessage>(oscMessage);
+
+					// Send message to main thread
+					this->incomingMessages.send(incomingMessage);
+
+					// Send an ACK
+					auto ack = make_shared<AckMessageOutgoing>(*incomingMessage);
+					{
+						unique_lock<mutex> lock(this->stateMutex);
+						this->destinations[ack->getTargetHost()].queue.push_back(ack);
+						this->queuedCount++;
+					}
+					this->sendCondition.notify_one();
+				}
+			}
+
+			//----------
+			// Called with stateMutex locked
+			void
+				MessageRouter::processNewOutgoingMessages()
+			{
+				for (const auto& message : this->newOutgoingMessages) {
+					if (message->getAddress() != Message::ackAddress) {
+						// Replace any active message with same address and target host
+						auto key = make_pair(message->getTargetHost(), message->getAddress());
+						auto findExisting = this->activeOutgoingMessageByTarget.find(key);
+						if (findExisting != this->activeOutgoingMessageByTarget.end()) {
+							this->eraseActiveOutgoingMessage(findExisting->second);
 						}
-						else {
-							// Check (e.g. retry period)
-							if (outgoingMessage->getShouldSend()) {
-								if (this->sendMessageInner(outgoingMessage)) {
-									outgoingMessage->markAsSent();
-								}
-							}
-							it++;
+
+						// Retry messages stay active until acked or timed out
+						auto retryMessage = dynamic_pointer_cast<OutgoingMessageRetry>(message);
+						if (retryMessage) {
+							this->activeOutgoingMessages[retryMessage->index] = retryMessage;
+							this->activeOutgoingMessageByTarget[key] = retryMessage->index;
+						}
+					}
+
+					this->destinations[message->getTargetHost()].queue.push_back(message);
+					this->queuedCount++;
+				}
+				this->newOutgoingMessages.clear();
+			}
+
+			//----------
+			// Called with stateMutex locked
+			void
+				MessageRouter::processRetryTimers(const TimerWheel::TimePoint& now)
+			{
+				auto& expired = this->expiredRetryTimers;
+				expired.clear();
+				this->retryTimers.advance(now, expired);
+
+				for (const auto& index : expired) {
+					// Ignore timers of messages which have been acked or replaced
+					auto findActive = this->activeOutgoingMessages.find(index);
+					if (findActive == this->activeOutgoingMessages.end()) {
+						// Fleet command timers are keyed by base index
+						auto findCommand = this->activeFleetCommands.find(index);
+						if (findCommand != this->activeFleetCommands.end()) {
+							this->processFleetRetryTimer(findCommand->second, now);
 						}
+						continue;
+					}
+					auto retryMessage = findActive->second;
+
+					if (retryMessage->getShouldDestroy()) {
+						// The message has expired - send an exception
+						this->eraseActiveOutgoingMessage(index);
+						retryMessage->onSent.set_exception(make_exception_ptr(Message::TimeoutException(*retryMessage)));
+					}
+					else if (retryMessage->getShouldSend()) {
+						this->destinations[retryMessage->getTargetHost()].queue.push_back(retryMessage);
+						this->queuedCount++;
+					}
+					else {
+						// Timer ticks are coarser than the retry period
+						this->scheduleRetry(retryMessage);
 					}
 				}
-				this->activeOutgoingMessagesMutex.unlock();
+			}
 
-				// Send the ACKS
-				{
-					shared_ptr<AckMessageOutgoing> ackMessage;
-					while (this->outgoingAcks.tryReceive(ackMessage)) {
-						this->sendMessageInner(ackMessage);
+			//----------
+			// Called with stateMutex locked
+			void
+				MessageRouter::scheduleRetry(const shared_ptr<OutgoingMessageRetry>& retryMessage)
+			{
+				auto nextSendTime = retryMessage->getLastSendTime() + retryMessage->getRetryPeriod();
+				auto dueTime = min(nextSendTime, retryMessage->getRetryDeadline());
+				this->retryTimers.schedule(retryMessage->index, dueTime);
+			}
+
+			//----------
+			// Called with stateMutex locked
+			void
+				MessageRouter::eraseActiveOutgoingMessage(Message::Index index)
+			{
+				auto findActive = this->activeOutgoingMessages.find(index);
+				if (findActive == this->activeOutgoingMessages.end()) {
+					// Might be the target of a fleet command
+					auto command = this->findFleetCommand(index);
+					if (command) {
+						this->completeFleetTarget(command
+							, (size_t)(index - command->baseIndex)
+							, FleetCommand::TargetState::Replaced);
 					}
+					return;
+				}
+
+				auto key = make_pair(findActive->second->getTargetHost(), findActive->second->getAddress());
+				auto findByTarget = this->activeOutgoingMessageByTarget.find(key);
+				if (findByTarget != this->activeOutgoingMessageByTarget.end() && findByTarget->second == index) {
+					this->activeOutgoingMessageByTarget.erase(findByTarget);
 				}
+
+				this->activeOutgoingMessages.erase(findActive);
 			}
 
 			//----------
 			bool
-				MessageRouter::sendMessageInner(shared_ptr<OutgoingMessage> outgoingMessage)
+				MessageRouter::sendMessageInner(Destination& destination
+					, const std::string& targetHost
+					, shared_ptr<OutgoingMessage> outgoingMessage)
 			{
-				// Refresh the sender if required
-				{
-					// Find existing sender
-					auto findSender = this->senders.find(outgoingMessage->getTargetHost());
-					if (findSender != this->senders.end()) {
-						auto& sender = findSender->second;
-
-						// Check the send port matches
-						if (sender) {
-							if (this->portRemote != sender->getPort()) {
-								this->senders.erase(findSender);
-							}
-						}
+				// Check the send port matches
+				if (destination.sender) {
+					if (this->portRemote != destination.sender->getPort()) {
+						destination.sender.reset();
 					}
 				}
 
 				// Check if need create sender
-				{
-					auto findSender = this->senders.find(outgoingMessage->getTargetHost());
-					if (findSender == this->senders.end()) {
-						auto it = this->senders.emplace(outgoingMessage->getTargetHost(), make_unique<ofxOscSender>());
-						auto& sender = it.first->second;
-
-						ofxOscSenderSettings settings;
-						{
-							settings.host = outgoingMessage->getTargetHost();
-							settings.port = this->portRemote;
-						}
+				if (!destination.sender) {
+					auto sender = make_unique<ofxOscSender>();
 
-						if (!sender->setup(settings)) {
-							this->senders.erase(it.first);
-							return false;
-						}
+					ofxOscSenderSettings settings;
+					{
+						settings.host = targetHost;
+						settings.port = this->portRemote;
 					}
+
+					if (!sender->setup(settings)) {
+						return false;
+					}
+					destination.sender = move(sender);
 				}
 
 				// Send message
-				{
-					auto findSender = this->senders.find(outgoingMessage->getTargetHost());
-					if (findSender != this->senders.end()) {
-						findSender->second->sendMessage(*outgoingMessage);
-						return true;
+				try {
+					destination.sender->sendMessage(*outgoingMessage);
+					return true;
+				}
+				catch (const std::exception& e) {
+					ofLogError("MessageRouter") << "Send to " << targetHost << " : " << e.what();
+					destination.sender.reset();
+					return false;
+				}
+			}
+
+			//----------
+			// Called with stateMutex locked
+			void
+				MessageRouter::processNewFleetCommands()
+			{
+				for (const auto& command : this->newFleetCommands) {
+					if (command->isRetry) {
+						// Replace any active message with same address and target host
+						const auto& address = command->message->getAddress();
+						for (size_t i = 0; i < command->size(); i++) {
+							auto key = make_pair(command->targetHosts[i], address);
+							auto findExisting = this->activeOutgoingMessageByTarget.find(key);
+							if (findExisting != this->activeOutgoingMessageByTarget.end()) {
+								this->eraseActiveOutgoingMessage(findExisting->second);
+							}
+							this->activeOutgoingMessageByTarget[key] = command->baseIndex + (Message::Index)i;
+						}
+
+						// Stays active until all targets are acked, replaced or timed out
+						this->activeFleetCommands[command->baseIndex] = command;
+					}
+
+					this->fleetSendQueue.push_back(command);
+				}
+				this->newFleetCommands.clear();
+			}
+
+			//----------
+			// Called with stateMutex locked
+			void
+				MessageRouter::processFleetRetryTimer(shared_ptr<FleetCommand> command, const TimerWheel::TimePoint& now)
+			{
+				if (now > command->retryDeadline) {
+					// Time out all targets which haven't acked (this completes the command)
+					for (size_t i = 0; i < command->size(); i++) {
+						this->completeFleetTarget(command, i, FleetCommand::TargetState::TimedOut);
+					}
+				}
+				else if (now - command->lastSendTime > command->retryPeriod) {
+					this->fleetSendQueue.push_back(command);
+				}
+				else {
+					// Timer ticks are coarser than the retry period
+					this->scheduleRetry(command);
+				}
+			}
+
+			//----------
+			// Called with stateMutex locked
+			void
+				MessageRouter::scheduleRetry(const shared_ptr<FleetCommand>& command)
+			{
+				auto nextSendTime = command->lastSendTime + command->retryPeriod;
+				auto dueTime = min(nextSendTime, command->retryDeadline);
+				this->retryTimers.schedule(command->baseIndex, dueTime);
+			}
+
+			//----------
+			// Called with stateMutex locked
+			shared_ptr<FleetCommand>
+				MessageRouter::findFleetCommand(Message::Index index) const
+			{
+				// The last command starting at or before this index
+				auto findCommand = this->activeFleetCommands.upper_bound(index);
+				if (findCommand == this->activeFleetCommands.begin()) {
+					return nullptr;
+				}
+				findCommand--;
+
+				if (!findCommand->second->contains(index)) {
+					return nullptr;
+				}
+				return findCommand->second;
+			}
+
+			//----------
+			// Called with stateMutex locked. Returns false if the target was already complete
+			bool
+				MessageRouter::completeFleetTarget(const shared_ptr<FleetCommand>& command
+					, size_t target
+					, FleetCommand::TargetState targetState)
+			{
+				auto& currentState = command->targetStates[target];
+				if (currentState != FleetCommand::TargetState::Pending) {
+					return false;
+				}
+				currentState = targetState;
+
+				auto index = command->baseIndex + (Message::Index)target;
+				auto key = make_pair(command->targetHosts[target], command->message->getAddress());
+				auto findByTarget = this->activeOutgoingMessageByTarget.find(key);
+				if (findByTarget != this->activeOutgoingMessageByTarget.end() && findByTarget->second == index) {
+					this->activeOutgoingMessageByTarget.erase(findByTarget);
+				}
+
+				switch (targetState) {
+				case FleetCommand::TargetState::Acked:
+					command->ackedCount++;
+					this->fleetStatistics.ackedTargets++;
+					break;
+				case FleetCommand::TargetState::TimedOut:
+					command->timedOutCount++;
+					this->fleetStatistics.timedOutTargets++;
+					break;
+				default:
+					break;
+				}
+
+				if (--command->pendingCount == 0) {
+					// Alert listeners once for the whole fleet
+					if (command->timedOutCount > 0) {
+						vector<Message::HostName> timedOutTargets;
+						for (size_t i = 0; i < command->size(); i++) {
+							if (command->targetStates[i] == FleetCommand::TargetState::TimedOut) {
+								timedOutTargets.push_back(command->targetHosts[i]);
+							}
+						}
+						command->onSent.set_exception(make_exception_ptr(Message::TimeoutException(command->retryDuration
+							, command->message->getAddress()
+							, timedOutTargets
+							, command->size())));
 					}
 					else {
-						return false;
+						command->onSent.set_value();
 					}
+
+					// The caller holds a reference to the command, so this can't destroy it
+					this->activeFleetCommands.erase(command->baseIndex);
+				}
+
+				return true;
+			}
+
+			//----------
+			bool
+				MessageRouter::sendPacketInner(Destination& destination
+					, const std::string& targetHost
+					, const vector<char>& packet)
+			{
+				try {
+					// One socket sends to every laser
+					if (!this->fleetSocket) {
+						this->fleetSocket = make_unique<UdpSocket>();
+					}
+
+					// Resolve the laser's endpoint once
+					if (!destination.endpoint || destination.endpoint->port != this->portRemote) {
+						destination.endpoint = make_unique<IpEndpointName>(targetHost.c_str(), this->portRemote);
+					}
+
+					this->fleetSocket->SendTo(*destination.endpoint, packet.data(), packet.size());
+					return true;
+				}
+				catch (const std::exception& e) {
+					ofLogError("MessageRouter") << "Send to " << targetHost << " : " << e.what();
+					destination.endpoint.reset();
+					this->fleetSocket.reset();
+					return false;
 				}
 			}
 		}
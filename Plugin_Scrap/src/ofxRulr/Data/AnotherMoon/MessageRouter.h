@@ -1,14 +1,34 @@
 #pragma once
 
 #include "Message.h"
+#include "FleetCommand.h"
+#include "TimerWheel.h"
 #include "ofxOsc.h"
 #include "ofThreadChannel.h"
 
 #include <map>
+#include <unordered_map>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+class UdpListeningReceiveSocket;
+class UdpSocket;
+class IpEndpointName;
 
 namespace ofxRulr {
 	namespace Data {
 		namespace AnotherMoon {
+			/// <summary>
+			/// Sends and receives messages with the lasers.
+			/// The receive thread blocks on the socket, and the send thread sleeps until there is something to send
+			/// or a retry is due, so neither spins whilst idle.
+			/// Messages waiting for an ack are found by index in a hash map, retries and timeouts are scheduled on a
+			/// timer wheel, and each laser (host) has its own send queue.
+			/// FleetCommands send one pre-encoded packet to many lasers from a single socket, with one retry timer
+			/// per command and acks matched to the command by index range.
+			/// </summary>
 			class MessageRouter {
 			public:
 				enum Port : int {
@@ -16,6 +36,7 @@ namespace ofxRulr {
 					Server = 4001
 				};
 
+				MessageRouter();
 				~MessageRouter();
 
 				void init(int portLocal, int portRemote);
@@ -24,35 +45,87 @@ namespace ofxRulr {
 				bool getIncomingMessage(std::shared_ptr<IncomingMessage>& message);
 				bool getIncomingAck(std::shared_ptr<AckMessageIncoming>&);
 				void sendOutgoingMessage(const std::shared_ptr<OutgoingMessage>& message);
+				void sendFleetCommand(const std::shared_ptr<FleetCommand>&);
 
 				void setAckTimeLoggingEnabled(bool);
 				ofThreadChannel<int> ackTime;
+
+				size_t getActiveOutgoingMessageCount() const;
+
+				struct FleetStatistics {
+					size_t activeCommands = 0;
+					size_t pendingTargets = 0;
+					size_t ackedTargets = 0;
+					size_t timedOutTargets = 0;
+					size_t packetsSent = 0;
+				};
+				FleetStatistics getFleetStatistics() const;
 			protected:
-				void receiveThreadLoop();
-				void sendThreadLoop();
-				bool sendMessageInner(std::shared_ptr<OutgoingMessage>);
+				class Listener;
 
-				ofThreadChannel<std::shared_ptr<IncomingMessage>> incomingMessages;
-				ofThreadChannel<std::shared_ptr<OutgoingMessage>> outgoingMessages;
+				struct Destination {
+					std::unique_ptr<ofxOscSender> sender; // owned by the send thread
+					std::unique_ptr<IpEndpointName> endpoint; // owned by the send thread (for FleetCommands)
+					std::deque<std::shared_ptr<OutgoingMessage>> queue;
+				};
+
+				void sendThreadFunction();
+				void processIncomingMessage(const ofxOscMessage&);
+				void processNewOutgoingMessages();
+				void processRetryTimers(const TimerWheel::TimePoint& now);
+				void scheduleRetry(const std::shared_ptr<OutgoingMessageRetry>&);
+				void eraseActiveOutgoingMessage(Message::Index);
+				bool sendMessageInner(Destination&, const std::string& targetHost, std::shared_ptr<OutgoingMessage>);
 
-				// Messages being sent (messages may be sent multiple times if no ack received)
-				std::vector<std::shared_ptr<OutgoingMessage>> activeOutgoingMessages;
-				std::mutex activeOutgoingMessagesMutex; // inbox will delete from list on ack
-				ofThreadChannel<std::shared_ptr<AckMessageOutgoing>> outgoingAcks;
+				void processNewFleetCommands();
+				void processFleetRetryTimer(std::shared_ptr<FleetCommand>, const TimerWheel::TimePoint& now);
+				void scheduleRetry(const std::shared_ptr<FleetCommand>&);
+				std::shared_ptr<FleetCommand> findFleetCommand(Message::Index) const;
+				bool completeFleetTarget(const std::shared_ptr<FleetCommand>&, size_t target, FleetCommand::TargetState);
+				bool sendPacketInner(Destination&, const std::string& targetHost, const std::vector<char>& packet);
+
+				ofThreadChannel<std::shared_ptr<IncomingMessage>> incomingMessages;
 				ofThreadChannel<std::shared_ptr<AckMessageIncoming>> incomingAcks;
 
+				// All below guarded by stateMutex
+				std::vector<std::shared_ptr<OutgoingMessage>> newOutgoingMessages;
+
+				// Messages waiting for an ack (messages may be sent multiple times if no ack received)
+				std::unordered_map<Message::Index, std::shared_ptr<OutgoingMessageRetry>> activeOutgoingMessages;
+
+				// A new message replaces any active message with the same target and address
+				std::map<std::pair<Message::HostName, Message::Address>, Message::Index> activeOutgoingMessageByTarget;
+
+				std::vector<std::shared_ptr<FleetCommand>> newFleetCommands;
+
+				// Fleet commands waiting for acks, by base index (each covers [baseIndex, baseIndex + size) )
+				std::map<Message::Index, std::shared_ptr<FleetCommand>> activeFleetCommands;
+
+				// Fleet commands whose pending targets should be sent (again)
+				std::vector<std::shared_ptr<FleetCommand>> fleetSendQueue;
+				FleetStatistics fleetStatistics;
+
+				TimerWheel retryTimers;
+				std::vector<Message::Index> expiredRetryTimers;
+				std::map<Message::HostName, Destination> destinations;
+				size_t queuedCount = 0;
+
+				mutable std::mutex stateMutex;
+				std::condition_variable sendCondition;
+
 				int portLocal;
 				int portRemote;
 
-				std::unique_ptr<ofxOscReceiver> receiver;
-				std::map<Message::Address, std::unique_ptr<ofxOscSender>> senders;
+				std::unique_ptr<Listener> listener;
+				std::unique_ptr<UdpListeningReceiveSocket> receiveSocket;
+				std::unique_ptr<UdpSocket> fleetSocket; // owned by the send thread
 
 				std::thread receiveThread;
 				std::thread sendThread;
 				bool isClosing = false;
 				bool isOpen = false;
 
-				bool ackTimeLoggingEnabled = false;
+				std::atomic<bool> ackTimeLoggingEnabled{ false };
 			};
 		}
 	}
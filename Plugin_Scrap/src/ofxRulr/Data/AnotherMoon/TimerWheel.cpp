@@ -0,0 +1,134 @@
+#include "TimerWheel.h"
+
+using namespace std;
+
+namespace ofxRulr {
+	namespace Data {
+		namespace AnotherMoon {
+			//----------
+			TimerWheel::TimerWheel(const std::chrono::milliseconds& tickPeriod)
+				: tickPeriod(tickPeriod)
+			{
+
+			}
+
+			//----------
+			void
+				TimerWheel::schedule(Message::Index index, const TimePoint& dueTime)
+			{
+				// If nothing is pending then we can jump straight to now
+				if (this->count == 0) {
+					this->currentTick = max(this->currentTick, this->toTick(chrono::system_clock::now()));
+				}
+
+				Timer timer;
+				{
+					timer.index = index;
+					timer.dueTick = max(this->toTick(dueTime), this->currentTick + 1);
+				}
+				this->insert(timer);
+				this->count++;
+			}
+
+			//----------
+			void
+				TimerWheel::advance(const TimePoint& now, vector<Message::Index>& expired)
+			{
+				auto nowTick = this->toTick(now);
+
+				if (this->count == 0) {
+					this->currentTick = max(this->currentTick, nowTick);
+					return;
+				}
+
+				while (this->currentTick < nowTick) {
+					this->currentTick++;
+
+					// Move timers down from the coarser levels as we enter their slot
+					if ((this->currentTick & slotMask) == 0) {
+						if (((this->currentTick >> slotBits) & slotMask) == 0) {
+							this->cascade(2);
+						}
+						this->cascade(1);
+					}
+
+					auto& slot = this->slots[0][this->currentTick & slotMask];
+					for (const auto& timer : slot) {
+						expired.push_back(timer.index);
+					}
+					this->count -= slot.size();
+					slot.clear();
+
+					if (this->count == 0) {
+						this->currentTick = nowTick;
+						break;
+					}
+				}
+			}
+
+			//----------
+			bool
+				TimerWheel::empty() const
+			{
+				return this->count == 0;
+			}
+
+			//----------
+			size_t
+				TimerWheel::size() const
+			{
+				return this->count;
+			}
+
+			//----------
+			TimerWheel::TimePoint
+				TimerWheel::getNextTickTime() const
+			{
+				return this->startTime + this->tickPeriod * (this->currentTick + 1);
+			}
+
+			//----------
+			uint64_t
+				TimerWheel::toTick(const TimePoint& time) const
+			{
+				if (time <= this->startTime) {
+					return 0;
+				}
+				return (uint64_t) chrono::duration_cast<chrono::milliseconds>(time - this->startTime).count()
+					/ (uint64_t) this->tickPeriod.count();
+			}
+
+			//----------
+			void
+				TimerWheel::insert(const Timer& timer)
+			{
+				auto delta = timer.dueTick - this->currentTick;
+
+				if (delta < slotCount) {
+					this->slots[0][timer.dueTick & slotMask].push_back(timer);
+				}
+				else if (delta < (slotCount << slotBits)) {
+					this->slots[1][(timer.dueTick >> slotBits) & slotMask].push_back(timer);
+				}
+				else {
+					// Beyond the range of the wheel, park it in the furthest slot and it will be re-inserted when it cascades
+					auto tick = min(timer.dueTick, this->currentTick + (slotCount << (2 * slotBits)) - 1);
+					this->slots[2][(tick >> (2 * slotBits)) & slotMask].push_back(timer);
+				}
+			}
+
+			//----------
+			void
+				TimerWheel::cascade(size_t level)
+			{
+				auto& slot = this->slots[level][(this->currentTick >> (level * slotBits)) & slotMask];
+
+				vector<Timer> timers;
+				swap(timers, slot);
+				for (const auto& timer : timers) {
+					this->insert(timer);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Message.h"
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+namespace ofxRulr {
+	namespace Data {
+		namespace AnotherMoon {
+			/// <summary>
+			/// Hierarchical timer wheel of message indices (3 levels of 64 slots).
+			/// Scheduling and expiring are O(1) per timer regardless of how many are pending.
+			/// Timers can't be cancelled, so the owner should ignore expired indices which are no longer relevant.
+			/// </summary>
+			class TimerWheel {
+			public:
+				typedef std::chrono::system_clock::time_point TimePoint;
+
+				TimerWheel(const std::chrono::milliseconds& tickPeriod = std::chrono::milliseconds(10));
+
+				void schedule(Message::Index, const TimePoint& dueTime);
+
+				// Appends the indices of all timers due at or before now
+				void advance(const TimePoint& now, std::vector<Message::Index>& expired);
+
+				bool empty() const;
+				size_t size() const;
+
+				// When the next call to advance might expire a timer
+				TimePoint getNextTickTime() const;
+			protected:
+				static const size_t levelCount = 3;
+				static const size_t slotBits = 6;
+				static const size_t slotCount = 1 << slotBits;
+				static const uint64_t slotMask = slotCount - 1;
+
+				struct Timer {
+					Message::Index index;
+					uint64_t dueTick;
+				};
+
+				uint64_t toTick(const TimePoint&) const;
+				void insert(const Timer&);
+				void cascade(size_t level);
+
+				std::chrono::milliseconds tickPeriod;
+				TimePoint startTime = std::chrono::system_clock::now();
+				uint64_t currentTick = 0; // last tick which has been processed
+				size_t count = 0;
+
+				std::array<std::array<std::vector<Timer>, slotCount>, levelCount> slots;
+			};
+		}
+	}
+}
\ No newline at end of file
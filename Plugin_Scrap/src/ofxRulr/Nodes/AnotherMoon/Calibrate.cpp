@@ -44,6 +44,7 @@ namespace ofxRulr {
 			{
 				Utils::serialize(json, "projectionPoint", this->projectionPoint);
 				Utils::serialize(json, "residual", this->residual);
+				Utils::serialize(json, "isOutlier", this->isOutlier);
 				Utils::serialize(json, "isOffset", this->isOffset);
 
 				this->onImage.serialize(json["onImage"]);
@@ -73,6 +74,7 @@ namespace ofxRulr {
 
 				Utils::deserialize(json, "projectionPoint", this->projectionPoint);
 				Utils::deserialize(json, "residual", this->residual);
+				Utils::deserialize(json, "isOutlier", this->isOutlier);
 				Utils::deserialize(json, "isOffset", this->isOffset);
 
 				if (json.contains("onImage")) {
@@ -597,6 +599,16 @@ namespace ofxRulr {
 						});
 				}
 
+				inspector->addButton("Export beam capture residuals", [this]() {
+					try {
+						auto result = ofSystemSaveDialog("residuals.csv", "Export beam capture residuals");
+						if (result.bSuccess) {
+							this->exportBeamCaptureResiduals(result.filePath);
+						}
+					}
+					RULR_CATCH_ALL_TO_ALERT;
+					});
+
 				inspector->addSpacer();
 
 				inspector->addButton("Fix missing serial numbers", [this]() {
@@ -1067,6 +1079,36 @@ goto_endCameraCapture:
 				}
 			}
 
+			//----------
+			void
+				Calibrate::exportBeamCaptureResiduals(const filesystem::path& path) const
+			{
+				ofstream file(path.string());
+				if (!file.is_open()) {
+					throw(ofxRulr::Exception("Failed to open " + path.string() + " for writing"));
+				}
+
+				file << "Camera,Laser,Projection point X,Projection point Y,Residual [px],Outlier,Selected" << endl;
+
+				auto cameraCaptures = this->cameraCaptures.getSelection();
+				for (auto cameraCapture : cameraCaptures) {
+					auto laserCaptures = cameraCapture->laserCaptures.getSelection();
+					for (auto laserCapture : laserCaptures) {
+						auto beamCaptures = laserCapture->beamCaptures.getAllCaptures();
+						for (auto beamCapture : beamCaptures) {
+							file << cameraCapture->getName()
+								<< "," << laserCapture->serialNumber
+								<< "," << beamCapture->projectionPoint.x
+								<< "," << beamCapture->projectionPoint.y
+								<< "," << beamCapture->residual
+								<< "," << (beamCapture->isOutlier ? 1 : 0)
+								<< "," << (beamCapture->isSelected() ? 1 : 0)
+								<< endl;
+						}
+					}
+				}
+			}
+
 			//----------
 			vector<glm::vec2>
 				Calibrate::getCalibrationImagePoints() const
@@ -26,6 +26,10 @@ namespace ofxRulr {
 					, (NextBeam, NextLaser, End)
 					, ("NextBeam", "NextLaser", "End"));
 
+				MAKE_ENUM(RobustLoss
+					, (None, Huber, Cauchy)
+					, ("None", "Huber", "Cauchy"));
+
 				struct ImagePath {
 					void serialize(nlohmann::json&);
 					void deserialize(const nlohmann::json&);
@@ -72,6 +76,7 @@ namespace ofxRulr {
 
 					Utils::EditSelection<BeamCapture>* parentSelection = nullptr;
 					float residual = 0.0f;
+					bool isOutlier = false; // as classified by the robust bundle adjustment
 
 					/// <summary>
 					/// Denotes if the projectionPoint is offset by the lasers' centerOffset when captured.
@@ -167,6 +172,7 @@ namespace ofxRulr {
 				void calibrateBundleAdjustLasers(bool performSolve); // Otherwise just get the residuals
 
 				void pruneBeamCapturesByResidual(float);
+				void exportBeamCaptureResiduals(const filesystem::path&) const;
 
 				Utils::EditSelection<CameraCapture> cameraEditSelection;
 
@@ -304,6 +310,24 @@ namespace ofxRulr {
 							PARAM_DECLARE("Fixed", lasers, cameras)
 						} fixed;
 
+						struct : ofParameterGroup {
+							ofParameter<bool> enabled{ "Enabled", false };
+							ofParameter<RobustLoss> loss{ "Loss", RobustLoss::Huber };
+							ofParameter<float> lossScale{ "Loss scale [px]", 2, 0.01, 100 };
+							ofParameter<int> maxPasses{ "Max passes", 5 };
+							ofParameter<float> outlierThreshold{ "Outlier threshold [x median]", 3, 1, 100 };
+							ofParameter<float> minOutlierResidual{ "Min outlier residual [px]", 1, 0, 100 };
+							ofParameter<bool> deselectOutliers{ "Deselect outliers", true };
+							PARAM_DECLARE("Robust"
+								, enabled
+								, loss
+								, lossScale
+								, maxPasses
+								, outlierThreshold
+								, minOutlierResidual
+								, deselectOutliers);
+						} robust;
+
 						SolverSettings solverSettings;
 
 						PARAM_DECLARE("Bundle adjustment"
@@ -312,6 +336,7 @@ namespace ofxRulr {
 							, cameraWith0Yaw
 							, planeConstraint
 							, fixed
+							, robust
 							, solverSettings);
 					} bundleAdjustment;
 
@@ -181,11 +181,37 @@ namespace ofxRulr {
 
 				// Solve the problem
 				Solvers::BundleAdjustmentLasers::Solution solution;
+				const auto& robustParameters = this->parameters.bundleAdjustment.robust;
+				const bool robustSolve = performSolve && robustParameters.enabled.get();
 				if (performSolve) {
 					auto solverSettings = Solvers::BundleAdjustmentLasers::defaultSolverSettings();
 					this->configureSolverSettings(solverSettings, this->parameters.bundleAdjustment.solverSettings);
-					auto result = problem.solve(solverSettings);
-					solution = result.solution;
+
+					if (robustSolve) {
+						Solvers::BundleAdjustmentLasers::RobustSettings robustSettings;
+						switch (robustParameters.loss.get().get()) {
+						case RobustLoss::Huber:
+							robustSettings.loss = Solvers::BundleAdjustmentLasers::Loss::Huber;
+							break;
+						case RobustLoss::Cauchy:
+							robustSettings.loss = Solvers::BundleAdjustmentLasers::Loss::Cauchy;
+							break;
+						default:
+							robustSettings.loss = Solvers::BundleAdjustmentLasers::Loss::None;
+							break;
+						}
+						robustSettings.lossScale = robustParameters.lossScale.get();
+						robustSettings.maxPasses = robustParameters.maxPasses.get();
+						robustSettings.outlierThreshold = robustParameters.outlierThreshold.get();
+						robustSettings.minOutlierResidual = robustParameters.minOutlierResidual.get();
+
+						auto result = problem.solveRobust(solverSettings, robustSettings);
+						solution = result.solution;
+					}
+					else {
+						auto result = problem.solve(solverSettings);
+						solution = result.solution;
+					}
 				}
 				else {
 					solution = initialSolution;
@@ -221,6 +247,28 @@ namespace ofxRulr {
 					associatedImage.beamCapture->residual = residual;
 				}
 
+				// Store the inlier classification of the robust solve (observations are in the order they were added)
+				if (robustSolve) {
+					auto observationResiduals = problem.getObservationResiduals();
+					size_t outlierCount = 0;
+					for (size_t i = 0; i < associatedImages.size(); i++) {
+						auto beamCapture = associatedImages[i].beamCapture;
+						beamCapture->isOutlier = !observationResiduals[i].inlier;
+						if (beamCapture->isOutlier) {
+							outlierCount++;
+							if (robustParameters.deselectOutliers.get()) {
+								beamCapture->setSelected(false);
+							}
+						}
+					}
+					ofLogNotice("Calibrate") << "Bundle adjust lasers : " << outlierCount << " / " << associatedImages.size() << " beam captures are outliers";
+				}
+				else if (performSolve) {
+					for (const auto& associatedImage : associatedImages) {
+						associatedImage.beamCapture->isOutlier = false;
+					}
+				}
+
 				scopedProcess.end();
 			}
 		}
@@ -70,9 +70,11 @@ namespace ofxRulr {
 						auto period = chrono::milliseconds(this->parameters.communications.keepAlive.period.get());
 						if (this->lastKeepAliveSent + period < now) {
 							this->lastKeepAliveSent = now;
-							auto message = this->createOutgoingMessageOnce();
-							message->setAddress("/keepAlive");
-							this->sendMessage(message);
+							if (this->parent->isCommunicationEnabled()) {
+								// Sent as one command with the keep alives of all other lasers this frame
+								this->parent->fleetScheduler.queueKeepAlive(this->getHostname());
+								this->isFrameNewTransmit.notify();
+							}
 						}
 					}
 				}
@@ -80,28 +82,28 @@ namespace ofxRulr {
 				// Check all parameters for stale and push if needed
 				{
 					if(this->parameters.deviceState.state.get() != this->sentDeviceParameters.state.get()) {
-						this->pushState();
+						this->queueDeviceCommand(DeviceCommand::State);
 					}
 
 					if (this->parameters.deviceState.localKeepAlive.get() != this->sentDeviceParameters.localKeepAlive.get()) {
-						this->pushLocalKeepAlive();
+						this->queueDeviceCommand(DeviceCommand::LocalKeepAlive);
 					}
 
 					if (this->parameters.deviceState.projection.source.get() != this->sentDeviceParameters.projection.source.get()) {
-						this->pushSource();
+						this->queueDeviceCommand(DeviceCommand::Source);
 					}
 
 					if (this->parameters.deviceState.projection.color.red.get() != this->sentDeviceParameters.projection.color.red.get()
 						|| this->parameters.deviceState.projection.color.green.get() != this->sentDeviceParameters.projection.color.green.get()
 						|| this->parameters.deviceState.projection.color.blue.get() != this->sentDeviceParameters.projection.color.blue.get()) {
-						this->pushColor();
+						this->queueDeviceCommand(DeviceCommand::Color);
 					}
 
 					if (this->parameters.deviceState.projection.transform.sizeX.get() != this->sentDeviceParameters.projection.transform.sizeX.get()
 						|| this->parameters.deviceState.projection.transform.sizeY.get() != this->sentDeviceParameters.projection.transform.sizeY.get()
 						|| this->parameters.deviceState.projection.transform.offsetX.get() != this->sentDeviceParameters.projection.transform.offsetX.get()
 						|| this->parameters.deviceState.projection.transform.offsetY.get() != this->sentDeviceParameters.projection.transform.offsetY.get()) {
-						this->pushTransform();
+						this->queueDeviceCommand(DeviceCommand::Transform);
 					}
 
 					if (this->parameters.deviceState.projection.circle.sizeX.get() != this->sentDeviceParameters.projection.circle.sizeX.get()
@@ -110,7 +112,7 @@ namespace ofxRulr {
 						|| this->parameters.deviceState.projection.circle.offsetY.get() != this->sentDeviceParameters.projection.circle.offsetY.get()
 						|| this->parameters.deviceState.projection.circle.frequency.get() != this->sentDeviceParameters.projection.circle.frequency.get()
 						|| this->parameters.deviceState.projection.circle.phase.get() != this->sentDeviceParameters.projection.circle.phase.get()) {
-						this->pushCircle();
+						this->queueDeviceCommand(DeviceCommand::Circle);
 					}
 				}
 
@@ -406,129 +408,54 @@ namespace ofxRulr {
 			future<void>
 				Laser::pushState()
 			{
-				auto message = this->createOutgoingMessageRetry();
-				{
-					message->setAddress("/device/setState");
-					message->addInt32Arg(this->parameters.deviceState.state.get().toIndex());
-				}
-				auto future = message->onSent.get_future();
-				this->sendMessage(message);
-
-				this->sentDeviceParameters.state.set(this->parameters.deviceState.state.get());
-				return future;
+				return this->pushDeviceCommand(DeviceCommand::State);
 			}
 
 			//----------
 			future<void>
 				Laser::pushLocalKeepAlive()
 			{
-				auto message = this->createOutgoingMessageRetry();
-				{
-					message->setAddress("/device/keepAlive");
-					message->addBoolArg(this->parameters.deviceState.localKeepAlive.get());
-				}
-				auto future = message->onSent.get_future();
-				this->sendMessage(message);
-
-				this->sentDeviceParameters.localKeepAlive.set(this->parameters.deviceState.localKeepAlive.get());
-				return future;
+				return this->pushDeviceCommand(DeviceCommand::LocalKeepAlive);
 			}
 
 			//----------
 			future<void>
 				Laser::pushSource()
 			{
-				auto message = this->createOutgoingMessageRetry();
-				{
-					message->setAddress("/device/setSource");
-					message->addInt32Arg(this->parameters.deviceState.projection.source.get().toIndex());
-				}
-				auto future = message->onSent.get_future();
-				this->sendMessage(message);
-
-				this->sentDeviceParameters.projection.source.set(this->parameters.deviceState.projection.source.get());
-				return future;
+				return this->pushDeviceCommand(DeviceCommand::Source);
 			}
 
 			//----------
 			future<void>
 				Laser::pushColor()
 			{
-				auto message = this->createOutgoingMessageRetry();
-				{
-					message->setAddress("/device/setColor");
-					message->addFloatArg(this->parameters.deviceState.projection.color.red.get());
-					message->addFloatArg(this->parameters.deviceState.projection.color.green.get());
-					message->addFloatArg(this->parameters.deviceState.projection.color.blue.get());
-				}
-				auto future = message->onSent.get_future();
-				this->sendMessage(message);
-
-				this->sentDeviceParameters.projection.color.red.set(this->parameters.deviceState.projection.color.red.get());
-				this->sentDeviceParameters.projection.color.green.set(this->parameters.deviceState.projection.color.green.get());
-				this->sentDeviceParameters.projection.color.blue.set(this->parameters.deviceState.projection.color.blue.get());
-				return future;
+				return this->pushDeviceCommand(DeviceCommand::Color);
 			}
 
 			//----------
 			future<void>
 				Laser::pushTransform()
 			{
-				auto message = this->createOutgoingMessageRetry();
-				{
-					message->setAddress("/device/setTransform");
-					message->addFloatArg(this->parameters.deviceState.projection.transform.sizeX.get());
-					message->addFloatArg(this->parameters.deviceState.projection.transform.sizeY.get());
-					message->addFloatArg(this->parameters.deviceState.projection.transform.offsetX.get());
-					message->addFloatArg(this->parameters.deviceState.projection.transform.offsetY.get());
-				}
-				auto future = message->onSent.get_future();
-				this->sendMessage(message);
-
-				this->sentDeviceParameters.projection.transform.sizeX.set(this->parameters.deviceState.projection.transform.sizeX.get());
-				this->sentDeviceParameters.projection.transform.sizeY.set(this->parameters.deviceState.projection.transform.sizeY.get());
-				this->sentDeviceParameters.projection.transform.offsetX.set(this->parameters.deviceState.projection.transform.offsetX.get());
-				this->sentDeviceParameters.projection.transform.offsetY.set(this->parameters.deviceState.projection.transform.offsetY.get());
-				return future;
+				return this->pushDeviceCommand(DeviceCommand::Transform);
 			}
 
 			//----------
 			future<void>
 				Laser::pushCircle()
 			{
-				auto message = this->createOutgoingMessageRetry();
-				{
-					message->setAddress("/device/setCircle");
-					message->addFloatArg(this->parameters.deviceState.projection.circle.sizeX.get());
-					message->addFloatArg(this->parameters.deviceState.projection.circle.sizeY.get());
-					message->addFloatArg(this->parameters.deviceState.projection.circle.offsetX.get());
-					message->addFloatArg(this->parameters.deviceState.projection.circle.offsetY.get());
-					message->addFloatArg(this->parameters.deviceState.projection.circle.phase.get());
-					message->addFloatArg(this->parameters.deviceState.projection.circle.frequency.get());
-				}
-				auto future = message->onSent.get_future();
-				this->sendMessage(message);
-
-				this->sentDeviceParameters.projection.circle.sizeX.set(this->parameters.deviceState.projection.circle.sizeX.get());
-				this->sentDeviceParameters.projection.circle.sizeY.set(this->parameters.deviceState.projection.circle.sizeY.get());
-				this->sentDeviceParameters.projection.circle.offsetX.set(this->parameters.deviceState.projection.circle.offsetX.get());
-				this->sentDeviceParameters.projection.circle.offsetY.set(this->parameters.deviceState.projection.circle.offsetY.get());
-				this->sentDeviceParameters.projection.circle.phase.set(this->parameters.deviceState.projection.circle.phase.get());
-				this->sentDeviceParameters.projection.circle.frequency.set(this->parameters.deviceState.projection.circle.frequency.get());
-
-				return future;
+				return this->pushDeviceCommand(DeviceCommand::Circle);
 			}
 
 			//----------
 			void
 				Laser::pushAll()
 			{
-				this->pushState();
-				this->pushLocalKeepAlive();
-				this->pushSource();
-				this->pushColor();
-				this->pushTransform();
-				this->pushCircle();
+				this->queueDeviceCommand(DeviceCommand::State);
+				this->queueDeviceCommand(DeviceCommand::LocalKeepAlive);
+				this->queueDeviceCommand(DeviceCommand::Source);
+				this->queueDeviceCommand(DeviceCommand::Color);
+				this->queueDeviceCommand(DeviceCommand::Transform);
+				this->queueDeviceCommand(DeviceCommand::Circle);
 			}
 
 			//----------
@@ -686,6 +613,120 @@ namespace ofxRulr {
 				}
 			}
 
+			//----------
+			void
+				Laser::buildDeviceMessage(DeviceCommand deviceCommand, ofxOscMessage& message) const
+			{
+				const auto& deviceState = this->parameters.deviceState;
+				switch (deviceCommand) {
+				case DeviceCommand::State:
+				{
+					auto state = deviceState.state.get();
+					message.setAddress("/device/setState");
+					message.addInt32Arg(state.toIndex());
+					break;
+				}
+				case DeviceCommand::LocalKeepAlive:
+					message.setAddress("/device/keepAlive");
+					message.addBoolArg(deviceState.localKeepAlive.get());
+					break;
+				case DeviceCommand::Source:
+				{
+					auto source = deviceState.projection.source.get();
+					message.setAddress("/device/setSource");
+					message.addInt32Arg(source.toIndex());
+					break;
+				}
+				case DeviceCommand::Color:
+					message.setAddress("/device/setColor");
+					message.addFloatArg(deviceState.projection.color.red.get());
+					message.addFloatArg(deviceState.projection.color.green.get());
+					message.addFloatArg(deviceState.projection.color.blue.get());
+					break;
+				case DeviceCommand::Transform:
+					message.setAddress("/device/setTransform");
+					message.addFloatArg(deviceState.projection.transform.sizeX.get());
+					message.addFloatArg(deviceState.projection.transform.sizeY.get());
+					message.addFloatArg(deviceState.projection.transform.offsetX.get());
+					message.addFloatArg(deviceState.projection.transform.offsetY.get());
+					break;
+				case DeviceCommand::Circle:
+					message.setAddress("/device/setCircle");
+					message.addFloatArg(deviceState.projection.circle.sizeX.get());
+					message.addFloatArg(deviceState.projection.circle.sizeY.get());
+					message.addFloatArg(deviceState.projection.circle.offsetX.get());
+					message.addFloatArg(deviceState.projection.circle.offsetY.get());
+					message.addFloatArg(deviceState.projection.circle.phase.get());
+					message.addFloatArg(deviceState.projection.circle.frequency.get());
+					break;
+				}
+			}
+
+			//----------
+			void
+				Laser::markDeviceCommandSent(DeviceCommand deviceCommand)
+			{
+				const auto& deviceState = this->parameters.deviceState;
+				auto& sent = this->sentDeviceParameters;
+				switch (deviceCommand) {
+				case DeviceCommand::State:
+					sent.state.set(deviceState.state.get());
+					break;
+				case DeviceCommand::LocalKeepAlive:
+					sent.localKeepAlive.set(deviceState.localKeepAlive.get());
+					break;
+				case DeviceCommand::Source:
+					sent.projection.source.set(deviceState.projection.source.get());
+					break;
+				case DeviceCommand::Color:
+					sent.projection.color.red.set(deviceState.projection.color.red.get());
+					sent.projection.color.green.set(deviceState.projection.color.green.get());
+					sent.projection.color.blue.set(deviceState.projection.color.blue.get());
+					break;
+				case DeviceCommand::Transform:
+					sent.projection.transform.sizeX.set(deviceState.projection.transform.sizeX.get());
+					sent.projection.transform.sizeY.set(deviceState.projection.transform.sizeY.get());
+					sent.projection.transform.offsetX.set(deviceState.projection.transform.offsetX.get());
+					sent.projection.transform.offsetY.set(deviceState.projection.transform.offsetY.get());
+					break;
+				case DeviceCommand::Circle:
+					sent.projection.circle.sizeX.set(deviceState.projection.circle.sizeX.get());
+					sent.projection.circle.sizeY.set(deviceState.projection.circle.sizeY.get());
+					sent.projection.circle.offsetX.set(deviceState.projection.circle.offsetX.get());
+					sent.projection.circle.offsetY.set(deviceState.projection.circle.offsetY.get());
+					sent.projection.circle.phase.set(deviceState.projection.circle.phase.get());
+					sent.projection.circle.frequency.set(deviceState.projection.circle.frequency.get());
+					break;
+				}
+			}
+
+			//----------
+			future<void>
+				Laser::pushDeviceCommand(DeviceCommand deviceCommand)
+			{
+				auto message = this->createOutgoingMessageRetry();
+				this->buildDeviceMessage(deviceCommand, *message);
+				auto future = message->onSent.get_future();
+				this->sendMessage(message);
+
+				this->markDeviceCommandSent(deviceCommand);
+				return future;
+			}
+
+			//----------
+			void
+				Laser::queueDeviceCommand(DeviceCommand deviceCommand)
+			{
+				if (this->parent->isCommunicationEnabled()) {
+					ofxOscMessage message;
+					this->buildDeviceMessage(deviceCommand, message);
+					this->parent->fleetScheduler.queue(this->getHostname(), message);
+					this->isFrameNewTransmit.notify();
+				}
+
+				this->markDeviceCommandSent(deviceCommand);
+			}
+
 			//----------
 			void
 				Laser::processIncomingMessage(shared_ptr<IncomingMessage> message)
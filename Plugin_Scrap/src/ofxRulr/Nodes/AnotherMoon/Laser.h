@@ -82,6 +82,7 @@ namespace ofxRulr {
 				std::future<void> pushTransform();
 				std::future<void> pushCircle();
 
+				// Queued with the rest of the fleet (sent at the end of Lasers::update)
 				void pushAll();
 
 				std::future<void> drawCircle(glm::vec2 center, float radius);
@@ -178,6 +179,25 @@ namespace ofxRulr {
 				void callbackIntrinsicsChange(glm::vec2&);
 				void updatePicturePreviewWorld();
 
+				enum class DeviceCommand {
+					State,
+					LocalKeepAlive,
+					Source,
+					Color,
+					Transform,
+					Circle
+				};
+
+				// Address and arguments (without the index) for a device parameter command
+				void buildDeviceMessage(DeviceCommand, ofxOscMessage&) const;
+				void markDeviceCommandSent(DeviceCommand);
+
+				// Send now (own message and future)
+				std::future<void> pushDeviceCommand(DeviceCommand);
+
+				// Send with the rest of the fleet at the end of the frame
+				void queueDeviceCommand(DeviceCommand);
+
 				Lasers* parent;
 
 				shared_ptr<Item::RigidBody> rigidBody = make_shared<Item::RigidBody>();
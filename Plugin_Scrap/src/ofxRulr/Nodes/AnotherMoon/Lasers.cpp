@@ -74,18 +74,32 @@ namespace ofxRulr {
 
 				// Perform communications
 				{
+					// Send what the lasers queued this frame
+					if (this->isCommunicationEnabled()) {
+						this->fleetScheduler.flush(this->messageRouter
+							, chrono::milliseconds(this->parameters.communications.retryDuration.get())
+							, chrono::milliseconds(this->parameters.communications.retryPeriod.get()));
+					}
+					else {
+						this->fleetScheduler.clear();
+					}
+
 					auto lasers = this->getLasersAll();
 
+					// Lookup lasers by hostname (first laser wins if a hostname is repeated)
+					map<string, shared_ptr<Laser>> lasersByHostname;
+					for (auto it = lasers.rbegin(); it != lasers.rend(); it++) {
+						lasersByHostname[(*it)->getHostname()] = *it;
+					}
+
 					// Messages
 					{
 						shared_ptr<IncomingMessage> incomingMessage;
 						while (this->messageRouter.getIncomingMessage(incomingMessage)) {
 							// find the matching laser
-							for (auto laser : lasers) {
-								if (laser->getHostname() == incomingMessage->getRemoteHost()) {
-									laser->processIncomingMessage(incomingMessage);
-									break;
-								}
+							auto findLaser = lasersByHostname.find(incomingMessage->getRemoteHost());
+							if (findLaser != lasersByHostname.end()) {
+								findLaser->second->processIncomingMessage(incomingMessage);
 							}
 						}
 					}
@@ -95,11 +109,9 @@ namespace ofxRulr {
 						shared_ptr<AckMessageIncoming> incomingMessage;
 						while (this->messageRouter.getIncomingAck(incomingMessage)) {
 							// find the matching laser
-							for (auto laser : lasers) {
-								if (laser->getHostname() == incomingMessage->getRemoteHost()) {
-									laser->processIncomingAck(incomingMessage);
-									break;
-								}
+							auto findLaser = lasersByHostname.find(incomingMessage->getRemoteHost());
+							if (findLaser != lasersByHostname.end()) {
+								findLaser->second->processIncomingAck(incomingMessage);
 							}
 						}
 
@@ -203,6 +215,34 @@ namespace ofxRulr {
 				inspector->addButton("Push full state", [this]() {
 					pushAllSelected();
 					}, OF_KEY_RETURN)->setHeight(100.0f);
+
+				inspector->addTitle("Fleet", ofxCvGui::Widgets::Title::Level::H3);
+				{
+					inspector->addLiveValue<size_t>("Active commands", [this]() {
+						return this->messageRouter.getFleetStatistics().activeCommands;
+						});
+					inspector->addLiveValue<size_t>("Lasers waiting for ack", [this]() {
+						return this->messageRouter.getFleetStatistics().pendingTargets;
+						});
+					inspector->addLiveValue<size_t>("Acks received", [this]() {
+						return this->messageRouter.getFleetStatistics().ackedTargets;
+						});
+					inspector->addLiveValue<size_t>("Timeouts", [this]() {
+						return this->messageRouter.getFleetStatistics().timedOutTargets;
+						});
+					inspector->addLiveValue<size_t>("Packets sent", [this]() {
+						return this->messageRouter.getFleetStatistics().packetsSent;
+						});
+					inspector->addLiveValue<size_t>("Messages queued", [this]() {
+						return this->fleetScheduler.getStatistics().messagesQueued;
+						});
+					inspector->addLiveValue<size_t>("Commands sent", [this]() {
+						return this->fleetScheduler.getStatistics().commandsSent;
+						});
+					inspector->addLiveValue<size_t>("Encoded messages cached", [this]() {
+						return this->fleetScheduler.getStatistics().encodedCacheSize;
+						});
+				}
 			}
 
 			//----------
@@ -4,6 +4,7 @@
 #include "ofxRulr.h"
 #include "ofxRulr/Utils/CaptureSet.h"
 #include "ofxRulr/Data/AnotherMoon/MessageRouter.h"
+#include "ofxRulr/Data/AnotherMoon/FleetScheduler.h"
 
 #include "ofxOsc.h"
 
@@ -56,6 +57,7 @@ namespace ofxRulr {
 				shared_ptr<ofxCvGui::Panels::Widgets> panel;
 
 				Data::AnotherMoon::MessageRouter messageRouter;
+				Data::AnotherMoon::FleetScheduler fleetScheduler;
 
 				struct : ofParameterGroup {
 					struct : ofParameterGroup {
@@ -0,0 +1,260 @@
+#include "pch_Plugin_Scrap.h"
+#include "SolverBenchmark.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace AnotherMoon {
+			//----------
+			SolverBenchmark::SolverBenchmark()
+			{
+				RULR_NODE_INIT_LISTENER;
+			}
+
+			//----------
+			string
+				SolverBenchmark::getTypeName() const
+			{
+				return "AnotherMoon::SolverBenchmark";
+			}
+
+			//----------
+			void
+				SolverBenchmark::init()
+			{
+				this->manageParameters(this->parameters);
+			}
+
+			//----------
+			void
+				SolverBenchmark::runTrial(size_t trial)
+			{
+				this->runPoints(trial);
+				this->runLasers(trial);
+			}
+
+			//----------
+			void
+				SolverBenchmark::runPoints(size_t trial)
+			{
+				const auto cameraIntrinsics = this->getCameraIntrinsics();
+				const auto cameraViewTransforms = this->makeCameraViewTransforms();
+				const auto pointCount = (size_t)max(this->parameters.points.count.get(), 4);
+				const auto distance = this->parameters.distance.get();
+				const auto spread = this->parameters.spread.get();
+				const auto imageNoise = this->parameters.noise.imageNoise.get();
+
+				// Ground truth
+				Solvers::BundleAdjustmentPoints::Solution groundTruth;
+				groundTruth.cameraViewTransforms = cameraViewTransforms;
+				for (size_t i = 0; i < pointCount; i++) {
+					groundTruth.worldPoints.emplace_back(ofRandomf() * spread
+						, ofRandomf() * spread
+						, -distance + ofRandomf() * spread);
+				}
+
+				glm::vec3 sceneCenter;
+				float sceneRadius = 0.0f;
+				{
+					for (const auto& worldPoint : groundTruth.worldPoints) {
+						sceneCenter += worldPoint;
+					}
+					sceneCenter /= (float)pointCount;
+					for (const auto& worldPoint : groundTruth.worldPoints) {
+						sceneRadius = max(sceneRadius, glm::distance(worldPoint, sceneCenter));
+					}
+				}
+
+				// Observations
+				vector<Solvers::BundleAdjustmentPoints::Image> images;
+				for (size_t viewIndex = 0; viewIndex < cameraViewTransforms.size(); viewIndex++) {
+					Models::Camera camera(cameraViewTransforms[viewIndex], cameraIntrinsics);
+					for (size_t pointIndex = 0; pointIndex < pointCount; pointIndex++) {
+						auto imagePoint = camera.worldToImage(groundTruth.worldPoints[pointIndex])
+							+ glm::vec2(ofRandomf(), ofRandomf()) * imageNoise;
+						if (imagePoint.x < 0 || imagePoint.y < 0
+							|| imagePoint.x >= cameraIntrinsics.width || imagePoint.y >= cameraIntrinsics.height) {
+							continue;
+						}
+						images.push_back({
+							(int)pointIndex
+							, (int)viewIndex
+							, imagePoint
+							});
+					}
+				}
+
+				// Initial solution
+				auto initialSolution = groundTruth;
+				{
+					const auto positionError = this->parameters.noise.initialPosition.get();
+					const auto rotationError = this->parameters.noise.initialRotation.get();
+					for (auto& worldPoint : initialSolution.worldPoints) {
+						worldPoint += glm::vec3(ofRandomf(), ofRandomf(), ofRandomf()) * positionError;
+					}
+					for (size_t i = 1; i < initialSolution.cameraViewTransforms.size(); i++) {
+						auto& transform = initialSolution.cameraViewTransforms[i];
+						transform.translation += glm::vec3(ofRandomf(), ofRandomf(), ofRandomf()) * positionError;
+						transform.rotation += glm::vec3(ofRandomf(), ofRandomf(), ofRandomf()) * rotationError;
+					}
+				}
+
+				auto solverSettings = Solvers::BundleAdjustmentPoints::defaultSolverSettings();
+				solverSettings.printReport = false;
+
+				this->benchmark.measure("BundleAdjustmentPoints", "Points", pointCount, trial, [&](Utils::SolverBenchmark::Record& record) {
+					// Hold the gauge with the scene center and scale and the orientation of the first camera
+					// (the error includes any drift in the remaining pitch freedom)
+					Solvers::BundleAdjustmentPoints::Problem problem(initialSolution, cameraIntrinsics);
+					for (const auto& image : images) {
+						problem.addImagePointObservation(image, false);
+					}
+					problem.addSceneCenteredConstraint(sceneCenter);
+					problem.addSceneScaleConstraint(sceneRadius);
+					problem.addCameraZeroYawConstraint(0);
+					problem.addCameraZeroRollConstrant(0);
+
+					auto result = problem.solve(solverSettings);
+					record.residual = result.residual;
+					record.converged = result.isConverged();
+
+					// Mean point position error [m]
+					for (size_t i = 0; i < pointCount; i++) {
+						record.parameterError += glm::distance(result.solution.worldPoints[i], groundTruth.worldPoints[i]);
+					}
+					record.parameterError /= (float)pointCount;
+					});
+			}
+
+			//----------
+			void
+				SolverBenchmark::runLasers(size_t trial)
+			{
+				const auto cameraIntrinsics = this->getCameraIntrinsics();
+				const auto cameraViewTransforms = this->makeCameraViewTransforms();
+				const auto laserCount = (size_t)max(this->parameters.lasers.count.get(), 1);
+				const auto resolution = max(this->parameters.lasers.resolution.get(), 2);
+				const auto distance = this->parameters.distance.get();
+				const auto spread = this->parameters.spread.get();
+				const auto imageNoise = this->parameters.noise.imageNoise.get();
+
+				// Ground truth : lasers along the ground in front of the cameras, pointing up
+				Solvers::BundleAdjustmentLasers::Solution groundTruth;
+				groundTruth.cameraViewTransforms = cameraViewTransforms;
+				for (size_t i = 0; i < laserCount; i++) {
+					Models::LaserProjector laserProjector;
+					laserProjector.rigidBodyTransform.translation = {
+						ofRandomf() * spread
+						, -spread / 2.0f
+						, -distance + ofRandomf() * spread
+					};
+					laserProjector.rigidBodyTransform.rotation = {
+						-HALF_PI + ofRandomf() * 0.1f
+						, ofRandomf() * 0.1f
+						, ofRandomf() * 0.1f
+					};
+					laserProjector.fov = { 30, 30 };
+					laserProjector.fov2 = { 0, 0 };
+					groundTruth.laserProjectors.push_back(laserProjector);
+				}
+
+				// Observations (a line in each camera for each projected point)
+				vector<Solvers::BundleAdjustmentLasers::Image> images;
+				for (size_t cameraIndex = 0; cameraIndex < cameraViewTransforms.size(); cameraIndex++) {
+					Models::Camera camera(cameraViewTransforms[cameraIndex], cameraIntrinsics);
+					for (size_t laserIndex = 0; laserIndex < laserCount; laserIndex++) {
+						auto laserProjector = groundTruth.laserProjectors[laserIndex];
+						for (int j = 0; j < resolution; j++) {
+							for (int i = 0; i < resolution; i++) {
+								glm::vec2 projectedPoint{
+									ofMap(i, 0, resolution - 1, -1, 1)
+									, ofMap(j, 0, resolution - 1, -1, 1)
+								};
+
+								auto ray = laserProjector.castRayWorldSpace(projectedPoint);
+								auto imageLine = camera.worldToImage(ray);
+								auto lineNormal = glm::vec2(-imageLine.t.y, imageLine.t.x);
+								imageLine.s += lineNormal * ofRandomf() * imageNoise;
+
+								Solvers::BundleAdjustmentLasers::Image image;
+								image.cameraIndex = (int)cameraIndex;
+								image.laserProjectorIndex = (int)laserIndex;
+								image.imageLine = imageLine;
+								image.projectedPoint = projectedPoint;
+								images.push_back(image);
+							}
+						}
+					}
+				}
+
+				// Initial solution
+				auto initialSolution = groundTruth;
+				{
+					const auto positionError = this->parameters.noise.initialPosition.get();
+					const auto rotationError = this->parameters.noise.initialRotation.get();
+					for (auto& laserProjector : initialSolution.laserProjectors) {
+						laserProjector.rigidBodyTransform.translation += glm::vec3(ofRandomf(), ofRandomf(), ofRandomf()) * positionError;
+						laserProjector.rigidBodyTransform.rotation += glm::vec3(ofRandomf(), ofRandomf(), ofRandomf()) * rotationError;
+					}
+				}
+
+				auto solverSettings = Solvers::BundleAdjustmentLasers::defaultSolverSettings();
+				solverSettings.printReport = false;
+
+				this->benchmark.measure("BundleAdjustmentLasers", "Lasers", laserCount, trial, [&](Utils::SolverBenchmark::Record& record) {
+					// Cameras and FOVs are known, solve the laser poses
+					Solvers::BundleAdjustmentLasers::Problem problem(initialSolution, cameraIntrinsics);
+					for (const auto& image : images) {
+						problem.addLineImageObservation(image);
+					}
+					problem.setCamerasFixed();
+					problem.setLaserFOVsFixed();
+					problem.setLaserFOV2sFixed();
+
+					auto result = problem.solve(solverSettings);
+					record.residual = result.residual;
+					record.converged = result.isConverged();
+
+					// Mean laser position error [m]
+					for (size_t i = 0; i < laserCount; i++) {
+						record.parameterError += glm::distance(result.solution.laserProjectors[i].rigidBodyTransform.translation
+							, groundTruth.laserProjectors[i].rigidBodyTransform.translation);
+					}
+					record.parameterError /= (float)laserCount;
+					});
+			}
+
+			//----------
+			Models::Intrinsics
+				SolverBenchmark::getCameraIntrinsics() const
+			{
+				Models::Intrinsics cameraIntrinsics;
+				cameraIntrinsics.width = 1920;
+				cameraIntrinsics.height = 1080;
+				cameraIntrinsics.projectionMatrix = glm::perspective(60.0f * DEG_TO_RAD
+					, cameraIntrinsics.width / cameraIntrinsics.height
+					, 0.1f
+					, 1000.0f);
+				return cameraIntrinsics;
+			}
+
+			//----------
+			vector<Models::Transform>
+				SolverBenchmark::makeCameraViewTransforms() const
+			{
+				const auto cameraCount = (size_t)max(this->parameters.cameraCount.get(), 1);
+				vector<Models::Transform> cameraViewTransforms;
+				for (size_t i = 0; i < cameraCount; i++) {
+					// The first camera has zero yaw and roll (see the constraints in runPoints)
+					glm::vec3 rotation{ ofRandomf() * 0.05f, 0, 0 };
+					if (i > 0) {
+						rotation.y = ofRandomf() * 0.05f;
+						rotation.z = ofRandomf() * 0.05f;
+					}
+					glm::vec3 translation{ ofRandomf() * 0.5f, ofRandomf() * 0.5f, ofRandomf() * 0.5f };
+					cameraViewTransforms.emplace_back(translation, rotation);
+				}
+				return cameraViewTransforms;
+			}
+		}
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "ofxRulr.h"
+#include "ofxRulr/Nodes/Test/AbstractSolverBenchmark.h"
+#include "ofxRulr/Solvers/BundleAdjustmentPoints.h"
+#include "ofxRulr/Solvers/BundleAdjustmentLasers.h"
+
+namespace ofxRulr {
+	namespace Nodes {
+		namespace AnotherMoon {
+			// Runs the bundle adjustment solvers on synthetic scenes (cameras, points and lasers with known poses)
+			// and records time and error against the known positions
+			class SolverBenchmark : public Test::AbstractSolverBenchmark {
+			public:
+				SolverBenchmark();
+				string getTypeName() const override;
+				void init();
+			protected:
+				void runTrial(size_t trial) override;
+				void runPoints(size_t trial);
+				void runLasers(size_t trial);
+
+				Models::Intrinsics getCameraIntrinsics() const;
+
+				// Cameras at the origin looking down -z with small random offsets
+				vector<Models::Transform> makeCameraViewTransforms() const;
+
+				struct : ofParameterGroup {
+					ofParameter<int> cameraCount{ "Camera count", 8 };
+					ofParameter<float> distance{ "Distance", 10, 1, 100 };
+					ofParameter<float> spread{ "Spread", 3, 0, 50 };
+
+					struct : ofParameterGroup {
+						ofParameter<int> count{ "Count", 200 };
+						PARAM_DECLARE("Points", count);
+					} points;
+
+					struct : ofParameterGroup {
+						ofParameter<int> count{ "Count", 16 };
+						ofParameter<int> resolution{ "Resolution", 3 };
+						PARAM_DECLARE("Lasers", count, resolution);
+					} lasers;
+
+					struct : ofParameterGroup {
+						ofParameter<float> imageNoise{ "Image noise [px]", 0.5, 0, 10 };
+						ofParameter<float> initialPosition{ "Initial position error", 0.1, 0, 10 };
+						ofParameter<float> initialRotation{ "Initial rotation error", 0.02, 0, 1 };
+						PARAM_DECLARE("Noise", imageNoise, initialPosition, initialRotation);
+					} noise;
+
+					PARAM_DECLARE("SolverBenchmark", cameraCount, distance, spread, points, lasers, noise);
+				} parameters;
+			};
+		}
+	}
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "pch_Plugin_Scrap.h"
 #include "BundleAdjustmentLasers.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 struct ProjectedLineCost
 {
@@ -371,6 +372,21 @@ namespace ofxRulr {
 			}
 		}
 
+		//----------
+		static ceres::LossFunction*
+			createLossFunction(BundleAdjustmentLasers::Loss loss, float scale)
+		{
+			switch (loss) {
+			case BundleAdjustmentLasers::Loss::Huber:
+				return new ceres::HuberLoss(scale);
+			case BundleAdjustmentLasers::Loss::Cauchy:
+				return new ceres::CauchyLoss(scale);
+			case BundleAdjustmentLasers::Loss::None:
+			default:
+				return NULL;
+			}
+		}
+
 		//----------
 		ofxCeres::SolverSettings
 			BundleAdjustmentLasers::defaultSolverSettings()
@@ -483,8 +499,16 @@ namespace ofxRulr {
 				, this->cameraIntrinsics
 				, weight);
 
+			// Wrap the loss so that it can be changed between passes of solveRobust
+			auto lossFunction = new ceres::LossFunctionWrapper(createLossFunction(this->loss, this->lossScale)
+				, ceres::TAKE_OWNERSHIP);
+			this->observations.push_back(Observation{
+				image
+				, lossFunction
+				});
+
 			this->problem.AddResidualBlock(residualBlock
-				, NULL
+				, lossFunction
 				, cameraViewTranslationData
 				, cameraViewRotationData
 				, laserRigidBodyTranslationData
@@ -667,46 +691,195 @@ namespace ofxRulr {
 				cout << "Solve BundleAdjustmentLasers" << endl;
 			}
 			ceres::Solver::Summary summary;
-			ceres::Solve(solverSettings.options
+			Utils::solveCeres("BundleAdjustmentLasers"
+				, solverSettings.options
 				, &problem
-				, &summary);
+				, &summary
+				, true); // points can be eliminated (Schur)
 
 			if (solverSettings.printReport) {
 				cout << summary.FullReport() << endl;
 			}
 
-			{
-				Result result(summary);
-
-				{
-					auto cameraCount = this->allCameraTranslationParameters.size();
-					for (size_t i = 0; i < cameraCount; i++) {
-						auto cameraViewTranslationParameters = this->allCameraTranslationParameters[i];
-						auto cameraViewRotationParameters = this->allCameraRotationParameters[i];
-						auto transform = Models::Transform_<double>(cameraViewTranslationParameters, cameraViewRotationParameters).castTo<float>();
-						result.solution.cameraViewTransforms.push_back(transform);
-					}
+			return this->getResult(summary);
+		}
+
+		//----------
+		BundleAdjustmentLasers::Result
+			BundleAdjustmentLasers::Problem::solveRobust(const ofxCeres::SolverSettings& solverSettings
+				, const RobustSettings& robustSettings)
+		{
+			// Start with all observations as inliers
+			for (auto& observation : this->observations) {
+				observation.inlier = true;
+			}
+			this->setLoss(robustSettings.loss, robustSettings.lossScale);
+
+			ceres::Solver::Summary summary;
+			auto passCount = max(robustSettings.maxPasses, 1);
+			for (int pass = 0; pass < passCount; pass++) {
+				if (solverSettings.printReport) {
+					cout << "Solve BundleAdjustmentLasers (pass " << (pass + 1) << " / " << passCount << ")" << endl;
 				}
 
-				{
-					auto laserCount = this->allLaserTranslationParameters.size();
-					for (size_t i = 0; i < laserCount; i++) {
-						auto laserRigidBodyTranslationParameters = this->allLaserTranslationParameters[i];
-						auto laserRigidBodyRotationParameters = this->allLaserRotationParameters[i];
-						auto transform = Models::Transform_<double>(laserRigidBodyTranslationParameters, laserRigidBodyRotationParameters).castTo<float>();
+				// Each pass continues from the parameters of the previous pass
+				Utils::solveCeres("BundleAdjustmentLasers"
+					, solverSettings.options
+					, &problem
+					, &summary
+					, true); // points can be eliminated (Schur)
 
-						auto laserFovParameters = this->allLaserFovParameters[i];
-						auto fov = (glm::vec2)glm::tvec2<double>(laserFovParameters[0], laserFovParameters[1]);
+				if (solverSettings.printReport) {
+					cout << summary.BriefReport() << endl;
+				}
 
-						auto laserFov2Parameters = this->allLaserFov2Parameters[i];
-						auto fov2 = (glm::vec2)glm::tvec2<double>(laserFov2Parameters[0], laserFov2Parameters[1]);
+				if (summary.termination_type == ceres::TerminationType::FAILURE
+					|| pass + 1 == passCount
+					|| this->observations.empty()) {
+					break;
+				}
 
-						result.solution.laserProjectors.emplace_back(Models::LaserProjector{ transform, fov, fov2 });
+				// Classify observations by residual
+				vector<float> residuals;
+				residuals.reserve(this->observations.size());
+				for (const auto& observation : this->observations) {
+					residuals.push_back(this->getObservationResidual(observation));
+				}
+
+				auto sortedResiduals = residuals;
+				auto median = sortedResiduals.begin() + sortedResiduals.size() / 2;
+				nth_element(sortedResiduals.begin(), median, sortedResiduals.end());
+				auto threshold = max(*median * robustSettings.outlierThreshold
+					, robustSettings.minOutlierResidual);
+
+				size_t changedCount = 0;
+				size_t outlierCount = 0;
+				for (size_t i = 0; i < this->observations.size(); i++) {
+					auto& observation = this->observations[i];
+					auto inlier = residuals[i] <= threshold;
+
+					if (!inlier) {
+						outlierCount++;
+					}
+
+					if (inlier != observation.inlier) {
+						observation.inlier = inlier;
+						observation.lossFunction->Reset(inlier
+							? createLossFunction(this->loss, this->lossScale)
+							: new ceres::ScaledLoss(NULL, 0.0, ceres::TAKE_OWNERSHIP)
+							, ceres::TAKE_OWNERSHIP);
+						changedCount++;
 					}
 				}
 
-				return result;
+				if (solverSettings.printReport) {
+					cout << "Outlier threshold " << threshold << "px : "
+						<< outlierCount << " / " << this->observations.size() << " outliers"
+						<< " (" << changedCount << " changed)" << endl;
+				}
+
+				// Inlier set is stable
+				if (changedCount == 0) {
+					break;
+				}
 			}
+
+			if (solverSettings.printReport) {
+				cout << summary.FullReport() << endl;
+			}
+
+			return this->getResult(summary);
+		}
+
+		//----------
+		void
+			BundleAdjustmentLasers::Problem::setLoss(Loss loss, float scale)
+		{
+			this->loss = loss;
+			this->lossScale = scale;
+
+			for (auto& observation : this->observations) {
+				if (observation.inlier) {
+					observation.lossFunction->Reset(createLossFunction(this->loss, this->lossScale), ceres::TAKE_OWNERSHIP);
+				}
+			}
+		}
+
+		//----------
+		vector<BundleAdjustmentLasers::ObservationResidual>
+			BundleAdjustmentLasers::Problem::getObservationResiduals() const
+		{
+			vector<ObservationResidual> observationResiduals;
+			observationResiduals.reserve(this->observations.size());
+			for (const auto& observation : this->observations) {
+				observationResiduals.push_back(ObservationResidual{
+					observation.image
+					, this->getObservationResidual(observation)
+					, observation.inlier
+					});
+			}
+			return observationResiduals;
+		}
+
+		//----------
+		float
+			BundleAdjustmentLasers::Problem::getObservationResidual(const Observation& observation) const
+		{
+			const auto& image = observation.image;
+
+			ProjectedLineCost costFunction(image.projectedPoint
+				, image.imageLine
+				, this->cameraIntrinsics
+				, 1.0f);
+
+			double residuals[2];
+			if (!costFunction(this->allCameraTranslationParameters[image.cameraIndex]
+				, this->allCameraRotationParameters[image.cameraIndex]
+				, this->allLaserTranslationParameters[image.laserProjectorIndex]
+				, this->allLaserRotationParameters[image.laserProjectorIndex]
+				, this->allLaserFovParameters[image.laserProjectorIndex]
+				, this->allLaserFov2Parameters[image.laserProjectorIndex]
+				, residuals)) {
+				throw(ofxRulr::Exception("BundleAdjustmentLasers::Problem::getObservationResidual : Failed to evaluate cost function"));
+			}
+
+			return (float) sqrt((residuals[0] * residuals[0] + residuals[1] * residuals[1]) / 2.0);
+		}
+
+		//----------
+		BundleAdjustmentLasers::Result
+			BundleAdjustmentLasers::Problem::getResult(const ceres::Solver::Summary& summary) const
+		{
+			Result result(summary);
+
+			{
+				auto cameraCount = this->allCameraTranslationParameters.size();
+				for (size_t i = 0; i < cameraCount; i++) {
+					auto cameraViewTranslationParameters = this->allCameraTranslationParameters[i];
+					auto cameraViewRotationParameters = this->allCameraRotationParameters[i];
+					auto transform = Models::Transform_<double>(cameraViewTranslationParameters, cameraViewRotationParameters).castTo<float>();
+					result.solution.cameraViewTransforms.push_back(transform);
+				}
+			}
+
+			{
+				auto laserCount = this->allLaserTranslationParameters.size();
+				for (size_t i = 0; i < laserCount; i++) {
+					auto laserRigidBodyTranslationParameters = this->allLaserTranslationParameters[i];
+					auto laserRigidBodyRotationParameters = this->allLaserRotationParameters[i];
+					auto transform = Models::Transform_<double>(laserRigidBodyTranslationParameters, laserRigidBodyRotationParameters).castTo<float>();
+
+					auto laserFovParameters = this->allLaserFovParameters[i];
+					auto fov = (glm::vec2)glm::tvec2<double>(laserFovParameters[0], laserFovParameters[1]);
+
+					auto laserFov2Parameters = this->allLaserFov2Parameters[i];
+					auto fov2 = (glm::vec2)glm::tvec2<double>(laserFov2Parameters[0], laserFov2Parameters[1]);
+
+					result.solution.laserProjectors.emplace_back(Models::LaserProjector{ transform, fov, fov2 });
+				}
+			}
+
+			return result;
 		}
 
 		//----------
@@ -29,6 +29,29 @@ namespace ofxRulr {
 
 			typedef ofxCeres::Result<Solution> Result;
 
+			enum class Loss {
+				None,
+				Huber,
+				Cauchy
+			};
+
+			// Iteratively reweighted solve : each pass solves with the robust loss, then observations are
+			// classified as inliers/outliers by their residual. Outliers are given zero weight for the next pass
+			// (they stay in the problem, so they can be re-admitted if the solution moves towards them).
+			struct RobustSettings {
+				Loss loss = Loss::Huber;
+				float lossScale = 2.0f; // [px]
+				int maxPasses = 5;
+				float outlierThreshold = 3.0f; // multiples of the median residual
+				float minOutlierResidual = 1.0f; // [px] observations below this are always inliers
+			};
+
+			struct ObservationResidual {
+				Image image;
+				float residual; // RMS of the line residuals [px]
+				bool inlier;
+			};
+
 			static ofxCeres::SolverSettings defaultSolverSettings();
 			
 			static void fillCameraParameters(const Models::Transform&
@@ -70,7 +93,22 @@ namespace ofxRulr {
 				void setCamerasVariable();
 
 				Result solve(const ofxCeres::SolverSettings&);
+				Result solveRobust(const ofxCeres::SolverSettings&, const RobustSettings&);
+
+				void setLoss(Loss, float scale);
+
+				// Residuals of the line observations at the current parameters (in the order they were added)
+				vector<ObservationResidual> getObservationResiduals() const;
 			protected:
+				struct Observation {
+					Image image;
+					ceres::LossFunctionWrapper* lossFunction; // owned by the problem
+					bool inlier = true;
+				};
+
+				float getObservationResidual(const Observation&) const;
+				Result getResult(const ceres::Solver::Summary&) const;
+
 				ceres::Problem problem;
 				const Models::Intrinsics cameraIntrinsics;
 
@@ -84,6 +122,10 @@ namespace ofxRulr {
 
 				set<int> activeCameras;
 				set<int> activeLasers;
+
+				vector<Observation> observations;
+				Loss loss = Loss::None;
+				float lossScale = 1.0f;
 			};
 
 			static float getResidual(const Solution&
@@ -2,6 +2,7 @@
 #include "BundleAdjustmentPoints.h"
 
 #include "ofxRulr/Models/Camera.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 struct ProjectedPointCost
 {
@@ -63,6 +64,130 @@ struct ProjectedPointCost
 	const float weight;
 };
 
+// Same residual as ProjectedPointCost with the Jacobians derived by hand.
+// The view rotation is euler angles (x, y, z) applied as R = Rz * Ry * Rx (the convention of glm::eulerAngles,
+// which Models::Transform_ uses to decompose a matrix), and the view transform is viewPoint = R * worldPoint + t.
+class ProjectedPointAnalyticCost : public ceres::SizedCostFunction<2, 3, 3, 3>
+{
+public:
+	//---------
+	ProjectedPointAnalyticCost(const glm::vec2& imagePoint
+		, const ofxRulr::Models::Intrinsics& cameraIntrinsics
+		, const float weight)
+		: imagePoint(imagePoint)
+		, cameraIntrinsics(cameraIntrinsics.castTo<double>())
+		, weight(weight)
+	{
+
+	}
+
+	//---------
+	bool
+		Evaluate(double const* const* parameters
+			, double* residuals
+			, double** jacobians) const override
+	{
+		const auto& worldPoint = *(const glm::tvec3<double>*) parameters[0];
+		const auto& translation = *(const glm::tvec3<double>*) parameters[1];
+		const auto& rotation = *(const glm::tvec3<double>*) parameters[2];
+
+		// Rotation matrices per axis and their derivatives (glm is column major)
+		const auto cx = cos(rotation.x), sx = sin(rotation.x);
+		const auto cy = cos(rotation.y), sy = sin(rotation.y);
+		const auto cz = cos(rotation.z), sz = sin(rotation.z);
+
+		const glm::dmat3 rx(glm::dvec3(1, 0, 0), glm::dvec3(0, cx, sx), glm::dvec3(0, -sx, cx));
+		const glm::dmat3 ry(glm::dvec3(cy, 0, -sy), glm::dvec3(0, 1, 0), glm::dvec3(sy, 0, cy));
+		const glm::dmat3 rz(glm::dvec3(cz, sz, 0), glm::dvec3(-sz, cz, 0), glm::dvec3(0, 0, 1));
+		const auto rotationMatrix = rz * ry * rx;
+
+		// Transform into view space
+		const auto viewPoint = rotationMatrix * worldPoint + translation;
+
+		// Project (homogeneous)
+		const auto& projection = this->cameraIntrinsics.projectionMatrix;
+		const auto clip = projection * glm::dvec4(viewPoint, 1.0);
+		const auto ndc = glm::dvec2(clip.x, clip.y) / clip.w;
+
+		const glm::dvec2 projectedImagePoint(this->cameraIntrinsics.width * (ndc.x + 1.0) / 2.0
+			, this->cameraIntrinsics.height * (1.0 - ndc.y) / 2.0);
+		const auto delta = projectedImagePoint - (glm::dvec2) this->imagePoint;
+
+		residuals[0] = delta.x * this->weight;
+		residuals[1] = delta.y * this->weight;
+
+		if (!jacobians) {
+			return true;
+		}
+
+		// d(imagePoint) / d(viewPoint) [row][column]
+		double imageByView[2][3];
+		{
+			const auto wSquared = clip.w * clip.w;
+			const double scale[2] = {
+				this->weight * this->cameraIntrinsics.width / 2.0
+				, -this->weight * this->cameraIntrinsics.height / 2.0
+			};
+			for (int row = 0; row < 2; row++) {
+				for (int column = 0; column < 3; column++) {
+					imageByView[row][column] = scale[row]
+						* (projection[column][row] * clip.w - clip[row] * projection[column][3])
+						/ wSquared;
+				}
+			}
+		}
+
+		// Chain with d(viewPoint) / d(parameters) where each column of the 3x3 is a glm::dvec3
+		auto chain = [&imageByView](const glm::dmat3& viewByParameters, double* jacobian) {
+			for (int row = 0; row < 2; row++) {
+				for (int column = 0; column < 3; column++) {
+					const auto& viewByParameter = viewByParameters[column];
+					jacobian[row * 3 + column] = imageByView[row][0] * viewByParameter.x
+						+ imageByView[row][1] * viewByParameter.y
+						+ imageByView[row][2] * viewByParameter.z;
+				}
+			}
+		};
+
+		// World point
+		if (jacobians[0]) {
+			chain(rotationMatrix, jacobians[0]);
+		}
+
+		// View translation
+		if (jacobians[1]) {
+			chain(glm::dmat3(1.0), jacobians[1]);
+		}
+
+		// View rotation
+		if (jacobians[2]) {
+			const glm::dmat3 drx(glm::dvec3(0, 0, 0), glm::dvec3(0, -sx, cx), glm::dvec3(0, -cx, -sx));
+			const glm::dmat3 dry(glm::dvec3(-sy, 0, -cy), glm::dvec3(0, 0, 0), glm::dvec3(cy, 0, -sy));
+			const glm::dmat3 drz(glm::dvec3(-sz, cz, 0), glm::dvec3(-cz, -sz, 0), glm::dvec3(0, 0, 0));
+
+			const glm::dmat3 viewByRotation(rz * ry * drx * worldPoint
+				, rz * dry * rx * worldPoint
+				, drz * ry * rx * worldPoint);
+			chain(viewByRotation, jacobians[2]);
+		}
+
+		return true;
+	}
+
+	//---------
+	static ceres::CostFunction*
+		Create(const glm::vec2& imagePoint
+			, const ofxRulr::Models::Intrinsics& cameraIntrinsics
+			, const float& weight)
+	{
+		return new ProjectedPointAnalyticCost(imagePoint, cameraIntrinsics, weight);
+	}
+protected:
+	const glm::vec2 imagePoint;
+	const ofxRulr::Models::Intrinsics_<double> cameraIntrinsics;
+	const double weight;
+};
+
 struct SceneRadiusCost
 {
 	//---------
@@ -213,7 +338,7 @@ struct CameraFixedRotateCost
 	}
 
 	const size_t axis;
-	const size_t angle;
+	const float angle;
 };
 
 struct PointsInPlaneCost
@@ -293,61 +418,51 @@ namespace ofxRulr {
 			, size_t viewCount
 			, const Models::Intrinsics& cameraIntrinsics)
 			: cameraIntrinsics(cameraIntrinsics)
+			, worldPointParameters(pointCount * 3, 0.0)
+			, viewTranslationParameters(viewCount * 3, 0.0)
+			, viewRotationParameters(viewCount * 3, 0.0)
 		{
-			for (size_t i = 0; i < pointCount; i++) {
-				this->allWorldPointParameters.push_back(new double[3]);
-			}
 
-			for (size_t i = 0; i < viewCount; i++) {
-				this->allViewTranslateParameters.push_back(new double[3]);
-				this->allViewRotationParameters.push_back(new double[3]);
-			}
 		}
 
 		//---------
 		BundleAdjustmentPoints::Problem::Problem(const Solution& initialSolution
 			, const Models::Intrinsics& cameraIntrinsics)
-			: cameraIntrinsics(cameraIntrinsics)
+			: Problem(initialSolution.worldPoints.size()
+				, initialSolution.cameraViewTransforms.size()
+				, cameraIntrinsics)
 		{
-			for (const auto& worldPoint : initialSolution.worldPoints) {
-				auto data = new double[3];
+			for (size_t i = 0; i < initialSolution.worldPoints.size(); i++) {
+				const auto& worldPoint = initialSolution.worldPoints[i];
+				auto data = this->getWorldPointParameters(i);
 				data[0] = (double)worldPoint[0];
 				data[1] = (double)worldPoint[1];
 				data[2] = (double)worldPoint[2];
-				this->allWorldPointParameters.push_back(data);
 			}
 
-			for (const auto& cameraView : initialSolution.cameraViewTransforms) {
+			for (size_t i = 0; i < initialSolution.cameraViewTransforms.size(); i++) {
+				const auto& cameraView = initialSolution.cameraViewTransforms[i];
 				{
-					auto data = new double[3];
+					auto data = this->getViewTranslationParameters(i);
 					data[0] = (double)cameraView.translation[0];
 					data[1] = (double)cameraView.translation[1];
 					data[2] = (double)cameraView.translation[2];
-					this->allViewTranslateParameters.push_back(data);
 				}
 
 				{
-					auto data = new double[3];
+					auto data = this->getViewRotationParameters(i);
 					data[0] = (double)cameraView.rotation[0];
 					data[1] = (double)cameraView.rotation[1];
 					data[2] = (double)cameraView.rotation[2];
-					this->allViewRotationParameters.push_back(data);
 				}
 			}
 		}
 
 		//---------
-		BundleAdjustmentPoints::Problem::~Problem()
+		void
+			BundleAdjustmentPoints::Problem::setUseAnalyticJacobians(bool useAnalyticJacobians)
 		{
-			for (auto& data : allWorldPointParameters) {
-				delete[] data;
-			}
-			for (auto& data : allViewTranslateParameters) {
-				delete[] data;
-			}
-			for (auto& data : allViewRotationParameters) {
-				delete[] data;
-			}
+			this->useAnalyticJacobians = useAnalyticJacobians;
 		}
 
 		//---------
@@ -355,91 +470,162 @@ namespace ofxRulr {
 		BundleAdjustmentPoints::Problem::addImagePointObservation(const Image& image
 			, bool applyWeightByDistanceFromImageCenter)
 		{
-			if (image.pointIndex >= this->allWorldPointParameters.size()) {
+			if (image.pointIndex >= this->getPointCount()) {
 				throw(ofxRulr::Exception("image.pointIndex is out of range"));
 			}
 
-			if (image.viewIndex >= this->allViewTranslateParameters.size()) {
+			if (image.viewIndex >= this->getViewCount()) {
 				throw(ofxRulr::Exception("image.viewIndex is out of range"));
 			}
 
-			auto& worldPointData = this->allWorldPointParameters[image.pointIndex];
-			auto& viewTranslationData = this->allViewTranslateParameters[image.viewIndex];
-			auto& viewRotationData = this->allViewRotationParameters[image.viewIndex];
-
 			float weight = 1.0f;
 			if (applyWeightByDistanceFromImageCenter) {
 				auto distanceToImageCenter = image.imagePoint - glm::vec2(this->cameraIntrinsics.width, this->cameraIntrinsics.height);
 				weight = 1.0f / sqrt(glm::length(distanceToImageCenter));
 			}
-			auto residualBlock = ProjectedPointCost::Create(image.imagePoint
-				, this->cameraIntrinsics
-				, weight);
+			auto residualBlock = this->useAnalyticJacobians
+				? ProjectedPointAnalyticCost::Create(image.imagePoint
+					, this->cameraIntrinsics
+					, weight)
+				: ProjectedPointCost::Create(image.imagePoint
+					, this->cameraIntrinsics
+					, weight);
 
 			this->problem.AddResidualBlock(residualBlock
 				, NULL
-				, worldPointData
-				, viewTranslationData
-				, viewRotationData);
+				, this->getWorldPointParameters(image.pointIndex)
+				, this->getViewTranslationParameters(image.viewIndex)
+				, this->getViewRotationParameters(image.viewIndex));
 		}
 
 		//---------
 		void
 			BundleAdjustmentPoints::Problem::addSceneScaleConstraint(float maxRadius)
 		{
-			auto residualBlock = SceneRadiusCost::Create(maxRadius, this->allWorldPointParameters.size());
+			auto residualBlock = SceneRadiusCost::Create(maxRadius, this->getPointCount());
 			this->problem.AddResidualBlock(residualBlock
 				, NULL
-				, this->allWorldPointParameters);
+				, this->getAllWorldPointParameters());
+			this->pointsCoupled = true;
 		}
 
 		//---------
 		void
 			BundleAdjustmentPoints::Problem::addSceneCenteredConstraint(const glm::vec3& sceneCenter)
 		{
-			auto residualBlock = SceneCenterCost::Create(sceneCenter, this->allWorldPointParameters.size());
+			auto residualBlock = SceneCenterCost::Create(sceneCenter, this->getPointCount());
 			this->problem.AddResidualBlock(residualBlock
 				, NULL
-				, this->allWorldPointParameters);
+				, this->getAllWorldPointParameters());
+			this->pointsCoupled = true;
 		}
 
 		//---------
 		void
 			BundleAdjustmentPoints::Problem::addCameraZeroYawConstraint(int viewIndex)
 		{
-			if (viewIndex >= this->allViewRotationParameters.size()) {
+			if (viewIndex >= this->getViewCount()) {
 				throw(ofxRulr::Exception("viewIndex is out of range"));
 			}
 
 			auto residualBlock = CameraFixedRotateCost::Create(1, 0.0f);
 			this->problem.AddResidualBlock(residualBlock
 				, NULL
-				, this->allViewRotationParameters[viewIndex]);
+				, this->getViewRotationParameters(viewIndex));
 		}
 
 		//---------
 		void
 			BundleAdjustmentPoints::Problem::addCameraZeroRollConstrant(int viewIndex)
 		{
-			if (viewIndex >= this->allViewRotationParameters.size()) {
+			if (viewIndex >= this->getViewCount()) {
 				throw(ofxRulr::Exception("viewIndex is out of range"));
 			}
 
 			auto residualBlock = CameraFixedRotateCost::Create(2, 0.0f);
 			this->problem.AddResidualBlock(residualBlock
 				, NULL
-				, this->allViewRotationParameters[viewIndex]);
+				, this->getViewRotationParameters(viewIndex));
 		}
 
 		//---------
 		void
 			BundleAdjustmentPoints::Problem::addPointsInPlaneConstraint(size_t plane)
 		{
-			auto residualBlock = PointsInPlaneCost::Create(plane, this->allWorldPointParameters.size());
+			auto residualBlock = PointsInPlaneCost::Create(plane, this->getPointCount());
 			this->problem.AddResidualBlock(residualBlock
 				, NULL
-				, this->allWorldPointParameters);
-			
+				, this->getAllWorldPointParameters());
+			this->pointsCoupled = true;
+		}
+
+		//---------
+		shared_ptr<ceres::ParameterBlockOrdering>
+			BundleAdjustmentPoints::Problem::getParameterOrdering()
+		{
+			if (this->pointsCoupled) {
+				return nullptr;
+			}
+
+			auto ordering = make_shared<ceres::ParameterBlockOrdering>();
+			size_t pointsInProblem = 0;
+			{
+				auto pointCount = this->getPointCount();
+				for (size_t i = 0; i < pointCount; i++) {
+					auto data = this->getWorldPointParameters(i);
+					if (this->problem.HasParameterBlock(data)) {
+						ordering->AddElementToGroup(data, 0);
+						pointsInProblem++;
+					}
+				}
+			}
+			if (pointsInProblem == 0) {
+				return nullptr;
+			}
+
+			{
+				auto viewCount = this->getViewCount();
+				for (size_t i = 0; i < viewCount; i++) {
+					auto translationData = this->getViewTranslationParameters(i);
+					auto rotationData = this->getViewRotationParameters(i);
+					if (this->problem.HasParameterBlock(translationData)) {
+						ordering->AddElementToGroup(translationData, 1);
+					}
+					if (this->problem.HasParameterBlock(rotationData)) {
+						ordering->AddElementToGroup(rotationData, 1);
+					}
+				}
+			}
+
+			return ordering;
+		}
+
+		//---------
+		void
+			BundleAdjustmentPoints::Problem::configureLinearSolver(ceres::Solver::Options& options)
+		{
+			if (options.linear_solver_ordering) {
+				return;
+			}
+
+			auto ordering = this->getParameterOrdering();
+			if (!ordering) {
+				return;
+			}
+			options.linear_solver_ordering = ordering;
+
+			// The reduced camera system is 6 * viewCount square. Above this it's cheaper to keep it sparse
+			const size_t denseSchurMaxViewCount = 50;
+			if (options.linear_solver_type == ceres::DENSE_SCHUR
+				&& this->getViewCount() > denseSchurMaxViewCount) {
+				if (ceres::IsSparseLinearAlgebraLibraryTypeAvailable(options.sparse_linear_algebra_library_type)) {
+					options.linear_solver_type = ceres::SPARSE_SCHUR;
+				}
+				else {
+					options.linear_solver_type = ceres::ITERATIVE_SCHUR;
+					options.preconditioner_type = ceres::SCHUR_JACOBI;
+				}
+			}
 		}
 
 		//---------
@@ -449,8 +635,12 @@ namespace ofxRulr {
 			if (solverSettings.printReport) {
 				cout << "Solve BundleAdjustmentPoints" << endl;
 			}
+			auto options = solverSettings.options;
+			this->configureLinearSolver(options);
+
 			ceres::Solver::Summary summary;
-			ceres::Solve(solverSettings.options
+			Utils::solveCeres("BundleAdjustmentPoints"
+				, options
 				, &problem
 				, &summary);
 
@@ -461,15 +651,15 @@ namespace ofxRulr {
 			{
 				Result result(summary);
 
-				for (auto& worldPointParameters : this->allWorldPointParameters) {
-					result.solution.worldPoints.push_back((glm::vec3) * (glm::tvec3<double>*) worldPointParameters);
+				auto pointCount = this->getPointCount();
+				for (size_t i = 0; i < pointCount; i++) {
+					result.solution.worldPoints.push_back((glm::vec3) * (glm::tvec3<double>*) this->getWorldPointParameters(i));
 				}
 
-				auto viewCount = this->allViewTranslateParameters.size();
+				auto viewCount = this->getViewCount();
 				for (size_t i = 0; i < viewCount; i++) {
-					auto viewTranslationParameters = this->allViewTranslateParameters[i];
-					auto viewRotationParameters = this->allViewRotationParameters[i];
-					auto transform = Models::Transform_<double>(viewTranslationParameters, viewRotationParameters).castTo<float>();
+					auto transform = Models::Transform_<double>(this->getViewTranslationParameters(i)
+						, this->getViewRotationParameters(i)).castTo<float>();
 					result.solution.cameraViewTransforms.push_back(transform);
 				}
 
@@ -477,5 +667,52 @@ namespace ofxRulr {
 			}
 
 		}
+
+		//---------
+		size_t
+			BundleAdjustmentPoints::Problem::getPointCount() const
+		{
+			return this->worldPointParameters.size() / 3;
+		}
+
+		//---------
+		size_t
+			BundleAdjustmentPoints::Problem::getViewCount() const
+		{
+			return this->viewTranslationParameters.size() / 3;
+		}
+
+		//---------
+		double*
+			BundleAdjustmentPoints::Problem::getWorldPointParameters(size_t pointIndex)
+		{
+			return this->worldPointParameters.data() + pointIndex * 3;
+		}
+
+		//---------
+		double*
+			BundleAdjustmentPoints::Problem::getViewTranslationParameters(size_t viewIndex)
+		{
+			return this->viewTranslationParameters.data() + viewIndex * 3;
+		}
+
+		//---------
+		double*
+			BundleAdjustmentPoints::Problem::getViewRotationParameters(size_t viewIndex)
+		{
+			return this->viewRotationParameters.data() + viewIndex * 3;
+		}
+
+		//---------
+		vector<double*>
+			BundleAdjustmentPoints::Problem::getAllWorldPointParameters()
+		{
+			vector<double*> allWorldPointParameters;
+			auto pointCount = this->getPointCount();
+			for (size_t i = 0; i < pointCount; i++) {
+				allWorldPointParameters.push_back(this->getWorldPointParameters(i));
+			}
+			return allWorldPointParameters;
+		}
 	}
 }
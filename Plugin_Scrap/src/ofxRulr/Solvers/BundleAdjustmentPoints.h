@@ -32,7 +32,9 @@ namespace ofxRulr {
 				Problem(const Solution& initialSolution
 					, const Models::Intrinsics& cameraIntrinsics);
 
-				~Problem();
+				// Use the hand-derived Jacobian for the reprojection residual (default).
+				// Set to false before adding observations to use automatic differentiation instead.
+				void setUseAnalyticJacobians(bool);
 
 				void addImagePointObservation(const Image&, bool applyWeightByDistanceFromImageCenter);
 				void addSceneScaleConstraint(float maxRadius);
@@ -41,14 +43,37 @@ namespace ofxRulr {
 				void addCameraZeroRollConstrant(int viewIndex);
 				void addPointsInPlaneConstraint(size_t plane);
 
+				// Elimination ordering for the Schur solvers : world points in group 0 (eliminated first)
+				// and views in group 1. Points which are coupled by a scene constraint (scale, center, plane)
+				// can't be eliminated and are put in group 1 with the views.
+				// Returns nullptr if no point can be eliminated (ceres will then choose the ordering).
+				shared_ptr<ceres::ParameterBlockOrdering> getParameterOrdering();
+
+				// If the options have no ordering, this applies getParameterOrdering(), and for problems
+				// with many views replaces DENSE_SCHUR with SPARSE_SCHUR (or ITERATIVE_SCHUR with
+				// the SCHUR_JACOBI preconditioner if no sparse library is available)
+				void configureLinearSolver(ceres::Solver::Options&);
+
 				Result solve(const ofxCeres::SolverSettings&);
+
+				size_t getPointCount() const;
+				size_t getViewCount() const;
 			protected:
+				double* getWorldPointParameters(size_t pointIndex);
+				double* getViewTranslationParameters(size_t viewIndex);
+				double* getViewRotationParameters(size_t viewIndex);
+				vector<double*> getAllWorldPointParameters();
+
 				ceres::Problem problem;
 				const Models::Intrinsics cameraIntrinsics;
 
-				vector<double*> allWorldPointParameters;
-				vector<double*> allViewTranslateParameters;
-				vector<double*> allViewRotationParameters;
+				// Contiguous storage, 3 values per point / view
+				vector<double> worldPointParameters;
+				vector<double> viewTranslationParameters;
+				vector<double> viewRotationParameters;
+
+				bool useAnalyticJacobians = true;
+				bool pointsCoupled = false;
 			};
 		};
 	}
@@ -1,6 +1,7 @@
 #include "pch_Plugin_Scrap.h"
 #include "LineMCToImage.h"
 #include <opencv2/opencv.hpp>
+#include "ofxRulr/Utils/SolveCeres.h"
 
 const bool previewEnabled = true;
 
@@ -134,7 +135,8 @@ namespace ofxRulr {
 
 			// Solve the problem;
 			ceres::Solver::Summary summary;
-			ceres::Solve(solverSettings.options
+			Utils::solveCeres("LineMCToImage"
+				, solverSettings.options
 				, &problem
 				, &summary);
 
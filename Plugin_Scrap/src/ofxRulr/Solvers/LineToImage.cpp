@@ -1,6 +1,7 @@
 #include "pch_Plugin_Scrap.h"
 #include "LineToImage.h"
 #include <opencv2/opencv.hpp>
+#include "ofxRulr/Utils/SolveCeres.h"
 
 const bool previewEnabled = false;
 
@@ -140,7 +141,8 @@ namespace ofxRulr {
 
 			// Solve the problem;
 			ceres::Solver::Summary summary;
-			ceres::Solve(solverSettings.options
+			Utils::solveCeres("LineToImage"
+				, solverSettings.options
 				, &problem
 				, &summary);
 
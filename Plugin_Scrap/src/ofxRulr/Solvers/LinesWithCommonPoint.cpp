@@ -4,6 +4,7 @@
 #include <opencv2/opencv.hpp>
 
 #include "ofxRulr/Nodes/Item/Camera.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 typedef ofxRulr::Models::Line Line;
 
@@ -54,7 +55,7 @@ namespace ofxRulr {
 		{
 			ofxCeres::SolverSettings solverSettings;
 			{
-				solverSettings.options.num_threads = std::thread::hardware_concurrency();
+				solverSettings.options.num_threads = 0; // as many as the SolverRuntime allows
 			}
 			return solverSettings;
 		}
@@ -453,7 +454,8 @@ namespace ofxRulr {
 			{
 				Utils::ScopedProcess scopedProcessSolve("Solve LinesWithCommonPointCost", false);
 
-				ceres::Solve(solverSettings.options
+				Utils::solveCeres("LinesWithCommonPoint"
+					, solverSettings.options
 					, &problem
 					, &summary);
 
@@ -493,7 +495,8 @@ namespace ofxRulr {
 					Utils::ScopedProcess scopedProcessSolve("Solve LinesWithCommonPointCost (alternative)", false);
 
 					ceres::Solver::Summary summaryAlt;
-					ceres::Solve(solverSettings.options
+					Utils::solveCeres("LinesWithCommonPoint"
+						, solverSettings.options
 						, &problem
 						, &summaryAlt);
 
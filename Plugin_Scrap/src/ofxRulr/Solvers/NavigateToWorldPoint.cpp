@@ -1,5 +1,6 @@
 #include "pch_Plugin_Scrap.h"
 #include "NavigateToWorldPoint.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 const bool previewEnabled = false;
 
@@ -86,7 +87,8 @@ namespace ofxRulr {
 
 			// Solve the problem;
 			ceres::Solver::Summary summary;
-			ceres::Solve(solverSettings.options
+			Utils::solveCeres("NavigateToWorldPoint"
+				, solverSettings.options
 				, &problem
 				, &summary);
 
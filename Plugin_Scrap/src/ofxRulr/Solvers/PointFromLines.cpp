@@ -2,6 +2,7 @@
 #include "PointFromLines.h"
 #include <opencv2/opencv.hpp>
 #include "ofxRulr/Models/Line.h"
+#include "ofxRulr/Utils/SolveCeres.h"
 
 const bool previewEnabled = false;
 
@@ -70,7 +71,8 @@ namespace ofxRulr {
 
 			// Solve the problem;
 			ceres::Solver::Summary summary;
-			ceres::Solve(solverSettings.options
+			Utils::solveCeres("PointFromLines"
+				, solverSettings.options
 				, &problem
 				, &summary);
 
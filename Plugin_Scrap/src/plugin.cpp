@@ -19,6 +19,7 @@
 #include "ofxRulr/Nodes/AnotherMoon/ExportPictures.h"
 #include "ofxRulr/Nodes/AnotherMoon/OSCReceiver.h"
 #include "ofxRulr/Nodes/AnotherMoon/Shutdown.h"
+#include "ofxRulr/Nodes/AnotherMoon/SolverBenchmark.h"
 
 
 OFXPLUGIN_PLUGIN_MODULES_BEGIN(ofxRulr::Nodes::Base)
@@ -41,4 +42,5 @@ OFXPLUGIN_PLUGIN_MODULES_BEGIN(ofxRulr::Nodes::Base)
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::AnotherMoon::ExportPictures);
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::AnotherMoon::OSCReceiver);
 	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::AnotherMoon::Shutdown);
+	OFXPLUGIN_PLUGIN_REGISTER_MODULE(ofxRulr::Nodes::AnotherMoon::SolverBenchmark);
 OFXPLUGIN_PLUGIN_MODULES_END
\ No newline at end of file